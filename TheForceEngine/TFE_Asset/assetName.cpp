@@ -0,0 +1,130 @@
+#include <cstdlib>
+#include <cctype>
+
+#include "assetName.h"
+#include <assert.h>
+#include <vector>
+
+namespace TFE_AssetName
+{
+	enum
+	{
+		STRING_BLOCK_SIZE = 16 * 1024,
+		TABLE_MIN_SIZE = 1024,
+	};
+
+	struct NameEntry
+	{
+		u32 hash;
+		const char* str;
+	};
+
+	// Names are stored in fixed size blocks that are never reallocated, so the strings never move.
+	static std::vector<char*> s_stringBlocks;
+	static size_t s_blockUsed = STRING_BLOCK_SIZE;
+
+	static std::vector<NameEntry> s_names;		// Indexed by handle.
+	static std::vector<AssetName> s_table;		// Open addressed hash table of handles.
+
+	static u32 hashName(const char* name, size_t* length)
+	{
+		// FNV-1a of the lower case string.
+		u32 hash = 2166136261u;
+		const char* c = name;
+		for (; *c; c++)
+		{
+			hash = (hash ^ u8(tolower(*c))) * 16777619u;
+		}
+		*length = size_t(c - name);
+		return hash;
+	}
+
+	static bool nameEquals(const char* name, const char* folded)
+	{
+		for (; *name && tolower(*name) == *folded; name++, folded++);
+		return *name == 0 && *folded == 0;
+	}
+
+	static const char* storeString(const char* name, size_t length)
+	{
+		if (s_blockUsed + length + 1 > STRING_BLOCK_SIZE)
+		{
+			// Very long names get their own block.
+			const size_t blockSize = length + 1 > STRING_BLOCK_SIZE ? length + 1 : STRING_BLOCK_SIZE;
+			s_stringBlocks.push_back((char*)malloc(blockSize));
+			s_blockUsed = 0;
+		}
+		char* str = s_stringBlocks.back() + s_blockUsed;
+		for (size_t i = 0; i < length; i++)
+		{
+			str[i] = (char)tolower(name[i]);
+		}
+		str[length] = 0;
+		s_blockUsed += length + 1;
+		return str;
+	}
+
+	// Returns the table slot holding the name or the empty slot where it should be inserted.
+	static AssetName* findSlot(const char* name, u32 hash)
+	{
+		const u32 mask = u32(s_table.size()) - 1;
+		for (u32 i = hash & mask; ; i = (i + 1) & mask)
+		{
+			AssetName* slot = &s_table[i];
+			if (*slot == ASSET_NAME_INVALID || (s_names[*slot].hash == hash && nameEquals(name, s_names[*slot].str)))
+			{
+				return slot;
+			}
+		}
+	}
+
+	static void growTable()
+	{
+		const size_t newSize = s_table.empty() ? TABLE_MIN_SIZE : s_table.size() * 2;
+		s_table.assign(newSize, ASSET_NAME_INVALID);
+
+		const u32 mask = u32(newSize) - 1;
+		const u32 count = u32(s_names.size());
+		for (u32 n = 0; n < count; n++)
+		{
+			u32 i = s_names[n].hash & mask;
+			while (s_table[i] != ASSET_NAME_INVALID) { i = (i + 1) & mask; }
+			s_table[i] = n;
+		}
+	}
+
+	AssetName intern(const char* name)
+	{
+		if (!name) { return ASSET_NAME_INVALID; }
+		// Keep the load factor at or below 1/2.
+		if ((s_names.size() + 1) * 2 > s_table.size())
+		{
+			growTable();
+		}
+
+		size_t length;
+		const u32 hash = hashName(name, &length);
+		AssetName* slot = findSlot(name, hash);
+		if (*slot == ASSET_NAME_INVALID)
+		{
+			*slot = AssetName(s_names.size());
+			s_names.push_back({ hash, storeString(name, length) });
+		}
+		return *slot;
+	}
+
+	AssetName find(const char* name)
+	{
+		if (!name || s_table.empty()) { return ASSET_NAME_INVALID; }
+
+		size_t length;
+		const u32 hash = hashName(name, &length);
+		return *findSlot(name, hash);
+	}
+
+	const char* getString(AssetName handle)
+	{
+		assert(handle < s_names.size());
+		return handle < s_names.size() ? s_names[handle].str : "";
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Interned asset names.
+// Asset names are case-folded and stored once, and each unique name
+// is given a stable handle. Handles are small, dense integers so
+// asset stores can index by them directly instead of building and
+// comparing strings on every lookup.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+
+typedef u32 AssetName;
+#define ASSET_NAME_INVALID 0xffffffffu
+
+namespace TFE_AssetName
+{
+	// Returns the handle for 'name', adding it if it has not been seen before.
+	// Names that differ only by case share the same handle.
+	AssetName intern(const char* name);
+	// Returns the handle for 'name' or ASSET_NAME_INVALID if it has never been interned.
+	AssetName find(const char* name);
+	// Returns the case-folded name. The string remains valid for the lifetime of the program.
+	const char* getString(AssetName handle);
+}
@@ -149,17 +149,42 @@ namespace TFE_Jedi_Object3d
 			}
 		}
 	}
+
+	void object3d_computeVertexArrays(const vec3* vtx, s32 count, JmVertexArrays* out)
+	{
+		*out = { nullptr, nullptr, nullptr };
+		if (count <= 0) { return; }
+
+		const s32 paddedCount = (count + 3) & ~3;
+		f32* data = (f32*)model_alloc(paddedCount * 3 * sizeof(f32));
+		if (!data)
+		{
+			TFE_System::logWrite(LOG_ERROR, "ComputeVertexArrays", "Failed to allocate vertex arrays.");
+			return;
+		}
+		memset(data, 0, paddedCount * 3 * sizeof(f32));
+
+		out->x = data;
+		out->y = data + paddedCount;
+		out->z = data + paddedCount * 2;
+		for (s32 i = 0; i < count; i++, vtx++)
+		{
+			out->x[i] = fixed16ToFloat(vtx->x);
+			out->y[i] = fixed16ToFloat(vtx->y);
+			out->z[i] = fixed16ToFloat(vtx->z);
+		}
+	}
 }
 
 using namespace TFE_Jedi_Object3d;
 
 namespace TFE_Model_Jedi
 {
-	typedef std::map<std::string, JediModel*> ModelMap;
+	// Loaded models indexed by interned name, null if the name is not loaded in the pool.
+	typedef std::vector<JediModel*> ModelTable;
 	typedef std::vector<JediModel*> ModelList;
-	typedef std::map<std::string, TextureData*> TextureMap;
-	typedef std::vector<std::string> NameList;
-	static ModelMap s_models[POOL_COUNT];
+	typedef std::vector<AssetName> NameList;
+	static ModelTable s_models[POOL_COUNT];
 	static ModelList s_modelList[POOL_COUNT];
 	static NameList s_modelNames[POOL_COUNT];
 	static std::vector<char> s_buffer;
@@ -171,13 +196,22 @@ namespace TFE_Model_Jedi
 
 	JediModel* get(const char* name, AssetPool pool)
 	{
-		ModelMap::iterator iModel = s_models[pool].find(name);
-		if (iModel != s_models[pool].end())
+		return get(TFE_AssetName::intern(name), pool);
+	}
+
+	JediModel* get(AssetName assetName, AssetPool pool)
+	{
+		if (assetName == ASSET_NAME_INVALID)
+		{
+			return nullptr;
+		}
+		if (assetName < s_models[pool].size() && s_models[pool][assetName])
 		{
-			return iModel->second;
+			return s_models[pool][assetName];
 		}
 
 		// It doesn't exist yet, try to load the model.
+		const char* name = TFE_AssetName::getString(assetName);
 		FilePath filePath;
 		if (!TFE_Paths::getFilePath(name, &filePath))
 		{
@@ -241,11 +275,23 @@ namespace TFE_Model_Jedi
 		}
 		model->radius = maxDist;
 
+		// Float copies for the vectorized transform.
+		object3d_computeVertexArrays(model->vertices, model->vertexCount, &model->verticesFlt);
+		object3d_computeVertexArrays(model->polygonNormals, model->polygonCount, &model->polygonNormalsFlt);
+		if (model->vertexNormals)
+		{
+			object3d_computeVertexArrays(model->vertexNormals, model->vertexCount, &model->vertexNormalsFlt);
+		}
+
 		// TODO (maybe): Cache binary models to disk so they can be
 		// directly loaded, which will reduce load time.
-		s_models[pool][name] = model;
+		if (assetName >= s_models[pool].size())
+		{
+			s_models[pool].resize(assetName + 1, nullptr);
+		}
+		s_models[pool][assetName] = model;
 		s_modelList[pool].push_back(model);
-		s_modelNames[pool].push_back(name);
+		s_modelNames[pool].push_back(assetName);
 		return model;
 	}
 
@@ -313,14 +359,15 @@ namespace TFE_Model_Jedi
 		s32 count = (s32)s_modelNames[POOL_LEVEL].size();
 		SERIALIZE(SaveVersionInit, count, 0);
 
-		std::string* names = s_modelNames[POOL_LEVEL].data();
+		const AssetName* names = s_modelNames[POOL_LEVEL].data();
 		std::string name;
 		for (s32 i = 0; i < count; i++)
 		{
 			u8 size;
 			if (modeWrite)
 			{
-				size = (u8)names[i].length();
+				name = TFE_AssetName::getString(names[i]);
+				size = (u8)name.length();
 			}
 			SERIALIZE(SaveVersionInit, size, 0);
 
@@ -328,7 +375,7 @@ namespace TFE_Model_Jedi
 			{
 				name.resize(size);
 			}
-			SERIALIZE_BUF(SaveVersionInit, modeWrite ? &names[i][0] : &name[0], size);
+			SERIALIZE_BUF(SaveVersionInit, &name[0], size);
 
 			if (!modeWrite)
 			{
@@ -378,6 +425,9 @@ namespace TFE_Model_Jedi
 		model->textures = nullptr;
 		model->radius = 0;
 		model->drawId = nullptr;	// invalid ID initially.
+		model->verticesFlt = { nullptr, nullptr, nullptr };
+		model->vertexNormalsFlt = { nullptr, nullptr, nullptr };
+		model->polygonNormalsFlt = { nullptr, nullptr, nullptr };
 
 		// Check to see if the name has an underscore.
 		// If so, set the "isBridge" field.
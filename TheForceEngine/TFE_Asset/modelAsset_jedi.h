@@ -4,6 +4,7 @@
 //////////////////////////////////////////////////////////////////////
 #include <TFE_System/types.h>
 #include <TFE_FileSystem/stream.h>
+#include <TFE_Asset/assetName.h>
 #include <string>
 #include <vector>
 
@@ -52,6 +53,15 @@ struct JmPolygon
 	s32 p24;
 };
 
+// TFE: Float copy of vertex positions or normals as separate x, y and z arrays, used by the vectorized transform.
+// Each array holds the values padded with zeros to a multiple of 4, the arrays are null if not computed.
+struct JmVertexArrays
+{
+	f32* x;
+	f32* y;
+	f32* z;
+};
+
 struct JediModel
 {
 	s32 isBridge;		// this 3D object is a 3D "bridge" which gets special sorting. All 3D objects with '_' in their name get this flag.
@@ -66,11 +76,16 @@ struct JediModel
 	TextureData** textures;
 	s32 radius;
 	void* drawId;		// TFE: Added for the GPU renderer.
+	JmVertexArrays verticesFlt;			// TFE: Added for the float renderer.
+	JmVertexArrays vertexNormalsFlt;	// TFE: Added for the float renderer.
+	JmVertexArrays polygonNormalsFlt;	// TFE: Added for the float renderer.
 };
 
 namespace TFE_Model_Jedi
 {
 	JediModel* get(const char* name, AssetPool pool = POOL_LEVEL);
+	// Lookup by interned name, callers that reference the same model repeatedly can keep the handle.
+	JediModel* get(AssetName name, AssetPool pool = POOL_LEVEL);
 	const std::vector<JediModel*>& getModelList(AssetPool pool);
 	void freeAll();
 	void freeLevelData();
@@ -17,6 +17,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 
 using namespace TFE_Jedi;
 
@@ -27,16 +28,17 @@ namespace TFE_Sprite_Jedi
 		PoolDataOffset = 7,
 	};
 
-	typedef std::map<std::string, JediFrame*> FrameMap;
-	typedef std::map<std::string, JediWax*> SpriteMap;
+	// Loaded assets indexed by interned name, null if the name is not loaded in the pool.
+	typedef std::vector<JediFrame*> FrameTable;
+	typedef std::vector<JediWax*> SpriteTable;
 	typedef std::map<const void*, const HdWax*> HdSpriteMap;
 	typedef std::vector<JediFrame*> FrameList;
 	typedef std::vector<JediWax*> SpriteList;
 	typedef std::vector<HdWax*> HdSpriteList;
-	typedef std::vector<std::string> NameList;
+	typedef std::vector<AssetName> NameList;
 
-	static FrameMap    s_frames[POOL_COUNT];
-	static SpriteMap   s_sprites[POOL_COUNT];
+	static FrameTable  s_frames[POOL_COUNT];
+	static SpriteTable s_sprites[POOL_COUNT];
 	static HdSpriteMap s_hdSprites[POOL_COUNT];
 	static FrameList   s_frameList[POOL_COUNT];
 	static SpriteList  s_spriteList[POOL_COUNT];
@@ -45,6 +47,190 @@ namespace TFE_Sprite_Jedi
 	static NameList    s_spriteNames[POOL_COUNT];
 	static std::vector<u8> s_buffer;
 
+	// TFE: Level sprites and frames are owned by a reference-counted cache that survives level transitions.
+	// When a level is freed, its assets are released rather than freed so the next level can reuse them
+	// without loading and processing the files again. Unreferenced assets are evicted in least-recently-used
+	// order once they exceed the cache budget, and are discarded if the search paths have changed since they
+	// were loaded (such as when a different mod is selected).
+	enum SpriteCacheType
+	{
+		CACHE_FRAME = 0,
+		CACHE_WAX,
+		CACHE_COUNT
+	};
+	enum
+	{
+		SPRITE_CACHE_BUDGET = 64 * 1024 * 1024,
+	};
+
+	struct CachedSprite
+	{
+		void*  asset;		// JediFrame or JediWax.
+		HdWax* hdWax;		// HD version, if it exists.
+		size_t size;		// Memory used by the asset and HD version in bytes.
+		u32    searchHash;	// Search path hash when loaded.
+		u32    lastUsed;	// Cache tick when last acquired.
+		s32    refCount;
+	};
+	typedef std::unordered_map<AssetName, CachedSprite> SpriteCache;
+
+	static SpriteCache s_cache[CACHE_COUNT];
+	static size_t s_cacheUnusedSize = 0;	// Memory held by unreferenced assets in bytes.
+	static u32 s_cacheTick = 0;
+	static u32 s_freeGeneration = 0;
+
+	void freeHdWax(HdWax* hdWax);
+	void cache_evict(SpriteCache::iterator iEntry, SpriteCacheType type);
+
+	size_t getHdWaxSize(const HdWax* hdWax)
+	{
+		if (!hdWax) { return 0; }
+
+		size_t size = sizeof(HdWax) + sizeof(HdWaxCell) * hdWax->entryCount;
+		for (s32 i = 0; i < hdWax->entryCount; i++)
+		{
+			size += sizeof(u32) * hdWax->cells[i].pixelCount;
+		}
+		return size;
+	}
+
+	// Returns a cached, unreferenced asset and adds a reference or null if it is not in the cache.
+	CachedSprite* cache_acquire(SpriteCacheType type, AssetName name)
+	{
+		SpriteCache::iterator iEntry = s_cache[type].find(name);
+		if (iEntry == s_cache[type].end())
+		{
+			return nullptr;
+		}
+		// The asset may be stale if the search paths changed since it was loaded.
+		CachedSprite* entry = &iEntry->second;
+		if (entry->searchHash != TFE_Paths::getSearchPathHash())
+		{
+			if (entry->refCount == 0)
+			{
+				cache_evict(iEntry, type);
+			}
+			return nullptr;
+		}
+
+		if (entry->refCount == 0)
+		{
+			s_cacheUnusedSize -= entry->size;
+		}
+		entry->refCount++;
+		entry->lastUsed = s_cacheTick;
+		return entry;
+	}
+
+	void cache_add(SpriteCacheType type, AssetName name, void* asset, HdWax* hdWax, size_t size)
+	{
+		// Replace any stale entry with the same name.
+		SpriteCache::iterator iEntry = s_cache[type].find(name);
+		if (iEntry != s_cache[type].end() && iEntry->second.refCount == 0)
+		{
+			cache_evict(iEntry, type);
+		}
+
+		CachedSprite entry;
+		entry.asset = asset;
+		entry.hdWax = hdWax;
+		entry.size = size + getHdWaxSize(hdWax);
+		entry.searchHash = TFE_Paths::getSearchPathHash();
+		entry.lastUsed = s_cacheTick;
+		entry.refCount = 1;
+		s_cache[type][name] = entry;
+	}
+
+	void cache_release(SpriteCacheType type, AssetName name)
+	{
+		SpriteCache::iterator iEntry = s_cache[type].find(name);
+		if (iEntry == s_cache[type].end() || iEntry->second.refCount <= 0)
+		{
+			return;
+		}
+		iEntry->second.refCount--;
+		if (iEntry->second.refCount == 0)
+		{
+			s_cacheUnusedSize += iEntry->second.size;
+		}
+	}
+
+	// Frees an unreferenced asset and removes it from the cache.
+	void cache_evict(SpriteCache::iterator iEntry, SpriteCacheType type)
+	{
+		CachedSprite* entry = &iEntry->second;
+		assert(entry->refCount == 0);
+
+		s_cacheUnusedSize -= entry->size;
+		free(entry->asset);
+		s_freeGeneration++;
+		freeHdWax(entry->hdWax);
+		s_cache[type].erase(iEntry);
+	}
+
+	// Evicts stale assets and then the least recently used assets until the unreferenced memory fits in the budget.
+	void cache_trim(size_t budget)
+	{
+		const u32 searchHash = TFE_Paths::getSearchPathHash();
+		for (s32 t = 0; t < CACHE_COUNT; t++)
+		{
+			SpriteCache::iterator iEntry = s_cache[t].begin();
+			while (iEntry != s_cache[t].end())
+			{
+				SpriteCache::iterator iCur = iEntry++;
+				if (iCur->second.refCount == 0 && iCur->second.searchHash != searchHash)
+				{
+					cache_evict(iCur, SpriteCacheType(t));
+				}
+			}
+		}
+
+		while (s_cacheUnusedSize > budget)
+		{
+			SpriteCache::iterator iOldest;
+			s32 oldestType = -1;
+			for (s32 t = 0; t < CACHE_COUNT; t++)
+			{
+				SpriteCache::iterator iEntry = s_cache[t].begin();
+				for (; iEntry != s_cache[t].end(); ++iEntry)
+				{
+					if (iEntry->second.refCount == 0 && (oldestType < 0 || iEntry->second.lastUsed < iOldest->second.lastUsed))
+					{
+						iOldest = iEntry;
+						oldestType = t;
+					}
+				}
+			}
+			if (oldestType < 0) { break; }
+			cache_evict(iOldest, SpriteCacheType(oldestType));
+		}
+	}
+
+	template <typename T>
+	T* getTableEntry(const std::vector<T*>& table, AssetName name)
+	{
+		return name < table.size() ? table[name] : nullptr;
+	}
+
+	template <typename T>
+	void setTableEntry(std::vector<T*>& table, AssetName name, T* asset)
+	{
+		if (name >= table.size())
+		{
+			table.resize(name + 1, nullptr);
+		}
+		table[name] = asset;
+	}
+
+	void addHdWax(AssetPool pool, const void* asset, HdWax* hdWax)
+	{
+		if (hdWax)
+		{
+			s_hdSpriteList[pool].push_back(hdWax);
+			s_hdSprites[pool][asset] = hdWax;
+		}
+	}
+
 	bool loadFrameHd(const char* name, const JediFrame* frame, AssetPool pool, HdWax* hdWax)
 	{
 		char hdPath[TFE_MAX_PATH];
@@ -88,13 +274,34 @@ namespace TFE_Sprite_Jedi
 
 	JediFrame* getFrame(const char* name, AssetPool pool)
 	{
-		FrameMap::iterator iFrame = s_frames[pool].find(name);
-		if (iFrame != s_frames[pool].end())
+		return getFrame(TFE_AssetName::intern(name), pool);
+	}
+
+	JediFrame* getFrame(AssetName assetName, AssetPool pool)
+	{
+		if (assetName == ASSET_NAME_INVALID)
 		{
-			return iFrame->second;
+			return nullptr;
+		}
+		if (JediFrame* frame = getTableEntry(s_frames[pool], assetName))
+		{
+			return frame;
+		}
+		if (pool == POOL_LEVEL)
+		{
+			if (CachedSprite* entry = cache_acquire(CACHE_FRAME, assetName))
+			{
+				JediFrame* asset = (JediFrame*)entry->asset;
+				setTableEntry(s_frames[pool], assetName, asset);
+				s_frameList[pool].push_back(asset);
+				s_frameNames[pool].push_back(assetName);
+				addHdWax(pool, asset, entry->hdWax);
+				return asset;
+			}
 		}
 
 		// It doesn't exist yet, try to load the frame.
+		const char* name = TFE_AssetName::getString(assetName);
 		FilePath filePath;
 		if (!TFE_Paths::getFilePath(name, &filePath))
 		{
@@ -156,22 +363,26 @@ namespace TFE_Sprite_Jedi
 			}
 		}
 		
-		s_frames[pool][name] = asset;
+		setTableEntry(s_frames[pool], assetName, asset);
 		s_frameList[pool].push_back(asset);
-		s_frameNames[pool].push_back(name);
+		s_frameNames[pool].push_back(assetName);
 
 		// HD Version
 		HdWax* hdWax = (HdWax*)malloc(sizeof(HdWax));
 		if (loadFrameHd(name, asset, pool, hdWax))
 		{
-			s_hdSpriteList[pool].push_back(hdWax);
-			s_hdSprites[pool][asset] = hdWax;
+			addHdWax(pool, asset, hdWax);
 		}
 		else
 		{
 			free(hdWax);
+			hdWax = nullptr;
 		}
 
+		if (pool == POOL_LEVEL)
+		{
+			cache_add(CACHE_FRAME, assetName, asset, hdWax, s_buffer.size() + columnSize);
+		}
 		return asset;
 	}
 
@@ -257,15 +468,16 @@ namespace TFE_Sprite_Jedi
 		SERIALIZE(SaveVersionInit, frameCount, 0);
 		SERIALIZE(SaveVersionInit, spriteCount, 0);
 
-		std::string* frameNames  = s_frameNames[POOL_LEVEL].data();
-		std::string* spriteNames = s_spriteNames[POOL_LEVEL].data();
+		const AssetName* frameNames  = s_frameNames[POOL_LEVEL].data();
+		const AssetName* spriteNames = s_spriteNames[POOL_LEVEL].data();
 		std::string name;
 		for (s32 i = 0; i < frameCount; i++)
 		{
 			u8 size;
 			if (modeWrite)
 			{
-				size = (u8)frameNames[i].length();
+				name = TFE_AssetName::getString(frameNames[i]);
+				size = (u8)name.length();
 			}
 			SERIALIZE(SaveVersionInit, size, 0);
 
@@ -273,7 +485,7 @@ namespace TFE_Sprite_Jedi
 			{
 				name.resize(size);
 			}
-			SERIALIZE_BUF(SaveVersionInit, modeWrite ? &frameNames[i][0] : &name[0], size);
+			SERIALIZE_BUF(SaveVersionInit, &name[0], size);
 
 			if (serialization_getMode() == SMODE_READ)
 			{
@@ -285,14 +497,15 @@ namespace TFE_Sprite_Jedi
 			u8 size;
 			if (modeWrite)
 			{
-				size = (u8)spriteNames[i].length();
+				name = TFE_AssetName::getString(spriteNames[i]);
+				size = (u8)name.length();
 			}
 			SERIALIZE(SaveVersionInit, size, 0);
 			if (!modeWrite)
 			{
 				name.resize(size);
 			}
-			SERIALIZE_BUF(SaveVersionInit, modeWrite ? &spriteNames[i][0] : &name[0], size);
+			SERIALIZE_BUF(SaveVersionInit, &name[0], size);
 
 			if (serialization_getMode() == SMODE_READ)
 			{
@@ -348,13 +561,34 @@ namespace TFE_Sprite_Jedi
 
 	JediWax* getWax(const char* name, AssetPool pool)
 	{
-		SpriteMap::iterator iSprite = s_sprites[pool].find(name);
-		if (iSprite != s_sprites[pool].end())
+		return getWax(TFE_AssetName::intern(name), pool);
+	}
+
+	JediWax* getWax(AssetName assetName, AssetPool pool)
+	{
+		if (assetName == ASSET_NAME_INVALID)
 		{
-			return iSprite->second;
+			return nullptr;
+		}
+		if (JediWax* wax = getTableEntry(s_sprites[pool], assetName))
+		{
+			return wax;
+		}
+		if (pool == POOL_LEVEL)
+		{
+			if (CachedSprite* entry = cache_acquire(CACHE_WAX, assetName))
+			{
+				JediWax* asset = (JediWax*)entry->asset;
+				setTableEntry(s_sprites[pool], assetName, asset);
+				s_spriteList[pool].push_back(asset);
+				s_spriteNames[pool].push_back(assetName);
+				addHdWax(pool, asset, entry->hdWax);
+				return asset;
+			}
 		}
 
 		// It doesn't exist yet, try to load the frame.
+		const char* name = TFE_AssetName::getString(assetName);
 		FilePath filePath;
 		if (!TFE_Paths::getFilePath(name, &filePath))
 		{
@@ -503,22 +737,26 @@ namespace TFE_Sprite_Jedi
 		asset->animCount = animIdx;
 		asset->pool = u32(pool);
 
-		s_sprites[pool][name] = asset;
+		setTableEntry(s_sprites[pool], assetName, asset);
 		s_spriteList[pool].push_back(asset);
-		s_spriteNames[pool].push_back(name);
+		s_spriteNames[pool].push_back(assetName);
 
 		// HD Version
 		HdWax* hdWax = (HdWax*)malloc(sizeof(HdWax));
 		if (loadWaxHd(name, asset, pool, hdWax))
 		{
-			s_hdSpriteList[pool].push_back(hdWax);
-			s_hdSprites[pool][asset] = hdWax;
+			addHdWax(pool, asset, hdWax);
 		}
 		else
 		{
 			free(hdWax);
+			hdWax = nullptr;
 		}
 
+		if (pool == POOL_LEVEL)
+		{
+			cache_add(CACHE_WAX, assetName, asset, hdWax, sizeToAlloc);
+		}
 		return asset;
 	}
 		
@@ -688,13 +926,29 @@ namespace TFE_Sprite_Jedi
 		return s_frameList[pool];
 	}
 
+	void freeHdWax(HdWax* hdWax)
+	{
+		if (!hdWax) { return; }
+		for (s32 e = 0; e < hdWax->entryCount; e++)
+		{
+			free(hdWax->cells[e].data);
+		}
+		free(hdWax->cells);
+		free(hdWax);
+	}
+
 	void freePool(AssetPool pool)
 	{
+		// Level assets are owned by the cache, so release them instead of freeing them here.
+		const bool cached = (pool == POOL_LEVEL);
+
 		const size_t frameCount = s_frameList[pool].size();
 		JediFrame** frameList = s_frameList[pool].data();
+		const AssetName* frameNames = s_frameNames[pool].data();
 		for (size_t i = 0; i < frameCount; i++)
 		{
-			free(frameList[i]);
+			if (cached) { cache_release(CACHE_FRAME, frameNames[i]); }
+			else { free(frameList[i]); }
 		}
 		s_frames[pool].clear();
 		s_frameList[pool].clear();
@@ -702,28 +956,28 @@ namespace TFE_Sprite_Jedi
 
 		const size_t waxCount = s_spriteList[pool].size();
 		JediWax** waxList = s_spriteList[pool].data();
+		const AssetName* spriteNames = s_spriteNames[pool].data();
 		for (size_t i = 0; i < waxCount; i++)
 		{
-			free(waxList[i]);
+			if (cached) { cache_release(CACHE_WAX, spriteNames[i]); }
+			else { free(waxList[i]); }
 		}
 		s_sprites[pool].clear();
 		s_spriteList[pool].clear();
 		s_spriteNames[pool].clear();
 
-		const size_t hdWaxCount = s_hdSpriteList[pool].size();
-		if (HdWax** hdWaxList = s_hdSpriteList[pool].data(); hdWaxList)
+		if (!cached)
 		{
-			for (size_t i = 0; i < waxCount; i++)
+			const size_t hdWaxCount = s_hdSpriteList[pool].size();
+			HdWax** hdWaxList = s_hdSpriteList[pool].data();
+			for (size_t i = 0; i < hdWaxCount; i++)
 			{
-				for (s32 e = 0; e < hdWaxList[i]->entryCount; e++)
-				{
-					free(hdWaxList[i]->cells[e].data);
-				}
-				free(hdWaxList[i]);
+				freeHdWax(hdWaxList[i]);
 			}
 		}
 		s_hdSpriteList[pool].clear();
 		s_hdSprites[pool].clear();
+		if (!cached) { s_freeGeneration++; }
 	}
 
 	void freeAll()
@@ -732,11 +986,19 @@ namespace TFE_Sprite_Jedi
 		{
 			freePool(AssetPool(p));
 		}
+		cache_trim(0);
 	}
 
 	void freeLevelData()
 	{
 		freePool(POOL_LEVEL);
+		cache_trim(SPRITE_CACHE_BUDGET);
+		s_cacheTick++;
+	}
+
+	u32 getFreeGeneration()
+	{
+		return s_freeGeneration;
 	}
 
 	bool getWaxIndex(JediWax* wax, s32* index, AssetPool* pool)
@@ -6,6 +6,7 @@
 //////////////////////////////////////////////////////////////////////
 #include <TFE_System/types.h>
 #include <TFE_FileSystem/stream.h>
+#include <TFE_Asset/assetName.h>
 #include <vector>
 
 // The original DOS code relied on 32-bit pointers and just swapped offsets for pointers at load time.
@@ -105,9 +106,14 @@ namespace TFE_Sprite_Jedi
 {
 	JediFrame* getFrame(const char* name, AssetPool pool = POOL_LEVEL);
 	JediWax*   getWax(const char* name, AssetPool pool = POOL_LEVEL);
+	// Lookup by interned name, callers that reference the same asset repeatedly can keep the handle.
+	JediFrame* getFrame(AssetName name, AssetPool pool = POOL_LEVEL);
+	JediWax*   getWax(AssetName name, AssetPool pool = POOL_LEVEL);
 	const HdWax* getHdWaxData(const void* srcWax);
 	void freeAll();
 	void freeLevelData();
+	// Incremented whenever sprite memory is freed, so data cached by address can be invalidated.
+	u32 getFreeGeneration();
 
 	JediFrame* loadFrameFromMemory(const u8* data, size_t size, bool transformOffsets = true);
 	JediWax* loadWaxFromMemory(const u8* data, size_t size, bool transformOffsets = true);
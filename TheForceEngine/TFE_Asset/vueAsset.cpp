@@ -110,30 +110,30 @@ namespace TFE_VueAsset
 		u32 frameCount = 0;
 		u32 transformIndex = 0;
 
+		TokenViewList tokens;
+		char transformName[256];
 		while (bufferPos < len)
 		{
 			const char* line = parser.readLine(bufferPos);
 			if (!line) { break; }
 
-			TokenList tokens;
 			parser.tokenizeLine(line, tokens);
 			if (tokens.size() < 1) { continue; }
 
-			char* endPtr = nullptr;
-			if (strcasecmp("frame", tokens[0].c_str()) == 0)
+			if (TFE_Parser::tokenEquals(tokens[0], "frame"))
 			{
 				frameIndex++;
 				s32 frameId = frameIndex;
-				if (tokens.size() > 1u)
+				if (tokens.size() > 1u && !TFE_Parser::parseS32(tokens[1], &frameId))
 				{
-					frameId = strtol(tokens[1].c_str(), &endPtr, 10);
+					frameId = 0;
 				}
 				// Are we allowed to skip frames?
 				assert(frameId == frameIndex);
 				transformIndex = 0;
 				frameCount++;
 			}
-			else if (strcasecmp("transform", tokens[0].c_str()) == 0)
+			else if (TFE_Parser::tokenEquals(tokens[0], "transform"))
 			{
 				// if no frame is specified, then assume that this is a frame.
 				if (frameIndex < 0)
@@ -142,14 +142,15 @@ namespace TFE_VueAsset
 					frameCount++;
 				}
 				assert(tokens.size() == 14u);
-				const char* transformName = tokens.size() > 1 ? tokens[1].c_str() : "";
+				transformName[0] = 0;
+				if (tokens.size() > 1) { TFE_Parser::tokenCopy(tokens[1], transformName, sizeof(transformName)); }
 				Mat3 rotScale = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
 				if (tokens.size() > 10)
 				{
 					for (u32 i = 0; i < 9; i++)
 					{
 						Vec3f& row = rotScale.m[i / 3];
-						row.m[i % 3] = (f32)strtod(tokens[2 + i].c_str(), &endPtr);
+						if (!TFE_Parser::parseF32(tokens[2 + i], &row.m[i % 3])) { row.m[i % 3] = 0.0f; }
 					}
 				}
 				Vec3f translation = { 0 };
@@ -157,7 +158,7 @@ namespace TFE_VueAsset
 				{
 					for (u32 i = 0; i < 3; i++)
 					{
-						translation.m[i] = (f32)strtod(tokens[11 + i].c_str(), &endPtr);
+						if (!TFE_Parser::parseF32(tokens[11 + i], &translation.m[i])) { translation.m[i] = 0.0f; }
 					}
 					translation.y = -translation.y;
 				}
@@ -75,6 +75,13 @@ namespace TFE_DarkForces
 		welder_clear();
 	}
 
+	void actor_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_istate);
+		SERIALIZE_INPLACE(s_physicsActors);
+		SERIALIZE_INPLACE(s_actorState);
+	}
+
 	void actor_exitState()
 	{
 		actor_clearState();
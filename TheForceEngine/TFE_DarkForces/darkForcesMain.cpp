@@ -47,6 +47,7 @@
 #include <TFE_Archive/gobMemoryArchive.h>
 #include <TFE_Jedi/Level/rfont.h>
 #include <TFE_Jedi/Level/level.h>
+#include <TFE_Jedi/Level/levelData.h>
 #include <TFE_Jedi/InfSystem/infSystem.h>
 #include <TFE_Jedi/Task/task.h>
 #include <TFE_Jedi/Renderer/jediRenderer.h>
@@ -1383,4 +1384,70 @@ namespace TFE_DarkForces
 		}
 		return true;
 	}
-}
\ No newline at end of file
+
+	// Captures the state outside of the game and level regions that points into them, the save system handles the regions.
+	// The regions are restored at the same addresses, so nothing has to be reloaded, but a state can only be restored within
+	// the level it was captured in. Projectiles, collision and logic scratch state only live within a frame and are not needed.
+	bool DarkForces::serializeStateInPlace(Stream* stream, bool writeState, RestoreRegionsFunc restoreRegions)
+	{
+		if (!stream) { return false; }
+
+		time_pause(JTRUE);
+		if (!writeState)
+		{
+			// The audio and midi threads read sound data from the game region, keep them out until the sounds are restarted.
+			TFE_MidiPlayer::pauseThread();
+			TFE_Audio::lock();
+			ImStopAllSounds();
+			if (restoreRegions && !restoreRegions(stream))
+			{
+				TFE_Audio::unlock();
+				TFE_MidiPlayer::resumeThread();
+				time_pause(JFALSE);
+				TFE_System::logWrite(LOG_ERROR, "DarkForces", "Failed to restore the memory regions for a save state.");
+				return false;
+			}
+		}
+
+		serialization_setMode(writeState ? SMODE_WRITE : SMODE_READ);
+		serializeVersion(stream);
+
+		SERIALIZE_INPLACE(s_runGameState);
+		SERIALIZE_INPLACE(s_levelComplete);
+		time_serialize(stream);
+		random_serialize(stream);
+		automap_serialize(stream);
+		mission_serialize(stream);
+		task_serializeInPlace(stream);
+		level_serializeInPlace(stream);
+		inf_serializeInPlace(stream);
+		player_serializeInPlace(stream);
+		weapon_serializeInPlace(stream);
+		pickup_serializeInPlace(stream);
+		hitEffect_serializeInPlace(stream);
+		actor_serializeInPlace(stream);
+		sound_serializeInPlace(stream);
+		gameMusic_serializeInPlace(stream);
+		renderer_serializeInPlace(stream);
+		ImSerializeSounds(stream);
+
+		if (!writeState)
+		{
+			TFE_Audio::unlock();
+			TFE_MidiPlayer::resumeThread();
+
+			// Sector data may have changed since the renderers cached it.
+			for (u32 s = 0; s < s_levelState.sectorCount; s++)
+			{
+				s_levelState.sectors[s].dirtyFlags = SDF_ALL;
+			}
+		}
+
+		time_pause(JFALSE);
+		if (!writeState)
+		{
+			task_updateTime();
+		}
+		return true;
+	}
+}
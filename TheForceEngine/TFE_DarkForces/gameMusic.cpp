@@ -6,6 +6,7 @@
 #include <TFE_Game/igame.h>
 #include <TFE_System/system.h>
 #include <TFE_FileSystem/filestream.h>
+#include <TFE_Jedi/Serialization/serialization.h>
 #include <TFE_System/parser.h>
 #include <cstring>
 
@@ -259,6 +260,21 @@ namespace TFE_DarkForces
 		ImResume();
 	}
 
+	void gameMusic_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_currentState);
+		SERIALIZE_INPLACE(s_oldState);
+		SERIALIZE_INPLACE(s_stateEntrances);
+		SERIALIZE_INPLACE(s_currentLevel);
+		SERIALIZE_INPLACE(s_oldSong);
+		SERIALIZE_INPLACE(s_newSong);
+		SERIALIZE_INPLACE(s_transChunk);
+		SERIALIZE_INPLACE(s_savedMeasure);
+		SERIALIZE_INPLACE(s_savedBeat);
+		SERIALIZE_INPLACE(s_musicTask);
+		SERIALIZE_INPLACE(s_desiredFightState);
+	}
+
 	MusicState gameMusic_getState()
 	{
 		return s_currentState;
@@ -6,6 +6,8 @@
 #include <TFE_System/types.h>
 #include <TFE_FileSystem/paths.h>
 
+class Stream;
+
 enum MusicState
 {
 	MUS_STATE_NULLSTATE = 0,
@@ -27,4 +29,6 @@ namespace TFE_DarkForces
 	void gameMusic_sustainFight();
 
 	MusicState gameMusic_getState();
+	// Copy the music state for in-place save states, the songs themselves are restored by iMuse.
+	void gameMusic_serializeInPlace(Stream* stream);
 }  // TFE_DarkForces
\ No newline at end of file
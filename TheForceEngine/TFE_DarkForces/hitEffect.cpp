@@ -264,6 +264,14 @@ namespace TFE_DarkForces
 		s_hitEffectTask = createSubTask("hitEffects", hitEffectTaskFunc);
 	}
 
+	void hitEffect_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_hitEffects);
+		SERIALIZE_INPLACE(s_hitEffectTask);
+		SERIALIZE_INPLACE(s_explodePos);
+		SERIALIZE_INPLACE(s_curEffectData);
+	}
+
 	void hitEffect_serializeTasks(Stream* stream)
 	{
 		u8 hasTask = 0;
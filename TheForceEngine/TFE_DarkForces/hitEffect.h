@@ -56,6 +56,7 @@ namespace TFE_DarkForces
 
 	// Serialization
 	void hitEffect_serializeTasks(Stream* stream);
+	void hitEffect_serializeInPlace(Stream* stream);
 
 	// Spawn a new hit effect at location (x,y,z) in 'sector'.
 	// The ExcludeObj field is used to avoid effecting a specific object during wakeup or explosions.
@@ -105,84 +105,74 @@ namespace TFE_DarkForces
 		return retValue;
 	}
 
-	JBool object_parseSeq(SecObject* obj, TFE_Parser* parser, size_t* bufferPos)
-	{
-		LogicSetupFunc setupFunc = nullptr;
+	// TFE: The sequence lines are read by the level loader from the compiled object data, so the logic being set up
+	// is kept here between lines.
+	static LogicSetupFunc s_seqSetupFunc = nullptr;
+	static Logic* s_seqLogic = nullptr;
 
-		const char* line = parser->readLine(*bufferPos);
-		if (!line || !strstr(line, "SEQ"))
-		{
-			return JFALSE;
-		}
+	void object_beginSeq()
+	{
+		s_seqSetupFunc = nullptr;
+		s_seqLogic = nullptr;
+	}
 
-		Logic* newLogic = nullptr;
-		while (1)
+	JBool object_parseSeqLine(SecObject* obj)
+	{
+		KEYWORD key = getKeywordIndex(s_objSeqArg0);
+		if (key == KW_TYPE || key == KW_LOGIC)
 		{
-			line = parser->readLine(*bufferPos);
-			if (!line) { return JFALSE; }
-
-			s_objSeqArgCount = sscanf(line, " %s %s %s %s %s %s", s_objSeqArg0, s_objSeqArg1, s_objSeqArg2, s_objSeqArg3, s_objSeqArg4, s_objSeqArg5);
-			KEYWORD key = getKeywordIndex(s_objSeqArg0);
-			if (key == KW_TYPE || key == KW_LOGIC)
+			KEYWORD logicId = getKeywordIndex(s_objSeqArg1);
+			if (logicId == KW_PLAYER)  // Player Logic.
 			{
-				KEYWORD logicId = getKeywordIndex(s_objSeqArg1);
-				if (logicId == KW_PLAYER)  // Player Logic.
-				{
-					player_setupObject(obj);
-					setupFunc = nullptr;
-				}
-				else if (logicId == KW_ANIM)	// Animated Sprites Logic.
-				{
-					newLogic = obj_setSpriteAnim(obj);
-					setupFunc = nullptr;
-				}
-				else if (logicId == KW_UPDATE)	// "Update" logic is usually used for rotating 3D objects, like the Death Star.
-				{
-					newLogic = obj_setUpdate(obj, &setupFunc);
-				}
-				else if (logicId >= KW_TROOP && logicId <= KW_SCENERY)	// Enemies, explosives barrels, land mines, and scenery.
-				{
-					newLogic = obj_setEnemyLogic(obj, logicId);
-				}
-				else if (logicId == KW_KEY)         // Vue animation logic.
-				{
-					newLogic = obj_createVueLogic(obj, &setupFunc);
-				}
-				else if (logicId == KW_GENERATOR)	// Enemy generator, used for in-level enemy spawning.
-				{
-					KEYWORD genType = getKeywordIndex(s_objSeqArg2);
-					newLogic = obj_createGenerator(obj, &setupFunc, genType);
-				}
-				else if (logicId == KW_DISPATCH)
-				{
-					newLogic = (Logic*)actor_createDispatch(obj, &setupFunc);
-				}
-				else if ((logicId >= KW_BATTERY && logicId <= KW_AUTOGUN) || logicId == KW_ITEM)
-				{
-					if (logicId >= KW_BATTERY && logicId <= KW_AUTOGUN)
-					{
-						strcpy(s_objSeqArg2, s_objSeqArg1);
-					}
-					ItemId itemId = getPickupItemId(s_objSeqArg2);
-					obj_createPickup(obj, itemId);
-					setupFunc = nullptr;
-				}
+				player_setupObject(obj);
+				s_seqSetupFunc = nullptr;
 			}
-			else if (key == KW_SEQEND)
+			else if (logicId == KW_ANIM)	// Animated Sprites Logic.
 			{
-				return JTRUE;
+				s_seqLogic = obj_setSpriteAnim(obj);
+				s_seqSetupFunc = nullptr;
 			}
-			else
+			else if (logicId == KW_UPDATE)	// "Update" logic is usually used for rotating 3D objects, like the Death Star.
+			{
+				s_seqLogic = obj_setUpdate(obj, &s_seqSetupFunc);
+			}
+			else if (logicId >= KW_TROOP && logicId <= KW_SCENERY)	// Enemies, explosives barrels, land mines, and scenery.
+			{
+				s_seqLogic = obj_setEnemyLogic(obj, logicId);
+			}
+			else if (logicId == KW_KEY)         // Vue animation logic.
+			{
+				s_seqLogic = obj_createVueLogic(obj, &s_seqSetupFunc);
+			}
+			else if (logicId == KW_GENERATOR)	// Enemy generator, used for in-level enemy spawning.
 			{
-				if (setupFunc && setupFunc(newLogic, key))
+				KEYWORD genType = getKeywordIndex(s_objSeqArg2);
+				s_seqLogic = obj_createGenerator(obj, &s_seqSetupFunc, genType);
+			}
+			else if (logicId == KW_DISPATCH)
+			{
+				s_seqLogic = (Logic*)actor_createDispatch(obj, &s_seqSetupFunc);
+			}
+			else if ((logicId >= KW_BATTERY && logicId <= KW_AUTOGUN) || logicId == KW_ITEM)
+			{
+				if (logicId >= KW_BATTERY && logicId <= KW_AUTOGUN)
 				{
-					continue;
+					strcpy(s_objSeqArg2, s_objSeqArg1);
 				}
-				logic_defaultSetupFunc(obj, key);
+				ItemId itemId = getPickupItemId(s_objSeqArg2);
+				obj_createPickup(obj, itemId);
+				s_seqSetupFunc = nullptr;
 			}
 		}
-
-		return JTRUE;
+		else if (key == KW_SEQEND)
+		{
+			return JTRUE;
+		}
+		else if (!s_seqSetupFunc || !s_seqSetupFunc(s_seqLogic, key))
+		{
+			logic_defaultSetupFunc(obj, key);
+		}
+		return JFALSE;
 	}
 
 	Logic* obj_setEnemyLogic(SecObject* obj, KEYWORD logicId)
@@ -53,7 +53,10 @@ namespace TFE_DarkForces
 {		
 	void obj_addLogic(SecObject* obj, Logic* logic, LogicType type, Task* task, LogicCleanupFunc cleanupFunc);
 	void deleteLogicAndObject(Logic* logic);
-	JBool object_parseSeq(SecObject* obj, TFE_Parser* parser, size_t* bufferPos);
+	// Set up the object logic from its sequence in the level object file, one line at a time with the arguments in
+	// s_objSeqArg0-5. Returns JTRUE at the end of the sequence.
+	void  object_beginSeq();
+	JBool object_parseSeqLine(SecObject* obj);
 	Logic* obj_setEnemyLogic(SecObject* obj, KEYWORD logicId);
 	SecObject* logic_spawnEnemy(const char* waxName, const char* typeName);
 
@@ -263,6 +263,7 @@ namespace TFE_DarkForces
 		TFE_Jedi::renderer_setType(RendererType(graphics->rendererIndex));
 		TFE_Jedi::render_setResolution();
 		TFE_Jedi::renderer_setLimits();
+		TFE_Jedi::renderer_resetLimits();
 
 		// Clear the palette for now.
 		blankScreen();
@@ -953,6 +953,18 @@ namespace TFE_DarkForces
 		}
 	}
 
+	void pickup_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_playerDying);
+		SERIALIZE_INPLACE(s_pickupTask);
+		SERIALIZE_INPLACE(s_superchargeTask);
+		SERIALIZE_INPLACE(s_invincibilityTask);
+		SERIALIZE_INPLACE(s_gasmaskTask);
+		SERIALIZE_INPLACE(s_gasSectorTask);
+		SERIALIZE_INPLACE(s_listToFree);
+		SERIALIZE_INPLACE(s_listToFreeCnt);
+	}
+
 	void pickupLogic_serializeTasks(Stream* stream)
 	{
 		enum PickupTasks
@@ -2807,6 +2807,113 @@ namespace TFE_DarkForces
 	}
 		
 	// Serialization
+	void player_serializeInPlace(Stream* stream)
+	{
+		// Controller
+		SERIALIZE_INPLACE(s_playerLogic);
+		SERIALIZE_INPLACE(s_externalYawSpd);
+		SERIALIZE_INPLACE(s_playerPitch);
+		SERIALIZE_INPLACE(s_playerRoll);
+		SERIALIZE_INPLACE(s_forwardSpd);
+		SERIALIZE_INPLACE(s_strafeSpd);
+		SERIALIZE_INPLACE(s_maxMoveDist);
+		SERIALIZE_INPLACE(s_playerStopAccel);
+		SERIALIZE_INPLACE(s_minEyeDistFromFloor);
+		SERIALIZE_INPLACE(s_postLandVel);
+		SERIALIZE_INPLACE(s_landUpVel);
+		SERIALIZE_INPLACE(s_playerVelX);
+		SERIALIZE_INPLACE(s_playerUpVel);
+		SERIALIZE_INPLACE(s_playerUpVel2);
+		SERIALIZE_INPLACE(s_playerVelZ);
+		SERIALIZE_INPLACE(s_externalVelX);
+		SERIALIZE_INPLACE(s_externalVelZ);
+		SERIALIZE_INPLACE(s_playerCrouchSpd);
+		SERIALIZE_INPLACE(s_playerSpeedAve);
+		SERIALIZE_INPLACE(s_prevDistFromFloor);
+		SERIALIZE_INPLACE(s_wpnSin);
+		SERIALIZE_INPLACE(s_wpnCos);
+		SERIALIZE_INPLACE(s_moveDirX);
+		SERIALIZE_INPLACE(s_moveDirZ);
+		SERIALIZE_INPLACE(s_dist);
+		SERIALIZE_INPLACE(s_distScale);
+		SERIALIZE_INPLACE(s_levelAtten);
+		SERIALIZE_INPLACE(s_prevCollisionFrameWall);
+		SERIALIZE_INPLACE(s_curSafe);
+		// Actions
+		SERIALIZE_INPLACE(s_playerUse);
+		SERIALIZE_INPLACE(s_playerActionUse);
+		SERIALIZE_INPLACE(s_playerPrimaryFire);
+		SERIALIZE_INPLACE(s_playerSecFire);
+		SERIALIZE_INPLACE(s_playerJumping);
+		SERIALIZE_INPLACE(s_playerInWater);
+		SERIALIZE_INPLACE(s_aiActive);
+		SERIALIZE_INPLACE(s_crushSoundId);
+		SERIALIZE_INPLACE(s_kyleScreamSoundId);
+		// Position and orientation
+		SERIALIZE_INPLACE(s_playerPos);
+		SERIALIZE_INPLACE(s_playerObjHeight);
+		SERIALIZE_INPLACE(s_playerObjPitch);
+		SERIALIZE_INPLACE(s_playerObjYaw);
+		SERIALIZE_INPLACE(s_playerObjSector);
+		SERIALIZE_INPLACE(s_playerSlideWall);
+		// Shared state
+		SERIALIZE_INPLACE(s_playerInfo);
+		SERIALIZE_INPLACE(s_batteryPower);
+		SERIALIZE_INPLACE(s_lifeCount);
+		SERIALIZE_INPLACE(s_playerLight);
+		SERIALIZE_INPLACE(s_headwaveVerticalOffset);
+		SERIALIZE_INPLACE(s_onFloor);
+		SERIALIZE_INPLACE(s_weaponLight);
+		SERIALIZE_INPLACE(s_baseAtten);
+		SERIALIZE_INPLACE(s_gravityAccel);
+		SERIALIZE_INPLACE(s_invincibility);
+		SERIALIZE_INPLACE(s_weaponFiring);
+		SERIALIZE_INPLACE(s_weaponFiringSec);
+		SERIALIZE_INPLACE(s_wearingCleats);
+		SERIALIZE_INPLACE(s_wearingGasmask);
+		SERIALIZE_INPLACE(s_nightvisionActive);
+		SERIALIZE_INPLACE(s_headlampActive);
+		SERIALIZE_INPLACE(s_superCharge);
+		SERIALIZE_INPLACE(s_superChargeHud);
+		SERIALIZE_INPLACE(s_playerSecMoved);
+		SERIALIZE_INPLACE(s_limitStepHeight);
+		SERIALIZE_INPLACE(s_smallModeEnabled);
+		SERIALIZE_INPLACE(s_flyMode);
+		SERIALIZE_INPLACE(s_noclip);
+		SERIALIZE_INPLACE(s_oneHitKillEnabled);
+		SERIALIZE_INPLACE(s_instaDeathEnabled);
+		SERIALIZE_INPLACE(s_playerInvSaved);
+		// Player object and camera
+		SERIALIZE_INPLACE(s_playerSector);
+		SERIALIZE_INPLACE(s_playerObject);
+		SERIALIZE_INPLACE(s_playerEye);
+		SERIALIZE_INPLACE(s_eyePos);
+		SERIALIZE_INPLACE(s_pitch);
+		SERIALIZE_INPLACE(s_yaw);
+		SERIALIZE_INPLACE(s_roll);
+		SERIALIZE_INPLACE(s_playerEyeFlags);
+		SERIALIZE_INPLACE(s_playerTick);
+		SERIALIZE_INPLACE(s_prevPlayerTick);
+		SERIALIZE_INPLACE(s_nextShieldDmgTick);
+		SERIALIZE_INPLACE(s_reviveTick);
+		SERIALIZE_INPLACE(s_nextPainSndTick);
+		SERIALIZE_INPLACE(s_playerTask);
+		SERIALIZE_INPLACE(s_playerYPos);
+		SERIALIZE_INPLACE(s_camOffset);
+		SERIALIZE_INPLACE(s_camOffsetPitch);
+		SERIALIZE_INPLACE(s_camOffsetYaw);
+		SERIALIZE_INPLACE(s_camOffsetRoll);
+		SERIALIZE_INPLACE(s_playerYaw);
+		SERIALIZE_INPLACE(s_itemUnknown1);
+		SERIALIZE_INPLACE(s_itemUnknown2);
+		SERIALIZE_INPLACE(s_playerHeight);
+		SERIALIZE_INPLACE(s_playerRun);
+		SERIALIZE_INPLACE(s_jumpScale);
+		SERIALIZE_INPLACE(s_playerSlow);
+		SERIALIZE_INPLACE(s_onMovingSurface);
+		SERIALIZE_INPLACE(s_playerCrouch);
+	}
+
 	void playerLogic_serialize(Logic*& logic, SecObject* obj, Stream* stream)
 	{
 		PlayerLogic* playerLogic;
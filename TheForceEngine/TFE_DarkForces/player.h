@@ -180,4 +180,5 @@ namespace TFE_DarkForces
 
 	// Serialization
 	void playerLogic_serialize(Logic*& logic, SecObject* obj, Stream* stream);
+	void player_serializeInPlace(Stream* stream);
 }  // namespace TFE_DarkForces
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <TFE_Settings/settings.h>
 #include <TFE_Game/igame.h>
 #include <TFE_Asset/vocAsset.h>
+#include <TFE_Asset/assetName.h>
 #include <TFE_Audio/audioSystem.h>
 #include <TFE_Audio/midiPlayer.h>
 #include <TFE_Jedi/Math/core_math.h>
@@ -15,6 +16,9 @@
 #include <TFE_Jedi/Serialization/serialization.h>
 #include <TFE_DarkForces/time.h>
 #include <TFE_System/system.h>
+#include <TFE_FileSystem/paths.h>
+#include <unordered_map>
+#include <vector>
 
 namespace TFE_DarkForces
 {
@@ -39,7 +43,19 @@ namespace TFE_DarkForces
 		s32 soundLevelStart = -1;
 	};
 
+	// TFE: Sound data that is no longer referenced is kept, up to a budget, so sounds shared between levels are only read once.
+	struct CachedSound
+	{
+		u8* data;
+		u32 size;
+		u32 searchHash;	// Search path hash when loaded.
+		u32 lastUsed;	// Cache tick when released.
+	};
+	typedef std::unordered_map<AssetName, GameSound*> SoundRegistry;
+	typedef std::unordered_map<AssetName, CachedSound> SoundCache;
+
 	#define MAX_LEVEL_SOUNDS 300
+	#define SOUND_CACHE_BUDGET (16 * 1024 * 1024)
 	#define CUE_RING1 FIXED(30)
 	#define CUE_RING2 FIXED(150)
 
@@ -52,6 +68,10 @@ namespace TFE_DarkForces
 	static const s32 s_tPan[32] = { 00,-06,-12,-18,-24,-30,-36,-42,-48,-42,-36,-30,-24,-18,-12,-06,00,06,12,18,24,30,36,42,48,42,36,30,24,18,12,06 };
 	
 	static SoundState s_state = {};
+	static SoundRegistry s_soundRegistry;	// Loaded sounds by name.
+	static SoundCache s_soundCache;
+	static size_t s_soundCacheSize = 0;
+	static u32 s_soundCacheTick = 0;
 	s32 s_lastMaintainVolume;
 
 	SoundEffectId soundInstance(SoundSourceId soundId, s32 instance);
@@ -60,6 +80,7 @@ namespace TFE_DarkForces
 	u8* sound_getResource(SoundEffectId id);
 	void sound_alwaysFree(GameSound* sound);
 	void sound_clearLevelSounds();
+	void soundCache_trim(size_t budget);
 
 	// Called at game startup and shutdown.
 	void sound_open(MemoryRegion* memRegion)
@@ -78,6 +99,8 @@ namespace TFE_DarkForces
 	void sound_close()
 	{
 		sound_levelStop();
+		soundCache_trim(0);
+		s_soundRegistry.clear();
 		allocator_free(s_state.gameSoundList);
 		ImTerminate();
 		s_state = {};
@@ -95,6 +118,8 @@ namespace TFE_DarkForces
 
 		// Unload any existing level sounds.
 		sound_clearLevelSounds();
+		soundCache_trim(SOUND_CACHE_BUDGET);
+		s_soundCacheTick++;
 	}
 
 	void sound_levelStop()
@@ -126,6 +151,73 @@ namespace TFE_DarkForces
 		s_state.soundLevelStart = allocator_getCount(s_state.gameSoundList);
 	}
 
+	void sound_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_state);
+		SERIALIZE_INPLACE(s_soundCacheSize);
+		SERIALIZE_INPLACE(s_soundCacheTick);
+		SERIALIZE_INPLACE(s_lastMaintainVolume);
+
+		// The maps live on the heap, so they are copied out as arrays. The sounds and cached data they point to are in the game region.
+		std::vector<AssetName> names;
+		std::vector<GameSound*> sounds;
+		u32 count = 0;
+		if (serialization_getMode() == SMODE_WRITE)
+		{
+			for (SoundRegistry::iterator iSound = s_soundRegistry.begin(); iSound != s_soundRegistry.end(); ++iSound)
+			{
+				names.push_back(iSound->first);
+				sounds.push_back(iSound->second);
+			}
+			count = u32(names.size());
+		}
+		SERIALIZE(SaveVersionInit, count, 0);
+		names.resize(count);
+		sounds.resize(count);
+		if (count)
+		{
+			SERIALIZE_BUF(SaveVersionInit, names.data(), count * sizeof(AssetName));
+			SERIALIZE_BUF(SaveVersionInit, sounds.data(), count * sizeof(GameSound*));
+		}
+		if (serialization_getMode() == SMODE_READ)
+		{
+			s_soundRegistry.clear();
+			for (u32 i = 0; i < count; i++)
+			{
+				s_soundRegistry[names[i]] = sounds[i];
+			}
+		}
+
+		std::vector<CachedSound> cached;
+		names.clear();
+		count = 0;
+		if (serialization_getMode() == SMODE_WRITE)
+		{
+			for (SoundCache::iterator iEntry = s_soundCache.begin(); iEntry != s_soundCache.end(); ++iEntry)
+			{
+				names.push_back(iEntry->first);
+				cached.push_back(iEntry->second);
+			}
+			count = u32(names.size());
+		}
+		SERIALIZE(SaveVersionInit, count, 0);
+		names.resize(count);
+		cached.resize(count);
+		if (count)
+		{
+			SERIALIZE_BUF(SaveVersionInit, names.data(), count * sizeof(AssetName));
+			SERIALIZE_BUF(SaveVersionInit, cached.data(), count * sizeof(CachedSound));
+		}
+		if (serialization_getMode() == SMODE_READ)
+		{
+			s_soundCache.clear();
+			for (u32 i = 0; i < count; i++)
+			{
+				s_soundCache[names[i]] = cached[i];
+			}
+		}
+	}
+
 	void sound_serializeLevelSounds(Stream* stream)
 	{
 		s32 count;
@@ -178,34 +270,136 @@ namespace TFE_DarkForces
 		}
 	}
 
-	SoundSourceId sound_load(const char* fileName, u32 priority)
+	////////////////////////////////////////////////////////////////////
+	// Sound data cache
+	////////////////////////////////////////////////////////////////////
+	void soundCache_evict(SoundCache::iterator iEntry)
 	{
-		SoundSourceId newId = NULL_SOUND;
-		GameSound* sound = (GameSound*)allocator_getHead(s_state.gameSoundList);
-		while (sound)
+		s_soundCacheSize -= iEntry->second.size;
+		game_free(iEntry->second.data);
+		s_soundCache.erase(iEntry);
+	}
+
+	// Takes the data for 'name' out of the cache, returns null if it is not cached or stale.
+	u8* soundCache_take(AssetName name, u32* size)
+	{
+		SoundCache::iterator iEntry = s_soundCache.find(name);
+		if (iEntry == s_soundCache.end()) { return nullptr; }
+		if (iEntry->second.searchHash != TFE_Paths::getSearchPathHash())
+		{
+			soundCache_evict(iEntry);
+			return nullptr;
+		}
+
+		u8* data = iEntry->second.data;
+		*size = iEntry->second.size;
+		s_soundCacheSize -= iEntry->second.size;
+		s_soundCache.erase(iEntry);
+		return data;
+	}
+
+	// Takes ownership of the sound data.
+	void soundCache_add(const GameSound* sound)
+	{
+		const AssetName name = TFE_AssetName::intern(sound->name);
+		SoundCache::iterator iEntry = s_soundCache.find(name);
+		if (iEntry != s_soundCache.end())
+		{
+			soundCache_evict(iEntry);
+		}
+
+		CachedSound entry;
+		entry.data = sound->data;
+		entry.size = sound->size;
+		entry.searchHash = TFE_Paths::getSearchPathHash();
+		entry.lastUsed = s_soundCacheTick;
+		s_soundCache[name] = entry;
+		s_soundCacheSize += sound->size;
+	}
+
+	// Evicts stale data and then the least recently used data until the cache fits in the budget.
+	void soundCache_trim(size_t budget)
+	{
+		const u32 searchHash = TFE_Paths::getSearchPathHash();
+		SoundCache::iterator iEntry = s_soundCache.begin();
+		while (iEntry != s_soundCache.end())
 		{
-			if (!strcasecmp(fileName, sound->name))
+			SoundCache::iterator iCur = iEntry++;
+			if (iCur->second.searchHash != searchHash || budget == 0)
 			{
-				sound->refCount++;
-				return soundInstance((SoundSourceId)sound, 0);
+				soundCache_evict(iCur);
 			}
-			sound = (GameSound*)allocator_getNext(s_state.gameSoundList);
+		}
+
+		while (s_soundCacheSize > budget)
+		{
+			SoundCache::iterator iOldest = s_soundCache.begin();
+			for (iEntry = s_soundCache.begin(); iEntry != s_soundCache.end(); ++iEntry)
+			{
+				if (iEntry->second.lastUsed < iOldest->second.lastUsed)
+				{
+					iOldest = iEntry;
+				}
+			}
+			soundCache_evict(iOldest);
+		}
+	}
+
+	// Release the sound data to the cache and remove the sound from the registry.
+	void sound_release(GameSound* sound)
+	{
+		SoundRegistry::iterator iSound = s_soundRegistry.find(TFE_AssetName::intern(sound->name));
+		if (iSound != s_soundRegistry.end() && iSound->second == sound)
+		{
+			s_soundRegistry.erase(iSound);
+		}
+
+		if (sound->data)
+		{
+			soundCache_add(sound);
+		}
+		sound->data = nullptr;
+		allocator_deleteItem(s_state.gameSoundList, sound);
+	}
+
+	SoundSourceId sound_load(const char* fileName, u32 priority)
+	{
+		SoundSourceId newId = NULL_SOUND;
+		// Sounds are keyed by the stored name, which is limited to 12 characters.
+		char soundName[13];
+		strncpy(soundName, fileName, 12);
+		soundName[12] = 0;
+
+		const AssetName name = TFE_AssetName::intern(soundName);
+		SoundRegistry::iterator iSound = s_soundRegistry.find(name);
+		if (iSound != s_soundRegistry.end())
+		{
+			GameSound* sound = iSound->second;
+			sound->refCount++;
+			return soundInstance((SoundSourceId)sound, 0);
 		}
 
 		u32 size = 0;
-		u8* data = readVocFileData(fileName, &size);
+		u8* data = soundCache_take(name, &size);
+		if (!data)
+		{
+			data = readVocFileData(fileName, &size);
+		}
+
+		GameSound* sound;
 		if (data)
 		{
 			sound = (GameSound*)allocator_newItem(s_state.gameSoundList);
 			sound->id = (SoundSourceId)sound;
 			sound->time = s_curTick;
 			sound->data = data;
-			strncpy(sound->name, fileName, 13);
+			strncpy(sound->name, soundName, 13);
 			sound->priority = priority;
 			sound->size = size;
 			sound->volume = 127;
 			sound->refCount = 1;
 			newId = soundInstance(sound->id, 0);
+			s_soundRegistry[name] = sound;
 		}
 
 		return newId;
@@ -220,12 +414,7 @@ namespace TFE_DarkForces
 
 			if (sound->refCount == 0)
 			{
-				if (sound->data)
-				{
-					game_free(sound->data);
-				}
-				sound->data = nullptr;
-				allocator_deleteItem(s_state.gameSoundList, sound);
+				sound_release(sound);
 			}
 		}
 	}
@@ -234,12 +423,7 @@ namespace TFE_DarkForces
 	{
 		if (sound)
 		{
-			if (sound->data)
-			{
-				game_free(sound->data);
-			}
-			sound->data = nullptr;
-			allocator_deleteItem(s_state.gameSoundList, sound);
+			sound_release(sound);
 		}
 	}
 
@@ -62,6 +62,7 @@ namespace TFE_DarkForces
 
 	// Serialization
 	void sound_serializeLevelSounds(Stream* stream);
+	void sound_serializeInPlace(Stream* stream);
 
 	// Load a sound source from disk.
 	SoundSourceId sound_load(const char* sound, u32 priority = SOUND_PRIORITY_MED0);
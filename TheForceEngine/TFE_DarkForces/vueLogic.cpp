@@ -75,6 +75,7 @@ namespace TFE_DarkForces
 
 	static char* s_workBuffer = nullptr;
 	static size_t s_workBufferSize = 0;
+	static TokenViewList s_tokens;
 
 	JBool vueLogicSetupFunc(Logic* logic, KEYWORD key);
 	void vueLogicTaskFunc(MessageType msg);
@@ -206,8 +207,20 @@ namespace TFE_DarkForces
 		task_serializeState(stream, vueLogic->logic.task, vueLogic, vueLogic_serializeTaskLocalMemory);
 	}
 
+	// Parse 'count' floats from the tokens starting at 'first', returns false if there are too few tokens or they are not numbers.
+	bool parseVueFloats(const TokenViewList& tokens, size_t first, s32 count, f32* values)
+	{
+		if (tokens.size() < first + count) { return false; }
+		for (s32 i = 0; i < count; i++)
+		{
+			if (!TFE_Parser::parseF32(tokens[first + i], &values[i])) { return false; }
+		}
+		return true;
+	}
+
 	void loadVueFile(Allocator* vueList, char* transformName, TFE_Parser* parser)
 	{
+		// VUE files can have thousands of lines and are parsed once per VUE logic, so use token views instead of sscanf.
 		size_t bufferPos = 0;
 		if (!strcasecmp(transformName, "camera"))
 		{
@@ -216,11 +229,14 @@ namespace TFE_DarkForces
 				const char* line = parser->readLine(bufferPos);
 				if (!line) { break; }
 
-				f32 x1, z1, y1, x2, z2, y2, r, lens;
-				if (sscanf(line, "camera %f %f %f %f %f %f %f %f", &x1, &z1, &y1, &x2, &z2, &y2, &r, &lens) == 8)
+				parser->tokenizeLine(line, s_tokens);
+				f32 values[8];
+				if (!s_tokens.empty() && TFE_Parser::tokenEquals(s_tokens[0], "camera") && parseVueFloats(s_tokens, 1, 8, values))
 				{
-					y1 = -y1;
-					y2 = -y2;
+					const f32 x1 = values[0], z1 = values[1], y1 = -values[2];
+					const f32 x2 = values[3], z2 = values[4];
+					const f32 r = values[6];
+
 					VueFrame* frame = (VueFrame*)allocator_newItem(vueList);
 					frame->offset.x = floatToFixed16(x1);
 					frame->offset.y = floatToFixed16(y1);
@@ -272,11 +288,13 @@ namespace TFE_DarkForces
 					break;
 				}
 
+				parser->tokenizeLine(line, s_tokens);
 				char name[32];
-				f32 f00, f01, f02, f03, f04, f05, f06, f07, f08, f09, f10, f11;
-				s32 count = sscanf(line, "transform %s %f %f %f %f %f %f %f %f %f %f %f %f", name, &f00, &f01, &f02, &f03, &f04, &f05, &f06, &f07, &f08, &f09, &f10, &f11);
-				if (count == 13)
+				f32 values[12];
+				if (s_tokens.size() >= 2 && TFE_Parser::tokenEquals(s_tokens[0], "transform") && parseVueFloats(s_tokens, 2, 12, values))
 				{
+					TFE_Parser::tokenCopy(s_tokens[1], name, sizeof(name));
+
 					// Is this the correct transform?
 					if (transformName[0] == '*' || strcasecmp(name, transformName) == 0)
 					{
@@ -284,24 +302,24 @@ namespace TFE_DarkForces
 
 						// Rotation/Scale matrix.
 						fixed16_16 frameMtx[9];
-						frameMtx[0] = floatToFixed16(f00);
-						frameMtx[1] = floatToFixed16(f01);
-						frameMtx[2] = floatToFixed16(f02);
-						frameMtx[3] = floatToFixed16(f03);
-						frameMtx[4] = floatToFixed16(f04);
-						frameMtx[5] = floatToFixed16(f05);
-						frameMtx[6] = floatToFixed16(f06);
-						frameMtx[7] = floatToFixed16(f07);
-						frameMtx[8] = floatToFixed16(f08);
+						frameMtx[0] = floatToFixed16(values[0]);
+						frameMtx[1] = floatToFixed16(values[1]);
+						frameMtx[2] = floatToFixed16(values[2]);
+						frameMtx[3] = floatToFixed16(values[3]);
+						frameMtx[4] = floatToFixed16(values[4]);
+						frameMtx[5] = floatToFixed16(values[5]);
+						frameMtx[6] = floatToFixed16(values[6]);
+						frameMtx[7] = floatToFixed16(values[7]);
+						frameMtx[8] = floatToFixed16(values[8]);
 
 						// Transform to DF coordinate system.
 						fixed16_16 tempMtx[9];
 						mulMatrix3x3(mtx1, frameMtx, tempMtx);
 						mulMatrix3x3(tempMtx, mtx0, frame->mtx);
 
-						frame->offset.x =  floatToFixed16(f09);
-						frame->offset.y = -floatToFixed16(f11);
-						frame->offset.z =  floatToFixed16(f10);
+						frame->offset.x =  floatToFixed16(values[9]);
+						frame->offset.y = -floatToFixed16(values[11]);
+						frame->offset.z =  floatToFixed16(values[10]);
 
 						frame->yaw = 8191;
 						frame->flags = 0;
@@ -171,6 +171,31 @@ namespace TFE_DarkForces
 		}
 	}
 
+	void weapon_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_switchWeapons);
+		SERIALIZE_INPLACE(s_queWeaponSwitch);
+		SERIALIZE_INPLACE(s_playerWeaponList);
+		SERIALIZE_INPLACE(s_weaponDelayPrimary);
+		SERIALIZE_INPLACE(s_weaponDelaySeconary);
+		SERIALIZE_INPLACE(s_canFirePrimPtr);
+		SERIALIZE_INPLACE(s_canFireSecPtr);
+		SERIALIZE_INPLACE(s_weaponAnimState);
+		SERIALIZE_INPLACE(s_prevWeapon);
+		SERIALIZE_INPLACE(s_curWeapon);
+		SERIALIZE_INPLACE(s_nextWeapon);
+		SERIALIZE_INPLACE(s_lastWeapon);
+		SERIALIZE_INPLACE(s_weaponAutoMount2);
+		SERIALIZE_INPLACE(s_secondaryFire);
+		SERIALIZE_INPLACE(s_weaponOffAnim);
+		SERIALIZE_INPLACE(s_isShooting);
+		SERIALIZE_INPLACE(s_canFireWeaponSec);
+		SERIALIZE_INPLACE(s_canFireWeaponPrim);
+		SERIALIZE_INPLACE(s_fireFrame);
+		SERIALIZE_INPLACE(s_repeaterFireSndID);
+		SERIALIZE_INPLACE(s_curPlayerWeapon);
+	}
+
 	void weapon_startup()
 	{
 		// TODO: Move this into data instead of hard coding it like vanilla Dark Forces.
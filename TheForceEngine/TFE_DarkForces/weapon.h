@@ -96,6 +96,7 @@ namespace TFE_DarkForces
 
 	// Serialization
 	void weapon_serialize(Stream* stream);
+	void weapon_serializeInPlace(Stream* stream);
 
 	extern PlayerWeapon* s_curPlayerWeapon;
 	extern SoundSourceId s_superchargeCountdownSound;
@@ -9,7 +9,10 @@
 #include <strings.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <SDL_mutex.h>
 #include <TFE_System/system.h>
+#include <string>
+#include <unordered_map>
 #include "fileutil.h"
 #include "filestream.h"
 
@@ -18,6 +21,25 @@ namespace FileUtil
 {
 	bool existsNoCase(const char *filename);
 	static char *findFileObjectNoCase(const char *filename, bool objisdir);
+	static void invalidateDirCache(const char *path);
+
+	// Case-insensitive lookups read the whole directory, so the case-folded
+	// names of each directory are cached and revalidated against the
+	// directory modification time.
+	struct DirCacheEntry
+	{
+		string fileName;	// first regular file matching the folded name.
+		string dirName;		// first directory matching the folded name.
+	};
+	struct DirCache
+	{
+		struct timespec mtime;
+		ino_t ino;
+		bool valid = false;
+		std::unordered_map<string, DirCacheEntry> names;
+	};
+	static std::unordered_map<string, DirCache> s_dirCache;
+	static SDL_mutex *s_dirCacheMutex = SDL_CreateMutex();
 
 	void readDirectory(const char *dir, const char *ext, FileList& fileList)
 	{
@@ -91,6 +113,7 @@ namespace FileUtil
 
 	bool makeDirectory(const char *dir)
 	{
+		invalidateDirCache(dir);
 		if (!mkdir(dir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) || errno == EEXIST)
 			return true;
 		return false;
@@ -199,6 +222,7 @@ namespace FileUtil
 		s = open(src, O_RDONLY);
 		if (!s)
 			return;
+		invalidateDirCache(dst);
 		d = open(dst, O_WRONLY | O_CREAT, 00644);
 		if (!d) {
 			close(s);
@@ -219,6 +243,7 @@ namespace FileUtil
 
 	void deleteFile(const char *fn)
 	{
+		invalidateDirCache(fn);
 		int ret = unlink(fn);
 		if (ret) {
 			TFE_System::logWrite(LOG_WARNING, "deleteFile", "unlink(%s) failed with %d\n", fn, errno);
@@ -245,81 +270,137 @@ namespace FileUtil
 		return existsNoCase(path);
 	}
 
-	// Linux filesystems are case-sensitive; try to open the
-	// base directory and find a file/directory that has the same name
-	// with different case.
-	// Caller MUST free the pointer returned by this function!
-	// Input: full path to file or dir: /abs/path/to/object
-	// This function will try to find "object" with differently cased name
-	// in path "/abs/path/to/".
-	static char *findFileObjectNoCase(const char *filename, bool objisdir)
+	static void foldName(const char *name, string& out)
 	{
-		char *fncopy, *dn, *fn;
-		char *result = NULL;
-		char buf[PATH_MAX];
-		int ol, dl, fl, nfl, ret;
-		struct stat st;
-		struct dirent *de;
-		DIR *dir;
+		out.assign(name);
+		for (size_t i = 0; i < out.size(); i++)
+			out[i] = tolower((unsigned char)out[i]);
+	}
+
+	// Splits a path into its directory and base name, the same way
+	// dirname() and basename() would.
+	static bool splitPath(const char *filename, string& dn, string& fn)
+	{
+		char *fncopy;
+		int ol;
 
 		// dirname() and basename() screw with the input buffer,
 		// hence we need to make 2 copies.
 		ol = strlen(filename);
 		fncopy = (char *)malloc(ol * 2 + 2);
 		if (!fncopy)
-			return NULL;
+			return false;
 		memset(fncopy, 0, ol + ol + 2);
 		strncpy(fncopy, filename, ol);
 		strncpy(fncopy + ol + 1, filename, ol);
 
 		dn = dirname(fncopy);
-		fn = basename(fncopy + ol +1);
+		fn = basename(fncopy + ol + 1);
+		free(fncopy);
+		return !dn.empty() && !fn.empty();
+	}
 
-		dl = strlen(dn);
-		fl = strlen(fn);
-		if ((dl < 1) || (fl < 1)) {
-			free(fncopy);
-			return NULL;
-		}
+	// Drop the cached listing of the directory containing 'path', for changes
+	// made within the timestamp granularity of the file system.
+	static void invalidateDirCache(const char *path)
+	{
+		string dn, fn;
+		if (!splitPath(path, dn, fn))
+			return;
 
-		dir = opendir(dn);
-		if (!dir) {
-			free(fncopy);
-			return NULL;
-		}
+		SDL_LockMutex(s_dirCacheMutex);
+		s_dirCache.erase(dn);
+		SDL_UnlockMutex(s_dirCacheMutex);
+	}
+
+	// Read the directory and store the folded names of its files and subdirectories.
+	static bool readDirCache(const string& dn, DirCache& cache)
+	{
+		char buf[PATH_MAX];
+		struct stat st;
+		struct dirent *de;
+		string folded;
+		DIR *dir;
+		bool isdir;
 
+		dir = opendir(dn.c_str());
+		if (!dir)
+			return false;
+
+		cache.names.clear();
 		while (NULL != (de = readdir(dir)))
 		{
-			memset(buf, 0, PATH_MAX);
-			snprintf(buf, PATH_MAX - 2, "%s/%s", dn, de->d_name);
-			ret = stat(buf, &st);
-			if (ret != 0)
-				continue;
-			if (objisdir) {
-				if (!S_ISDIR(st.st_mode))
-					continue;
+			// d_type avoids a stat() per entry where the file system provides it.
+			if (de->d_type == DT_REG || de->d_type == DT_DIR) {
+				isdir = de->d_type == DT_DIR;
 			} else {
-				if (!S_ISREG(st.st_mode))
+				memset(buf, 0, PATH_MAX);
+				snprintf(buf, PATH_MAX - 2, "%s/%s", dn.c_str(), de->d_name);
+				if (stat(buf, &st) != 0)
+					continue;
+				if (S_ISDIR(st.st_mode))
+					isdir = true;
+				else if (S_ISREG(st.st_mode))
+					isdir = false;
+				else
 					continue;
 			}
 
-			nfl = strlen(de->d_name);
-			if (nfl != fl)
-				continue;
+			foldName(de->d_name, folded);
+			DirCacheEntry& entry = cache.names[folded];
+			string& name = isdir ? entry.dirName : entry.fileName;
+			if (name.empty())
+				name = de->d_name;
+		}
+		closedir(dir);
+		return true;
+	}
 
-			if (0 != strncasecmp(de->d_name, fn, fl))
-				continue;
+	// Linux filesystems are case-sensitive; try to find a file/directory
+	// in the base directory that has the same name with different case.
+	// Caller MUST free the pointer returned by this function!
+	// Input: full path to file or dir: /abs/path/to/object
+	// This function will try to find "object" with differently cased name
+	// in path "/abs/path/to/".
+	static char *findFileObjectNoCase(const char *filename, bool objisdir)
+	{
+		char *result = NULL;
+		string dn, fn, folded;
+		struct stat st;
 
-			// found a match
-			result = (char *)malloc(dl + 1 + nfl + 1);
-			if (!result)
-				break;
-			memset(result, 0, dl + 1 + nfl + 1);
-			sprintf(result, "%s/%s", dn, de->d_name);
-			break;	// we're done.
+		if (!splitPath(filename, dn, fn))
+			return NULL;
+		if (stat(dn.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+			return NULL;
+
+		SDL_LockMutex(s_dirCacheMutex);
+		DirCache& cache = s_dirCache[dn];
+		if (!cache.valid || cache.ino != st.st_ino ||
+		    cache.mtime.tv_sec != st.st_mtim.tv_sec || cache.mtime.tv_nsec != st.st_mtim.tv_nsec)
+		{
+			cache.mtime = st.st_mtim;
+			cache.ino = st.st_ino;
+			cache.valid = readDirCache(dn, cache);
+			if (!cache.valid) {
+				s_dirCache.erase(dn);
+				SDL_UnlockMutex(s_dirCacheMutex);
+				return NULL;
+			}
 		}
-		free(fncopy);
-		closedir(dir);
+
+		foldName(fn.c_str(), folded);
+		std::unordered_map<string, DirCacheEntry>::const_iterator iName = cache.names.find(folded);
+		if (iName != cache.names.end())
+		{
+			const string& name = objisdir ? iName->second.dirName : iName->second.fileName;
+			if (!name.empty())
+			{
+				result = (char *)malloc(dn.size() + 1 + name.size() + 1);
+				if (result)
+					sprintf(result, "%s/%s", dn.c_str(), name.c_str());
+			}
+		}
+		SDL_UnlockMutex(s_dirCacheMutex);
 		return result;
 	}
 
@@ -0,0 +1,116 @@
+#include "mappedfile.h"
+#include <TFE_System/system.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0)
+{
+#ifdef _WIN32
+	m_mapping = nullptr;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const char* filename)
+{
+	close();
+
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// The mapping keeps the file open, so the file handle can be closed right away.
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+	{
+		TFE_System::logWrite(LOG_WARNING, "MappedFile", "Cannot map file '%s'.", filename);
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	if (!view)
+	{
+		TFE_System::logWrite(LOG_WARNING, "MappedFile", "Cannot map a view of file '%s'.", filename);
+		CloseHandle(mapping);
+		return false;
+	}
+
+	m_mapping = mapping;
+	m_data = (u8*)view;
+	m_size = size_t(size.QuadPart);
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (m_data)
+	{
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+	}
+	m_mapping = nullptr;
+	m_data = nullptr;
+	m_size = 0;
+}
+#else
+bool MappedFile::open(const char* filename)
+{
+	close();
+
+	const int file = ::open(filename, O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	if (fstat(file, &st) != 0 || st.st_size == 0)
+	{
+		::close(file);
+		return false;
+	}
+
+	// The mapping keeps its own reference to the file, so the descriptor can be closed right away.
+	void* view = mmap(nullptr, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+	::close(file);
+	if (view == MAP_FAILED)
+	{
+		TFE_System::logWrite(LOG_WARNING, "MappedFile", "Cannot map file '%s'.", filename);
+		return false;
+	}
+
+	m_data = (u8*)view;
+	m_size = size_t(st.st_size);
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (m_data)
+	{
+		munmap(m_data, m_size);
+	}
+	m_data = nullptr;
+	m_size = 0;
+}
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Memory mapped file view.
+// The whole file is mapped copy-on-write, so the data may be
+// modified in memory without changing the file on disk. Pages are
+// only read from disk when they are first touched.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	bool open(const char* filename);
+	void close();
+
+	u8* data() const { return m_data; }
+	size_t getSize() const { return m_size; }
+	bool isOpen() const { return m_data != nullptr; }
+
+private:
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	u8* m_data;
+	size_t m_size;
+#ifdef _WIN32
+	void* m_mapping;
+#endif
+};
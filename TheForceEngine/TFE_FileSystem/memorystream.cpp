@@ -86,6 +86,14 @@ void MemoryStream::clear()
 	m_size = 0u;
 }
 
+void MemoryStream::release()
+{
+	clear();
+	free(m_memory);
+	m_memory = nullptr;
+	m_capacity = 0u;
+}
+
 //derived from Stream
 bool MemoryStream::seek(s32 offset, Origin origin/*=ORIGIN_START*/)
 {
@@ -25,6 +25,8 @@ public:
 	// This clears out the size, address, mode, etc. so the stream can be re-used,
 	// but does not free memory.
 	void clear();
+	// Clear the stream and free its memory.
+	void release();
 
 	// Standard stream access.
 	bool open(AccessMode mode);
@@ -291,6 +291,36 @@ namespace TFE_Paths
 		s_localArchives.pop_back();
 	}
 
+	static u32 hashString(u32 hash, const char* str)
+	{
+		// FNV-1a
+		for (; *str; str++)
+		{
+			hash = (hash ^ u8(*str)) * 16777619u;
+		}
+		// Separate consecutive strings so that "ab" + "c" != "a" + "bc".
+		return (hash ^ 0xffu) * 16777619u;
+	}
+
+	u32 getSearchPathHash()
+	{
+		u32 hash = 2166136261u;
+		for (const std::string& path : s_searchPaths)
+		{
+			hash = hashString(hash, path.c_str());
+		}
+		for (const Archive* archive : s_localArchives)
+		{
+			hash = hashString(hash, archive->getPath());
+		}
+		for (const FileMapping& mapping : s_fileMappings)
+		{
+			hash = hashString(hash, mapping.fileName.c_str());
+			hash = hashString(hash, mapping.realPath.c_str());
+		}
+		return hash;
+	}
+
 	bool getFilePath(const char *fileName, FilePath *outPath)
 	{
 		char fullname[TFE_MAX_PATH];
@@ -53,6 +53,9 @@ namespace TFE_Paths
 	void addLocalArchiveToFront(Archive* archive);
 	void removeFirstArchive();
 	bool getFilePath(const char* fileName, FilePath* path);
+	// Hash of the current search paths, archives and file mappings. This changes whenever the set of
+	// files that getFilePath() can resolve may have changed, such as when mods are loaded or unloaded.
+	u32 getSearchPathHash();
 
 	// Add a single file that can be referenced by 'fileName' even though the real name may be different.
 	void addSingleFilePath(const char* fileName, const char* filePath);
@@ -1466,6 +1466,18 @@ namespace TFE_FrontEndUI
 			enhancements->enableHdHud = useHdHUD;
 			forceTextureUpdate = true;
 		}
+		bool compressHdCache = enhancements->compressHdTextureCache;
+		if (ImGui::Checkbox("Compress HD Texture Cache", &compressHdCache))
+		{
+			enhancements->compressHdTextureCache = compressHdCache;
+		}
+		Tooltip("Uses less disk space, but HD textures are decompressed on load rather than memory mapped.");
+		bool streamHdTextures = enhancements->streamHdTextures;
+		if (ImGui::Checkbox("Stream HD Textures", &streamHdTextures))
+		{
+			enhancements->streamHdTextures = streamHdTextures;
+		}
+		Tooltip("Read HD level textures as they come into view, showing the original texture until they are ready. Texture memory is still reserved for every texture.");
 
 		if (!enhancedGobExists || graphics->colorMode != COLORMODE_TRUE_COLOR)
 		{
@@ -1480,6 +1492,7 @@ namespace TFE_FrontEndUI
 	///////////////////////////////////////////////////////////////////////////////
 	static std::vector<TFE_SaveSystem::SaveHeader> s_saveDir;
 	static TextureGpu* s_saveImageView = nullptr;
+	static u32 s_saveImage[TFE_SaveSystem::SAVE_IMAGE_WIDTH * TFE_SaveSystem::SAVE_IMAGE_HEIGHT];
 	static s32 s_selectedSave = -1;
 	static s32 s_selectedSaveSlot = -1;
 	static bool s_hasQuicksave = false;
@@ -1499,7 +1512,9 @@ namespace TFE_FrontEndUI
 
 	void updateSaveImage(s32 index)
 	{
-		s_saveImageView->update(s_saveDir[index].imageData, TFE_SaveSystem::SAVE_IMAGE_WIDTH * TFE_SaveSystem::SAVE_IMAGE_HEIGHT * 4);
+		// Thumbnails are only decoded once the save is selected.
+		TFE_SaveSystem::loadSaveImage(&s_saveDir[index], s_saveImage);
+		s_saveImageView->update(s_saveImage, TFE_SaveSystem::SAVE_IMAGE_WIDTH * TFE_SaveSystem::SAVE_IMAGE_HEIGHT * 4);
 	}
 
 	void openLoadConfirmPopup()
@@ -2510,6 +2525,27 @@ namespace TFE_FrontEndUI
 			graphics->asyncFramebuffer = true;
 			graphics->gpuColorConvert = true;
 			ImGui::Checkbox("Extend Adjoin/Portal Limits", &graphics->extendAjoinLimits);
+
+			// Render threads, only used above 320x200.
+			ImGui::LabelText("##ConfigLabel", "Render Threads"); ImGui::SameLine(150 * s_uiScale);
+			ImGui::SetNextItemWidth(196 * s_uiScale);
+			ImGui::SliderInt("##RenderThreads", &graphics->rendererThreads, 0, 16, graphics->rendererThreads ? "%d" : "Auto");
+			Tooltip("Number of threads used to draw the view at higher resolutions, 1 (the default) draws on the main thread only and Auto uses one per CPU core.");
+
+			// Dynamic resolution, only used above 320x200.
+			ImGui::Checkbox("Dynamic Resolution", &graphics->dynamicResolution);
+			Tooltip("Lower the resolution of the 3D view when it cannot be drawn at the target frame rate. The HUD stays at the game resolution.");
+			if (graphics->dynamicResolution)
+			{
+				ImGui::LabelText("##ConfigLabel", "Target FPS"); ImGui::SameLine(150 * s_uiScale);
+				ImGui::SetNextItemWidth(196 * s_uiScale);
+				ImGui::SliderInt("##DynamicResTargetFps", &graphics->dynamicResTargetFps, 15, 240);
+
+				ImGui::LabelText("##ConfigLabel", "Minimum Scale"); ImGui::SameLine(150 * s_uiScale);
+				ImGui::SetNextItemWidth(196 * s_uiScale);
+				ImGui::SliderFloat("##DynamicResMinScale", &graphics->dynamicResMinScale, 0.25f, 1.0f, "%.2f");
+				Tooltip("Lowest resolution of the 3D view, as a fraction of the game resolution.");
+			}
 		}
 		else if (graphics->rendererIndex == 1)
 		{
@@ -14,6 +14,7 @@
 #include <TFE_Settings/settings.h>
 #include <TFE_Asset/imageAsset.h>
 #include <TFE_Archive/zipArchive.h>
+#include <TFE_Archive/gobArchive.h>
 #include <TFE_Archive/gobMemoryArchive.h>
 #include <TFE_Input/inputMapping.h>
 #include <TFE_Asset/imageAsset.h>
@@ -23,6 +24,9 @@
 // Game
 #include <TFE_DarkForces/mission.h>
 #include <TFE_Jedi/Renderer/jediRenderer.h>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include <SDL_atomic.h>
 #include <map>
 #include <algorithm>
 
@@ -58,17 +62,59 @@ namespace TFE_FrontEndUI
 
 		bool invertImage = true;
 	};
+
+	// Mods are scanned on a worker thread, posters are decoded there and handed to the main thread to create textures.
+	enum PosterType : u8
+	{
+		POSTER_NONE = 0,
+		POSTER_IMAGE,		// posterData[0] is an encoded image (JPG).
+		POSTER_BM,			// posterData[0] is a BM and posterData[1] a PAL, empty means the default from the base game.
+	};
+
+	struct ModScan
+	{
+		ModData data;
+		PosterType posterType = POSTER_NONE;
+		std::vector<u8> posterData[2];
+
+		// Decoded poster.
+		std::vector<u32> posterPixels;
+		u32 posterWidth = 0;
+		u32 posterHeight = 0;
+	};
+
+	// Scan results are cached on disk, keyed by the mod path and validated with the modified time and size of the mod files.
+	struct ModCacheEntry
+	{
+		u64 modifiedTime;
+		u64 size;
+		ModScan scan;
+	};
+	typedef std::map<std::string, ModCacheEntry> ModCache;
+
+	enum ModCacheConst : u32
+	{
+		MOD_CACHE_MAGIC = 0x534d4654,	// "TFMS"
+		MOD_CACHE_VERSION = 1,
+	};
 	static std::vector<ModData> s_mods;
 	static std::vector<ModData*> s_filteredMods;
 
 	static std::vector<char> s_fileBuffer;
-	static std::vector<u8> s_readBuffer[2];
 	static s32 s_selectedMod;
 
 	static std::vector<QueuedRead> s_readQueue;
-	static std::vector<u8> s_imageBuffer;
 	static size_t s_readIndex = 0;
 
+	// Scan thread state.
+	static SDL_Thread* s_scanThread = nullptr;
+	static SDL_mutex* s_scanMutex = nullptr;
+	static SDL_atomic_t s_scanCancel;
+	static std::vector<ModScan*> s_scanResults;	// Protected by s_scanMutex.
+	static size_t s_scanCount = 0;				// Queue entries processed, protected by s_scanMutex.
+	static std::vector<u8> s_defaultPoster[2];	// wait.bm and wait.pal from the base game.
+	static ModCache s_modCache;
+
 	static ViewMode s_viewMode = VIEW_IMAGES;
 
 	static char s_modFilter[256] = { 0 };
@@ -80,8 +126,11 @@ namespace TFE_FrontEndUI
 	void fixupName(char* name);
 	void readFromQueue(size_t itemsPerFrame);
 	bool parseNameFromText(const char* textFileName, const char* path, char* name, std::string* fullText);
-	void extractPosterFromImage(const char* baseDir, const char* zipFile, const char* imageFileName, UiTexture* poster);
-	void extractPosterFromMod(const char* baseDir, const char* archiveFileName, UiTexture* poster);
+	void readPosterFromImage(const char* baseDir, const char* zipFile, const char* imageFileName, ModScan* scan);
+	void readPosterFromMod(const char* baseDir, const char* archiveFileName, ModScan* scan);
+	void readDefaultPoster();
+	void startScanThread();
+	void stopScanThread();
 	void filterMods(bool filterByName, bool sort = true);
 
 	bool sortQueueByName(QueuedRead& a, QueuedRead& b)
@@ -219,10 +268,12 @@ namespace TFE_FrontEndUI
 		}
 
 		std::sort(s_readQueue.begin(), s_readQueue.end(), sortQueueByName);
+		startScanThread();
 	}
 
 	void modLoader_cleanupResources()
 	{
+		stopScanThread();
 		for (size_t i = 0; i < s_mods.size(); i++)
 		{
 			if (s_mods[i].image.texture)
@@ -850,142 +901,478 @@ namespace TFE_FrontEndUI
 		}
 	}
 
-	void readFromQueue(size_t itemsPerFrame)
+	///////////////////////////////////////////////////
+	// Mod scanning, runs on the scan thread.
+	///////////////////////////////////////////////////
+	bool scanModDirectory(const char* subDir, ModScan* scan)
 	{
 		FileList gobFiles, txtFiles, imgFiles;
-		const size_t readEnd = min(s_readIndex + itemsPerFrame, s_readQueue.size());
-		const QueuedRead* reads = s_readQueue.data();
-		bool updateFilter = false;
-		for (size_t i = s_readIndex; i < readEnd; i++, s_readIndex++)
+		FileUtil::readDirectory(subDir, "gob", gobFiles);
+		FileUtil::readDirectory(subDir, "txt", txtFiles);
+		FileUtil::readDirectory(subDir, "jpg", imgFiles);
+
+		// No gob files = no mod.
+		if (gobFiles.size() != 1)
 		{
-			updateFilter = true;
-			if (reads[i].type == QREAD_DIR)
+			return false;
+		}
+
+		ModData& mod = scan->data;
+		mod.gobFiles = gobFiles;
+		mod.textFile = txtFiles.empty() ? "" : txtFiles[0];
+		mod.imageFile = imgFiles.empty() ? "" : imgFiles[0];
+		mod.text = "";
+
+		size_t fullDirLen = strlen(subDir);
+		for (size_t i = 0; i < fullDirLen; i++)
+		{
+			if (strncasecmp("Mods", &subDir[i], 4) == 0)
 			{
-				// Clear doesn't deallocate in most implementations, so doing it this way should reduce memory allocations.
-				gobFiles.clear();
-				txtFiles.clear();
-				imgFiles.clear();
-
-				const char* subDir = reads[i].path.c_str();
-				FileUtil::readDirectory(subDir, "gob", gobFiles);
-				FileUtil::readDirectory(subDir, "txt", txtFiles);
-				FileUtil::readDirectory(subDir, "jpg", imgFiles);
-
-				// No gob files = no mod.
-				if (gobFiles.size() != 1)
-				{
-					continue;
-				}
-				s_mods.push_back({});
-				ModData& mod = s_mods.back();
+				mod.relativePath = &subDir[i + 5];
+				break;
+			}
+		}
 
-				mod.gobFiles = gobFiles;
-				mod.textFile = txtFiles.empty() ? "" : txtFiles[0];
-				mod.imageFile = imgFiles.empty() ? "" : imgFiles[0];
-				mod.text = "";
+		if (mod.imageFile.empty())
+		{
+			readPosterFromMod(subDir, mod.gobFiles[0].c_str(), scan);
+			mod.invertImage = true;
+		}
+		else
+		{
+			readPosterFromImage(subDir, nullptr, mod.imageFile.c_str(), scan);
+			mod.invertImage = false;
+		}
 
-				size_t fullDirLen = strlen(subDir);
-				for (size_t i = 0; i < fullDirLen; i++)
-				{
-					if (strncasecmp("Mods", &subDir[i], 4) == 0)
-					{
-						mod.relativePath = &subDir[i + 5];
-						break;
-					}
-				}
+		char name[TFE_MAX_PATH];
+		if (!parseNameFromText(mod.textFile.c_str(), subDir, name, &mod.text))
+		{
+			const char* gobFileName = mod.gobFiles[0].c_str();
+			memcpy(name, gobFileName, strlen(gobFileName) - 4);
+			name[strlen(gobFileName) - 4] = 0;
+			fixupName(name);
+		}
+		mod.name = name;
+		return true;
+	}
 
-				if (mod.imageFile.empty())
-				{
-					extractPosterFromMod(subDir, mod.gobFiles[0].c_str(), &mod.image);
-					mod.invertImage = true;
-				}
-				else
-				{
-					extractPosterFromImage(subDir, nullptr, mod.imageFile.c_str(), &mod.image);
-					mod.invertImage = false;
-				}
+	bool scanModZip(const char* modPath, const char* zipName, ModScan* scan)
+	{
+		ZipArchive zipArchive;
+		char zipPath[TFE_MAX_PATH];
+		sprintf(zipPath, "%s%s", modPath, zipName);
+		if (!zipArchive.open(zipPath)) { return false; }
+
+		s32 gobFileIndex = -1;
+		s32 txtFileIndex = -1;
+		s32 jpgFileIndex = -1;
+
+		// Look for the following:
+		// 1. Gob File.
+		// 2. Text File.
+		// 3. JPG
+		for (u32 f = 0; f < zipArchive.getFileCount(); f++)
+		{
+			const char* fileName = zipArchive.getFileName(f);
+			size_t len = strlen(fileName);
+			if (len <= 4)
+			{
+				continue;
+			}
+			const char* ext = &fileName[len - 3];
+			if (strcasecmp(ext, "gob") == 0)
+			{
+				gobFileIndex = s32(f);
+			}
+			else if (strcasecmp(ext, "txt") == 0)
+			{
+				txtFileIndex = s32(f);
+			}
+			else if (strcasecmp(ext, "jpg") == 0)
+			{
+				jpgFileIndex = s32(f);
+			}
+		}
+		std::string jpgFileName = jpgFileIndex >= 0 ? zipArchive.getFileName(jpgFileIndex) : "";
+		zipArchive.close();
 
-				char name[TFE_MAX_PATH];
-				if (!parseNameFromText(mod.textFile.c_str(), subDir, name, &mod.text))
+		if (gobFileIndex < 0)
+		{
+			return false;
+		}
+
+		ModData& mod = scan->data;
+		mod.gobFiles.push_back(zipName);
+		mod.text = "";
+
+		char name[TFE_MAX_PATH];
+		if (!parseNameFromText(mod.gobFiles[0].c_str(), modPath, name, &mod.text))
+		{
+			const char* gobFileName = mod.gobFiles[0].c_str();
+			memcpy(name, gobFileName, strlen(gobFileName) - 4);
+			name[strlen(gobFileName) - 4] = 0;
+			fixupName(name);
+		}
+		mod.name = name;
+
+		if (jpgFileName.empty())
+		{
+			readPosterFromMod(modPath, mod.gobFiles[0].c_str(), scan);
+			mod.invertImage = true;
+		}
+		else
+		{
+			readPosterFromImage(modPath, mod.gobFiles[0].c_str(), jpgFileName.c_str(), scan);
+			mod.invertImage = false;
+		}
+		return true;
+	}
+
+	void getFileStamp(const char* path, u64* modifiedTime, u64* size)
+	{
+		*modifiedTime = FileUtil::getModifiedTime(path);
+		*size = 0;
+
+		FileStream file;
+		if (file.open(path, Stream::MODE_READ))
+		{
+			*size = file.getSize();
+			file.close();
+		}
+	}
+
+	// Combines the modified times and sizes of the files that make up a mod.
+	// Directory mods are keyed on the file listing as well so adding or removing files causes a rescan.
+	void getModStamp(const QueuedRead& read, u64* modifiedTime, u64* size)
+	{
+		if (read.type == QREAD_ZIP)
+		{
+			char zipPath[TFE_MAX_PATH];
+			sprintf(zipPath, "%s%s", read.path.c_str(), read.fileName.c_str());
+			getFileStamp(zipPath, modifiedTime, size);
+			return;
+		}
+
+		*modifiedTime = 0;
+		*size = 0;
+		const char* exts[] = { "gob", "txt", "jpg" };
+		FileList files;
+		for (s32 e = 0; e < TFE_ARRAYSIZE(exts); e++)
+		{
+			files.clear();
+			FileUtil::readDirectory(read.path.c_str(), exts[e], files);
+			for (size_t i = 0; i < files.size(); i++)
+			{
+				char filePath[TFE_MAX_PATH];
+				sprintf(filePath, "%s%s", read.path.c_str(), files[i].c_str());
+
+				u64 fileTime, fileSize;
+				getFileStamp(filePath, &fileTime, &fileSize);
+				*modifiedTime = max(*modifiedTime, fileTime);
+				*size = *size * 31 + fileSize + 1;
+			}
+		}
+	}
+
+	void decodePoster(ModScan* scan)
+	{
+		if (scan->posterType == POSTER_IMAGE)
+		{
+			SDL_Surface* image = TFE_Image::loadFromMemory(scan->posterData[0].data(), scan->posterData[0].size());
+			if (image)
+			{
+				scan->posterWidth = image->w;
+				scan->posterHeight = image->h;
+				scan->posterPixels.resize(image->w * image->h);
+				for (s32 y = 0; y < image->h; y++)
 				{
-					const char* gobFileName = mod.gobFiles[0].c_str();
-					memcpy(name, gobFileName, strlen(gobFileName) - 4);
-					name[strlen(gobFileName) - 4] = 0;
-					fixupName(name);
+					memcpy(&scan->posterPixels[y * image->w], (u8*)image->pixels + y * image->pitch, image->w * sizeof(u32));
 				}
+				TFE_Image::free(image);
+			}
+		}
+		else if (scan->posterType == POSTER_BM)
+		{
+			const std::vector<u8>& bm  = scan->posterData[0].empty() ? s_defaultPoster[0] : scan->posterData[0];
+			const std::vector<u8>& pal = scan->posterData[1].empty() ? s_defaultPoster[1] : scan->posterData[1];
+			if (bm.empty() || pal.size() < 768) { return; }
+
+			TextureData* imageData = bitmap_loadFromMemory(bm.data(), bm.size(), 1);
+			if (imageData)
+			{
+				u32 palette[256];
+				convertPalette(pal.data(), palette);
 
-				mod.name = name;
+				scan->posterWidth = imageData->width;
+				scan->posterHeight = imageData->height;
+				scan->posterPixels.resize(imageData->width * imageData->height);
+				convertDfTextureToTrueColor(imageData, palette, scan->posterPixels.data());
+
+				free(imageData->image);
+				free(imageData);
+			}
+		}
+	}
+
+	void writeModData(FileStream& file, const ModScan& scan)
+	{
+		const ModData& mod = scan.data;
+		const u32 gobCount = (u32)mod.gobFiles.size();
+		file.write(&gobCount);
+		file.write(mod.gobFiles.data(), gobCount);
+		file.write(&mod.textFile);
+		file.write(&mod.imageFile);
+		file.write(&mod.name);
+		file.write(&mod.relativePath);
+		file.write(&mod.text);
+		const u8 invertImage = mod.invertImage ? 1 : 0;
+		file.write(&invertImage);
+
+		const u8 posterType = scan.posterType;
+		file.write(&posterType);
+		for (s32 i = 0; i < 2; i++)
+		{
+			const u32 size = (u32)scan.posterData[i].size();
+			file.write(&size);
+			file.writeBuffer(scan.posterData[i].data(), size);
+		}
+	}
+
+	bool readModData(FileStream& file, ModScan* scan)
+	{
+		ModData& mod = scan->data;
+		u32 gobCount = 0;
+		file.read(&gobCount);
+		if (gobCount == 0 || gobCount > 1024) { return false; }
+		mod.gobFiles.resize(gobCount);
+		file.read(mod.gobFiles.data(), gobCount);
+		file.read(&mod.textFile);
+		file.read(&mod.imageFile);
+		file.read(&mod.name);
+		file.read(&mod.relativePath);
+		file.read(&mod.text);
+		u8 invertImage = 0;
+		file.read(&invertImage);
+		mod.invertImage = invertImage != 0;
+
+		u8 posterType = 0;
+		file.read(&posterType);
+		if (posterType > POSTER_BM) { return false; }
+		scan->posterType = PosterType(posterType);
+		for (s32 i = 0; i < 2; i++)
+		{
+			u32 size = 0;
+			file.read(&size);
+			if (size > file.getSize()) { return false; }
+			scan->posterData[i].resize(size);
+			if (size && file.readBuffer(scan->posterData[i].data(), size) != size) { return false; }
+		}
+		return true;
+	}
+
+	void getModCachePath(char* path)
+	{
+		char cacheDir[TFE_MAX_PATH];
+		TFE_Paths::appendPath(PATH_PROGRAM_DATA, "Cache/", cacheDir);
+		if (!FileUtil::directoryExits(cacheDir))
+		{
+			FileUtil::makeDirectory(cacheDir);
+		}
+		snprintf(path, TFE_MAX_PATH, "%sModScan.tfc", cacheDir);
+	}
+
+	void readModCache()
+	{
+		s_modCache.clear();
+
+		char path[TFE_MAX_PATH];
+		getModCachePath(path);
+		FileStream file;
+		if (!file.open(path, Stream::MODE_READ)) { return; }
+
+		u32 magic = 0, version = 0, count = 0;
+		file.read(&magic);
+		file.read(&version);
+		file.read(&count);
+		if (magic != MOD_CACHE_MAGIC || version != MOD_CACHE_VERSION)
+		{
+			return;
+		}
+
+		for (u32 i = 0; i < count; i++)
+		{
+			std::string key;
+			ModCacheEntry entry;
+			file.read(&key);
+			file.read(&entry.modifiedTime);
+			file.read(&entry.size);
+			if (!readModData(file, &entry.scan))
+			{
+				TFE_System::logWrite(LOG_WARNING, "ModLoader", "Mod scan cache '%s' is invalid, mods will be rescanned.", path);
+				s_modCache.clear();
+				break;
+			}
+			s_modCache[key] = entry;
+		}
+		file.close();
+	}
+
+	void writeModCache(const ModCache& cache)
+	{
+		char path[TFE_MAX_PATH];
+		getModCachePath(path);
+		FileStream file;
+		if (!file.open(path, Stream::MODE_WRITE)) { return; }
+
+		const u32 magic = MOD_CACHE_MAGIC, version = MOD_CACHE_VERSION, count = (u32)cache.size();
+		file.write(&magic);
+		file.write(&version);
+		file.write(&count);
+
+		ModCache::const_iterator iEntry = cache.begin();
+		for (; iEntry != cache.end(); ++iEntry)
+		{
+			file.write(&iEntry->first);
+			file.write(&iEntry->second.modifiedTime);
+			file.write(&iEntry->second.size);
+			writeModData(file, iEntry->second.scan);
+		}
+		file.close();
+	}
+
+	s32 scanThreadFunc(void* userData)
+	{
+		readModCache();
+
+		ModCache newCache;
+		bool cacheChanged = false;
+		const size_t count = s_readQueue.size();
+		for (size_t i = 0; i < count && !SDL_AtomicGet(&s_scanCancel); i++)
+		{
+			const QueuedRead& read = s_readQueue[i];
+			const std::string key = read.path + read.fileName;
+
+			ModCacheEntry entry;
+			getModStamp(read, &entry.modifiedTime, &entry.size);
+
+			bool valid = false;
+			ModCache::iterator iCached = s_modCache.find(key);
+			if (iCached != s_modCache.end() && iCached->second.modifiedTime == entry.modifiedTime && iCached->second.size == entry.size)
+			{
+				entry.scan = iCached->second.scan;
+				valid = true;
 			}
 			else
 			{
-				ZipArchive zipArchive;
-				const char* modPath = reads[i].path.c_str();
-				const char* zipName = reads[i].fileName.c_str();
-
-				char zipPath[TFE_MAX_PATH];
-				sprintf(zipPath, "%s%s", modPath, zipName);
-				if (!zipArchive.open(zipPath)) { continue; }
-
-				s32 gobFileIndex = -1;
-				s32 txtFileIndex = -1;
-				s32 jpgFileIndex = -1;
-
-				// Look for the following:
-				// 1. Gob File.
-				// 2. Text File.
-				// 3. JPG
-				for (u32 f = 0; f < zipArchive.getFileCount(); f++)
-				{
-					const char* fileName = zipArchive.getFileName(f);
-					size_t len = strlen(fileName);
-					if (len <= 4)
-					{
-						continue;
-					}
-					const char* ext = &fileName[len - 3];
-					if (strcasecmp(ext, "gob") == 0)
-					{
-						gobFileIndex = s32(f);
-					}
-					else if (strcasecmp(ext, "txt") == 0)
-					{
-						txtFileIndex = s32(f);
-					}
-					else if (strcasecmp(ext, "jpg") == 0)
-					{
-						jpgFileIndex = s32(f);
-					}
-				}
-				if (gobFileIndex >= 0)
-				{
-					s_mods.push_back({});
-					ModData& mod = s_mods.back();
-					mod.gobFiles.push_back(zipName);
-					mod.text = "";
+				valid = (read.type == QREAD_DIR) ? scanModDirectory(read.path.c_str(), &entry.scan) :
+					scanModZip(read.path.c_str(), read.fileName.c_str(), &entry.scan);
+				cacheChanged = true;
+			}
 
-					char name[TFE_MAX_PATH];
-					if (!parseNameFromText(mod.gobFiles[0].c_str(), modPath, name, &mod.text))
-					{
-						const char* gobFileName = mod.gobFiles[0].c_str();
-						memcpy(name, gobFileName, strlen(gobFileName) - 4);
-						name[strlen(gobFileName) - 4] = 0;
-						fixupName(name);
-					}
-					mod.name = name;
+			ModScan* result = nullptr;
+			if (valid)
+			{
+				newCache[key] = entry;
+				result = new ModScan(entry.scan);
+				decodePoster(result);
+				// The source data is only needed for the cache.
+				result->posterData[0].clear();
+				result->posterData[1].clear();
+			}
 
-					if (jpgFileIndex < 0)
-					{
-						extractPosterFromMod(modPath, mod.gobFiles[0].c_str(), &mod.image);
-						mod.invertImage = true;
-					}
-					else
-					{
-						extractPosterFromImage(modPath, mod.gobFiles[0].c_str(), zipArchive.getFileName(jpgFileIndex), &mod.image);
-						mod.invertImage = false;
-					}
-				}
+			SDL_LockMutex(s_scanMutex);
+			if (result)
+			{
+				s_scanResults.push_back(result);
+			}
+			s_scanCount++;
+			SDL_UnlockMutex(s_scanMutex);
+		}
 
-				zipArchive.close();
+		// Only write the cache after a complete scan, so mods that were not reached are not dropped.
+		if (!SDL_AtomicGet(&s_scanCancel) && (cacheChanged || newCache.size() != s_modCache.size()))
+		{
+			writeModCache(newCache);
+		}
+		s_modCache.clear();
+		return 0;
+	}
+
+	void startScanThread()
+	{
+		if (s_readQueue.empty()) { return; }
+
+		// The base game poster is read here since the archive system is not thread safe.
+		readDefaultPoster();
+
+		if (!s_scanMutex)
+		{
+			s_scanMutex = SDL_CreateMutex();
+		}
+		SDL_AtomicSet(&s_scanCancel, 0);
+		s_scanCount = 0;
+		s_scanThread = SDL_CreateThread(scanThreadFunc, "TFE_ModScan", nullptr);
+		if (!s_scanThread)
+		{
+			TFE_System::logWrite(LOG_WARNING, "ModLoader", "Cannot create the mod scan thread, scanning on the main thread.");
+			scanThreadFunc(nullptr);
+		}
+	}
+
+	void stopScanThread()
+	{
+		if (s_scanThread)
+		{
+			SDL_AtomicSet(&s_scanCancel, 1);
+			SDL_WaitThread(s_scanThread, nullptr);
+			s_scanThread = nullptr;
+		}
+		for (size_t i = 0; i < s_scanResults.size(); i++)
+		{
+			delete s_scanResults[i];
+		}
+		s_scanResults.clear();
+	}
+
+	///////////////////////////////////////////////////
+	// Main thread.
+	///////////////////////////////////////////////////
+	// Take the finished scans from the scan thread and create the poster textures.
+	void readFromQueue(size_t itemsPerFrame)
+	{
+		if (s_readIndex >= s_readQueue.size()) { return; }
+
+		std::vector<ModScan*> results;
+		SDL_LockMutex(s_scanMutex);
+		const size_t resultCount = min(itemsPerFrame, s_scanResults.size());
+		results.assign(s_scanResults.begin(), s_scanResults.begin() + resultCount);
+		s_scanResults.erase(s_scanResults.begin(), s_scanResults.begin() + resultCount);
+		const bool scanFinished = s_scanResults.empty() && s_scanCount == s_readQueue.size();
+		SDL_UnlockMutex(s_scanMutex);
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			ModScan* scan = results[i];
+			s_mods.push_back(scan->data);
+			ModData& mod = s_mods.back();
+			if (!scan->posterPixels.empty())
+			{
+				mod.image.texture = TFE_RenderBackend::createTexture(scan->posterWidth, scan->posterHeight, scan->posterPixels.data(), MAG_FILTER_LINEAR);
+				mod.image.width = scan->posterWidth;
+				mod.image.height = scan->posterHeight;
+			}
+			delete scan;
+		}
+
+		bool updateFilter = !results.empty();
+		if (scanFinished)
+		{
+			s_readIndex = s_readQueue.size();
+			updateFilter = true;
+			if (s_scanThread)
+			{
+				SDL_WaitThread(s_scanThread, nullptr);
+				s_scanThread = nullptr;
 			}
 		}
 
@@ -998,8 +1385,9 @@ namespace TFE_FrontEndUI
 		}
 	}
 
-	void extractPosterFromImage(const char* baseDir, const char* zipFile, const char* imageFileName, UiTexture* poster)
+	void readPosterFromImage(const char* baseDir, const char* zipFile, const char* imageFileName, ModScan* scan)
 	{
+		std::vector<u8>& imageData = scan->posterData[0];
 		if (zipFile && zipFile[0])
 		{
 			char zipPath[TFE_MAX_PATH];
@@ -1010,20 +1398,9 @@ namespace TFE_FrontEndUI
 			if (zipArchive.openFile(imageFileName))
 			{
 				size_t imageSize = zipArchive.getFileLength();
-				s_imageBuffer.resize(imageSize);
-				zipArchive.readFile(s_imageBuffer.data(), imageSize);
+				imageData.resize(imageSize);
+				zipArchive.readFile(imageData.data(), imageSize);
 				zipArchive.closeFile();
-
-				SDL_Surface* image = TFE_Image::loadFromMemory((u8*)s_imageBuffer.data(), imageSize);
-				if (image)
-				{
-					TextureGpu* gpuImage = TFE_RenderBackend::createTexture(image->w, image->h, (u32*)image->pixels, MAG_FILTER_LINEAR);
-					poster->texture = gpuImage;
-					poster->width = image->w;
-					poster->height = image->h;
-
-					TFE_Image::free(image);
-				}
 			}
 			zipArchive.close();
 		}
@@ -1032,35 +1409,63 @@ namespace TFE_FrontEndUI
 			char imagePath[TFE_MAX_PATH];
 			sprintf(imagePath, "%s%s", baseDir, imageFileName);
 
-			SDL_Surface* image = TFE_Image::get(imagePath);
-			if (image)
+			FileStream file;
+			if (file.open(imagePath, Stream::MODE_READ))
 			{
-				TextureGpu* gpuImage = TFE_RenderBackend::createTexture(image->w, image->h, (u32*)image->pixels, MAG_FILTER_LINEAR);
-				poster->texture = gpuImage;
-				poster->width = image->w;
-				poster->height = image->h;
+				imageData.resize(file.getSize());
+				file.readBuffer(imageData.data(), (u32)imageData.size());
+				file.close();
 			}
 		}
+		scan->posterType = imageData.empty() ? POSTER_NONE : POSTER_IMAGE;
 	}
 
-	void extractPosterFromMod(const char* baseDir, const char* archiveFileName, UiTexture* poster)
+	void readArchiveFile(Archive* archive, const char* fileName, std::vector<u8>& buffer)
 	{
-		// Extract a "poster", if possible, from the GOB file.
-		// And then save it as a JPG in /ProgramData/TheForceEngine/ModPosters/NAME.jpg
-		char modPath[TFE_MAX_PATH], srcPath[TFE_MAX_PATH], srcPathTex[TFE_MAX_PATH];
-		sprintf(modPath, "%s%s", baseDir, archiveFileName);
+		if (archive->fileExists(fileName) && archive->openFile(fileName))
+		{
+			buffer.resize(archive->getFileLength());
+			archive->readFile(buffer.data(), archive->getFileLength());
+			archive->closeFile();
+		}
+	}
+
+	void readDefaultPoster()
+	{
+		char srcPath[TFE_MAX_PATH], srcPathTex[TFE_MAX_PATH];
 		sprintf(srcPath, "%s%s", TFE_Paths::getPath(PATH_SOURCE_DATA), "DARK.GOB");
 		sprintf(srcPathTex, "%s%s", TFE_Paths::getPath(PATH_SOURCE_DATA), "TEXTURES.GOB");
 
+		Archive* archiveTex = Archive::getArchive(ARCHIVE_GOB, "TEXTURES.GOB", srcPathTex);
+		Archive* archiveBase = Archive::getArchive(ARCHIVE_GOB, "DARK.GOB", srcPath);
+
+		s_defaultPoster[0].clear();
+		s_defaultPoster[1].clear();
+		if (archiveTex)
+		{
+			readArchiveFile(archiveTex, "wait.bm", s_defaultPoster[0]);
+		}
+		if (archiveBase)
+		{
+			readArchiveFile(archiveBase, "wait.pal", s_defaultPoster[1]);
+		}
+	}
+
+	void readPosterFromMod(const char* baseDir, const char* archiveFileName, ModScan* scan)
+	{
+		// Extract a "poster", if possible, from the GOB file.
+		// The mod's own wait.bm and wait.pal are used if they exist, otherwise the base game versions.
+		char modPath[TFE_MAX_PATH];
+		sprintf(modPath, "%s%s", baseDir, archiveFileName);
+
 		GobMemoryArchive gobMemArchive;
+		GobArchive gobArchive;
+		u8* gobBuffer = nullptr;
 		const size_t len = strlen(archiveFileName);
 		const char* archiveExt = &archiveFileName[len - 3];
 		Archive* archiveMod = nullptr;
-		bool archiveIsGob = true;
 		if (strcasecmp(archiveExt, "zip") == 0)
 		{
-			archiveIsGob = false;
-
 			ZipArchive zipArchive;
 			if (zipArchive.open(modPath))
 			{
@@ -1082,14 +1487,14 @@ namespace TFE_FrontEndUI
 				if (gobIndex >= 0)
 				{
 					size_t bufferLen = zipArchive.getFileLength(gobIndex);
-					u8* buffer = (u8*)malloc(bufferLen);
+					gobBuffer = (u8*)malloc(bufferLen);
 					zipArchive.openFile(gobIndex);
-					const size_t lengthRead = zipArchive.readFile(buffer, bufferLen);
+					const size_t lengthRead = zipArchive.readFile(gobBuffer, bufferLen);
 					zipArchive.closeFile();
 
 					if (lengthRead > 0)
 					{
-						gobMemArchive.open(buffer, bufferLen);
+						gobMemArchive.open(gobBuffer, bufferLen);
 						archiveMod = &gobMemArchive;
 					}
 					else
@@ -1101,55 +1506,21 @@ namespace TFE_FrontEndUI
 				zipArchive.close();
 			}
 		}
-		else
-		{
-			archiveMod = Archive::getArchive(ARCHIVE_GOB, archiveFileName, modPath);
-		}
-		Archive* archiveTex = Archive::getArchive(ARCHIVE_GOB, "TEXTURES.GOB", srcPathTex);
-		Archive* archiveBase = Archive::getArchive(ARCHIVE_GOB, "DARK.GOB", srcPath);
-
-		s_readBuffer[0].clear();
-		s_readBuffer[1].clear();
-		if (archiveMod || archiveBase)
-		{
-			if (archiveMod && archiveMod->fileExists("wait.bm") && archiveMod->openFile("wait.bm"))
-			{
-				s_readBuffer[0].resize(archiveMod->getFileLength());
-				archiveMod->readFile(s_readBuffer[0].data(), archiveMod->getFileLength());
-				archiveMod->closeFile();
-			}
-			else if (archiveTex->openFile("wait.bm"))
-			{
-				s_readBuffer[0].resize(archiveTex->getFileLength());
-				archiveTex->readFile(s_readBuffer[0].data(), archiveTex->getFileLength());
-				archiveTex->closeFile();
-			}
-
-			if (archiveMod && archiveMod->fileExists("wait.pal") && archiveMod->openFile("wait.pal"))
-			{
-				s_readBuffer[1].resize(archiveMod->getFileLength());
-				archiveMod->readFile(s_readBuffer[1].data(), archiveMod->getFileLength());
-				archiveMod->closeFile();
-			}
-			else if (archiveBase->openFile("wait.pal"))
-			{
-				s_readBuffer[1].resize(archiveBase->getFileLength());
-				archiveBase->readFile(s_readBuffer[1].data(), archiveBase->getFileLength());
-				archiveBase->closeFile();
-			}
-		}
-
-		if (!s_readBuffer[0].empty() && !s_readBuffer[1].empty())
+		else if (gobArchive.open(modPath))
 		{
-			TextureData* imageData = bitmap_loadFromMemory(s_readBuffer[0].data(), s_readBuffer[0].size(), 1);
-			u32 palette[256];
-			convertPalette(s_readBuffer[1].data(), palette);
-			createTexture(imageData, palette, poster, MAG_FILTER_LINEAR);
+			// Use a local archive rather than the shared archive list, which is not thread safe.
+			archiveMod = &gobArchive;
 		}
 
-		if (archiveMod && archiveIsGob)
+		scan->posterData[0].clear();
+		scan->posterData[1].clear();
+		if (archiveMod)
 		{
-			Archive::freeArchive(archiveMod);
+			readArchiveFile(archiveMod, "wait.bm", scan->posterData[0]);
+			readArchiveFile(archiveMod, "wait.pal", scan->posterData[1]);
+			archiveMod->close();
 		}
+		scan->posterType = POSTER_BM;
+		free(gobBuffer);
 	}
 }
\ No newline at end of file
@@ -18,6 +18,8 @@ extern MemoryRegion* s_levelRegion;
 #define level_realloc(ptr, size) TFE_Memory::region_realloc(s_levelRegion, ptr, size)
 #define level_free(ptr) TFE_Memory::region_free(s_levelRegion, ptr)
 
+typedef bool(*RestoreRegionsFunc)(Stream* stream);
+
 struct IGame
 {
 	virtual bool runGame(s32 argCount, const char* argv[], Stream* stream) = 0;
@@ -27,6 +29,9 @@ struct IGame
 	virtual void restartMusic() = 0;
 	virtual void loopGame() {};
 	virtual bool serializeGameState(Stream* stream, const char* filename, bool writeState) { return false; };
+	// Copy the game state that lives outside of the memory regions, for save states restored in place within the same level.
+	// When reading, 'restoreRegions' is called to restore the regions once nothing else is reading them.
+	virtual bool serializeStateInPlace(Stream* stream, bool writeState, RestoreRegionsFunc restoreRegions = nullptr) { return false; };
 	virtual bool canSave() { return false; }
 	virtual bool isPaused() { return false; }
 	virtual void getLevelName(char* name) {};
@@ -0,0 +1,308 @@
+#include "rewind.h"
+#include "saveSystem.h"
+#include <TFE_System/system.h>
+#include <TFE_FrontEndUI/console.h>
+#include <TFE_FileSystem/memorystream.h>
+#include <algorithm>
+
+using namespace TFE_Memory;
+
+namespace TFE_Rewind
+{
+	enum RewindConst
+	{
+		REWIND_MAX_SNAPSHOTS = 1024,
+	};
+
+	// The game and level regions are tracked by page, each capture writes the difference to the old contents of the pages that
+	// changed since the previous capture into the undo data of the previous snapshot. A snapshot is reached by reverting the regions to the
+	// newest capture and then undoing the changes of each newer snapshot, so no snapshot depends on an older one.
+	struct Snapshot
+	{
+		MemoryStream state;		// Game state outside of the memory regions.
+		MemoryStream undo;		// Region pages as they were at this snapshot, for the pages changed by the next one.
+	};
+
+	struct RewindStats
+	{
+		f64 lastCaptureMs;
+		f64 maxCaptureMs;
+		f64 totalCaptureMs;
+		f64 lastRestoreMs;
+		size_t lastPageBytes;
+		u32 captureCount;
+	};
+
+	// Settings.
+	static bool s_enable = false;
+	static f32  s_interval = 1.0f;
+	static s32  s_budgetMB = 64;
+
+	// Ring of snapshots, oldest first.
+	static Snapshot s_snapshots[REWIND_MAX_SNAPSHOTS];
+	static s32 s_head = 0;
+	static s32 s_count = 0;
+	static size_t s_memoryUsed = 0;
+	// Region generations the snapshots were captured with.
+	static u32 s_gameGen = 0;
+	static u32 s_levelGen = 0;
+	static u64 s_lastCapture = 0;
+	// Snapshot to restore on the next update, or -1.
+	static s32 s_restoreTarget = -1;
+
+	static MemoryStream s_firstPages;
+	static RewindStats s_stats = {};
+
+	void console_rewind(const ConsoleArgList& args);
+	void console_rewindStats(const ConsoleArgList& args);
+
+	void init()
+	{
+		CVAR_BOOL(s_enable, "d_rewindEnable", CVFLAG_DO_NOT_SERIALIZE, "Periodically capture the game state so it can be rewound.");
+		CVAR_FLOAT(s_interval, "d_rewindInterval", CVFLAG_DO_NOT_SERIALIZE, "Time between rewind snapshots, in seconds.");
+		CVAR_INT(s_budgetMB, "d_rewindBudgetMB", CVFLAG_DO_NOT_SERIALIZE, "Memory budget for rewind snapshots, in megabytes.");
+		CCMD("rewind", console_rewind, 0, "Rewind the game - rewind [steps], where steps is the number of snapshots to go back (default 1).");
+		CCMD("rewindStats", console_rewindStats, 0, "Display rewind buffer memory and timing statistics.");
+	}
+
+	void destroy()
+	{
+		clear();
+	}
+
+	void clear()
+	{
+		for (s32 i = 0; i < REWIND_MAX_SNAPSHOTS; i++)
+		{
+			s_snapshots[i].state.release();
+			s_snapshots[i].undo.release();
+		}
+		s_firstPages.release();
+		s_head = 0;
+		s_count = 0;
+		s_memoryUsed = 0;
+		s_restoreTarget = -1;
+		s_stats = {};
+
+		// The page copies are only needed while there are snapshots to go back to.
+		if (s_gameRegion)  { region_clearPageTracking(s_gameRegion); }
+		if (s_levelRegion) { region_clearPageTracking(s_levelRegion); }
+	}
+
+	s32 getSnapshotCount()
+	{
+		return s_count;
+	}
+
+	// The page copies the regions keep to find their changes, counted against the budget along with the snapshots.
+	size_t getPageTrackingSize()
+	{
+		size_t size = 0;
+		if (s_gameRegion)  { size += region_getPageTrackingSize(s_gameRegion); }
+		if (s_levelRegion) { size += region_getPageTrackingSize(s_levelRegion); }
+		return size;
+	}
+
+	size_t getMemoryUsed()
+	{
+		return s_memoryUsed + getPageTrackingSize();
+	}
+
+	Snapshot* getSnapshot(s32 index)
+	{
+		return &s_snapshots[(s_head + index) % REWIND_MAX_SNAPSHOTS];
+	}
+
+	////////////////////////////////////////////
+	// Ring management
+	////////////////////////////////////////////
+	void freeSnapshot(Snapshot* snapshot)
+	{
+		s_memoryUsed -= snapshot->state.getSize() + snapshot->undo.getSize();
+		snapshot->state.release();
+		snapshot->undo.release();
+	}
+
+	// The oldest snapshot is only needed to go back to itself, so it can be dropped on its own.
+	void evictOldest()
+	{
+		freeSnapshot(getSnapshot(0));
+		s_head = (s_head + 1) % REWIND_MAX_SNAPSHOTS;
+		s_count--;
+	}
+
+	bool levelChanged()
+	{
+		return region_getGeneration(s_gameRegion) != s_gameGen || region_getGeneration(s_levelRegion) != s_levelGen;
+	}
+
+	void capture()
+	{
+		const u64 start = TFE_System::getCurrentTimeInTicks();
+		// The regions are cleared when a level is loaded, snapshots from before can no longer be restored.
+		if (s_count && levelChanged())
+		{
+			clear();
+		}
+		if (s_count == REWIND_MAX_SNAPSHOTS)
+		{
+			evictOldest();
+		}
+
+		Snapshot* snapshot = getSnapshot(s_count);
+		if (!TFE_SaveSystem::captureGameState(&snapshot->state))
+		{
+			snapshot->state.release();
+			return;
+		}
+
+		// The pages changed since the last capture are written to the previous snapshot, the first capture only copies the regions.
+		MemoryStream* undo = s_count ? &getSnapshot(s_count - 1)->undo : &s_firstPages;
+		undo->clear();
+		undo->open(Stream::MODE_WRITE);
+		bool ret = region_capturePageChanges(s_gameRegion, undo) && region_capturePageChanges(s_levelRegion, undo);
+		undo->close();
+		if (!ret)
+		{
+			clear();
+			return;
+		}
+		s_firstPages.release();
+
+		s_gameGen = region_getGeneration(s_gameRegion);
+		s_levelGen = region_getGeneration(s_levelRegion);
+		s_count++;
+		s_memoryUsed += snapshot->state.getSize() + (s_count > 1 ? undo->getSize() : 0);
+
+		// Stay within the budget, but always keep the newest snapshot.
+		const size_t budget = size_t(std::max(s_budgetMB, 1)) * 1024 * 1024;
+		const size_t pageTracking = getPageTrackingSize();
+		if (pageTracking >= budget)
+		{
+			char msg[256];
+			sprintf(msg, "Rewind disabled, the region page copies need %zu MB which does not fit in d_rewindBudgetMB.", (pageTracking + 1024 * 1024 - 1) / (1024 * 1024));
+			TFE_Console::addToHistory(msg);
+			s_enable = false;
+			clear();
+			return;
+		}
+		while (s_memoryUsed + pageTracking > budget && s_count > 1)
+		{
+			evictOldest();
+		}
+
+		const f64 captureMs = TFE_System::convertFromTicksToSeconds(TFE_System::getCurrentTimeInTicks() - start) * 1000.0;
+		s_stats.lastCaptureMs = captureMs;
+		s_stats.maxCaptureMs = std::max(s_stats.maxCaptureMs, captureMs);
+		s_stats.totalCaptureMs += captureMs;
+		s_stats.lastPageBytes = s_count > 1 ? undo->getSize() : 0;
+		s_stats.captureCount++;
+	}
+
+	////////////////////////////////////////////
+	// Restore
+	////////////////////////////////////////////
+	// Called by the game once the audio is stopped, the stream is the snapshot game state and is not read here.
+	bool restoreRegions(Stream* stream)
+	{
+		region_revertToCapture(s_gameRegion);
+		region_revertToCapture(s_levelRegion);
+		for (s32 i = s_count - 2; i >= s_restoreTarget; i--)
+		{
+			MemoryStream* undo = &getSnapshot(i)->undo;
+			undo->open(Stream::MODE_READ);
+			bool ret = region_undoPageChanges(s_gameRegion, undo) && region_undoPageChanges(s_levelRegion, undo);
+			undo->close();
+			if (!ret) { return false; }
+		}
+		return true;
+	}
+
+	void restore()
+	{
+		// A level may have been loaded since the request was made.
+		if (levelChanged())
+		{
+			clear();
+			TFE_Console::addToHistory("Cannot rewind, the level has changed.");
+			return;
+		}
+
+		const u64 start = TFE_System::getCurrentTimeInTicks();
+		const s32 target = s_restoreTarget;
+		if (!TFE_SaveSystem::restoreGameState(&getSnapshot(target)->state, restoreRegions))
+		{
+			clear();
+			TFE_Console::addToHistory("Failed to rewind, the rewind buffer has been cleared.");
+			return;
+		}
+		s_restoreTarget = -1;
+
+		// Discard the "future", the regions now match the restored snapshot which becomes the newest.
+		while (s_count > target + 1)
+		{
+			freeSnapshot(getSnapshot(s_count - 1));
+			s_count--;
+		}
+		Snapshot* snapshot = getSnapshot(target);
+		s_memoryUsed -= snapshot->undo.getSize();
+		snapshot->undo.release();
+
+		s_lastCapture = TFE_System::getCurrentTimeInTicks();
+		s_stats.lastRestoreMs = TFE_System::convertFromTicksToSeconds(s_lastCapture - start) * 1000.0;
+	}
+
+	void update()
+	{
+		// Rewinding is requested from the console during the frame and applied here, between frames.
+		if (s_restoreTarget >= 0)
+		{
+			restore();
+			return;
+		}
+		if (!s_enable) { return; }
+
+		const u64 now = TFE_System::getCurrentTimeInTicks();
+		if (TFE_System::convertFromTicksToSeconds(now - s_lastCapture) < s_interval)
+		{
+			return;
+		}
+		s_lastCapture = now;
+		capture();
+	}
+
+	bool rewind(s32 steps)
+	{
+		if (steps < 1 || steps > s_count)
+		{
+			return false;
+		}
+		s_restoreTarget = s_count - steps;
+		return true;
+	}
+
+	void console_rewind(const ConsoleArgList& args)
+	{
+		s32 steps = args.size() > 1 ? atoi(args[1].c_str()) : 1;
+		if (!rewind(steps))
+		{
+			char msg[256];
+			sprintf(msg, "Cannot rewind %d steps, %d snapshots available.", steps, s_count);
+			TFE_Console::addToHistory(msg);
+		}
+	}
+
+	void console_rewindStats(const ConsoleArgList& args)
+	{
+		char msg[256];
+		sprintf(msg, "Snapshots: %d, Memory: %zu KB, Budget: %d MB", s_count, getMemoryUsed() / 1024, s_budgetMB);
+		TFE_Console::addToHistory(msg);
+		sprintf(msg, "Page copies: %zu KB, last changed pages: %zu KB", getPageTrackingSize() / 1024, s_stats.lastPageBytes / 1024);
+		TFE_Console::addToHistory(msg);
+		sprintf(msg, "Capture: last %0.3f ms, max %0.3f ms, avg %0.3f ms", s_stats.lastCaptureMs, s_stats.maxCaptureMs,
+			s_stats.captureCount ? s_stats.totalCaptureMs / f64(s_stats.captureCount) : 0.0);
+		TFE_Console::addToHistory(msg);
+		sprintf(msg, "Restore: last %0.3f ms", s_stats.lastRestoreMs);
+		TFE_Console::addToHistory(msg);
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Rewind Buffer
+// Periodically captures the game state into a ring of snapshots so
+// that play can be rewound to an earlier point. Only the memory pages
+// of the game and level regions that changed between snapshots are
+// stored, and snapshots are restored in place between frames. The
+// ring is bounded by a memory budget.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+
+namespace TFE_Rewind
+{
+	void init();
+	void destroy();
+	// Call once per frame while in game.
+	void update();
+	// Discard all snapshots, such as when the game changes.
+	void clear();
+
+	// Restore the game to the snapshot 'steps' captures ago, where 1 is the most recent snapshot.
+	// Snapshots newer than the restored one are discarded.
+	bool rewind(s32 steps);
+	s32  getSnapshotCount();
+	// Memory used by the snapshots and the region page copies, which is kept within d_rewindBudgetMB.
+	size_t getMemoryUsed();
+}
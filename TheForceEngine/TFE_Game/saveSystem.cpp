@@ -1,29 +1,48 @@
 #include "saveSystem.h"
+#include "rewind.h"
 #include <TFE_Input/inputMapping.h>
 #include <TFE_System/system.h>
+#include <TFE_FrontEndUI/console.h>
 #include <TFE_Settings/gameSourceData.h>
 #include <TFE_FileSystem/fileutil.h>
+#include <TFE_FileSystem/memorystream.h>
 
 #include <TFE_RenderBackend/renderBackend.h>
 #include <TFE_Asset/imageAsset.h>
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include <TFE_Archive/zip/miniz.h>
+#include <SDL_thread.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
 using namespace TFE_Input;
+using namespace TFE_Memory;
 
 namespace TFE_SaveSystem
 {
+	static const char* c_saveIndexName = "saves.idx";
+
 	enum SaveRequest
 	{
 		SF_REQ_NONE = 0,
 		SF_REQ_SAVE,
 		SF_REQ_LOAD,
+		SF_REQ_RESTORE,
 	};
 
 	enum SaveMasterVersion
 	{
 		SVER_INIT = 1,
-		SVER_CUR = SVER_INIT
+		SVER_COMPRESSED,	// Game state is compressed and follows the header.
+		SVER_CUR = SVER_COMPRESSED
+	};
+
+	enum SaveIndexVersion
+	{
+		SIDX_INIT = 1,
+		SIDX_CUR = SIDX_INIT
 	};
 
 	static SaveRequest s_req = SF_REQ_NONE;
@@ -32,76 +51,295 @@ namespace TFE_SaveSystem
 	static char s_gameSavePath[TFE_MAX_PATH];
 	static IGame* s_game = nullptr;
 	static s32 s_saveDelay = 0;
+	static MemoryStream* s_reqState = nullptr;
+	static GameID s_saveStateGame = Game_Count;
 
 	static u32* s_imageBuffer[2] = { nullptr, nullptr };
 	static size_t s_imageBufferSize[2] = { 0 };
 
-	void saveHeader(Stream* stream, const char* saveName)
+	// Everything required to write a save file, captured on the main thread and then
+	// compressed and written to disk on the save thread.
+	struct SaveJob
+	{
+		char filePath[TFE_MAX_PATH];
+		char saveName[SAVE_MAX_NAME_LEN];
+		char dateTime[256];
+		char levelName[256];
+		char modList[256];
+
+		u32 imageWidth;
+		u32 imageHeight;
+		std::vector<u32> image;
+		std::vector<u8>  png;
+		std::vector<u8>  compressed;
+		// Uncompressed game state.
+		MemoryStream state;
+		// Index entry, filled in once the file has been written.
+		SaveHeader header;
+		// True if 'state' matches the file on disk, which allows it to be loaded without reading the file.
+		bool stateOnDisk;
+	};
+	struct SaveState
+	{
+		MemoryStream state;
+		bool valid;
+	};
+	static SaveJob s_saveJob;
+	static SDL_Thread* s_saveThread = nullptr;
+	static SaveState s_saveStates[SAVE_STATE_COUNT];
+	static MemoryStream s_loadState;
+	static std::vector<u8> s_loadCompressed;
+
+	// Save headers for the current save directory, kept in sync with the index file.
+	static std::vector<SaveHeader> s_saveIndex;
+	static bool s_saveIndexLoaded = false;
+	static bool s_saveIndexDirty = false;
+
+	void updateIndexEntry(const SaveHeader* header);
+
+	void captureHeader(SaveJob* job, const char* saveName)
 	{
-		// Generate a screenshot.
+		// Generate a screenshot, the image is scaled and compressed on the save thread.
 		DisplayInfo displayInfo;
 		TFE_RenderBackend::getDisplayInfo(&displayInfo);
-		size_t size = displayInfo.width * displayInfo.height * 4;
-		if (size > s_imageBufferSize[0])
-		{
-			s_imageBuffer[0] = (u32*)realloc(s_imageBuffer[0], size);
-			s_imageBufferSize[0] = size;
-		}
-		TFE_RenderBackend::captureScreenToMemory(s_imageBuffer[0]);
-		// Save to memory.
-		u8* png = (u8*)malloc(SAVE_IMAGE_WIDTH * SAVE_IMAGE_HEIGHT * 4);
-		u32 pngSize = 0;
-		if (png)
-		{
-			pngSize = (u32)TFE_Image::writeImageToMemory(png, displayInfo.width, displayInfo.height,
-								 SAVE_IMAGE_WIDTH, SAVE_IMAGE_HEIGHT,
-								 s_imageBuffer[0]);
-		}
-		else
-		{
-			pngSize = 0;
-			png = (u8*)s_imageBuffer[0];
-		}
+		job->imageWidth  = displayInfo.width;
+		job->imageHeight = displayInfo.height;
+		job->image.resize(displayInfo.width * displayInfo.height);
+		TFE_RenderBackend::captureScreenToMemory(job->image.data());
+
+		// Save Name.
+		size_t saveNameLen = strlen(saveName);
+		if (saveNameLen > SAVE_MAX_NAME_LEN - 1) { saveNameLen = SAVE_MAX_NAME_LEN - 1; }
+		memcpy(job->saveName, saveName, saveNameLen);
+		job->saveName[saveNameLen] = 0;
+
+		// Time and Date of Save.
+		TFE_System::getDateTimeString(job->dateTime);
+		// Level Name
+		s_game->getLevelName(job->levelName);
+		// Mod List
+		s_game->getModList(job->modList);
+	}
+
+	void writeHeader(Stream* stream, SaveJob* job)
+	{
+		// Compress the screenshot.
+		job->png.resize(SAVE_IMAGE_WIDTH * SAVE_IMAGE_HEIGHT * 4);
+		u32 pngSize = (u32)TFE_Image::writeImageToMemory(job->png.data(), job->imageWidth, job->imageHeight,
+			SAVE_IMAGE_WIDTH, SAVE_IMAGE_HEIGHT, job->image.data());
 
 		// Master version.
 		u32 version = SVER_CUR;
 		stream->write(&version);
 
 		// Save Name.
-		size_t saveNameLen = strlen(saveName);
-		if (saveNameLen > SAVE_MAX_NAME_LEN - 1) { saveNameLen = SAVE_MAX_NAME_LEN - 1; }
-		u8 len = (u8)saveNameLen;
+		u8 len = (u8)strlen(job->saveName);
 		stream->write(&len);
-		stream->writeBuffer(saveName, len);
+		stream->writeBuffer(job->saveName, len);
 
 		// Time and Date of Save.
-		char timeDate[256];
-		TFE_System::getDateTimeString(timeDate);
-		len = (u8)strlen(timeDate);
+		len = (u8)strlen(job->dateTime);
 		stream->write(&len);
-		stream->writeBuffer(timeDate, len);
+		stream->writeBuffer(job->dateTime, len);
 
 		// Level Name
-		char levelName[256];
-		s_game->getLevelName(levelName);
-		len = (u8)strlen(levelName);
+		len = (u8)strlen(job->levelName);
 		stream->write(&len);
-		stream->writeBuffer(levelName, len);
+		stream->writeBuffer(job->levelName, len);
 
 		// Mod List
-		char modList[256];
-		s_game->getModList(modList);
-		len = (u8)strlen(modList);
+		len = (u8)strlen(job->modList);
 		stream->write(&len);
-		stream->writeBuffer(modList, len);
+		stream->writeBuffer(job->modList, len);
 
 		// Image.
 		stream->write(&pngSize);
-		stream->writeBuffer(png, pngSize);
-		free(png);
+		job->header.imageOffset = (u32)stream->getLoc();
+		job->header.imageSize = pngSize;
+		stream->writeBuffer(job->png.data(), pngSize);
+	}
+
+	// Compress the serialized game state and write the save file.
+	s32 SDLCALL saveThreadFunc(void* userData)
+	{
+		SaveJob* job = (SaveJob*)userData;
+
+		const u32 stateSize = (u32)job->state.getSize();
+		mz_ulong compressedSize = mz_compressBound(stateSize);
+		job->compressed.resize(compressedSize);
+		if (mz_compress2(job->compressed.data(), &compressedSize, (const u8*)job->state.data(), stateSize, MZ_DEFAULT_LEVEL) != MZ_OK)
+		{
+			TFE_System::logWrite(LOG_ERROR, "Save", "Failed to compress save game '%s'.", job->filePath);
+			return 0;
+		}
+
+		FileStream file;
+		if (!file.open(job->filePath, Stream::MODE_WRITE))
+		{
+			TFE_System::logWrite(LOG_ERROR, "Save", "Cannot open save game '%s' for writing.", job->filePath);
+			return 0;
+		}
+		writeHeader(&file, job);
+
+		const u32 size = (u32)compressedSize;
+		file.write(&stateSize);
+		file.write(&size);
+		file.writeBuffer(job->compressed.data(), size);
+		file.close();
+
+		// Fill in the rest of the index entry.
+		SaveHeader* header = &job->header;
+		FileUtil::getFileNameFromPath(job->filePath, header->fileName, true);
+		strcpy(header->saveName, job->saveName);
+		if (header->saveName[0] == 0 || header->saveName[0] == ' ')
+		{
+			FileUtil::getFileNameFromPath(job->filePath, header->saveName);
+		}
+		strcpy(header->dateTime, job->dateTime);
+		strcpy(header->levelName, job->levelName);
+		strcpy(header->modNames, job->modList);
+		header->modifiedTime = FileUtil::getModifiedTime(job->filePath);
+		return 1;
+	}
+
+	// Wait for the previous save to finish writing to disk.
+	void waitForSave()
+	{
+		if (s_saveThread)
+		{
+			s32 result = 0;
+			SDL_WaitThread(s_saveThread, &result);
+			s_saveThread = nullptr;
+			s_saveJob.stateOnDisk = result != 0;
+			if (result)
+			{
+				updateIndexEntry(&s_saveJob.header);
+			}
+		}
 	}
 
-	void loadHeader(Stream* stream, SaveHeader* header, const char* fileName)
+	void writeIndexString(Stream* stream, const char* str)
+	{
+		u8 len = (u8)std::min(strlen(str), size_t(255));
+		stream->write(&len);
+		stream->writeBuffer(str, len);
+	}
+
+	void readIndexString(Stream* stream, char* str, size_t bufferSize)
+	{
+		char tmp[256];
+		u8 len;
+		stream->read(&len);
+		stream->readBuffer(tmp, len);
+		tmp[len] = 0;
+
+		strncpy(str, tmp, bufferSize - 1);
+		str[bufferSize - 1] = 0;
+	}
+
+	void loadSaveIndex()
+	{
+		if (s_saveIndexLoaded) { return; }
+		s_saveIndexLoaded = true;
+		s_saveIndexDirty = false;
+		s_saveIndex.clear();
+
+		char indexPath[TFE_MAX_PATH];
+		sprintf(indexPath, "%s%s", s_gameSavePath, c_saveIndexName);
+		FileStream stream;
+		if (!stream.open(indexPath, Stream::MODE_READ))
+		{
+			return;
+		}
+
+		u32 version = 0, count = 0;
+		stream.read(&version);
+		stream.read(&count);
+		// Rebuild the index from the save files if the version changed.
+		if (version != SIDX_CUR)
+		{
+			stream.close();
+			return;
+		}
+
+		s_saveIndex.resize(count);
+		SaveHeader* header = s_saveIndex.data();
+		for (u32 i = 0; i < count; i++, header++)
+		{
+			readIndexString(&stream, header->fileName, sizeof(header->fileName));
+			readIndexString(&stream, header->saveName, sizeof(header->saveName));
+			readIndexString(&stream, header->dateTime, sizeof(header->dateTime));
+			readIndexString(&stream, header->levelName, sizeof(header->levelName));
+			readIndexString(&stream, header->modNames, sizeof(header->modNames));
+			stream.read(&header->modifiedTime);
+			stream.read(&header->imageOffset);
+			stream.read(&header->imageSize);
+		}
+		stream.close();
+	}
+
+	void writeSaveIndex()
+	{
+		char indexPath[TFE_MAX_PATH];
+		sprintf(indexPath, "%s%s", s_gameSavePath, c_saveIndexName);
+		FileStream stream;
+		if (!stream.open(indexPath, Stream::MODE_WRITE))
+		{
+			TFE_System::logWrite(LOG_WARNING, "Save", "Cannot write the save index '%s'.", indexPath);
+			return;
+		}
+
+		const u32 version = SIDX_CUR;
+		const u32 count = (u32)s_saveIndex.size();
+		stream.write(&version);
+		stream.write(&count);
+
+		const SaveHeader* header = s_saveIndex.data();
+		for (u32 i = 0; i < count; i++, header++)
+		{
+			writeIndexString(&stream, header->fileName);
+			writeIndexString(&stream, header->saveName);
+			writeIndexString(&stream, header->dateTime);
+			writeIndexString(&stream, header->levelName);
+			writeIndexString(&stream, header->modNames);
+			stream.write(&header->modifiedTime);
+			stream.write(&header->imageOffset);
+			stream.write(&header->imageSize);
+		}
+		stream.close();
+		s_saveIndexDirty = false;
+	}
+
+	SaveHeader* findIndexEntry(const char* fileName)
+	{
+		const size_t count = s_saveIndex.size();
+		SaveHeader* header = s_saveIndex.data();
+		for (size_t i = 0; i < count; i++, header++)
+		{
+			if (strcmp(header->fileName, fileName) == 0)
+			{
+				return header;
+			}
+		}
+		return nullptr;
+	}
+
+	void updateIndexEntry(const SaveHeader* header)
+	{
+		loadSaveIndex();
+		SaveHeader* entry = findIndexEntry(header->fileName);
+		if (entry)
+		{
+			*entry = *header;
+		}
+		else
+		{
+			s_saveIndex.push_back(*header);
+		}
+		s_saveIndexDirty = true;
+	}
+
+	u32 loadHeader(Stream* stream, SaveHeader* header, const char* fileName)
 	{
 		// Master version.
 		u32 version;
@@ -136,48 +374,90 @@ namespace TFE_SaveSystem
 		stream->readBuffer(header->modNames, len);
 		header->modNames[len] = 0;
 
-		// Image, re-use buffer 0 for the PNG.
+		// Image, this is skipped and only decoded when requested.
 		u32 pngSize;
 		stream->read(&pngSize);
-		if (pngSize > s_imageBufferSize[0])
-		{
-			s_imageBuffer[0] = (u32*)realloc(s_imageBuffer[0], pngSize);
-			s_imageBufferSize[0] = pngSize;
-		}
-		stream->readBuffer(s_imageBuffer[0], pngSize);
-
-		SDL_Surface* image;
-		TFE_Image::readImageFromMemory(&image, pngSize, s_imageBuffer[0]);
-		if (image)
-		{
-			const u32 sz = SAVE_IMAGE_WIDTH * SAVE_IMAGE_HEIGHT * sizeof(u32);
-			memcpy(header->imageData, image->pixels, sz);
-			TFE_Image::free(image);
-		}
+		header->imageOffset = (u32)stream->getLoc();
+		header->imageSize = pngSize;
+		stream->seek(pngSize, Stream::ORIGIN_CURRENT);
+		return version;
 	}
 
 	void populateSaveDirectory(std::vector<SaveHeader>& dir)
 	{
+		// Make sure the latest save is on disk.
+		waitForSave();
+		loadSaveIndex();
+
 		dir.clear();
 		FileList fileList;
 		FileUtil::readDirectory(s_gameSavePath, "tfe", fileList);
 		size_t saveCount = fileList.size();
-		dir.resize(saveCount);
+		dir.reserve(saveCount);
 
 		const std::string* filenames = fileList.data();
-		SaveHeader* headers = dir.data();
 		for (size_t i = 0; i < saveCount; i++)
 		{
-			loadGameHeader(filenames[i].c_str(), &headers[i]);
+			// Only read the header from the file if the save has changed since it was indexed.
+			char filePath[TFE_MAX_PATH];
+			sprintf(filePath, "%s%s", s_gameSavePath, filenames[i].c_str());
+			const SaveHeader* entry = findIndexEntry(filenames[i].c_str());
+			if (entry && entry->modifiedTime == FileUtil::getModifiedTime(filePath))
+			{
+				dir.push_back(*entry);
+				continue;
+			}
+
+			SaveHeader header;
+			if (loadGameHeader(filenames[i].c_str(), &header))
+			{
+				dir.push_back(header);
+				s_saveIndexDirty = true;
+			}
+		}
+
+		// Saves that were deleted are dropped from the index.
+		if (s_saveIndexDirty || dir.size() != s_saveIndex.size())
+		{
+			s_saveIndex = dir;
+			writeSaveIndex();
+		}
+	}
+
+	void console_saveState(const ConsoleArgList& args)
+	{
+		s32 slot = args.size() > 1 ? atoi(args[1].c_str()) : 0;
+		if (!captureSaveState(slot))
+		{
+			TFE_Console::addToHistory("Cannot capture save state.");
+		}
+	}
+
+	void console_loadState(const ConsoleArgList& args)
+	{
+		s32 slot = args.size() > 1 ? atoi(args[1].c_str()) : 0;
+		if (!postRestoreStateRequest(slot))
+		{
+			TFE_Console::addToHistory("Save state slot is empty.");
 		}
 	}
 
 	void init()
 	{
+		CCMD("saveState", console_saveState, 0, "Capture the game state in memory - saveState [slot], slot = 0 to 7.");
+		CCMD("loadState", console_loadState, 0, "Restore a game state captured with saveState - loadState [slot], slot = 0 to 7.");
 	}
 
 	void destroy()
 	{
+		waitForSave();
+		clearSaveStates();
+		if (s_saveIndexDirty)
+		{
+			writeSaveIndex();
+		}
+		s_saveIndex.clear();
+		s_saveIndexLoaded = false;
 		for (s32 i = 0; i < 2; i++)
 		{
 			free(s_imageBuffer[i]);
@@ -188,33 +468,108 @@ namespace TFE_SaveSystem
 
 	bool saveGame(const char* filename, const char* saveName)
 	{
-		char filePath[TFE_MAX_PATH];
-		sprintf(filePath, "%s%s", s_gameSavePath, filename);
+		// Only one save is in flight at a time, so the job can be reused.
+		waitForSave();
+
+		SaveJob* job = &s_saveJob;
+		sprintf(job->filePath, "%s%s", s_gameSavePath, filename);
+		captureHeader(job, saveName);
+
+		// Serialize into memory, compression and file IO are handled on the save thread.
+		job->stateOnDisk = false;
+		job->state.clear();
+		job->state.open(Stream::MODE_WRITE);
+		bool ret = s_game->serializeGameState(&job->state, filename, true);
+		job->state.close();
+		if (!ret) { return false; }
+
+		s_saveThread = SDL_CreateThread(saveThreadFunc, "TFE_SaveThread", job);
+		if (!s_saveThread)
+		{
+			TFE_System::logWrite(LOG_WARNING, "Save", "Cannot create save thread, writing '%s' on the main thread.", job->filePath);
+			ret = saveThreadFunc(job) != 0;
+		}
+		return ret;
+	}
 
-		bool ret = false;
-		FileStream stream;
-		if (stream.open(filePath, Stream::MODE_WRITE))
+	static bool restoreRegions(Stream* stream)
+	{
+		return region_restoreFromDisk(s_gameRegion, stream) && region_restoreFromDisk(s_levelRegion, stream);
+	}
+
+	bool restoreState(MemoryStream* stream)
+	{
+		const u64 start = TFE_System::getCurrentTimeInTicks();
+		stream->open(Stream::MODE_READ);
+		// The level region is cleared on every level load, which changes its generation.
+		u32 generation[2];
+		stream->readBuffer(generation, sizeof(generation));
+		if (generation[0] != region_getGeneration(s_gameRegion) || generation[1] != region_getGeneration(s_levelRegion))
 		{
-			saveHeader(&stream, saveName);
-			ret = s_game->serializeGameState(&stream, filename, true);
-			stream.close();
+			stream->close();
+			TFE_System::logWrite(LOG_WARNING, "Save", "Cannot restore a save state captured in another level.");
+			return false;
 		}
+		bool ret = s_game->serializeStateInPlace(stream, false, restoreRegions);
+		stream->close();
+		if (!ret) { return false; }
+
+		const f64 delta = TFE_System::convertFromTicksToSeconds(TFE_System::getCurrentTimeInTicks() - start);
+		TFE_System::logWrite(LOG_MSG, "Save", "Restored state (%zu bytes) in %0.3f ms.", stream->getSize(), delta * 1000.0);
 		return ret;
 	}
 
 	bool loadGame(const char* filename)
 	{
+		// Don't read the file while it is still being written.
+		waitForSave();
+
 		char filePath[TFE_MAX_PATH];
 		sprintf(filePath, "%s%s", s_gameSavePath, filename);
 
+		// If this is the most recent save and it hasn't changed on disk, the state is still in memory.
+		SaveJob* job = &s_saveJob;
+		if (job->stateOnDisk && strcmp(job->header.fileName, filename) == 0 && job->header.modifiedTime == FileUtil::getModifiedTime(filePath))
+		{
+			job->state.open(Stream::MODE_READ);
+			bool ret = s_game->serializeGameState(&job->state, filename, false);
+			job->state.close();
+			return ret;
+		}
+
 		bool ret = false;
 		FileStream stream;
 		if (stream.open(filePath, Stream::MODE_READ))
 		{
 			SaveHeader header;
-			loadHeader(&stream, &header, filename);
-			ret = s_game->serializeGameState(&stream, filename, false);
-			stream.close();
+			const u32 version = loadHeader(&stream, &header, filename);
+			if (version >= SVER_COMPRESSED)
+			{
+				u32 stateSize, compressedSize;
+				stream.read(&stateSize);
+				stream.read(&compressedSize);
+				s_loadCompressed.resize(compressedSize);
+				stream.readBuffer(s_loadCompressed.data(), compressedSize);
+				stream.close();
+
+				mz_ulong size = stateSize;
+				if (s_loadState.allocate(stateSize) &&
+					mz_uncompress((u8*)s_loadState.data(), &size, s_loadCompressed.data(), compressedSize) == MZ_OK && size == stateSize)
+				{
+					s_loadState.open(Stream::MODE_READ);
+					ret = s_game->serializeGameState(&s_loadState, filename, false);
+					s_loadState.close();
+				}
+				else
+				{
+					TFE_System::logWrite(LOG_ERROR, "Save", "Failed to decompress save game '%s'.", filePath);
+				}
+			}
+			else
+			{
+				ret = s_game->serializeGameState(&stream, filename, false);
+				stream.close();
+			}
 		}
 		return ret;
 	}
@@ -231,17 +586,152 @@ namespace TFE_SaveSystem
 			loadHeader(&stream, header, filename);
 			strcpy(header->fileName, filename);
 			stream.close();
+			header->modifiedTime = FileUtil::getModifiedTime(filePath);
 			ret = true;
 		}
 		return ret;
 	}
+
+	bool loadSaveImage(const SaveHeader* header, u32* imageData)
+	{
+		const u32 sz = SAVE_IMAGE_WIDTH * SAVE_IMAGE_HEIGHT * sizeof(u32);
+		memset(imageData, 0, sz);
+
+		char filePath[TFE_MAX_PATH];
+		sprintf(filePath, "%s%s", s_gameSavePath, header->fileName);
+		FileStream stream;
+		if (!header->imageSize || !stream.open(filePath, Stream::MODE_READ))
+		{
+			return false;
+		}
+
+		// Re-use buffer 0 for the PNG.
+		const u32 pngSize = header->imageSize;
+		if (pngSize > s_imageBufferSize[0])
+		{
+			s_imageBuffer[0] = (u32*)realloc(s_imageBuffer[0], pngSize);
+			s_imageBufferSize[0] = pngSize;
+		}
+		stream.seek(header->imageOffset);
+		stream.readBuffer(s_imageBuffer[0], pngSize);
+		stream.close();
+
+		SDL_Surface* image;
+		TFE_Image::readImageFromMemory(&image, pngSize, s_imageBuffer[0]);
+		if (!image)
+		{
+			return false;
+		}
+		memcpy(imageData, image->pixels, sz);
+		TFE_Image::free(image);
+		return true;
+	}
 		
 	void postLoadRequest(const char* filename)
 	{
 		s_req = SF_REQ_LOAD;
+		s_reqState = nullptr;
 		strcpy(s_reqFilename, filename);
 	}
 
+	bool captureState(MemoryStream* stream)
+	{
+		if (!s_game || !s_game->canSave())
+		{
+			return false;
+		}
+
+		stream->clear();
+		stream->open(Stream::MODE_WRITE);
+		const u32 generation[] = { region_getGeneration(s_gameRegion), region_getGeneration(s_levelRegion) };
+		stream->writeBuffer(generation, sizeof(generation));
+		bool ret = region_serializeToDisk(s_gameRegion, stream) && region_serializeToDisk(s_levelRegion, stream);
+		ret = ret && s_game->serializeStateInPlace(stream, true);
+		stream->close();
+		return ret;
+	}
+
+	bool captureGameState(MemoryStream* stream)
+	{
+		if (!s_game || !s_game->canSave())
+		{
+			return false;
+		}
+
+		stream->clear();
+		stream->open(Stream::MODE_WRITE);
+		bool ret = s_game->serializeStateInPlace(stream, true);
+		stream->close();
+		return ret;
+	}
+
+	bool restoreGameState(MemoryStream* stream, RestoreRegionsFunc restoreRegions)
+	{
+		if (!s_game || !stream->getSize())
+		{
+			return false;
+		}
+
+		stream->open(Stream::MODE_READ);
+		bool ret = s_game->serializeStateInPlace(stream, false, restoreRegions);
+		stream->close();
+		return ret;
+	}
+
+	bool postRestoreStateRequest(MemoryStream* stream)
+	{
+		if (!stream || !stream->getSize())
+		{
+			return false;
+		}
+		s_req = SF_REQ_RESTORE;
+		s_reqState = stream;
+		return true;
+	}
+
+	bool captureSaveState(s32 slot)
+	{
+		if (slot < 0 || slot >= SAVE_STATE_COUNT)
+		{
+			return false;
+		}
+
+		const u64 start = TFE_System::getCurrentTimeInTicks();
+		SaveState* saveState = &s_saveStates[slot];
+		saveState->valid = captureState(&saveState->state);
+		if (!saveState->valid)
+		{
+			return false;
+		}
+
+		const f64 delta = TFE_System::convertFromTicksToSeconds(TFE_System::getCurrentTimeInTicks() - start);
+		TFE_System::logWrite(LOG_MSG, "Save", "Captured save state %d (%zu bytes) in %0.3f ms.", slot, saveState->state.getSize(), delta * 1000.0);
+		return saveState->valid;
+	}
+
+	bool postRestoreStateRequest(s32 slot)
+	{
+		if (!hasSaveState(slot))
+		{
+			return false;
+		}
+		return postRestoreStateRequest(&s_saveStates[slot].state);
+	}
+
+	bool hasSaveState(s32 slot)
+	{
+		return slot >= 0 && slot < SAVE_STATE_COUNT && s_saveStates[slot].valid;
+	}
+
+	void clearSaveStates()
+	{
+		for (s32 i = 0; i < SAVE_STATE_COUNT; i++)
+		{
+			s_saveStates[i].state.release();
+			s_saveStates[i].valid = false;
+		}
+	}
+
 	void postSaveRequest(const char* filename, const char* saveName, s32 delay)
 	{
 		s_req = SF_REQ_SAVE;
@@ -285,6 +775,22 @@ namespace TFE_SaveSystem
 
 	void setCurrentGame(GameID id)
 	{
+		// Finish any pending save and index updates before switching directories.
+		waitForSave();
+		if (s_saveIndexDirty)
+		{
+			writeSaveIndex();
+		}
+		s_saveIndex.clear();
+		s_saveIndexLoaded = false;
+		// Save states are only valid for the game they were captured from.
+		if (id != s_saveStateGame)
+		{
+			clearSaveStates();
+			TFE_Rewind::clear();
+			s_saveStateGame = id;
+		}
+
 		char relativeBasePath[TFE_MAX_PATH];
 		TFE_Paths::appendPath(PATH_USER_DOCUMENTS, "Saves/", relativeBasePath);
 		if (!FileUtil::directoryExits(s_gameSavePath))
@@ -312,6 +818,27 @@ namespace TFE_SaveSystem
 	{
 		if (!s_game) { return; }
 
+		// Save states are restored in place between frames, without going through the game's load path.
+		if (s_req == SF_REQ_RESTORE)
+		{
+			s_req = SF_REQ_NONE;
+			MemoryStream* stream = s_reqState;
+			s_reqState = nullptr;
+			if (!restoreState(stream))
+			{
+				// The state belongs to another level, which will not be loaded with the same memory again.
+				for (s32 i = 0; i < SAVE_STATE_COUNT; i++)
+				{
+					if (stream == &s_saveStates[i].state)
+					{
+						s_saveStates[i].state.release();
+						s_saveStates[i].valid = false;
+					}
+				}
+				TFE_Console::addToHistory("Cannot restore the save state.");
+			}
+		}
+
 		static s32 lastState = 0;
 		const char* saveFilename = saveRequestFilename();
 
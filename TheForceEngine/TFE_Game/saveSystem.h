@@ -4,6 +4,7 @@
 //////////////////////////////////////////////////////////////////////
 #include "igame.h"
 #include <TFE_Asset/imageAsset.h>
+#include <TFE_FileSystem/memorystream.h>
 
 namespace TFE_SaveSystem
 {
@@ -13,6 +14,7 @@ namespace TFE_SaveSystem
 		SAVE_MAX_NAME_LEN = 64,
 		SAVE_IMAGE_WIDTH  = 426,
 		SAVE_IMAGE_HEIGHT = 240,
+		SAVE_STATE_COUNT  = 8,
 	};
 	struct SaveHeader
 	{
@@ -21,7 +23,10 @@ namespace TFE_SaveSystem
 		char dateTime[256];
 		char levelName[256];
 		char modNames[256];
-		u32  imageData[SAVE_IMAGE_WIDTH * SAVE_IMAGE_HEIGHT];
+		// The thumbnail is left compressed in the save file and decoded on demand, see loadSaveImage().
+		u64  modifiedTime;
+		u32  imageOffset;
+		u32  imageSize;
 	};
 
 	void init();
@@ -34,6 +39,8 @@ namespace TFE_SaveSystem
 	bool loadGame(const char* filename);
 	// Load only the header for UI.
 	bool loadGameHeader(const char* filename, SaveHeader* header);
+	// Decode the SAVE_IMAGE_WIDTH x SAVE_IMAGE_HEIGHT thumbnail for a save.
+	bool loadSaveImage(const SaveHeader* header, u32* imageData);
 
 	void postLoadRequest(const char* filename);
 	void postSaveRequest(const char* filename, const char* saveName, s32 delay = 0);
@@ -42,5 +49,22 @@ namespace TFE_SaveSystem
 
 	void getSaveFilenameFromIndex(s32 index, char* name);
 
+	// In-memory save states, these never touch the file system and only last for the current session.
+	// States hold a copy of the game memory and are restored in place between frames, without reloading the level,
+	// so they can only be restored within the level they were captured in.
+	bool captureSaveState(s32 slot);
+	bool postRestoreStateRequest(s32 slot);
+	// Capture into or restore from a stream owned by the caller, which must stay alive until the request is handled.
+	bool captureState(MemoryStream* stream);
+	bool postRestoreStateRequest(MemoryStream* stream);
+	// Capture or restore only the game state outside of the memory regions, the caller keeps track of the regions itself.
+	// 'restoreRegions' is called at the point the regions can be safely restored.
+	bool captureGameState(MemoryStream* stream);
+	bool restoreGameState(MemoryStream* stream, RestoreRegionsFunc restoreRegions);
+	bool hasSaveState(s32 slot);
+	void clearSaveStates();
+
+	// Fill in the headers for every save in the current game's save directory.
+	// Headers are read from the save index and only re-read from the save file if it changed.
 	void populateSaveDirectory(std::vector<SaveHeader>& dir);
 }
\ No newline at end of file
@@ -15,6 +15,8 @@
 #include "imMidiPlayer.h"
 #include "imDigitalSound.h"
 #include "midiData.h"
+#include <TFE_Jedi/Serialization/serialization.h>
+#include <vector>
 
 namespace TFE_Jedi
 {
@@ -639,6 +641,92 @@ namespace TFE_Jedi
 		return imSuccess;
 	}
 
+	///////////////////////////////////////////////////////////
+	// TFE: In-place save states
+	///////////////////////////////////////////////////////////
+	struct ImSoundState
+	{
+		ImSoundId id;
+		s32 type;
+		s32 priority;
+		s32 group;
+		s32 volume;
+		s32 pan;
+		// Midi only.
+		s32 chunk;
+		s32 measure;
+		s32 beat;
+		s32 tick;
+		s32 speed;
+		s32 hook;
+	};
+
+	void ImSerializeSounds(Stream* stream)
+	{
+		std::vector<ImSoundState> sounds;
+		if (serialization_getMode() == SMODE_WRITE)
+		{
+			ImSoundId soundId = ImGetNextSound(IM_NULL_SOUNDID);
+			while (soundId)
+			{
+				ImSoundState state = {};
+				state.id = soundId;
+				state.type     = ImGetParam(soundId, soundType);
+				state.priority = ImGetParam(soundId, soundPriority);
+				state.group    = ImGetParam(soundId, soundGroup);
+				state.volume   = ImGetParam(soundId, soundVol);
+				state.pan      = ImGetParam(soundId, soundPan);
+				if (state.type == typeMidi)
+				{
+					ImMidiPlayer* player = ImGetMidiPlayer(soundId);
+					state.chunk   = ImGetParam(soundId, midiChunk);
+					state.measure = ImGetParam(soundId, midiMeasure);
+					state.beat    = ImGetParam(soundId, midiBeat);
+					state.tick    = ImGetParam(soundId, midiTick);
+					state.speed   = ImGetParam(soundId, midiSpeed);
+					state.hook    = player ? player->hook : 0;
+				}
+				sounds.push_back(state);
+				soundId = ImGetNextSound(soundId);
+			}
+		}
+
+		u32 count = u32(sounds.size());
+		SERIALIZE(SaveVersionInit, count, 0);
+		if (serialization_getMode() == SMODE_READ)
+		{
+			sounds.resize(count);
+		}
+		if (count)
+		{
+			SERIALIZE_BUF(SaveVersionInit, sounds.data(), u32(count * sizeof(ImSoundState)));
+		}
+		if (serialization_getMode() != SMODE_READ)
+		{
+			return;
+		}
+
+		// Restart the sounds, wave sounds play from the start and midi sounds continue from the captured position.
+		ImStopAllSounds();
+		const ImSoundState* state = sounds.data();
+		for (u32 i = 0; i < count; i++, state++)
+		{
+			if (ImStartSound(state->id, state->priority) != imSuccess)
+			{
+				continue;
+			}
+			ImSetParam(state->id, soundGroup, state->group);
+			ImSetParam(state->id, soundVol, state->volume);
+			ImSetParam(state->id, soundPan, state->pan);
+			if (state->type == typeMidi)
+			{
+				ImSetParam(state->id, midiSpeed, state->speed);
+				ImSetHook(state->id, state->hook);
+				ImJumpMidi(state->id, state->chunk, state->measure, state->beat, state->tick, 0);
+			}
+		}
+	}
+
 	///////////////////////////////////////////////////////////
 	// Internal "main loop"
 	///////////////////////////////////////////////////////////
@@ -24,6 +24,7 @@
 #include "imConst.h"
 
 struct MemoryRegion;
+class Stream;
 
 enum ImWaveSpeed
 {
@@ -134,6 +135,9 @@ namespace TFE_Jedi
 	////////////////////////////////////////////////////
 	s32 ImSetDigitalChannelCount(s32 count);
 	s32 ImReintializeMidi();
+	// Capture the sounds that are playing or, when reading, stop all sounds and restart the captured ones.
+	// Used by in-place save states, wave sounds restart from the beginning.
+	void ImSerializeSounds(Stream* stream);
 
 	////////////////////////////////////////////////////
 	// Low level functions
@@ -1,6 +1,7 @@
 #include "infState.h"
 #include "infTypesInternal.h"
 #include "infSystem.h"
+#include "message.h"
 #include <TFE_DarkForces/sound.h>
 #include <TFE_Jedi/Serialization/serialization.h>
 #include <TFE_Jedi/Memory/allocator.h>
@@ -477,6 +478,17 @@ namespace TFE_Jedi
 		SERIALIZE(InfState_InitVersion, trigger->textId, 0);
 	}
 		
+	void inf_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_infSerState);
+		SERIALIZE_INPLACE(s_infState);
+		SERIALIZE_INPLACE(s_msgEntity);
+		SERIALIZE_INPLACE(s_msgTarget);
+		SERIALIZE_INPLACE(s_msgArg1);
+		SERIALIZE_INPLACE(s_msgArg2);
+		SERIALIZE_INPLACE(s_msgEvent);
+	}
+
 	void inf_serialize(Stream* stream)
 	{
 		SERIALIZE_VERSION(InfState_CurVersion);
@@ -14,6 +14,7 @@
 #include <TFE_Jedi/Memory/allocator.h>
 #include <TFE_Jedi/Level/level.h>
 #include <TFE_Jedi/Level/levelData.h>
+#include <TFE_Jedi/Level/levelCache.h>
 #include <TFE_Jedi/Collision/collision.h>
 #include <TFE_Settings/settings.h>
 #include <TFE_System/parser.h>
@@ -56,8 +57,40 @@ namespace TFE_Jedi
 	SoundSourceId s_needKeySoundId = NULL_SOUND;
 	SoundSourceId s_switchDefaultSndId = NULL_SOUND;
 
+	// TFE: The INF text is compiled into a record per line, see inf_compile(). The parser reads the lines back in order
+	// with inf_readLine(), which overwrites the current line the same way TFE_Parser::readLine() reuses its line buffer.
+	enum InfLineFlags : u32
+	{
+		INF_LINE_PREFIX  = FLAG_BIT(0),	// The line starts with "INF".
+		INF_LINE_VERSION = FLAG_BIT(1),	// "INF %f" was read.
+		INF_LINE_ITEMS   = FLAG_BIT(2),	// "ITEMS %d" was read.
+		INF_LINE_SEQ     = FLAG_BIT(3),	// The line contains "SEQ".
+		INF_LINE_CLASS   = FLAG_BIT(4),	// The line contains "CLASS".
+	};
+	enum
+	{
+		INF_MAX_ARGS = 7,
+		INF_LINE_END = -2,
+	};
+
+	struct InfLine
+	{
+		s32 argCount;		// Result of sscanf(line, " %s %s %s %s %s %s %s").
+		u32 flags;			// InfLineFlags
+		const char* args[INF_MAX_ARGS];
+		f32 version;
+		s32 itemCount;
+		// Result of sscanf(line, " ITEM: %s NAME: %s NUM: %d").
+		s32 itemScan;
+		const char* item;
+		const char* name;
+		s32 num;
+	};
+
 	// Temporary state that does not need to be cleared or serialized.
 	static std::vector<char> s_buffer;
+	static CompiledData s_compiled;
+	static InfLine s_line;
 	static char s_infArg0[256];
 	static char s_infArg1[256];
 	static char s_infArg2[256];
@@ -82,6 +115,8 @@ namespace TFE_Jedi
 	JBool updateElevator(InfElevator* elev);
 	void elevHandleStopDelay(InfElevator* elev);
 	Stop* inf_advanceStops(Allocator* stops, s32 absoluteStop, s32 relativeStop);
+	const InfLine* inf_readLine();
+	s32 inf_getArgs(const InfLine* line, char** args, s32 count);
 	bool inf_parseElevatorCommand(s32 argCount, KEYWORD action, Allocator* linkAlloc, bool seqEnd, InfElevator*& elev, s32& initStopIndex, InfLink*& link);
 	void inf_parseMessage(MessageType* type, u32* arg1, u32* arg2, u32* evt, const char* infArg0, const char* infArg1, const char* infArg2, bool elevator = false);
 	void inf_setWallBits(RWall* wall);
@@ -724,15 +759,15 @@ namespace TFE_Jedi
 	}
 	
 	// Return true if "SEQEND" found.
-	bool parseElevator(TFE_Parser& parser, size_t& bufferPos, const char* itemName)
+	bool parseElevator(const char* itemName)
 	{
-		const char* line;
+		const InfLine* line;
 
 		MessageAddress* msgAddr = message_getAddress(itemName);
 		// This means the level is most likely broken. But better to write an error and return than crash.
 		if (!msgAddr)
 		{
-			parser.readLine(bufferPos);
+			inf_readLine();
 			return false;
 		}
 
@@ -851,17 +886,18 @@ namespace TFE_Jedi
 		bool seqEnd = false;
 		while (!seqEnd)
 		{
-			line = parser.readLine(bufferPos);
+			line = inf_readLine();
 			if (!line) { break; }
 			// There is another class in this sequence, so finish the current class by setting up the initial stop.
-			if (strstr(line, "CLASS"))
+			if (line->flags & INF_LINE_CLASS)
 			{
 				inf_gotoInitialStop(elev, initStopIndex);
 				break;
 			}
 
 			char id[256];
-			s32 argCount = sscanf(line, " %s %s %s %s %s %s %s", id, s_infArg0, s_infArg1, s_infArg2, s_infArg3, s_infArg4, s_infArgExtra);
+			char* args[] = { id, s_infArg0, s_infArg1, s_infArg2, s_infArg3, s_infArg4, s_infArgExtra };
+			s32 argCount = inf_getArgs(line, args, 7);
 			KEYWORD action = getKeywordIndex(id);
 			if (action == KW_UNKNOWN)
 			{
@@ -874,12 +910,12 @@ namespace TFE_Jedi
 	}
 
 	// Return true if "SEQEND" found.
-	bool parseSectorTrigger(TFE_Parser& parser, size_t& bufferPos, s32 argCount, const char* itemName)
+	bool parseSectorTrigger(s32 argCount, const char* itemName)
 	{
 		MessageAddress* msgAddr = message_getAddress(itemName);
 		if (!msgAddr)
 		{
-			parser.readLine(bufferPos);
+			inf_readLine();
 			return false;
 		}
 		RSector* sector = msgAddr->sector;
@@ -892,19 +928,20 @@ namespace TFE_Jedi
 		InfTrigger* trigger = sector ? inf_createTrigger(ITRIGGER_SECTOR, obj) : nullptr;
 
 		// Loop through trigger parameters.
-		const char* line;
+		const InfLine* line;
 		bool seqEnd = false;
 		while (!seqEnd)
 		{
-			line = parser.readLine(bufferPos);
+			line = inf_readLine();
 			// There is another class in this sequence, so we are done with the trigger.
-			if (!line || strstr(line, "CLASS"))
+			if (!line || (line->flags & INF_LINE_CLASS))
 			{
 				break;
 			}
 			
 			char id[256];
-			argCount = sscanf(line, " %s %s %s %s %s", id, s_infArg0, s_infArg1, s_infArg2, s_infArg3);
+			char* args[] = { id, s_infArg0, s_infArg1, s_infArg2, s_infArg3 };
+			argCount = inf_getArgs(line, args, 5);
 			KEYWORD itemId = getKeywordIndex(id);
 			assert(itemId != KW_UNKNOWN);
 
@@ -987,12 +1024,12 @@ namespace TFE_Jedi
 	}
 		
 	// Return true if "SEQEND" found.
-	bool parseTeleport(TFE_Parser& parser, size_t& bufferPos, const char* itemName)
+	bool parseTeleport(const char* itemName)
 	{
 		MessageAddress* msgAddr = message_getAddress(itemName);
 		if (!msgAddr)
 		{
-			parser.readLine(bufferPos);
+			inf_readLine();
 			return false;
 		}
 
@@ -1010,19 +1047,20 @@ namespace TFE_Jedi
 		}
 
 		// Loop through trigger parameters.
-		const char* line;
+		const InfLine* line;
 		bool seqEnd = false;
 		while (!seqEnd)
 		{
-			line = parser.readLine(bufferPos);
+			line = inf_readLine();
 			// There is another class in this sequence, so we are done with the trigger.
-			if (!line || strstr(line, "CLASS"))
+			if (!line || (line->flags & INF_LINE_CLASS))
 			{
 				break;
 			}
 
 			char name[256];
-			sscanf(line, " %s %s %s %s %s", name, s_infArg0, s_infArg1, s_infArg2, s_infArg3);
+			char* args[] = { name, s_infArg0, s_infArg1, s_infArg2, s_infArg3 };
+			inf_getArgs(line, args, 5);
 			KEYWORD kw = getKeywordIndex(name);
 
 			if (kw == KW_TARGET)
@@ -1052,7 +1090,7 @@ namespace TFE_Jedi
 	}
 
 	// Return true if "SEQEND" found.
-	bool parseLineTrigger(TFE_Parser& parser, size_t& bufferPos, s32 argCount, const char* name, s32 num)
+	bool parseLineTrigger(s32 argCount, const char* name, s32 num)
 	{
 		KEYWORD typeId = getKeywordIndex(s_infArg0);
 		assert(typeId != KW_UNKNOWN);
@@ -1060,7 +1098,7 @@ namespace TFE_Jedi
 		MessageAddress* msgAddr = message_getAddress(name);
 		if (!msgAddr)
 		{
-			parser.readLine(bufferPos);
+			inf_readLine();
 			return false;
 		}
 
@@ -1108,18 +1146,19 @@ namespace TFE_Jedi
 		}
 
 		// Trigger parameters
-		const char* line;
+		const InfLine* line;
 		bool seqEnd = false;
 		while (!seqEnd)
 		{
-			line = parser.readLine(bufferPos);
-			if (!line || strstr(line, "CLASS"))
+			line = inf_readLine();
+			if (!line || (line->flags & INF_LINE_CLASS))
 			{
 				break;
 			}
 
 			char id[256];
-			argCount = sscanf(line, " %s %s %s %s %s", id, s_infArg0, s_infArg1, s_infArg2, s_infArg3);
+			char* args[] = { id, s_infArg0, s_infArg1, s_infArg2, s_infArg3 };
+			argCount = inf_getArgs(line, args, 5);
 			KEYWORD itemId = getKeywordIndex(id);
 			if (itemId == KW_UNKNOWN)
 			{
@@ -1202,6 +1241,9 @@ namespace TFE_Jedi
 		return seqEnd;
 	}
 
+	void inf_compile();
+	JBool inf_parse(const char* levelName);
+
 	// For now load the INF data directly.
 	// Move back to asset later.
 	JBool inf_load(const char* levelName)
@@ -1216,6 +1258,7 @@ namespace TFE_Jedi
 			TFE_System::logWrite(LOG_ERROR, "level_loadINF", "Cannot find level INF '%s'.", levelPath);
 			return JFALSE;
 		}
+
 		FileStream file;
 		if (!file.open(&filePath, Stream::MODE_READ))
 		{
@@ -1227,6 +1270,29 @@ namespace TFE_Jedi
 		file.readBuffer(s_buffer.data(), u32(len));
 		file.close();
 
+		// TFE: The text is compiled on the first load and the compiled data is cached, later loads of the same text skip parsing.
+		const u32 locationKey = levelCache_getLocationKey(&filePath);
+		const u32 sourceHash = levelCache_hashSource(s_buffer.data(), s_buffer.size());
+		if (!levelCache_read(levelPath, locationKey, sourceHash, &s_compiled))
+		{
+			inf_compile();
+			levelCache_write(levelPath, locationKey, sourceHash, &s_compiled);
+		}
+		s_compiled.pos = 0;
+		return inf_parse(levelName);
+	}
+
+	/////////////////////////////////////////////
+	// Compiled INF lines
+	/////////////////////////////////////////////
+	// Each line is stored as:
+	//   s32 argCount, u32 flags, [f32 version], [s32 itemCount], argCount strings,
+	//   s32 itemScan, [item string], [name string], [s32 num]
+	// and the data ends with INF_LINE_END in place of argCount.
+	void inf_compile()
+	{
+		compiled_clear(&s_compiled);
+
 		TFE_Parser parser;
 		size_t bufferPos = 0;
 		parser.init(s_buffer.data(), s_buffer.size());
@@ -1235,12 +1301,103 @@ namespace TFE_Jedi
 		parser.convertToUpperCase(true);
 
 		const char* line;
-		line = parser.readLine(bufferPos);
+		while (line = parser.readLine(bufferPos))
+		{
+			// Split the line on whitespace, which matches reading it with "%s".
+			char args[INF_MAX_ARGS][256];
+			s32 argCount = 0;
+			const char* ch = line;
+			while (argCount < INF_MAX_ARGS)
+			{
+				while (*ch && isspace(u8(*ch))) { ch++; }
+				if (!*ch) { break; }
+
+				s32 len = 0;
+				while (*ch && !isspace(u8(*ch)))
+				{
+					if (len < 255) { args[argCount][len++] = *ch; }
+					ch++;
+				}
+				args[argCount][len] = 0;
+				argCount++;
+			}
+			// sscanf() returns EOF if the line has no tokens.
+			if (!argCount) { argCount = -1; }
+
+			u32 flags = 0;
+			f32 version;
+			s32 itemCount;
+			if (strncasecmp(line, "INF", 3) == 0) { flags |= INF_LINE_PREFIX; }
+			if (sscanf(line, "INF %f", &version) == 1) { flags |= INF_LINE_VERSION; }
+			if (sscanf(line, "ITEMS %d", &itemCount) == 1) { flags |= INF_LINE_ITEMS; }
+			if (strstr(line, "SEQ")) { flags |= INF_LINE_SEQ; }
+			if (strstr(line, "CLASS")) { flags |= INF_LINE_CLASS; }
+
+			compiled_write(&s_compiled, argCount);
+			compiled_write(&s_compiled, flags);
+			if (flags & INF_LINE_VERSION) { compiled_write(&s_compiled, version); }
+			if (flags & INF_LINE_ITEMS) { compiled_write(&s_compiled, itemCount); }
+			for (s32 i = 0; i < argCount; i++)
+			{
+				compiled_writeString(&s_compiled, args[i]);
+			}
+
+			char item[256], name[256];
+			s32 num;
+			const s32 itemScan = sscanf(line, " ITEM: %255s NAME: %255s NUM: %d", item, name, &num);
+			compiled_write(&s_compiled, itemScan);
+			if (itemScan >= 1) { compiled_writeString(&s_compiled, item); }
+			if (itemScan >= 2) { compiled_writeString(&s_compiled, name); }
+			if (itemScan >= 3) { compiled_write(&s_compiled, num); }
+		}
+		const s32 end = INF_LINE_END;
+		compiled_write(&s_compiled, end);
+	}
+
+	// Read the next compiled line into s_line, returns null at the end of the data and leaves s_line unchanged.
+	const InfLine* inf_readLine()
+	{
+		InfLine line = {};
+		if (!compiled_read(&s_compiled, &line.argCount) || line.argCount == INF_LINE_END) { return nullptr; }
+		if (!compiled_read(&s_compiled, &line.flags)) { return nullptr; }
+		if ((line.flags & INF_LINE_VERSION) && !compiled_read(&s_compiled, &line.version)) { return nullptr; }
+		if ((line.flags & INF_LINE_ITEMS) && !compiled_read(&s_compiled, &line.itemCount)) { return nullptr; }
+		if (line.argCount > INF_MAX_ARGS) { return nullptr; }
+		for (s32 i = 0; i < line.argCount; i++)
+		{
+			line.args[i] = compiled_readString(&s_compiled);
+			if (!line.args[i]) { return nullptr; }
+		}
+
+		if (!compiled_read(&s_compiled, &line.itemScan)) { return nullptr; }
+		if (line.itemScan >= 1 && !(line.item = compiled_readString(&s_compiled))) { return nullptr; }
+		if (line.itemScan >= 2 && !(line.name = compiled_readString(&s_compiled))) { return nullptr; }
+		if (line.itemScan >= 3 && !compiled_read(&s_compiled, &line.num)) { return nullptr; }
+
+		s_line = line;
+		return &s_line;
+	}
+
+	// Copy up to 'count' arguments of the line, returns the same value as sscanf() with 'count' "%s" specifiers.
+	s32 inf_getArgs(const InfLine* line, char** args, s32 count)
+	{
+		const s32 argCount = min(line->argCount, count);
+		for (s32 i = 0; i < argCount; i++)
+		{
+			strcpy(args[i], line->args[i]);
+		}
+		return argCount;
+	}
+
+	JBool inf_parse(const char* levelName)
+	{
+		const InfLine* line;
+		line = inf_readLine();
 
 		// Keep looping until the version is found.
-		while (strncasecmp(line, "INF", 3) != 0 && line)
+		while (line && !(line->flags & INF_LINE_PREFIX))
 		{
-			line = parser.readLine(bufferPos);
+			line = inf_readLine();
 		}
 		if (!line)
 		{
@@ -1248,12 +1405,12 @@ namespace TFE_Jedi
 			return JFALSE;
 		}
 
-		f32 version;
-		if (sscanf(line, "INF %f", &version) != 1)
+		if (!(line->flags & INF_LINE_VERSION))
 		{
 			TFE_System::logWrite(LOG_ERROR, "level_loadINF", "Cannot read INF version.");
 			return JFALSE;
 		}
+		const f32 version = line->version;
 		if (version != 1.0f)
 		{
 			TFE_System::logWrite(LOG_ERROR, "level_loadINF", "Incorrect INF version %f, should be 1.0.", version);
@@ -1264,15 +1421,16 @@ namespace TFE_Jedi
 		s32 itemCount = 0;
 		while (1)
 		{
-			line = parser.readLine(bufferPos);
+			line = inf_readLine();
 			if (!line)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadINF", "Cannot find ITEMS in INF: '%s'.", levelName);
 				return JFALSE;
 			}
 
-			if (sscanf(line, "ITEMS %d", &itemCount) == 1)
+			if (line->flags & INF_LINE_ITEMS)
 			{
+				itemCount = line->itemCount;
 				break;
 			}
 		}
@@ -1291,7 +1449,7 @@ namespace TFE_Jedi
 		s32 wallNum = 0;
 		for (s32 i = 0; i < itemCount; i++)
 		{
-			line = parser.readLine(bufferPos);
+			line = inf_readLine();
 			if (!line)
 			{
 				TFE_System::logWrite(LOG_WARNING, "level_loadINF", "Hit the end of INF '%s' before parsing all items: %d/%d", levelName, i, itemCount);
@@ -1299,9 +1457,9 @@ namespace TFE_Jedi
 			}
 
 			char item[256], name[256];
-			while (sscanf(line, " ITEM: %s NAME: %s NUM: %d", item, name, &wallNum) < 1)
+			while (line->itemScan < 1)
 			{
-				line = parser.readLine(bufferPos);
+				line = inf_readLine();
 				if (!line)
 				{
 					TFE_System::logWrite(LOG_WARNING, "level_loadINF", "Hit the end of INF '%s' before parsing all items: %d/%d", levelName, i, itemCount);
@@ -1309,19 +1467,23 @@ namespace TFE_Jedi
 				}
 				continue;
 			}
+			strcpy(item, line->item);
+			if (line->itemScan >= 2) { strcpy(name, line->name); }
+			if (line->itemScan >= 3) { wallNum = line->num; }
 
 			KEYWORD itemType = getKeywordIndex(item);
 			switch (itemType)
 			{
 				case KW_LEVEL:
 				{
-					line = parser.readLine(bufferPos);
-					if (line && strstr(line, "SEQ"))
+					line = inf_readLine();
+					if (line && (line->flags & INF_LINE_SEQ))
 					{
-						while (line = parser.readLine(bufferPos))
+						while (line = inf_readLine())
 						{
 							char itemName[256];
-							s32 argCount = sscanf(line, " %s %s %s %s %s %s %s", itemName, s_infArg0, s_infArg1, s_infArg2, s_infArg3, s_infArgExtra, s_infArgExtra);
+							char* args[] = { itemName, s_infArg0, s_infArg1, s_infArg2, s_infArg3, s_infArgExtra, s_infArgExtra };
+							s32 argCount = inf_getArgs(line, args, 7);
 							KEYWORD levelItem = getKeywordIndex(itemName);
 							switch (levelItem)
 							{
@@ -1339,43 +1501,44 @@ namespace TFE_Jedi
 				} break;
 				case KW_SECTOR:
 				{
-					line = parser.readLine(bufferPos);
-					if (!line || !strstr(line, "SEQ"))
+					line = inf_readLine();
+					if (!line || !(line->flags & INF_LINE_SEQ))
 					{
 						continue;
 					}
 
-					line = parser.readLine(bufferPos);
+					line = inf_readLine();
 					// Loop until seqend since an INF item may have multiple classes.
 					while (1)
 					{
-						if (!line || !strstr(line, "CLASS"))
+						if (!line || !(line->flags & INF_LINE_CLASS))
 						{
 							break;
 						}
 
 						char id[256];
-						s32 argCount = sscanf(line, " %s %s %s %s %s %s %s", id, s_infArg0, s_infArg1, s_infArg2, s_infArg3, s_infArg4, s_infArgExtra);
+						char* args[] = { id, s_infArg0, s_infArg1, s_infArg2, s_infArg3, s_infArg4, s_infArgExtra };
+						s32 argCount = inf_getArgs(line, args, 7);
 						KEYWORD itemClass = getKeywordIndex(s_infArg0);
 						assert(itemClass != KW_UNKNOWN);
 
 						if (itemClass == KW_ELEVATOR)
 						{
-							if (parseElevator(parser, bufferPos, name))
+							if (parseElevator(name))
 							{
 								break;
 							}
 						}
 						else if (itemClass == KW_TRIGGER)
 						{
-							if (parseSectorTrigger(parser, bufferPos, argCount, name))
+							if (parseSectorTrigger(argCount, name))
 							{
 								break;
 							}
 						}
 						else if (itemClass == KW_TELEPORTER)
 						{
-							if (parseTeleport(parser, bufferPos, name))
+							if (parseTeleport(name))
 							{
 								break;
 							}
@@ -1383,30 +1546,31 @@ namespace TFE_Jedi
 						else
 						{
 							// Invalid item class.
-							line = parser.readLine(bufferPos);
+							line = inf_readLine();
 						}
 					}
 				} break;
 				case KW_LINE:
 				{
-					line = parser.readLine(bufferPos);
-					if (!line || !strstr(line, "SEQ"))
+					line = inf_readLine();
+					if (!line || !(line->flags & INF_LINE_SEQ))
 					{
 						continue;
 					}
 
-					line = parser.readLine(bufferPos);
+					line = inf_readLine();
 					// Loop until seqend since an INF item may have multiple classes.
 					while (1)
 					{
-						if (!line || !strstr(line, "CLASS"))
+						if (!line || !(line->flags & INF_LINE_CLASS))
 						{
 							break;
 						}
 
 						char id[256];
-						s32 argCount = sscanf(line, " %s %s %s %s %s", id, s_infArg0, s_infArg1, s_infArg2, s_infArg3);
-						if (parseLineTrigger(parser, bufferPos, argCount, name, wallNum))
+						char* args[] = { id, s_infArg0, s_infArg1, s_infArg2, s_infArg3 };
+						s32 argCount = inf_getArgs(line, args, 5);
+						if (parseLineTrigger(argCount, name, wallNum))
 						{
 							break;
 						}
@@ -36,6 +36,8 @@ namespace TFE_Jedi
 	// Serialization & State
 	void inf_clearState();
 	void inf_serialize(Stream* stream);
+	// Copy the INF state as is for in-place save states, see SERIALIZE_INPLACE().
+	void inf_serializeInPlace(Stream* stream);
 	
 	// ** Runtime API **
 	// Messages are the way entities and the player interact with the INF system during gameplay.
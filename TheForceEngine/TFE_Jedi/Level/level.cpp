@@ -3,6 +3,7 @@
 
 #include "level.h"
 #include "levelBin.h"
+#include "levelCache.h"
 #include "levelData.h"
 #include "rwall.h"
 #include "rtexture.h"
@@ -41,13 +42,89 @@ namespace TFE_Jedi
 		DF_LEVEL_VERSION_MINOR = 1,
 	};
 			
+	// Compiled LEV data: the header, palette name, texture names (an empty name is no texture), then for each sector:
+	// LevCompiledSector, sector name (may be empty), vertices and walls.
+	struct LevCompiledHeader
+	{
+		fixed16_16 parallax0;
+		fixed16_16 parallax1;
+		s32 textureCount;
+		s32 sectorCount;
+	};
+
+	struct LevCompiledSector
+	{
+		s32 id;
+		s32 ambient;
+		s32 floorTex;
+		s32 ceilTex;
+		vec2_fixed floorOffset;
+		vec2_fixed ceilOffset;
+		fixed16_16 floorHeight;
+		fixed16_16 ceilingHeight;
+		fixed16_16 secHeight;
+		u32 flags1;
+		u32 flags2;
+		u32 flags3;
+		s32 layer;
+		s32 vertexCount;
+		s32 wallCount;
+	};
+
+	struct LevCompiledWall
+	{
+		s32 left;
+		s32 right;
+		s32 midTex;
+		s32 topTex;
+		s32 botTex;
+		s32 signTex;
+		vec2_fixed midOffset;
+		vec2_fixed topOffset;
+		vec2_fixed botOffset;
+		vec2_fixed signOffset;
+		s32 adjoin;
+		s32 mirror;
+		u32 flags1;
+		u32 flags2;
+		u32 flags3;
+		s32 light;
+	};
+			
+	// Compiled O data: a sequence of sections, each an ObjCompiledSection followed by a s32 count. Asset lists hold count names
+	// (an empty name is no asset). Objects hold a s32 record count, then for each record: the class name, ObjCompiledObject and
+	// the logic sequence lines, each a s32 argument count followed by the arguments.
+	enum ObjCompiledSection : u32
+	{
+		OBJ_SECTION_END = 0,
+		OBJ_SECTION_PODS,
+		OBJ_SECTION_SPRITES,
+		OBJ_SECTION_FRAMES,
+		OBJ_SECTION_SOUNDS,
+		OBJ_SECTION_OBJECTS,
+	};
+
+	struct ObjCompiledObject
+	{
+		s32 dataIndex;
+		f32 x, y, z;
+		f32 pch, yaw, rol;
+		s32 diff;
+		s32 seqLineCount;	// -1 if the object has no sequence.
+	};
+
 	// Temp State.
 	static s32 s_dataIndex;
 	static char s_readBuffer[256];
 	static std::vector<char> s_buffer;
+	static CompiledData s_compiled;
 
 	JBool level_loadGeometry(const char* levelName);
+	JBool level_compileGeometry();
+	JBool level_buildGeometry();
 	JBool level_loadObjects(const char* levelName, u8 difficulty);
+	JBool level_compileObjects(const char* levelName);
+	JBool level_buildObjects(s32 curDiff);
 	JBool level_loadGoals(const char* levelName);
 
 	JBool level_load(const char* levelName, u8 difficulty)
@@ -155,6 +232,7 @@ namespace TFE_Jedi
 			TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot find level geometry '%s'.", levelName);
 			return false;
 		}
+
 		FileStream file;
 		if (!file.open(&filePath, Stream::MODE_READ))
 		{
@@ -166,6 +244,28 @@ namespace TFE_Jedi
 		file.readBuffer(s_buffer.data(), u32(len));
 		file.close();
 
+		// TFE: The text is compiled on the first load and the compiled data is cached, later loads of the same text skip parsing.
+		const u32 locationKey = levelCache_getLocationKey(&filePath);
+		const u32 sourceHash = levelCache_hashSource(s_buffer.data(), s_buffer.size());
+		if (!levelCache_read(levelPath, locationKey, sourceHash, &s_compiled))
+		{
+			if (!level_compileGeometry()) { return false; }
+			levelCache_write(levelPath, locationKey, sourceHash, &s_compiled);
+		}
+		return level_buildGeometry();
+	}
+
+	/////////////////////////////////////////////
+	// Compiled LEV data
+	// TFE: the LEV text is first parsed into a
+	// compact binary form, which is then used to
+	// build the level geometry.
+	/////////////////////////////////////////////
+	// Parse the LEV text in s_buffer into s_compiled.
+	JBool level_compileGeometry()
+	{
+		compiled_clear(&s_compiled);
+
 		TFE_Parser parser;
 		size_t bufferPos = 0;
 		parser.init(s_buffer.data(), s_buffer.size());
@@ -195,14 +295,13 @@ namespace TFE_Jedi
 		}
 
 		// This gets read here just to be overwritten later... so just ignore for now.
+		char paletteName[256];
 		line = parser.readLine(bufferPos);
-		if (sscanf(line, " PALETTE %s", s_levelState.levelPaletteName) != 1)
+		if (sscanf(line, " PALETTE %s", paletteName) != 1)
 		{
 			TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read palette name.");
 			return false;
 		}
-
-		level_loadPalette();
 		
 		// Another value that is ignored.
 		line = parser.readLine(bufferPos);
@@ -216,89 +315,66 @@ namespace TFE_Jedi
 		}
 
 		// Sky Parallax.
+		LevCompiledHeader header;
 		f32 parallax0, parallax1;
 		if (sscanf(line, " PARALLAX %f %f", &parallax0, &parallax1) != 2)
 		{
 			TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read parallax values.");
 			return false;
 		}
-		s_levelState.parallax0 = floatToFixed16(parallax0);
-		s_levelState.parallax1 = floatToFixed16(parallax1);
+		header.parallax0 = floatToFixed16(parallax0);
+		header.parallax1 = floatToFixed16(parallax1);
 
 		// Number of textures used by the level.
 		line = parser.readLine(bufferPos);
-		if (sscanf(line, " TEXTURES %d", &s_levelState.textureCount) != 1)
+		if (sscanf(line, " TEXTURES %d", &header.textureCount) != 1)
 		{
 			TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read texture count.");
 			return false;
 		}
-		s_levelState.textures = (TextureData**)level_alloc(2 * s_levelState.textureCount * sizeof(TextureData**));
-		memset(s_levelState.textures, 0, 2 * s_levelState.textureCount * sizeof(TextureData**));
 
-		// Load Textures.
-		TextureData** texture = s_levelState.textures;
-		TextureData** texBase = s_levelState.textures + s_levelState.textureCount;
-		for (s32 i = 0; i < s_levelState.textureCount; i++, texture++, texBase++)
+		// Texture names are read before the sector count, so the header is patched once it is known.
+		header.sectorCount = 0;
+		compiled_write(&s_compiled, header);
+		compiled_writeString(&s_compiled, paletteName);
+
+		// Texture names, an empty name means no texture.
+		for (s32 i = 0; i < header.textureCount; i++)
 		{
 			line = parser.readLine(bufferPos);
 			char textureName[256];
 			if (sscanf(line, " TEXTURE: %s ", textureName) != 1)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read texture name.");
-				*texture = bitmap_load("default.bm", 1);
-				(*texture)->flags |= ENABLE_MIP_MAPS;
+				compiled_writeString(&s_compiled, "default.bm");
 			}
 			else if (strcasecmp(textureName, "<NoTexture>") == 0)
 			{
-				*texture = nullptr;
+				compiled_writeString(&s_compiled, "");
 			}
 			else
 			{
-				TextureData* tex = bitmap_load(textureName, 1);
-				if (!tex)
-				{
-					TFE_System::logWrite(LOG_WARNING, "level_loadGeometry", "Could not open '%s', using 'default.bm' instead.", textureName);
-					tex = bitmap_load("default.bm", 1);
-					if (!tex)
-					{
-						TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "'default.bm' is not a valid BM file!");
-						assert(0);
-						return false;
-					}
-				}
-				// TFE - so we know which textures to mip.
-				tex->flags |= ENABLE_MIP_MAPS;
-				*texture = tex;
-				// This version never gets modified, so serialization is simpler.
-				*texBase = tex;
-
-				// Setup an animated texture.
-				if (tex->uvWidth == BM_ANIMATED_TEXTURE && !tex->animSetup)
-				{
-					bitmap_setupAnimatedTexture(texture, i);
-				}
+				compiled_writeString(&s_compiled, textureName);
 			}
 		}
 
-		// Load Sectors.
+		// Sectors.
 		line = parser.readLine(bufferPos);
-		if (sscanf(line, "NUMSECTORS %d", &s_levelState.sectorCount) != 1)
+		if (sscanf(line, "NUMSECTORS %d", &header.sectorCount) != 1)
 		{
 			TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read sector count.");
 			return false;
 		}
+		memcpy(s_compiled.data.data(), &header, sizeof(LevCompiledHeader));
 
-		s_levelState.sectors = (RSector*)level_alloc(sizeof(RSector) * s_levelState.sectorCount);
-		memset(s_levelState.sectors, 0, sizeof(RSector) * s_levelState.sectorCount);
-		for (u32 i = 0; i < s_levelState.sectorCount; i++)
+		std::vector<vec2_fixed> vertices;
+		for (s32 i = 0; i < header.sectorCount; i++)
 		{
-			RSector* sector = &s_levelState.sectors[i];
-			sector_clear(sector);
-			sector->index = i;
+			LevCompiledSector sector;
 
 			// Sector ID and Name
 			line = parser.readLine(bufferPos);
-			if (sscanf(line, " SECTOR %d", &sector->id) != 1)
+			if (sscanf(line, " SECTOR %d", &sector.id) != 1)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read sector id.");
 				return false;
@@ -309,53 +385,30 @@ namespace TFE_Jedi
 			// Sectors missing a name are valid but do not get "addresses" - and thus cannot be
 			// used by the INF system (except in the case of doors and exploding walls, see the flags section below).
 			char name[256];
-			if (sscanf(line, " NAME %s", name) == 1)
+			if (sscanf(line, " NAME %s", name) != 1)
 			{
-				// Add the sector "address" for later use by the INF system.
-				message_addAddress(name, 0, 0, sector);
-
-				// Track special elevators.
-				if (!strcasecmp(name, "complete"))
-				{
-					s_levelState.completeSector = sector;
-				}
-				else if (!strcasecmp(name, "boss"))
-				{
-					s_levelState.bossSector = sector;
-				}
-				else if (!strcasecmp(name, "mohc"))
-				{
-					s_levelState.mohcSector = sector;
-				}
+				name[0] = 0;
 			}
 
 			// Lighting
 			line = parser.readLine(bufferPos);
-			s32 ambient;
-			if (sscanf(line, " AMBIENT %d", &ambient) != 1)
+			if (sscanf(line, " AMBIENT %d", &sector.ambient) != 1)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read sector ambient.");
 				return false;
 			}
-			sector->ambient = intToFixed16(ambient);
 
 			// Floor Texture & Offset
 			line = parser.readLine(bufferPos);
-			s32 index, tmp;
+			s32 tmp;
 			f32 offsetX, offsetZ;
-			if (sscanf(line, " FLOOR TEXTURE %d %f %f %d", &index, &offsetX, &offsetZ, &tmp) != 4)
+			if (sscanf(line, " FLOOR TEXTURE %d %f %f %d", &sector.floorTex, &offsetX, &offsetZ, &tmp) != 4)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read floor texture.");
 				return false;
 			}
-
-			sector->floorTex = nullptr;
-			if (index != -1)
-			{
-				sector->floorTex = &s_levelState.textures[index];
-			}
-			sector->floorOffset.x = floatToFixed16(offsetX);
-			sector->floorOffset.z = floatToFixed16(offsetZ);
+			sector.floorOffset.x = floatToFixed16(offsetX);
+			sector.floorOffset.z = floatToFixed16(offsetZ);
 
 			// Floor Altitude
 			line = parser.readLine(bufferPos);
@@ -365,22 +418,17 @@ namespace TFE_Jedi
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read floor altitude.");
 				return false;
 			}
-			sector->floorHeight = floatToFixed16(alt);
+			sector.floorHeight = floatToFixed16(alt);
 
 			// Ceiling Texture & Offset
 			line = parser.readLine(bufferPos);
-			if (sscanf(line, " CEILING TEXTURE %d %f %f %d", &index, &offsetX, &offsetZ, &tmp) != 4)
+			if (sscanf(line, " CEILING TEXTURE %d %f %f %d", &sector.ceilTex, &offsetX, &offsetZ, &tmp) != 4)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read ceiling texture.");
 				return false;
 			}
-			sector->ceilTex = nullptr;
-			if (index != -1)
-			{
-				sector->ceilTex = &s_levelState.textures[index];
-			}
-			sector->ceilOffset.x = floatToFixed16(offsetX);
-			sector->ceilOffset.z = floatToFixed16(offsetZ);
+			sector.ceilOffset.x = floatToFixed16(offsetX);
+			sector.ceilOffset.z = floatToFixed16(offsetZ);
 
 			// Ceiling Altitude
 			line = parser.readLine(bufferPos);
@@ -389,7 +437,7 @@ namespace TFE_Jedi
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read ceiling altitude.");
 				return false;
 			}
-			sector->ceilingHeight = floatToFixed16(alt);
+			sector.ceilingHeight = floatToFixed16(alt);
 
 			// Second Altitude
 			line = parser.readLine(bufferPos);
@@ -398,81 +446,58 @@ namespace TFE_Jedi
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read second altitude.");
 				return false;
 			}
-			sector->secHeight = floatToFixed16(alt);
+			sector.secHeight = floatToFixed16(alt);
 
 			// Sector flags
 			line = parser.readLine(bufferPos);
-			if (sscanf(line, " FLAGS %d %d %d", &sector->flags1, &sector->flags2, &sector->flags3) != 3)
+			if (sscanf(line, " FLAGS %d %d %d", &sector.flags1, &sector.flags2, &sector.flags3) != 3)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read sector flags.");
 				return false;
 			}
-			// Create a door if needed.
-			if (sector->flags1 & SEC_FLAGS1_DOOR)
-			{
-				InfElevator* elev = inf_allocateSpecialElevator(sector, IELEV_SP_DOOR);
-				if (elev) { elev->flags |= INF_EFLAG_DOOR; }
-			}
-			// Create an exploding wall if needed.
-			if (sector->flags1 & SEC_FLAGS1_EXP_WALL)
-			{
-				inf_allocateSpecialElevator(sector, IELEV_SP_EXPLOSIVE_WALL);
-			}
-			// Add secrets.
-			if (sector->flags1 & SEC_FLAGS1_SECRET)
-			{
-				s_levelState.secretCount++;
-			}
 
 			// Layer
 			line = parser.readLine(bufferPos);
-			if (sscanf(line, " LAYER %d", &sector->layer) != 1)
+			if (sscanf(line, " LAYER %d", &sector.layer) != 1)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read sector layer.");
 				return false;
 			}
-			s_levelState.minLayer = min(s_levelState.minLayer, sector->layer);
-			s_levelState.maxLayer = max(s_levelState.maxLayer, sector->layer);
 
 			// Vertices
 			line = parser.readLine(bufferPos);
-			s32 vertexCount;
-			if (sscanf(line, " VERTICES %d", &vertexCount) != 1)
+			if (sscanf(line, " VERTICES %d", &sector.vertexCount) != 1)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read sector vertices.");
 				return false;
 			}
-			const size_t vtxSize = vertexCount * sizeof(vec2_fixed);
-			sector->verticesWS = (vec2_fixed*)level_alloc(vtxSize);
-			sector->verticesVS = (vec2_fixed*)level_alloc(vtxSize);
-			sector->vertexCount = vertexCount;
-
-			for (s32 v = 0; v < vertexCount; v++)
+			vertices.resize(sector.vertexCount);
+			for (s32 v = 0; v < sector.vertexCount; v++)
 			{
 				line = parser.readLine(bufferPos);
 
 				f32 x, z;
 				sscanf(line, " X: %f Z: %f ", &x, &z);
-				sector->verticesWS[v].x = floatToFixed16(x);
-				sector->verticesWS[v].z = floatToFixed16(z);
+				vertices[v].x = floatToFixed16(x);
+				vertices[v].z = floatToFixed16(z);
 			}
 
 			// Walls
 			line = parser.readLine(bufferPos);
-			s32 wallCount;
-			if (sscanf(line, " WALLS %d", &wallCount) != 1)
+			if (sscanf(line, " WALLS %d", &sector.wallCount) != 1)
 			{
 				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read sector walls.");
 				return false;
 			}
-			sector->walls = (RWall*)level_alloc(wallCount * sizeof(RWall));
-			sector->wallCount = wallCount;
 
-			for (s32 w = 0; w < wallCount; w++)
+			compiled_write(&s_compiled, sector);
+			compiled_writeString(&s_compiled, name);
+			compiled_writeBuffer(&s_compiled, vertices.data(), sector.vertexCount * sizeof(vec2_fixed));
+
+			for (s32 w = 0; w < sector.wallCount; w++)
 			{
-				s32 light, flags3, flags2, flags1, walk, mirror, adjoin;
-				s32 signTex, unused;
-				s32 botTex, topTex, midTex, right, left;
+				LevCompiledWall wall;
+				s32 walk, unused;
 				f32 signOffsetZ, signOffsetX;
 				f32 botOffsetZ, botOffsetX;
 				f32 topOffsetZ, topOffsetX;
@@ -480,22 +505,219 @@ namespace TFE_Jedi
 
 				line = parser.readLine(bufferPos);
 				if (sscanf(line, " WALL LEFT: %d RIGHT: %d MID: %d %f %f %d TOP: %d %f %f %d BOT: %d %f %f %d SIGN: %d %f %f ADJOIN: %d MIRROR: %d WALK: %d FLAGS: %d %d %d LIGHT: %d",
-					&left, &right, &midTex, &midOffsetX, &midOffsetZ, &unused, &topTex, &topOffsetX, &topOffsetZ, &unused, &botTex, &botOffsetX, &botOffsetZ, &unused,
-					&signTex, &signOffsetX, &signOffsetZ, &adjoin, &mirror, &walk, &flags1, &flags2, &flags3, &light) != 24)
+					&wall.left, &wall.right, &wall.midTex, &midOffsetX, &midOffsetZ, &unused, &wall.topTex, &topOffsetX, &topOffsetZ, &unused, &wall.botTex, &botOffsetX, &botOffsetZ, &unused,
+					&wall.signTex, &signOffsetX, &signOffsetZ, &wall.adjoin, &wall.mirror, &walk, &wall.flags1, &wall.flags2, &wall.flags3, &wall.light) != 24)
 				{
 					TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Cannot read wall.");
 					return false;
 				}
+				wall.midOffset.x  = floatToFixed16(midOffsetX) * 8;
+				wall.midOffset.z  = floatToFixed16(midOffsetZ) * 8;
+				wall.topOffset.x  = floatToFixed16(topOffsetX) * 8;
+				wall.topOffset.z  = floatToFixed16(topOffsetZ) * 8;
+				wall.botOffset.x  = floatToFixed16(botOffsetX) * 8;
+				wall.botOffset.z  = floatToFixed16(botOffsetZ) * 8;
+				wall.signOffset.x = floatToFixed16(signOffsetX) * 8;
+				wall.signOffset.z = floatToFixed16(signOffsetZ) * 8;
+				compiled_write(&s_compiled, wall);
+			}
+		}
+
+		return true;
+	}
+
+	// Build the level geometry from the compiled LEV data in s_compiled.
+	JBool level_buildGeometry()
+	{
+		s_compiled.pos = 0;
+
+		LevCompiledHeader header;
+		const char* paletteName = nullptr;
+		if (!compiled_read(&s_compiled, &header) || !(paletteName = compiled_readString(&s_compiled)) || header.textureCount < 0 || header.sectorCount < 0)
+		{
+			TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Invalid compiled level data.");
+			return false;
+		}
+		strcpy(s_levelState.levelPaletteName, paletteName);
+		level_loadPalette();
+
+		s_levelState.parallax0 = header.parallax0;
+		s_levelState.parallax1 = header.parallax1;
+
+		s_levelState.textureCount = header.textureCount;
+		s_levelState.textures = (TextureData**)level_alloc(2 * s_levelState.textureCount * sizeof(TextureData**));
+		memset(s_levelState.textures, 0, 2 * s_levelState.textureCount * sizeof(TextureData**));
+
+		// Load Textures.
+		TextureData** texture = s_levelState.textures;
+		TextureData** texBase = s_levelState.textures + s_levelState.textureCount;
+		bitmap_beginDecompressBatch();
+		for (s32 i = 0; i < s_levelState.textureCount; i++, texture++, texBase++)
+		{
+			const char* textureName = compiled_readString(&s_compiled);
+			if (!textureName)
+			{
+				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Invalid compiled level data.");
+				bitmap_endDecompressBatch();
+				return false;
+			}
+			else if (!textureName[0])
+			{
+				*texture = nullptr;
+			}
+			else
+			{
+				TextureData* tex = bitmap_load(textureName, 1);
+				if (!tex)
+				{
+					TFE_System::logWrite(LOG_WARNING, "level_loadGeometry", "Could not open '%s', using 'default.bm' instead.", textureName);
+					tex = bitmap_load("default.bm", 1);
+					if (!tex)
+					{
+						TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "'default.bm' is not a valid BM file!");
+						assert(0);
+						bitmap_endDecompressBatch();
+						return false;
+					}
+				}
+				// TFE - so we know which textures to mip.
+				tex->flags |= ENABLE_MIP_MAPS;
+				*texture = tex;
+				// This version never gets modified, so serialization is simpler.
+				*texBase = tex;
+
+				// Setup an animated texture.
+				if (tex->uvWidth == BM_ANIMATED_TEXTURE && !tex->animSetup)
+				{
+					bitmap_setupAnimatedTexture(texture, i);
+				}
+			}
+		}
+		bitmap_endDecompressBatch();
+
+		// Load Sectors.
+		s_levelState.sectorCount = header.sectorCount;
+		s_levelState.sectors = (RSector*)level_alloc(sizeof(RSector) * s_levelState.sectorCount);
+		memset(s_levelState.sectors, 0, sizeof(RSector) * s_levelState.sectorCount);
+		for (u32 i = 0; i < s_levelState.sectorCount; i++)
+		{
+			RSector* sector = &s_levelState.sectors[i];
+			sector_clear(sector);
+			sector->index = i;
+
+			LevCompiledSector sectorData;
+			const char* name = nullptr;
+			if (!compiled_read(&s_compiled, &sectorData) || !(name = compiled_readString(&s_compiled)) || sectorData.vertexCount < 0 || sectorData.wallCount < 0)
+			{
+				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Invalid compiled level data.");
+				return false;
+			}
+			sector->id = sectorData.id;
+
+			if (name[0])
+			{
+				// Add the sector "address" for later use by the INF system.
+				message_addAddress(name, 0, 0, sector);
+
+				// Track special elevators.
+				if (!strcasecmp(name, "complete"))
+				{
+					s_levelState.completeSector = sector;
+				}
+				else if (!strcasecmp(name, "boss"))
+				{
+					s_levelState.bossSector = sector;
+				}
+				else if (!strcasecmp(name, "mohc"))
+				{
+					s_levelState.mohcSector = sector;
+				}
+			}
+
+			// Lighting
+			sector->ambient = intToFixed16(sectorData.ambient);
+
+			// Floor and ceiling.
+			sector->floorTex = nullptr;
+			if (sectorData.floorTex != -1)
+			{
+				sector->floorTex = &s_levelState.textures[sectorData.floorTex];
+			}
+			sector->floorOffset = sectorData.floorOffset;
+			sector->floorHeight = sectorData.floorHeight;
+
+			sector->ceilTex = nullptr;
+			if (sectorData.ceilTex != -1)
+			{
+				sector->ceilTex = &s_levelState.textures[sectorData.ceilTex];
+			}
+			sector->ceilOffset = sectorData.ceilOffset;
+			sector->ceilingHeight = sectorData.ceilingHeight;
+			sector->secHeight = sectorData.secHeight;
+
+			// Sector flags
+			sector->flags1 = sectorData.flags1;
+			sector->flags2 = sectorData.flags2;
+			sector->flags3 = sectorData.flags3;
+			// Create a door if needed.
+			if (sector->flags1 & SEC_FLAGS1_DOOR)
+			{
+				InfElevator* elev = inf_allocateSpecialElevator(sector, IELEV_SP_DOOR);
+				if (elev) { elev->flags |= INF_EFLAG_DOOR; }
+			}
+			// Create an exploding wall if needed.
+			if (sector->flags1 & SEC_FLAGS1_EXP_WALL)
+			{
+				inf_allocateSpecialElevator(sector, IELEV_SP_EXPLOSIVE_WALL);
+			}
+			// Add secrets.
+			if (sector->flags1 & SEC_FLAGS1_SECRET)
+			{
+				s_levelState.secretCount++;
+			}
+
+			// Layer
+			sector->layer = sectorData.layer;
+			s_levelState.minLayer = min(s_levelState.minLayer, sector->layer);
+			s_levelState.maxLayer = max(s_levelState.maxLayer, sector->layer);
+
+			// Vertices
+			const s32 vertexCount = sectorData.vertexCount;
+			const size_t vtxSize = vertexCount * sizeof(vec2_fixed);
+			sector->verticesWS = (vec2_fixed*)level_alloc(vtxSize);
+			sector->verticesVS = (vec2_fixed*)level_alloc(vtxSize);
+			sector->vertexCount = vertexCount;
+			if (!compiled_readBuffer(&s_compiled, sector->verticesWS, vtxSize))
+			{
+				TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Invalid compiled level data.");
+				return false;
+			}
+
+			// Walls
+			const s32 wallCount = sectorData.wallCount;
+			sector->walls = (RWall*)level_alloc(wallCount * sizeof(RWall));
+			sector->wallCount = wallCount;
+
+			for (s32 w = 0; w < wallCount; w++)
+			{
+				LevCompiledWall wallData;
+				if (!compiled_read(&s_compiled, &wallData))
+				{
+					TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Invalid compiled level data.");
+					return false;
+				}
 
 				RWall* wall = &sector->walls[w];
 				wall->id = w;
 				wall->sector = sector;
 				wall->mirrorWall = nullptr;
 				wall->seen = JFALSE;
-				wall->flags1 = flags1;
-				wall->flags2 = flags2;
-				wall->flags3 = flags3;
+				wall->flags1 = wallData.flags1;
+				wall->flags2 = wallData.flags2;
+				wall->flags3 = wallData.flags3;
 
+				const s32 left = wallData.left;
+				const s32 right = wallData.right;
 				vec2_fixed* leftVtxWS = &sector->verticesWS[left];
 				vec2_fixed* rightVtxWS = &sector->verticesWS[right];
 				wall->w0 = leftVtxWS;
@@ -508,52 +730,48 @@ namespace TFE_Jedi
 
 				wall->nextSector = nullptr;
 				wall->mirror = -1;
-				if (adjoin != -1)
+				if (wallData.adjoin != -1)
 				{
-					wall->nextSector = &s_levelState.sectors[adjoin];
-					if (mirror == -1)
+					wall->nextSector = &s_levelState.sectors[wallData.adjoin];
+					if (wallData.mirror == -1)
 					{
 						TFE_System::logWrite(LOG_ERROR, "level_loadGeometry", "Adjoining wall missing mirror.");
 					}
-					wall->mirror = mirror;
+					wall->mirror = wallData.mirror;
 				}
 
 				wall->infLink = nullptr;
 				wall->collisionFrame = 0;
 				wall->drawFrame = 0;
 				wall->drawFlags = 0;
-				wall->wallLight = intToFixed16(light);
+				wall->wallLight = intToFixed16(wallData.light);
 
 				wall->midTex = nullptr;
-				if (midTex != -1)
+				if (wallData.midTex != -1)
 				{
-					wall->midTex = &s_levelState.textures[midTex];
-					wall->midOffset.x = floatToFixed16(midOffsetX) * 8;
-					wall->midOffset.z = floatToFixed16(midOffsetZ) * 8;
+					wall->midTex = &s_levelState.textures[wallData.midTex];
+					wall->midOffset = wallData.midOffset;
 				}
 
 				wall->topTex = nullptr;
-				if (topTex != -1)
+				if (wallData.topTex != -1)
 				{
-					wall->topTex = &s_levelState.textures[topTex];
-					wall->topOffset.x = floatToFixed16(topOffsetX) * 8;
-					wall->topOffset.z = floatToFixed16(topOffsetZ) * 8;
+					wall->topTex = &s_levelState.textures[wallData.topTex];
+					wall->topOffset = wallData.topOffset;
 				}
 
 				wall->botTex = nullptr;
-				if (botTex != -1)
+				if (wallData.botTex != -1)
 				{
-					wall->botTex = &s_levelState.textures[botTex];
-					wall->botOffset.x = floatToFixed16(botOffsetX) * 8;
-					wall->botOffset.z = floatToFixed16(botOffsetZ) * 8;
+					wall->botTex = &s_levelState.textures[wallData.botTex];
+					wall->botOffset = wallData.botOffset;
 				}
 
 				wall->signTex = nullptr;
-				if (signTex != -1)
+				if (wallData.signTex != -1)
 				{
-					wall->signTex = &s_levelState.textures[signTex];
-					wall->signOffset.x = floatToFixed16(signOffsetX) * 8;
-					wall->signOffset.z = floatToFixed16(signOffsetZ) * 8;
+					wall->signTex = &s_levelState.textures[wallData.signTex];
+					wall->signOffset = wallData.signOffset;
 				}
 
 				fixed16_16 dx = rightVtxWS->x - leftVtxWS->x;
@@ -707,26 +925,61 @@ namespace TFE_Jedi
 		strcpy(levelPath, levelName);
 		strcat(levelPath, ".O");
 
-		s32 curDiff = s32(difficulty) + 1;
-
 		FilePath filePath;
 		if (!TFE_Paths::getFilePath(levelPath, &filePath))
 		{
 			TFE_System::logWrite(LOG_ERROR, "Level Load", "Cannot find level objects '%s'.", levelName);
 			return false;
 		}
+
 		FileStream file;
 		if (!file.open(&filePath, Stream::MODE_READ))
 		{
 			TFE_System::logWrite(LOG_ERROR, "Level Load", "Cannot open level objects '%s'.", levelName);
 			return false;
 		}
-
 		size_t len = file.getSize();
 		s_buffer.resize(len);
 		file.readBuffer(s_buffer.data(), u32(len));
 		file.close();
 
+		// TFE: The text is compiled on the first load and the compiled data is cached, later loads of the same text skip parsing.
+		const u32 locationKey = levelCache_getLocationKey(&filePath);
+		const u32 sourceHash = levelCache_hashSource(s_buffer.data(), s_buffer.size());
+		if (!levelCache_read(levelPath, locationKey, sourceHash, &s_compiled))
+		{
+			if (!level_compileObjects(levelName)) { return false; }
+			levelCache_write(levelPath, locationKey, sourceHash, &s_compiled);
+		}
+		return level_buildObjects(s32(difficulty) + 1);
+	}
+
+	/////////////////////////////////////////////
+	// Compiled O data
+	/////////////////////////////////////////////
+	// Read a list of asset names, invalid or missing lines are written as empty names.
+	void level_compileNameList(TFE_Parser& parser, size_t& bufferPos, ObjCompiledSection section, s32 count, const char* format, const char* listName)
+	{
+		compiled_write(&s_compiled, section);
+		compiled_write(&s_compiled, count);
+		for (s32 i = 0; i < count; i++)
+		{
+			const char* line = parser.readLine(bufferPos);
+			char name[256] = "";
+			if (line && sscanf(line, format, name) != 1)
+			{
+				TFE_System::logWrite(LOG_WARNING, "Level Load", "Unknown line in %s list '%s' - skipping.", listName, line);
+				name[0] = 0;
+			}
+			compiled_writeString(&s_compiled, name);
+		}
+	}
+
+	// Parse the O text in s_buffer into s_compiled.
+	JBool level_compileObjects(const char* levelName)
+	{
+		compiled_clear(&s_compiled);
+
 		TFE_Parser parser;
 		size_t bufferPos = 0;
 		parser.init(s_buffer.data(), s_buffer.size());
@@ -739,265 +992,358 @@ namespace TFE_Jedi
 		const char* line;
 		line = parser.readLine(bufferPos);
 		s32 versionMajor, versionMinor;
-		if (sscanf(line, "O %d.%d", &versionMajor, &versionMinor) != 2)
+		if (!line || sscanf(line, "O %d.%d", &versionMajor, &versionMinor) != 2)
 		{
 			TFE_System::logWrite(LOG_ERROR, "Level Load", "Cannot parse version for Object file '%s'.", levelName);
 			return false;
 		}
 
+		s32 count;
 		while (line = parser.readLine(bufferPos))
 		{
-			if (sscanf(line, "PODS %d", &s_levelIntState.podCount) == 1)
+			if (sscanf(line, "PODS %d", &count) == 1)
+			{
+				level_compileNameList(parser, bufferPos, OBJ_SECTION_PODS, count, " POD: %s", "pod");
+			}
+			else if (sscanf(line, "SPRS %d", &count) == 1)
+			{
+				level_compileNameList(parser, bufferPos, OBJ_SECTION_SPRITES, count, " SPR: %s ", "sprite");
+			}
+			else if (sscanf(line, "FMES %d", &count) == 1)
+			{
+				level_compileNameList(parser, bufferPos, OBJ_SECTION_FRAMES, count, " FME: %s ", "fme");
+			}
+			else if (sscanf(line, "SOUNDS %d", &count) == 1)
 			{
-				s_levelIntState.pods = (JediModel**)level_alloc(sizeof(JediModel*)*s_levelIntState.podCount);
-				for (s32 p = 0; p < s_levelIntState.podCount; p++)
+				level_compileNameList(parser, bufferPos, OBJ_SECTION_SOUNDS, count, " SOUND: %s ", "sound");
+			}
+			else if (sscanf(line, "OBJECTS %d", &count) == 1)
+			{
+				compiled_write(&s_compiled, OBJ_SECTION_OBJECTS);
+				compiled_write(&s_compiled, count);
+				const size_t recordCountPos = s_compiled.data.size();
+				s32 recordCount = 0;
+				compiled_write(&s_compiled, recordCount);
+
+				JBool readNextLine = JTRUE;
+				for (s32 objIndex = 0; objIndex < count;)
 				{
-					line = parser.readLine(bufferPos);
-					s_levelIntState.pods[p] = nullptr;
+					if (readNextLine)
+					{
+						line = parser.readLine(bufferPos);
+						if (!line) { break; }
+					}
+					else
+					{
+						readNextLine = JTRUE;
+					}
 
-					if (line)
+					ObjCompiledObject obj = {};
+					char objClass[256];
+					if (sscanf(line, " CLASS: %s DATA: %d X: %f Y: %f Z: %f PCH: %f YAW: %f ROL: %f DIFF: %d", objClass, &obj.dataIndex,
+						&obj.x, &obj.y, &obj.z, &obj.pch, &obj.yaw, &obj.rol, &obj.diff) <= 5)
 					{
-						char podName[32];
-						if (sscanf(line, " POD: %s", podName) == 1)
-						{
-							s_levelIntState.pods[p] = TFE_Model_Jedi::get(podName);
-							if (!s_levelIntState.pods[p])
-							{
-								s_levelIntState.pods[p] = TFE_Model_Jedi::get("default.3do");
-							}
-						}
-						else
-						{
-							TFE_System::logWrite(LOG_WARNING, "Level Load", "Unknown line in pod list '%s' - skipping.", line);
-						}
+						continue;
 					}
-				}
-			}
-			else if (sscanf(line, "SPRS %d", &s_levelIntState.spriteCount) == 1)
-			{
-				s_levelIntState.sprites = (JediWax**)level_alloc(sizeof(JediWax*)*s_levelIntState.spriteCount);
-				for (s32 s = 0; s < s_levelIntState.spriteCount; s++)
-				{
+					objIndex++;
+					recordCount++;
+
+					// The logic sequence follows the object, otherwise the line belongs to the next object.
+					const size_t objPos = s_compiled.data.size() + strlen(objClass) + 1;
+					obj.seqLineCount = -1;
+					compiled_writeString(&s_compiled, objClass);
+					compiled_write(&s_compiled, obj);
+
 					line = parser.readLine(bufferPos);
-					s_levelIntState.sprites[s] = nullptr;
+					if (!line) { break; }
+					if (!strstr(line, "SEQ"))
+					{
+						readNextLine = JFALSE;
+						continue;
+					}
 
-					if (line)
+					// Sequence lines are stored split into arguments, up to and including SEQEND.
+					obj.seqLineCount = 0;
+					while (line = parser.readLine(bufferPos))
 					{
-						char name[32];
-						if (sscanf(line, " SPR: %s ", name) == 1)
-						{
-							s_levelIntState.sprites[s] = TFE_Sprite_Jedi::getWax(name);
-							if (!s_levelIntState.sprites[s])
-							{
-								s_levelIntState.sprites[s] = TFE_Sprite_Jedi::getWax("default.wax");
-							}
-						}
-						else
+						char args[6][256];
+						const s32 argCount = sscanf(line, " %s %s %s %s %s %s", args[0], args[1], args[2], args[3], args[4], args[5]);
+						compiled_write(&s_compiled, argCount);
+						for (s32 a = 0; a < argCount; a++)
 						{
-							TFE_System::logWrite(LOG_WARNING, "Level Load", "Unknown line in sprite list '%s' - skipping.", line);
+							compiled_writeString(&s_compiled, args[a]);
 						}
+						obj.seqLineCount++;
+						if (argCount > 0 && getKeywordIndex(args[0]) == KW_SEQEND) { break; }
 					}
+					memcpy(s_compiled.data.data() + objPos, &obj, sizeof(ObjCompiledObject));
+					if (!line) { break; }
 				}
+				memcpy(s_compiled.data.data() + recordCountPos, &recordCount, sizeof(s32));
 			}
-			else if (sscanf(line, "FMES %d", &s_levelIntState.fmeCount) == 1)
+		}
+		compiled_write(&s_compiled, OBJ_SECTION_END);
+		return JTRUE;
+	}
+
+	JBool level_buildObjectsError()
+	{
+		TFE_System::logWrite(LOG_ERROR, "Level Load", "Invalid compiled object data.");
+		return JFALSE;
+	}
+
+	// Create the object for a compiled object record, returns null if there is no object to set up the logic for.
+	SecObject* level_createObject(const char* objClass, const ObjCompiledObject* data, s32 curDiff)
+	{
+		// objDiff >= 0: This difficulty and all greater.
+		// objDiff <  0: Less than this difficulty.
+		const s32 objDiff = data->diff;
+		if ((objDiff >= 0 && curDiff < objDiff) || (objDiff < 0 && curDiff > TFE_Jedi::abs(objDiff)))
+		{
+			return nullptr;
+		}
+		s_dataIndex = data->dataIndex;
+
+		vec3_fixed posWS;
+		posWS.x = floatToFixed16(data->x);
+		posWS.y = floatToFixed16(data->y);
+		posWS.z = floatToFixed16(data->z);
+
+		// The DOS code allocated the object, tried to find the sector it is in and than frees the object
+		// if it doesn't fit.
+		// Instead TFE just reads the values and only allocates the object if it has a valid sector.
+		RSector* sector = sector_which3D(posWS.x, posWS.y, posWS.z);
+		if (!sector)
+		{
+			return nullptr;
+		}
+
+		SecObject* obj = allocateObject();
+		obj->posWS = posWS;
+		obj->pitch = floatDegreesToFixed(data->pch);
+		obj->yaw   = floatDegreesToFixed(data->yaw);
+		obj->roll  = floatDegreesToFixed(data->rol);
+
+		KEYWORD classType = getKeywordIndex(objClass);
+		switch (classType)
+		{
+			case KW_3D:
 			{
-				s_levelIntState.frames = (JediFrame**)level_alloc(sizeof(JediFrame*)*s_levelIntState.fmeCount);
-				for (s32 f = 0; f < s_levelIntState.fmeCount; f++)
+				if (s_levelIntState.pods)
 				{
-					line = parser.readLine(bufferPos);
-					s_levelIntState.frames[f] = nullptr;
+					sector_addObject(sector, obj);
+					obj3d_setData(obj, s_levelIntState.pods[s_dataIndex]);
+					obj3d_computeTransform(obj);
+				}
+				else
+				{
+					freeObject(obj);
+					obj = nullptr;
+				}
+			} break;
+			case KW_SPRITE:
+			{
+				if (s_levelIntState.sprites)
+				{
+					sector_addObject(sector, obj);
+					sprite_setData(obj, s_levelIntState.sprites[s_dataIndex]);
+				}
+				else
+				{
+					freeObject(obj);
+					obj = nullptr;
+				}
+			} break;
+			case KW_FRAME:
+			{
+				if (s_levelIntState.frames)
+				{
+					sector_addObject(sector, obj);
+					frame_setData(obj, s_levelIntState.frames[s_dataIndex]);
+				}
+				else
+				{
+					freeObject(obj);
+					obj = nullptr;
+				}
+			} break;
+			case KW_SPIRIT:
+			{
+				sector_addObject(sector, obj);
+				spirit_setData(obj);
+			} break;
+			case KW_SOUND:
+			{
+				level_addAmbientSound(s_levelIntState.soundIds[s_dataIndex], obj->posWS);
+				freeObject(obj);
+				obj = nullptr;
+			} break;
+			case KW_SAFE:
+			{
+				if (!s_levelState.safeLoc)
+				{
+					s_levelState.safeLoc = allocator_create(sizeof(Safe));
+				}
+				Safe* safe = (Safe*)allocator_newItem(s_levelState.safeLoc);
+				safe->sector = sector;
+				safe->x = obj->posWS.x;
+				safe->z = obj->posWS.z;
+				safe->yaw = obj->yaw;
+				sector->flags1 |= SEC_FLAGS1_SAFESECTOR;
+
+				freeObject(obj);
+				obj = nullptr;
+			} break;
+			default:
+			{
+				freeObject(obj);
+				obj = nullptr;
+				TFE_System::logWrite(LOG_ERROR, "Level Load", "Invalid Object Class: %d - Skipping Object.", classType);
+			}
+		}
+		return obj;
+	}
 
-					if (line)
+	// Build the level objects from the compiled O data in s_compiled.
+	JBool level_buildObjects(s32 curDiff)
+	{
+		s_compiled.pos = 0;
+
+		ObjCompiledSection section;
+		while (compiled_read(&s_compiled, &section) && section != OBJ_SECTION_END)
+		{
+			s32 count;
+			if (!compiled_read(&s_compiled, &count) || count < 0) { return level_buildObjectsError(); }
+
+			if (section == OBJ_SECTION_OBJECTS)
+			{
+				s_levelIntState.objectCount = count;
+				s32 recordCount;
+				if (!compiled_read(&s_compiled, &recordCount)) { return level_buildObjectsError(); }
+
+				for (s32 r = 0; r < recordCount; r++)
+				{
+					const char* objClass = compiled_readString(&s_compiled);
+					ObjCompiledObject data;
+					if (!objClass || !compiled_read(&s_compiled, &data)) { return level_buildObjectsError(); }
+
+					// The sequence is read even if the object was not created, to get to the next record.
+					SecObject* obj = level_createObject(objClass, &data, curDiff);
+					object_beginSeq();
+					JBool seqEnd = JFALSE;
+					for (s32 l = 0; l < data.seqLineCount; l++)
 					{
-						char name[32];
-						if (sscanf(line, " FME: %s ", name) == 1)
+						char* args[] = { s_objSeqArg0, s_objSeqArg1, s_objSeqArg2, s_objSeqArg3, s_objSeqArg4, s_objSeqArg5 };
+						if (!compiled_read(&s_compiled, &s_objSeqArgCount) || s_objSeqArgCount > s32(TFE_ARRAYSIZE(args))) { return level_buildObjectsError(); }
+						for (s32 a = 0; a < s_objSeqArgCount; a++)
 						{
-							s_levelIntState.frames[f] = TFE_Sprite_Jedi::getFrame(name);
-							if (!s_levelIntState.frames[f])
-							{
-								s_levelIntState.frames[f] = TFE_Sprite_Jedi::getFrame("default.fme");
-							}
+							const char* arg = compiled_readString(&s_compiled);
+							if (!arg) { return level_buildObjectsError(); }
+							strcpy(args[a], arg);
 						}
-						else
+						if (obj && !seqEnd)
 						{
-							TFE_System::logWrite(LOG_WARNING, "Level Load", "Unknown line in fme list '%s' - skipping.", line);
+							seqEnd = object_parseSeqLine(obj);
 						}
 					}
-				}
-			}
-			else if (sscanf(line, "SOUNDS %d", &s_levelIntState.soundCount) == 1)
-			{
-				s_levelIntState.soundIds = (SoundSourceId*)level_alloc(sizeof(SoundSourceId)*s_levelIntState.soundCount);
-				for (s32 s = 0; s < s_levelIntState.soundCount; s++)
-				{
-					line = parser.readLine(bufferPos);
-					s_levelIntState.soundIds[s] = NULL_SOUND;
 
-					if (line)
+					if (obj && (obj->entityFlags & ETFLAG_PLAYER))
 					{
-						char name[32];
-						if (sscanf(line, " SOUND: %s ", name) == 1)
+						if (!s_levelState.safeLoc)
 						{
-							s_levelIntState.soundIds[s] = sound_load(name, SOUND_PRIORITY_LOW2);
-						}
-						else
-						{
-							TFE_System::logWrite(LOG_WARNING, "Level Load", "Unknown line in sound list '%s' - skipping.", line);
+							s_levelState.safeLoc = allocator_create(sizeof(Safe));
 						}
+						Safe* safe = (Safe*)allocator_newItem(s_levelState.safeLoc);
+						safe->sector = obj->sector;
+						safe->x = obj->posWS.x;
+						safe->z = obj->posWS.z;
+						safe->yaw = obj->yaw;
+						obj->sector->flags1 |= SEC_FLAGS1_SAFESECTOR;
 					}
 				}
+				continue;
 			}
-			else if (sscanf(line, "OBJECTS %d", &s_levelIntState.objectCount) == 1)
+
+			// Asset lists, an empty name is no asset.
+			switch (section)
 			{
-				s32 count = s_levelIntState.objectCount;
-				JBool readNextLine = JTRUE;
-				for (s32 objIndex = 0; objIndex < count;)
+				case OBJ_SECTION_PODS:
 				{
-					if (readNextLine)
-					{
-						line = parser.readLine(bufferPos);
-						if (!line) { break; }
-					}
-					else
+					s_levelIntState.podCount = count;
+					s_levelIntState.pods = (JediModel**)level_alloc(sizeof(JediModel*)*count);
+					for (s32 p = 0; p < count; p++)
 					{
-						readNextLine = JTRUE;
-					}
+						const char* name = compiled_readString(&s_compiled);
+						if (!name) { return level_buildObjectsError(); }
 
-					s32 objDiff = 0;
-					f32 x, y, z, pch, yaw, rol;
-					char objClass[32];
-
-					if (sscanf(line, " CLASS: %s DATA: %d X: %f Y: %f Z: %f PCH: %f YAW: %f ROL: %f DIFF: %d", objClass, &s_dataIndex, &x, &y, &z, &pch, &yaw, &rol, &objDiff) > 5)
-					{
-						objIndex++;
-						// objDiff >= 0: This difficulty and all greater.
-						// objDiff <  0: Less than this difficulty.
-						if ((objDiff >= 0 && curDiff < objDiff) || (objDiff < 0 && curDiff > TFE_Jedi::abs(objDiff)))
+						s_levelIntState.pods[p] = nullptr;
+						if (name[0])
 						{
-							continue;
-						}
-
-						vec3_fixed posWS;
-						posWS.x = floatToFixed16(x);
-						posWS.y = floatToFixed16(y);
-						posWS.z = floatToFixed16(z);
-
-						// The DOS code allocated the object, tried to find the sector it is in and than frees the object
-						// if it doesn't fit.
-						// Instead TFE just reads the values and only allocates the object if it has a valid sector.
-						RSector* sector = sector_which3D(posWS.x, posWS.y, posWS.z);
-						if (!sector)
-						{
-							continue;
+							s_levelIntState.pods[p] = TFE_Model_Jedi::get(name);
+							if (!s_levelIntState.pods[p])
+							{
+								s_levelIntState.pods[p] = TFE_Model_Jedi::get("default.3do");
+							}
 						}
+					}
+				} break;
+				case OBJ_SECTION_SPRITES:
+				{
+					s_levelIntState.spriteCount = count;
+					s_levelIntState.sprites = (JediWax**)level_alloc(sizeof(JediWax*)*count);
+					for (s32 s = 0; s < count; s++)
+					{
+						const char* name = compiled_readString(&s_compiled);
+						if (!name) { return level_buildObjectsError(); }
 
-						SecObject* obj = allocateObject();
-						obj->posWS = posWS;
-						obj->pitch = floatDegreesToFixed(pch);
-						obj->yaw   = floatDegreesToFixed(yaw);
-						obj->roll  = floatDegreesToFixed(rol);
-
-						KEYWORD classType = getKeywordIndex(objClass);
-						switch (classType)
+						s_levelIntState.sprites[s] = nullptr;
+						if (name[0])
 						{
-							case KW_3D:
-							{
-								if (s_levelIntState.pods)
-								{
-									sector_addObject(sector, obj);
-									obj3d_setData(obj, s_levelIntState.pods[s_dataIndex]);
-									obj3d_computeTransform(obj);
-								}
-								else
-								{
-									freeObject(obj);
-									obj = nullptr;
-								}
-							} break;
-							case KW_SPRITE:
-							{
-								if (s_levelIntState.sprites)
-								{
-									sector_addObject(sector, obj);
-									sprite_setData(obj, s_levelIntState.sprites[s_dataIndex]);
-								}
-								else
-								{
-									freeObject(obj);
-									obj = nullptr;
-								}
-							} break;
-							case KW_FRAME:
-							{
-								if (s_levelIntState.frames)
-								{
-									sector_addObject(sector, obj);
-									frame_setData(obj, s_levelIntState.frames[s_dataIndex]);
-								}
-								else
-								{
-									freeObject(obj);
-									obj = nullptr;
-								}
-							} break;
-							case KW_SPIRIT:
-							{
-								sector_addObject(sector, obj);
-								spirit_setData(obj);
-							} break;
-							case KW_SOUND:
-							{
-								level_addAmbientSound(s_levelIntState.soundIds[s_dataIndex], obj->posWS);
-								freeObject(obj);
-								obj = nullptr;
-							} break;
-							case KW_SAFE:
-							{
-								if (!s_levelState.safeLoc)
-								{
-									s_levelState.safeLoc = allocator_create(sizeof(Safe));
-								}
-								Safe* safe = (Safe*)allocator_newItem(s_levelState.safeLoc);
-								safe->sector = sector;
-								safe->x = obj->posWS.x;
-								safe->z = obj->posWS.z;
-								safe->yaw = obj->yaw;
-								sector->flags1 |= SEC_FLAGS1_SAFESECTOR;
-
-								freeObject(obj);
-								obj = nullptr;
-							} break;
-							default:
+							s_levelIntState.sprites[s] = TFE_Sprite_Jedi::getWax(name);
+							if (!s_levelIntState.sprites[s])
 							{
-								freeObject(obj);
-								obj = nullptr;
-								TFE_System::logWrite(LOG_ERROR, "Level Load", "Invalid Object Class: %d - Skipping Object.", classType);
-								continue;
+								s_levelIntState.sprites[s] = TFE_Sprite_Jedi::getWax("default.wax");
 							}
 						}
+					}
+				} break;
+				case OBJ_SECTION_FRAMES:
+				{
+					s_levelIntState.fmeCount = count;
+					s_levelIntState.frames = (JediFrame**)level_alloc(sizeof(JediFrame*)*count);
+					for (s32 f = 0; f < count; f++)
+					{
+						const char* name = compiled_readString(&s_compiled);
+						if (!name) { return level_buildObjectsError(); }
 
-						if (obj)
+						s_levelIntState.frames[f] = nullptr;
+						if (name[0])
 						{
-							readNextLine = object_parseSeq(obj, &parser, &bufferPos);
-							if (obj->entityFlags & ETFLAG_PLAYER)
+							s_levelIntState.frames[f] = TFE_Sprite_Jedi::getFrame(name);
+							if (!s_levelIntState.frames[f])
 							{
-								if (!s_levelState.safeLoc)
-								{
-									s_levelState.safeLoc = allocator_create(sizeof(Safe));
-								}
-								Safe* safe = (Safe*)allocator_newItem(s_levelState.safeLoc);
-								safe->sector = obj->sector;
-								safe->x = obj->posWS.x;
-								safe->z = obj->posWS.z;
-								safe->yaw = obj->yaw;
-								sector->flags1 |= SEC_FLAGS1_SAFESECTOR;
+								s_levelIntState.frames[f] = TFE_Sprite_Jedi::getFrame("default.fme");
 							}
 						}
 					}
+				} break;
+				case OBJ_SECTION_SOUNDS:
+				{
+					s_levelIntState.soundCount = count;
+					s_levelIntState.soundIds = (SoundSourceId*)level_alloc(sizeof(SoundSourceId)*count);
+					for (s32 s = 0; s < count; s++)
+					{
+						const char* name = compiled_readString(&s_compiled);
+						if (!name) { return level_buildObjectsError(); }
+						s_levelIntState.soundIds[s] = name[0] ? sound_load(name, SOUND_PRIORITY_LOW2) : NULL_SOUND;
+					}
+				} break;
+				default:
+				{
+					return level_buildObjectsError();
 				}
 			}
 		}
-
 		return JTRUE;
 	}
 
@@ -42,6 +42,8 @@ namespace TFE_Jedi
 	void  level_freeAllAssets();
 
 	void level_serialize(Stream* stream);
+	// Copy the level state as is for in-place save states, see SERIALIZE_INPLACE().
+	void level_serializeInPlace(Stream* stream);
 
 	void setObjPos_AddToSector(SecObject* obj, s32 x, s32 y, s32 z, RSector* sector);
 	void getSkyParallax(fixed16_16* parallax0, fixed16_16* parallax1);
@@ -203,6 +203,7 @@ namespace TFE_Jedi
 		// Load Textures.
 		TextureData** texture = s_levelState.textures;
 		TextureData** texBase = s_levelState.textures + s_levelState.textureCount;
+		bitmap_beginDecompressBatch();
 		for (s32 i = 0; offset < dataEnd; i++, texture++, texBase++)
 		{
 			loadChunkHeader(data, offset, header);
@@ -224,6 +225,7 @@ namespace TFE_Jedi
 					{
 						TFE_System::logWrite(LOG_ERROR, "level_loadTextureListBin", "'default.bm' is not a valid BM file!");
 						assert(0);
+						bitmap_endDecompressBatch();
 						return false;
 					}
 				}
@@ -239,6 +241,7 @@ namespace TFE_Jedi
 				}
 			}
 		}
+		bitmap_endDecompressBatch();
 		return 0;
 	}
 		
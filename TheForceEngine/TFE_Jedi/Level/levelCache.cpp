@@ -0,0 +1,171 @@
+#include <cstring>
+
+#include "levelCache.h"
+#include <TFE_Archive/archive.h>
+#include <TFE_FileSystem/fileutil.h>
+#include <TFE_FileSystem/filestream.h>
+#include <TFE_System/system.h>
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include <TFE_Archive/zip/miniz.h>
+
+namespace TFE_Jedi
+{
+	enum LevelCacheConst : u32
+	{
+		LEVEL_CACHE_MAGIC = 0x43454654,	// "TFEC"
+		// Increment when the format of any compiled data changes.
+		LEVEL_CACHE_VERSION = 3,
+	};
+
+	struct LevelCacheHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 sourceHash;
+		u32 dataSize;
+		u32 dataHash;
+	};
+
+	static bool s_cacheDirValid = false;
+
+	/////////////////////////////////////////////
+	// Compiled data
+	/////////////////////////////////////////////
+	void compiled_clear(CompiledData* compiled)
+	{
+		compiled->data.clear();
+		compiled->pos = 0;
+	}
+
+	void compiled_writeBuffer(CompiledData* compiled, const void* buffer, size_t size)
+	{
+		const u8* data = (const u8*)buffer;
+		compiled->data.insert(compiled->data.end(), data, data + size);
+	}
+
+	void compiled_writeString(CompiledData* compiled, const char* str)
+	{
+		compiled_writeBuffer(compiled, str, strlen(str) + 1);
+	}
+
+	bool compiled_readBuffer(CompiledData* compiled, void* buffer, size_t size)
+	{
+		if (compiled->pos + size > compiled->data.size()) { return false; }
+		memcpy(buffer, compiled->data.data() + compiled->pos, size);
+		compiled->pos += size;
+		return true;
+	}
+
+	const char* compiled_readString(CompiledData* compiled)
+	{
+		if (compiled->pos >= compiled->data.size()) { return nullptr; }
+		const char* str = (const char*)compiled->data.data() + compiled->pos;
+		const char* end = (const char*)memchr(str, 0, compiled->data.size() - compiled->pos);
+		if (!end) { return nullptr; }
+		compiled->pos += size_t(end - str) + 1;
+		return str;
+	}
+
+	/////////////////////////////////////////////
+	// Cache files
+	/////////////////////////////////////////////
+	u32 levelCache_hash(const void* data, size_t size)
+	{
+		return u32(mz_crc32(MZ_CRC32_INIT, (const u8*)data, size));
+	}
+
+	u32 levelCache_getLocationKey(const FilePath* filePath)
+	{
+		const char* path = filePath->archive ? filePath->archive->getPath() : filePath->path;
+		u32 key = levelCache_hash(path, strlen(path));
+		if (filePath->archive)
+		{
+			key = u32(mz_crc32(key, (const u8*)&filePath->index, sizeof(u32)));
+		}
+		return key;
+	}
+
+	u32 levelCache_hashSource(const void* data, size_t size)
+	{
+		// Include the size so sources that only differ by trailing zeros do not match.
+		const u32 size32 = u32(size);
+		const u32 hash = levelCache_hash(data, size);
+		return u32(mz_crc32(hash, (const u8*)&size32, sizeof(u32)));
+	}
+
+	bool levelCache_getDir(char* cacheDir)
+	{
+		TFE_Paths::appendPath(PATH_PROGRAM_DATA, "Cache/", cacheDir);
+		if (!s_cacheDirValid)
+		{
+			if (!FileUtil::directoryExits(cacheDir) && !FileUtil::makeDirectory(cacheDir))
+			{
+				return false;
+			}
+			s_cacheDirValid = true;
+		}
+		return true;
+	}
+
+	bool levelCache_read(const char* fileName, u32 locationKey, u32 sourceHash, CompiledData* compiled)
+	{
+		compiled_clear(compiled);
+		char cacheDir[TFE_MAX_PATH];
+		if (!levelCache_getDir(cacheDir)) { return false; }
+
+		char path[TFE_MAX_PATH];
+		sprintf(path, "%s%s_%08X.tfc", cacheDir, fileName, locationKey);
+		FileStream file;
+		if (!file.open(path, Stream::MODE_READ)) { return false; }
+
+		LevelCacheHeader header;
+		bool valid = file.getSize() >= sizeof(LevelCacheHeader);
+		if (valid)
+		{
+			file.readBuffer(&header, sizeof(LevelCacheHeader));
+			valid = header.magic == LEVEL_CACHE_MAGIC && header.version == LEVEL_CACHE_VERSION && header.sourceHash == sourceHash &&
+				header.dataSize == file.getSize() - sizeof(LevelCacheHeader);
+		}
+		if (valid)
+		{
+			compiled->data.resize(header.dataSize);
+			file.readBuffer(compiled->data.data(), header.dataSize);
+			valid = levelCache_hash(compiled->data.data(), compiled->data.size()) == header.dataHash;
+		}
+		file.close();
+
+		// The source has changed since it was compiled, the cache is replaced once the source has been compiled again.
+		if (!valid)
+		{
+			compiled_clear(compiled);
+		}
+		return valid;
+	}
+
+	void levelCache_write(const char* fileName, u32 locationKey, u32 sourceHash, const CompiledData* compiled)
+	{
+		char cacheDir[TFE_MAX_PATH];
+		if (!levelCache_getDir(cacheDir)) { return; }
+
+		LevelCacheHeader header;
+		header.magic = LEVEL_CACHE_MAGIC;
+		header.version = LEVEL_CACHE_VERSION;
+		header.sourceHash = sourceHash;
+		header.dataSize = u32(compiled->data.size());
+		header.dataHash = levelCache_hash(compiled->data.data(), compiled->data.size());
+
+		// There is one cache file per source location, so this replaces the data compiled from an older version of the source.
+		char path[TFE_MAX_PATH];
+		sprintf(path, "%s%s_%08X.tfc", cacheDir, fileName, locationKey);
+		FileStream file;
+		if (!file.open(path, Stream::MODE_WRITE))
+		{
+			TFE_System::logWrite(LOG_WARNING, "LevelCache", "Cannot write cache file '%s'.", path);
+			return;
+		}
+		file.writeBuffer(&header, sizeof(LevelCacheHeader));
+		file.writeBuffer(compiled->data.data(), u32(compiled->data.size()));
+		file.close();
+	}
+}
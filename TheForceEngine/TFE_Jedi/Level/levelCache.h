@@ -0,0 +1,52 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// LevelCache
+// This was added for TFE and is not based on reverse-engineered code.
+// The level text files (LEV, O, INF) are compiled into binary records
+// which are stored in the user cache directory, so later loads of the
+// same text skip parsing. Cache files are named by the file name and
+// where the source was found, so sources with the same name in different
+// mods do not replace each other. The cached data is only used if the
+// hash of the source text and the cache format version match.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+#include <TFE_FileSystem/paths.h>
+#include <vector>
+
+namespace TFE_Jedi
+{
+	// Compiled data is a flat sequence of values and null-terminated strings, read back in the order it was written.
+	struct CompiledData
+	{
+		std::vector<u8> data;
+		size_t pos;
+	};
+
+	void compiled_clear(CompiledData* compiled);
+	void compiled_writeBuffer(CompiledData* compiled, const void* buffer, size_t size);
+	void compiled_writeString(CompiledData* compiled, const char* str);
+	bool compiled_readBuffer(CompiledData* compiled, void* buffer, size_t size);
+	// Returns nullptr if there is no complete string left to read.
+	const char* compiled_readString(CompiledData* compiled);
+
+	template<typename T>
+	void compiled_write(CompiledData* compiled, const T& value)
+	{
+		compiled_writeBuffer(compiled, &value, sizeof(T));
+	}
+
+	template<typename T>
+	bool compiled_read(CompiledData* compiled, T* value)
+	{
+		return compiled_readBuffer(compiled, value, sizeof(T));
+	}
+
+	// Returns the key identifying where the source file was found (the archive or directory and index in the archive).
+	u32  levelCache_getLocationKey(const FilePath* filePath);
+	// Returns the hash of the source text that the compiled data must match.
+	u32  levelCache_hashSource(const void* data, size_t size);
+	// Read the compiled data for 'fileName', returns false if there is no cache or it was compiled from a different source.
+	bool levelCache_read(const char* fileName, u32 locationKey, u32 sourceHash, CompiledData* compiled);
+	// Write the compiled data for 'fileName', replacing the data compiled from an older version of the source.
+	void levelCache_write(const char* fileName, u32 locationKey, u32 sourceHash, const CompiledData* compiled);
+}
@@ -105,6 +105,14 @@ namespace TFE_Jedi
 		s_secretsPercent = max(0, min(100, s_secretsPercent));
 	}
 		
+	void level_serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(s_levelState);
+		SERIALIZE_INPLACE(s_levelIntState);
+		SERIALIZE_INPLACE(TFE_DarkForces::s_secretsFound);
+		SERIALIZE_INPLACE(TFE_DarkForces::s_secretsPercent);
+	}
+
 	void level_serialize(Stream* stream)
 	{
 		bool debug = serialization_getMode() == SMODE_WRITE;
@@ -303,10 +311,13 @@ namespace TFE_Jedi
 		{
 			sector->self = sector;
 		}
-		SERIALIZE(LevelState_InitVersion, sector->id, 0);
-		SERIALIZE(LevelState_InitVersion, sector->index, 0);
-		SERIALIZE(LevelState_InitVersion, sector->prevDrawFrame, 0);
-		SERIALIZE(LevelState_InitVersion, sector->prevDrawFrame2, 0);
+		if (!SERIALIZE_RUN(LevelState_InitVersion, RSector, sector, id, prevDrawFrame2, 4 * sizeof(s32)))
+		{
+			SERIALIZE(LevelState_InitVersion, sector->id, 0);
+			SERIALIZE(LevelState_InitVersion, sector->index, 0);
+			SERIALIZE(LevelState_InitVersion, sector->prevDrawFrame, 0);
+			SERIALIZE(LevelState_InitVersion, sector->prevDrawFrame2, 0);
+		}
 
 		SERIALIZE(LevelState_InitVersion, sector->vertexCount, 0);
 		const size_t vtxSize = sector->vertexCount * sizeof(vec2_fixed);
@@ -315,7 +326,7 @@ namespace TFE_Jedi
 			sector->verticesWS = (vec2_fixed*)level_alloc(vtxSize);
 			sector->verticesVS = (vec2_fixed*)level_alloc(vtxSize);
 		}
-		SERIALIZE_BUF(LevelState_InitVersion, sector->verticesWS, u32(vtxSize));
+		SERIALIZE_ARRAY(LevelState_InitVersion, sector->verticesWS, sector->vertexCount);
 		// view space vertices don't need to be serialized.
 
 		SERIALIZE(LevelState_InitVersion, sector->wallCount, 0);
@@ -329,15 +340,19 @@ namespace TFE_Jedi
 			level_serializeWall(stream, wall, sector);
 		}
 
-		SERIALIZE(LevelState_InitVersion, sector->floorHeight, 0);
-		SERIALIZE(LevelState_InitVersion, sector->ceilingHeight, 0);
-		SERIALIZE(LevelState_InitVersion, sector->secHeight, 0);
-		SERIALIZE(LevelState_InitVersion, sector->ambient, 0);
-
-		SERIALIZE(LevelState_InitVersion, sector->colFloorHeight, 0);
-		SERIALIZE(LevelState_InitVersion, sector->colCeilHeight, 0);
-		SERIALIZE(LevelState_InitVersion, sector->colSecHeight, 0);
-		SERIALIZE(LevelState_InitVersion, sector->colSecCeilHeight, 0);
+		// Render and collision heights.
+		if (!SERIALIZE_RUN(LevelState_InitVersion, RSector, sector, floorHeight, colSecCeilHeight, 8 * sizeof(fixed16_16)))
+		{
+			SERIALIZE(LevelState_InitVersion, sector->floorHeight, 0);
+			SERIALIZE(LevelState_InitVersion, sector->ceilingHeight, 0);
+			SERIALIZE(LevelState_InitVersion, sector->secHeight, 0);
+			SERIALIZE(LevelState_InitVersion, sector->ambient, 0);
+
+			SERIALIZE(LevelState_InitVersion, sector->colFloorHeight, 0);
+			SERIALIZE(LevelState_InitVersion, sector->colCeilHeight, 0);
+			SERIALIZE(LevelState_InitVersion, sector->colSecHeight, 0);
+			SERIALIZE(LevelState_InitVersion, sector->colSecCeilHeight, 0);
+		}
 
 		// infLink will be set when the INF system is serialized.
 		if (serialization_getMode() == SMODE_READ)
@@ -349,8 +364,11 @@ namespace TFE_Jedi
 		level_serializeTexturePointer(stream, sector->ceilTex);
 
 		const vec2_fixed def = { 0,0 };
-		SERIALIZE(LevelState_InitVersion, sector->floorOffset, def);
-		SERIALIZE(LevelState_InitVersion, sector->ceilOffset, def);
+		if (!SERIALIZE_RUN(LevelState_InitVersion, RSector, sector, floorOffset, ceilOffset, 2 * sizeof(vec2_fixed)))
+		{
+			SERIALIZE(LevelState_InitVersion, sector->floorOffset, def);
+			SERIALIZE(LevelState_InitVersion, sector->ceilOffset, def);
+		}
 
 		// Objects are handled seperately and added to the sector later, so just initialize the object data.
 		if (serialization_getMode() == SMODE_READ)
@@ -360,15 +378,18 @@ namespace TFE_Jedi
 			sector->objectList = nullptr;
 		}
 
-		SERIALIZE(LevelState_InitVersion, sector->collisionFrame, 0);
-		SERIALIZE(LevelState_InitVersion, sector->startWall, 0);
-		SERIALIZE(LevelState_InitVersion, sector->drawWallCnt, 0);
-		SERIALIZE(LevelState_InitVersion, sector->flags1, 0);
-		SERIALIZE(LevelState_InitVersion, sector->flags2, 0);
-		SERIALIZE(LevelState_InitVersion, sector->flags3, 0);
-		SERIALIZE(LevelState_InitVersion, sector->layer, 0);
-		SERIALIZE(LevelState_InitVersion, sector->boundsMin, def);
-		SERIALIZE(LevelState_InitVersion, sector->boundsMax, def);
+		if (!SERIALIZE_RUN(LevelState_InitVersion, RSector, sector, collisionFrame, boundsMax, 7 * sizeof(s32) + 2 * sizeof(vec2_fixed)))
+		{
+			SERIALIZE(LevelState_InitVersion, sector->collisionFrame, 0);
+			SERIALIZE(LevelState_InitVersion, sector->startWall, 0);
+			SERIALIZE(LevelState_InitVersion, sector->drawWallCnt, 0);
+			SERIALIZE(LevelState_InitVersion, sector->flags1, 0);
+			SERIALIZE(LevelState_InitVersion, sector->flags2, 0);
+			SERIALIZE(LevelState_InitVersion, sector->flags3, 0);
+			SERIALIZE(LevelState_InitVersion, sector->layer, 0);
+			SERIALIZE(LevelState_InitVersion, sector->boundsMin, def);
+			SERIALIZE(LevelState_InitVersion, sector->boundsMax, def);
+		}
 
 		// dirty flags will be set on deserialization.
 		if (serialization_getMode() == SMODE_READ)
@@ -399,9 +420,12 @@ namespace TFE_Jedi
 				
 	void level_serializeWall(Stream* stream, RWall* wall, RSector* sector)
 	{
-		SERIALIZE(LevelState_InitVersion, wall->id, 0);
-		SERIALIZE(LevelState_InitVersion, wall->seen, 0);
-		SERIALIZE(LevelState_InitVersion, wall->visible, 0);
+		if (!SERIALIZE_RUN(LevelState_InitVersion, RWall, wall, id, visible, 2 * sizeof(s32) + sizeof(JBool)))
+		{
+			SERIALIZE(LevelState_InitVersion, wall->id, 0);
+			SERIALIZE(LevelState_InitVersion, wall->seen, 0);
+			SERIALIZE(LevelState_InitVersion, wall->visible, 0);
+		}
 
 		serialization_serializeSectorPtr(stream, LevelState_InitVersion, wall->sector);
 		serialization_serializeSectorPtr(stream, LevelState_InitVersion, wall->nextSector);
@@ -446,21 +470,25 @@ namespace TFE_Jedi
 		level_serializeTexturePointer(stream, wall->botTex);
 		level_serializeTexturePointer(stream, wall->signTex);
 
-		SERIALIZE(LevelState_InitVersion, wall->texelLength, 0);
-		SERIALIZE(LevelState_InitVersion, wall->topTexelHeight, 0);
-		SERIALIZE(LevelState_InitVersion, wall->midTexelHeight, 0);
-		SERIALIZE(LevelState_InitVersion, wall->botTexelHeight, 0);
-
+		// Texel sizes, texture offsets, direction and frame tracking.
 		const vec2_fixed def = { 0, 0 };
-		SERIALIZE(LevelState_InitVersion, wall->topOffset, def);
-		SERIALIZE(LevelState_InitVersion, wall->midOffset, def);
-		SERIALIZE(LevelState_InitVersion, wall->botOffset, def);
-		SERIALIZE(LevelState_InitVersion, wall->signOffset, def);
-
-		SERIALIZE(LevelState_InitVersion, wall->wallDir, def);
-		SERIALIZE(LevelState_InitVersion, wall->length, 0);
-		SERIALIZE(LevelState_InitVersion, wall->collisionFrame, 0);
-		SERIALIZE(LevelState_InitVersion, wall->drawFrame, 0);
+		if (!SERIALIZE_RUN(LevelState_InitVersion, RWall, wall, texelLength, drawFrame, 7 * sizeof(s32) + 5 * sizeof(vec2_fixed)))
+		{
+			SERIALIZE(LevelState_InitVersion, wall->texelLength, 0);
+			SERIALIZE(LevelState_InitVersion, wall->topTexelHeight, 0);
+			SERIALIZE(LevelState_InitVersion, wall->midTexelHeight, 0);
+			SERIALIZE(LevelState_InitVersion, wall->botTexelHeight, 0);
+
+			SERIALIZE(LevelState_InitVersion, wall->topOffset, def);
+			SERIALIZE(LevelState_InitVersion, wall->midOffset, def);
+			SERIALIZE(LevelState_InitVersion, wall->botOffset, def);
+			SERIALIZE(LevelState_InitVersion, wall->signOffset, def);
+
+			SERIALIZE(LevelState_InitVersion, wall->wallDir, def);
+			SERIALIZE(LevelState_InitVersion, wall->length, 0);
+			SERIALIZE(LevelState_InitVersion, wall->collisionFrame, 0);
+			SERIALIZE(LevelState_InitVersion, wall->drawFrame, 0);
+		}
 
 		// infLink will be filled in when serializing the INF system.
 		if (serialization_getMode() == SMODE_READ)
@@ -468,12 +496,15 @@ namespace TFE_Jedi
 			wall->infLink = nullptr;
 		}
 
-		SERIALIZE(LevelState_InitVersion, wall->flags1, 0);
-		SERIALIZE(LevelState_InitVersion, wall->flags2, 0);
-		SERIALIZE(LevelState_InitVersion, wall->flags3, 0);
+		if (!SERIALIZE_RUN(LevelState_InitVersion, RWall, wall, flags1, angle, 3 * sizeof(u32) + sizeof(vec2_fixed) + sizeof(fixed16_16) + sizeof(angle14_32)))
+		{
+			SERIALIZE(LevelState_InitVersion, wall->flags1, 0);
+			SERIALIZE(LevelState_InitVersion, wall->flags2, 0);
+			SERIALIZE(LevelState_InitVersion, wall->flags3, 0);
 
-		SERIALIZE(LevelState_InitVersion, wall->worldPos0, def);
-		SERIALIZE(LevelState_InitVersion, wall->wallLight, 0);
-		SERIALIZE(LevelState_InitVersion, wall->angle, 0);
+			SERIALIZE(LevelState_InitVersion, wall->worldPos0, def);
+			SERIALIZE(LevelState_InitVersion, wall->wallLight, 0);
+			SERIALIZE(LevelState_InitVersion, wall->angle, 0);
+		}
 	}
 }
@@ -60,13 +60,19 @@ namespace TFE_Jedi
 		}
 
 		const vec3_fixed def = { 0 };
-		SERIALIZE(ObjState_InitVersion, obj->type, ObjectType::OBJ_TYPE_SPIRIT);
-		SERIALIZE(ObjState_InitVersion, obj->entityFlags, 0);
+		if (!SERIALIZE_RUN(ObjState_InitVersion, SecObject, obj, type, entityFlags, sizeof(ObjectType) + sizeof(u32)))
+		{
+			SERIALIZE(ObjState_InitVersion, obj->type, ObjectType::OBJ_TYPE_SPIRIT);
+			SERIALIZE(ObjState_InitVersion, obj->entityFlags, 0);
+		}
 		SERIALIZE(ObjState_InitVersion, obj->posWS, def);
 		// obj->posVS is derived at runtime.
 
-		SERIALIZE(ObjState_InitVersion, obj->worldWidth,  -1);
-		SERIALIZE(ObjState_InitVersion, obj->worldHeight, -1);
+		if (!SERIALIZE_RUN(ObjState_InitVersion, SecObject, obj, worldWidth, worldHeight, 2 * sizeof(fixed16_16)))
+		{
+			SERIALIZE(ObjState_InitVersion, obj->worldWidth,  -1);
+			SERIALIZE(ObjState_InitVersion, obj->worldHeight, -1);
+		}
 		if (obj->type == OBJ_TYPE_3D)
 		{
 			SERIALIZE_BUF(ObjState_InitVersion, obj->transform, TFE_ARRAYSIZE(obj->transform) * sizeof(fixed16_16));
@@ -94,15 +100,21 @@ namespace TFE_Jedi
 			obj->ptr = nullptr;
 		}
 		
-		SERIALIZE(ObjState_InitVersion, obj->frame, 0);
-		SERIALIZE(ObjState_InitVersion, obj->anim, 0);
+		if (!SERIALIZE_RUN(ObjState_InitVersion, SecObject, obj, frame, anim, 2 * sizeof(s32)))
+		{
+			SERIALIZE(ObjState_InitVersion, obj->frame, 0);
+			SERIALIZE(ObjState_InitVersion, obj->anim, 0);
+		}
 		serialization_serializeSectorPtr(stream, ObjState_InitVersion, obj->sector);
 		assert(obj && obj->sector && obj->sector->id == obj->sector->index);
 
-		SERIALIZE(ObjState_InitVersion, obj->flags, 0);
-		SERIALIZE(ObjState_InitVersion, obj->pitch, 0);
-		SERIALIZE(ObjState_InitVersion, obj->yaw, 0);
-		SERIALIZE(ObjState_InitVersion, obj->roll, 0);
+		if (!SERIALIZE_RUN(ObjState_InitVersion, SecObject, obj, flags, roll, sizeof(u32) + 3 * sizeof(angle14_16)))
+		{
+			SERIALIZE(ObjState_InitVersion, obj->flags, 0);
+			SERIALIZE(ObjState_InitVersion, obj->pitch, 0);
+			SERIALIZE(ObjState_InitVersion, obj->yaw, 0);
+			SERIALIZE(ObjState_InitVersion, obj->roll, 0);
+		}
 
 		// obj->index will be reset once the object is re-added to its sector.
 		if (serialization_getMode() == SMODE_READ)
@@ -8,10 +8,18 @@
 #include <TFE_FileSystem/fileutil.h>
 #include <TFE_FileSystem/paths.h>
 #include <TFE_FileSystem/filestream.h>
+#include <TFE_FileSystem/mappedfile.h>
+#include <TFE_Settings/settings.h>
+#define MINIZ_HEADER_FILE_ONLY
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include <TFE_Archive/zip/miniz.h>
 #include <TFE_Jedi/Task/task.h>
 #include <TFE_Jedi/Serialization/serialization.h>
 #include <TFE_System/math.h>
 #include <unordered_map>
+#include <SDL_cpuinfo.h>
+#include <SDL_thread.h>
+#include <SDL_atomic.h>
 
 using namespace TFE_DarkForces;
 using namespace TFE_Memory;
@@ -46,8 +54,94 @@ namespace TFE_Jedi
 	static TextureList  s_textureList[POOL_COUNT];
 	static TextureTable s_textureTable[POOL_COUNT];
 
+	// TFE: HD texture cache.
+	// HD textures are stored bottom-up and have to be flipped into the engine's layout after loading.
+	// The flipped images are written to the user cache directory so later loads can map them directly.
+	enum HdCacheConst : u32
+	{
+		HD_CACHE_MAGIC = 0x48454654,	// "TFEH"
+		HD_CACHE_VERSION = 1,
+		HD_CACHE_COMPRESSED = (1 << 0),
+		HD_CACHE_DATA_OFFSET = 64,		// Keeps the image data aligned in mapped files.
+	};
+
+	struct HdCacheHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 sourceKey;
+		u32 flags;
+		s32 width;
+		s32 height;
+		s32 frameCount;
+		u32 dataSize;		// Image data size in memory.
+		u32 storedSize;		// Image data size in the file.
+	};
+
+	// Everything needed to load the HD image for a texture.
+	struct HdLoadInfo
+	{
+		char hdPath[TFE_MAX_PATH];
+		char cachePath[TFE_MAX_PATH];
+		FilePath filepath;
+		HdCacheHeader cacheHeader;
+		bool useCache;
+	};
+
+	// TFE: HD texture streaming.
+	// When enabled, the HD data for non-animated textures is only loaded once the renderer has seen the texture.
+	// The data is released as soon as the renderer has copied it into the atlas space reserved at level load.
+	enum HdStreamConst
+	{
+		HD_STREAM_LOADS_PER_FRAME = 4,
+	};
+
+	struct HdStreamSource
+	{
+		TextureData* texture;
+		HdLoadInfo info;
+		AssetPool pool;
+		MappedFile* mapping;	// Set if the resident data is a mapped cache file.
+		bool requested;
+		bool failed;
+	};
+
+	// Mapped cache files, these stay open while textures in the pool may reference them.
+	static std::vector<MappedFile*> s_hdMappings[POOL_COUNT];
+	static std::vector<u8> s_hdCompressed;
+	static bool s_hdCacheDirValid = false;
+
+	static std::vector<HdStreamSource*> s_hdStreamSources;
+	static std::vector<HdStreamSource*> s_hdStreamRequests;
+	static std::unordered_map<const TextureData*, HdStreamSource*> s_hdStreamMap;
+
+	// TFE: Batched texture decompression.
+	// While a batch is open, compressed textures are allocated but decoded later, when the batch ends, using worker threads.
+	enum DecompressConst
+	{
+		DECOMPRESS_MAX_THREADS = 8,
+		DECOMPRESS_MIN_PARALLEL_PIXELS = 256 * 1024,	// Below this it isn't worth starting threads.
+	};
+
+	struct DecompressJob
+	{
+		u8* compressed;		// Copy of the compressed data followed by the column table.
+		u32 columnOffset;
+		u8* image;
+		s32 width;
+		s32 height;
+		s32 type;
+	};
+
+	static std::vector<DecompressJob> s_decompressJobs;
+	static SDL_atomic_t s_decompressNext;
+	static s32 s_decompressBatch = 0;
+
 	void decompressColumn_Type1(const u8* src, u8* dst, s32 pixelCount);
 	void decompressColumn_Type2(const u8* src, u8* dst, s32 pixelCount);
+	void bitmap_decompressImage(const u8* inBuffer, const u32* columns, u8* image, s32 width, s32 height, s32 type);
+	void bitmap_decompressQueued();
+	void bitmap_queueDecompress(const u8* inBuffer, s32 inSize, const u32* columns, u8* image, s32 width, s32 height, s32 type);
 	void textureAnimationTaskFunc(MessageType msg);
 
 	u8 readByte(const u8*& data)
@@ -100,11 +194,63 @@ namespace TFE_Jedi
 		s_texState.memoryRegion = allocator;
 	}
 		
+	void bitmap_closeHdMappings(AssetPool pool)
+	{
+		for (size_t i = 0; i < s_hdMappings[pool].size(); i++)
+		{
+			delete s_hdMappings[pool][i];
+		}
+		s_hdMappings[pool].clear();
+	}
+
+	void bitmap_evictHdData(HdStreamSource* source)
+	{
+		TextureData* texture = source->texture;
+		if (!texture->hdAssetData) { return; }
+
+		if (source->mapping)
+		{
+			delete source->mapping;
+			source->mapping = nullptr;
+		}
+		else
+		{
+			free(texture->hdAssetData);
+		}
+		texture->hdAssetData = nullptr;
+	}
+
+	void bitmap_freeHdStreamSources(AssetPool pool)
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < s_hdStreamSources.size(); i++)
+		{
+			HdStreamSource* source = s_hdStreamSources[i];
+			if (source->pool == pool)
+			{
+				bitmap_evictHdData(source);
+				s_hdStreamMap.erase(source->texture);
+				delete source;
+			}
+			else
+			{
+				s_hdStreamSources[count++] = source;
+			}
+		}
+		s_hdStreamSources.resize(count);
+		s_hdStreamRequests.clear();
+	}
+
 	// Added for TFE to clear out per-level texture data.
 	void bitmap_clearLevelData()
 	{
+		// Finish any batch left open by a failed load before the memory is released.
+		s_decompressBatch = 0;
+		bitmap_decompressQueued();
 		s_textureList[POOL_LEVEL].clear();
 		s_textureTable[POOL_LEVEL].clear();
+		bitmap_closeHdMappings(POOL_LEVEL);
+		bitmap_freeHdStreamSources(POOL_LEVEL);
 	}
 
 	void bitmap_clearAll()
@@ -114,6 +260,8 @@ namespace TFE_Jedi
 		{
 			s_textureList[p].clear();
 			s_textureTable[p].clear();
+			bitmap_closeHdMappings(AssetPool(p));
+			bitmap_freeHdStreamSources(AssetPool(p));
 		}
 	}
 
@@ -163,6 +311,7 @@ namespace TFE_Jedi
 		}
 		list = s_textureList[POOL_LEVEL].data();
 
+		bitmap_beginDecompressBatch();
 		for (s32 i = 0; i < count; i++, list++)
 		{
 			// Assume names are less than 256 characters.
@@ -186,6 +335,7 @@ namespace TFE_Jedi
 				s_textureTable[POOL_LEVEL][name] = i;
 			}
 		}
+		bitmap_endDecompressBatch();
 	}
 		
 	TextureData** bitmap_getTextures(s32* textureCount, AssetPool pool)
@@ -203,24 +353,154 @@ namespace TFE_Jedi
 		return list;
 	}
 
-	void bitmap_loadHD(const char* name, TextureData* texData, s32 scaleFactor, AssetPool pool)
+	// Identify the source by its location, size and modification time so it doesn't need to be read to validate the cache.
+	u32 bitmap_getHdSourceKey(const char* name, const FilePath* filepath, s32 width, s32 height, s32 frameCount)
 	{
-		char hdPath[TFE_MAX_PATH];
-		FileUtil::replaceExtension(name, "raw", hdPath);
+		const char* sourcePath = filepath->archive ? filepath->archive->getPath() : filepath->path;
+		u64 sourceSize = 0;
+		if (filepath->archive)
+		{
+			sourceSize = filepath->archive->getFileLength(filepath->index);
+		}
+		else
+		{
+			FileStream file;
+			if (file.open(filepath, Stream::MODE_READ))
+			{
+				sourceSize = file.getSize();
+				file.close();
+			}
+		}
+		const u64 values[] = { FileUtil::getModifiedTime(sourcePath), sourceSize, u64(filepath->index), u64(width), u64(height), u64(frameCount) };
 
-		texData->scaleFactor = 1;
-		texData->hdAssetData = nullptr;
-		// If the file doesn't exist, just return - there is no HD asset.
-		FilePath filepath;
-		if (!TFE_Paths::getFilePath(hdPath, &filepath))
+		mz_ulong key = mz_crc32(MZ_CRC32_INIT, (const u8*)name, strlen(name));
+		key = mz_crc32(key, (const u8*)sourcePath, strlen(sourcePath));
+		key = mz_crc32(key, (const u8*)values, sizeof(values));
+		return u32(key);
+	}
+
+	bool bitmap_getHdCachePath(const char* name, u32 sourceKey, char* path)
+	{
+		char cacheDir[TFE_MAX_PATH];
+		TFE_Paths::appendPath(PATH_PROGRAM_DATA, "Cache/HD/", cacheDir);
+		if (!s_hdCacheDirValid)
 		{
-			return;
+			if (!FileUtil::directoryExits(cacheDir) && !FileUtil::makeDirectory(cacheDir))
+			{
+				return false;
+			}
+			s_hdCacheDirValid = true;
+		}
+		snprintf(path, TFE_MAX_PATH, "%s%s_%08X.thd", cacheDir, name, sourceKey);
+		return true;
+	}
+
+	// Allocate HD data from 'region', or from the heap if it is null so it can be freed individually.
+	u8* bitmap_allocHd(MemoryRegion* region, size_t size)
+	{
+		return region ? (u8*)region_alloc(region, size) : (u8*)malloc(size);
+	}
+
+	void bitmap_freeHd(MemoryRegion* region, u8* data)
+	{
+		if (region) { region_free(region, data); }
+		else { free(data); }
+	}
+
+	bool bitmap_readHdCache(const HdLoadInfo* info, MemoryRegion* region, u8** outData, MappedFile** outMapping)
+	{
+		const char* cachePath = info->cachePath;
+		const HdCacheHeader* expected = &info->cacheHeader;
+
+		MappedFile* file = new MappedFile();
+		if (!file->open(cachePath))
+		{
+			delete file;
+			return false;
+		}
+
+		HdCacheHeader header;
+		bool valid = file->getSize() >= HD_CACHE_DATA_OFFSET;
+		if (valid)
+		{
+			memcpy(&header, file->data(), sizeof(HdCacheHeader));
+			valid = header.magic == HD_CACHE_MAGIC && header.version == HD_CACHE_VERSION && header.sourceKey == expected->sourceKey &&
+				header.width == expected->width && header.height == expected->height && header.frameCount == expected->frameCount &&
+				header.dataSize == expected->dataSize && header.storedSize == file->getSize() - HD_CACHE_DATA_OFFSET;
+		}
+
+		const u8* storedData = file->data() + HD_CACHE_DATA_OFFSET;
+		if (valid && !(header.flags & HD_CACHE_COMPRESSED))
+		{
+			// Use the mapped data directly, pages are read in as the texture is uploaded.
+			*outData = file->data() + HD_CACHE_DATA_OFFSET;
+			*outMapping = file;
+			return true;
+		}
+		else if (valid)
+		{
+			u8* data = bitmap_allocHd(region, header.dataSize);
+			mz_ulong size = header.dataSize;
+			valid = mz_uncompress(data, &size, storedData, header.storedSize) == MZ_OK && size == header.dataSize;
+			if (valid)
+			{
+				*outData = data;
+			}
+			else
+			{
+				bitmap_freeHd(region, data);
+			}
+		}
+		delete file;
+
+		if (!valid)
+		{
+			TFE_System::logWrite(LOG_WARNING, "bitmap_loadHD", "HD cache file '%s' is invalid, it will be rebuilt.", cachePath);
 		}
+		return valid;
+	}
+
+	void bitmap_writeHdCache(const HdLoadInfo* info, const u8* data)
+	{
+		const char* cachePath = info->cachePath;
+		HdCacheHeader header = info->cacheHeader;
+		header.flags = 0;
+		header.storedSize = header.dataSize;
+
+		const u8* storedData = data;
+		if (TFE_Settings::getEnhancementsSettings()->compressHdTextureCache)
+		{
+			mz_ulong compressedSize = mz_compressBound(header.dataSize);
+			s_hdCompressed.resize(compressedSize);
+			if (mz_compress2(s_hdCompressed.data(), &compressedSize, data, header.dataSize, MZ_DEFAULT_LEVEL) == MZ_OK && compressedSize < header.dataSize)
+			{
+				header.flags |= HD_CACHE_COMPRESSED;
+				header.storedSize = u32(compressedSize);
+				storedData = s_hdCompressed.data();
+			}
+		}
+
 		FileStream file;
-		if (!file.open(&filepath, Stream::MODE_READ))
+		if (!file.open(cachePath, Stream::MODE_WRITE))
 		{
+			TFE_System::logWrite(LOG_WARNING, "bitmap_loadHD", "Cannot write HD cache file '%s'.", cachePath);
 			return;
 		}
+		u8 headerData[HD_CACHE_DATA_OFFSET] = { 0 };
+		memcpy(headerData, &header, sizeof(HdCacheHeader));
+		file.writeBuffer(headerData, HD_CACHE_DATA_OFFSET);
+		file.writeBuffer(storedData, header.storedSize);
+		file.close();
+	}
+
+	// Read the source image, flip it into the engine's layout and add it to the cache.
+	bool bitmap_readHdSource(const HdLoadInfo* info, MemoryRegion* region, u8** outData)
+	{
+		FileStream file;
+		if (!file.open(&info->filepath, Stream::MODE_READ))
+		{
+			return false;
+		}
 
 		// Load the raw data from disk.
 		size_t size = file.getSize();
@@ -228,6 +508,49 @@ namespace TFE_Jedi
 		file.readBuffer(s_buffer.data(), (u32)size);
 		file.close();
 
+		// Verify this is a valid texture.
+		const s32 width = info->cacheHeader.width;
+		const s32 height = info->cacheHeader.height;
+		const s32 frameCount = info->cacheHeader.frameCount;
+		const s32 hdFrameSize = width * height * 4;
+		if (size < hdFrameSize * frameCount)
+		{
+			return false;
+		}
+
+		// Process the HD data.
+		u8* hdData = bitmap_allocHd(region, hdFrameSize * frameCount);
+		u8* dstData = hdData;
+		const u8* srcData = s_buffer.data();
+		for (s32 i = 0; i < frameCount; i++)
+		{
+			for (s32 y = 0; y < height; y++)
+			{
+				memcpy(&dstData[y*width*4], &srcData[(height - y - 1)*width*4], width * 4);
+			}
+			dstData += hdFrameSize;
+			srcData += hdFrameSize;
+		}
+
+		if (info->useCache)
+		{
+			bitmap_writeHdCache(info, hdData);
+		}
+		*outData = hdData;
+		return true;
+	}
+
+	// Returns false if there is no HD version of the texture.
+	bool bitmap_getHdLoadInfo(const char* name, const TextureData* texData, s32 scaleFactor, HdLoadInfo* info)
+	{
+		FileUtil::replaceExtension(name, "raw", info->hdPath);
+
+		// If the file doesn't exist, just return - there is no HD asset.
+		if (!TFE_Paths::getFilePath(info->hdPath, &info->filepath))
+		{
+			return false;
+		}
+
 		// Process the data based on the base texture.
 		s32 width  = texData->width  * scaleFactor;
 		s32 height = texData->height * scaleFactor;
@@ -243,31 +566,121 @@ namespace TFE_Jedi
 			frameCount = texData->uvHeight;
 		}
 
-		const s32 hdFrameSize = width * height * 4;
-		// Verify this is a valid texture.
-		if (size < hdFrameSize * frameCount)
+		info->cacheHeader = { HD_CACHE_MAGIC, HD_CACHE_VERSION, 0, 0, width, height, frameCount, u32(width * height * 4 * frameCount), 0 };
+		info->cacheHeader.sourceKey = bitmap_getHdSourceKey(info->hdPath, &info->filepath, width, height, frameCount);
+		info->useCache = bitmap_getHdCachePath(info->hdPath, info->cacheHeader.sourceKey, info->cachePath);
+		return true;
+	}
+
+	// Try the cache first, which is already in the final layout.
+	bool bitmap_loadHdImage(const HdLoadInfo* info, MemoryRegion* region, u8** outData, MappedFile** outMapping)
+	{
+		*outData = nullptr;
+		*outMapping = nullptr;
+		if (info->useCache && bitmap_readHdCache(info, region, outData, outMapping))
+		{
+			return true;
+		}
+		return bitmap_readHdSource(info, region, outData);
+	}
+
+	void bitmap_loadHD(const char* name, TextureData* texData, s32 scaleFactor, AssetPool pool)
+	{
+		texData->scaleFactor = 1;
+		texData->hdAssetData = nullptr;
+
+		HdLoadInfo info;
+		if (!bitmap_getHdLoadInfo(name, texData, scaleFactor, &info))
 		{
 			return;
 		}
 
-		// Process the HD data.
-		texData->scaleFactor = scaleFactor;
-		texData->hdAssetData = (u8*)region_alloc(s_texState.memoryRegion, hdFrameSize * frameCount);
-		memset(texData->hdAssetData, 0, hdFrameSize * frameCount);
-		
-		u8* dstData = texData->hdAssetData;
-		const u8* srcData = s_buffer.data();
-		for (s32 i = 0; i < frameCount; i++)
+		// Streamed textures keep the HD scale factor so full size atlas space is still reserved for the HD data, only
+		// reading and decoding the file waits until the texture is seen. Animated textures share one HD image between frames and are always loaded up front, as are
+		// game textures which stay in the reserved atlas pages.
+		if (TFE_Settings::getEnhancementsSettings()->streamHdTextures && pool == POOL_LEVEL && texData->uvWidth != BM_ANIMATED_TEXTURE)
 		{
-			for (s32 y = 0; y < height; y++)
+			HdStreamSource* source = new HdStreamSource();
+			source->texture = texData;
+			source->info = info;
+			source->pool = pool;
+			source->mapping = nullptr;
+			source->requested = false;
+			source->failed = false;
+
+			s_hdStreamSources.push_back(source);
+			s_hdStreamMap[texData] = source;
+			texData->scaleFactor = scaleFactor;
+			return;
+		}
+
+		MappedFile* mapping;
+		if (bitmap_loadHdImage(&info, s_texState.memoryRegion, &texData->hdAssetData, &mapping))
+		{
+			texData->scaleFactor = scaleFactor;
+			if (mapping)
 			{
-				memcpy(&dstData[y*width*4], &srcData[(height - y - 1)*width*4], width * 4);
+				s_hdMappings[pool].push_back(mapping);
 			}
-			dstData += hdFrameSize;
-			srcData += hdFrameSize;
 		}
 	}
 
+	bool bitmap_isHdPending(const TextureData* texData)
+	{
+		if (s_hdStreamMap.empty()) { return false; }
+		return !texData->hdAssetData && s_hdStreamMap.find(texData) != s_hdStreamMap.end();
+	}
+
+	void bitmap_markHdVisible(const TextureData* texData)
+	{
+		if (!texData || s_hdStreamMap.empty()) { return; }
+
+		std::unordered_map<const TextureData*, HdStreamSource*>::iterator iSource = s_hdStreamMap.find(texData);
+		if (iSource == s_hdStreamMap.end()) { return; }
+
+		HdStreamSource* source = iSource->second;
+		if (!source->requested && !source->failed)
+		{
+			source->requested = true;
+			s_hdStreamRequests.push_back(source);
+		}
+	}
+
+	void bitmap_updateHdStreaming(HdResidentCallback onResident)
+	{
+		if (s_hdStreamSources.empty()) { return; }
+
+		// Load a limited number of requested textures per frame to avoid hitches.
+		s32 loadCount = 0;
+		size_t r = 0;
+		for (; r < s_hdStreamRequests.size() && loadCount < HD_STREAM_LOADS_PER_FRAME; r++)
+		{
+			HdStreamSource* source = s_hdStreamRequests[r];
+			source->requested = false;
+
+			TextureData* texture = source->texture;
+			if (!texture->hdAssetData)
+			{
+				if (!bitmap_loadHdImage(&source->info, nullptr, &texture->hdAssetData, &source->mapping))
+				{
+					TFE_System::logWrite(LOG_WARNING, "bitmap_loadHD", "Cannot stream HD texture '%s'.", source->info.hdPath);
+					source->failed = true;
+					continue;
+				}
+				loadCount++;
+			}
+			// The renderer keeps its own copy, so the data never needs to stay resident. If there is no space reserved
+			// for it the texture keeps showing the base texture rather than reading the file again every frame.
+			if (!onResident || !onResident(texture))
+			{
+				TFE_System::logWrite(LOG_WARNING, "bitmap_loadHD", "No atlas space is reserved for HD texture '%s'.", source->info.hdPath);
+				source->failed = true;
+			}
+			bitmap_evictHdData(source);
+		}
+		s_hdStreamRequests.erase(s_hdStreamRequests.begin(), s_hdStreamRequests.begin() + r);
+	}
+
 	TextureData* bitmap_load(const char* name, u32 decompress, AssetPool pool, bool addToCache)
 	{
 		// TFE: Keep track of per-level texture state for serialization.
@@ -346,23 +759,14 @@ namespace TFE_Jedi
 				data += sizeof(u32) * texture->width;
 				assert(data <= end);
 
-				if (texture->compressed == 1)
+				// Animated textures are read as soon as they are loaded, so they are never deferred.
+				if (s_decompressBatch && texture->uvWidth != BM_ANIMATED_TEXTURE)
 				{
-					u8* dst = texture->image;
-					for (s32 i = 0; i < texture->width; i++, dst += texture->height)
-					{
-						const u8* src = &inBuffer[columns[i]];
-						decompressColumn_Type1(src, dst, texture->height);
-					}
+					bitmap_queueDecompress(inBuffer, inSize, columns, texture->image, texture->width, texture->height, texture->compressed);
 				}
-				else if (texture->compressed == 2)
+				else
 				{
-					u8* dst = texture->image;
-					for (s32 i = 0; i < texture->width; i++, dst += texture->height)
-					{
-						const u8* src = &inBuffer[columns[i]];
-						decompressColumn_Type2(src, dst, texture->height);
-					}
+					bitmap_decompressImage(inBuffer, columns, texture->image, texture->width, texture->height, texture->compressed);
 				}
 				texture->compressed = 0;
 				texture->columns = nullptr;
@@ -464,24 +868,7 @@ namespace TFE_Jedi
 				const u32* columns = (u32*)data;
 				data += sizeof(u32) * texture->width;
 
-				if (texture->compressed == 1)
-				{
-					u8* dst = texture->image;
-					for (s32 i = 0; i < texture->width; i++, dst += texture->height)
-					{
-						const u8* src = &inBuffer[columns[i]];
-						decompressColumn_Type1(src, dst, texture->height);
-					}
-				}
-				else if (texture->compressed == 2)
-				{
-					u8* dst = texture->image;
-					for (s32 i = 0; i < texture->width; i++, dst += texture->height)
-					{
-						const u8* src = &inBuffer[columns[i]];
-						decompressColumn_Type2(src, dst, texture->height);
-					}
-				}
+				bitmap_decompressImage(inBuffer, columns, texture->image, texture->width, texture->height, texture->compressed);
 				texture->compressed = 0;
 				texture->columns = nullptr;
 			}
@@ -729,6 +1116,7 @@ namespace TFE_Jedi
 	}
 		
 	// Type 1: RLE with runs of solid colors. Costs 2 bytes per solid-color run.
+	// Runs are written with memset/memcpy rather than per byte, which use wide stores for longer runs.
 	void decompressColumn_Type1(const u8* src, u8* dst, s32 pixelCount)
 	{
 		while (pixelCount)
@@ -736,29 +1124,21 @@ namespace TFE_Jedi
 			const u8 value = *src;
 			src++;
 
+			const u32 count = value & 0x7f;
 			if (value & 0x80)
 			{
-				const u8 color = *src;
+				// store color 'count' times at dst
+				memset(dst, *src, count);
 				src++;
-
-				const u32 count = value & 0x7f;
-				// store packed at dst
-				for (u32 i = 0; i < count; i++, dst++)
-				{
-					*dst = color;
-				}
-				pixelCount -= count;
 			}
 			else
 			{
-				const u32 count = value;
 				// store packed at dst
-				for (u32 i = 0; i < count; i++, dst++, src++)
-				{
-					*dst = *src;
-				}
-				pixelCount -= count;
+				memcpy(dst, src, count);
+				src += count;
 			}
+			dst += count;
+			pixelCount -= count;
 		}
 	}
 
@@ -770,18 +1150,154 @@ namespace TFE_Jedi
 			const u8 value = *src;
 			src++;
 
+			const u32 count = value & 0x7f;
 			if (value & 0x80)
 			{
-				const u32 count = value & 0x7f;
 				// store 0 at dst
 				memset(dst, 0, count);
-				dst += count;
+			}
+			else
+			{
+				// store packed at dst
+				memcpy(dst, src, count);
+				src += count;
+			}
+			dst += count;
+			pixelCount -= count;
+		}
+	}
+
+	void bitmap_decompressImage(const u8* inBuffer, const u32* columns, u8* image, s32 width, s32 height, s32 type)
+	{
+		u8* dst = image;
+		if (type == 1)
+		{
+			for (s32 i = 0; i < width; i++, dst += height)
+			{
+				decompressColumn_Type1(&inBuffer[columns[i]], dst, height);
+			}
+		}
+		else if (type == 2)
+		{
+			for (s32 i = 0; i < width; i++, dst += height)
+			{
+				decompressColumn_Type2(&inBuffer[columns[i]], dst, height);
+			}
+		}
+	}
+
+	void bitmap_queueDecompress(const u8* inBuffer, s32 inSize, const u32* columns, u8* image, s32 width, s32 height, s32 type)
+	{
+		// The load buffer is reused by the next texture, so keep a copy of the compressed data.
+		const size_t columnSize = sizeof(u32) * width;
+		DecompressJob job;
+		job.compressed = (u8*)malloc(inSize + columnSize);
+		if (!job.compressed)
+		{
+			bitmap_decompressImage(inBuffer, columns, image, width, height, type);
+			return;
+		}
+		memcpy(job.compressed, inBuffer, inSize);
+		memcpy(job.compressed + inSize, columns, columnSize);
+		job.columnOffset = inSize;
+		job.image = image;
+		job.width = width;
+		job.height = height;
+		job.type = type;
+		s_decompressJobs.push_back(job);
+	}
+
+	// Worker threads and the main thread pull jobs until the list is exhausted.
+	s32 decompressThreadFunc(void* userData)
+	{
+		const s32 jobCount = (s32)s_decompressJobs.size();
+		for (s32 j = SDL_AtomicAdd(&s_decompressNext, 1); j < jobCount; j = SDL_AtomicAdd(&s_decompressNext, 1))
+		{
+			DecompressJob* job = &s_decompressJobs[j];
+			bitmap_decompressImage(job->compressed, (u32*)(job->compressed + job->columnOffset), job->image, job->width, job->height, job->type);
+		}
+		return 0;
+	}
+
+	void bitmap_decompressQueued()
+	{
+		const s32 jobCount = (s32)s_decompressJobs.size();
+		if (!jobCount) { return; }
+
+		s32 pixelCount = 0;
+		for (s32 j = 0; j < jobCount; j++)
+		{
+			pixelCount += s_decompressJobs[j].width * s_decompressJobs[j].height;
+		}
+
+		SDL_AtomicSet(&s_decompressNext, 0);
+		SDL_Thread* threads[DECOMPRESS_MAX_THREADS];
+		s32 threadCount = 0;
+		if (pixelCount >= DECOMPRESS_MIN_PARALLEL_PIXELS)
+		{
+			const s32 workerCount = min(min(SDL_GetCPUCount() - 1, jobCount - 1), (s32)DECOMPRESS_MAX_THREADS);
+			for (s32 t = 0; t < workerCount; t++)
+			{
+				threads[threadCount] = SDL_CreateThread(decompressThreadFunc, "TFE_TextureDecompress", nullptr);
+				if (!threads[threadCount]) { break; }
+				threadCount++;
+			}
+		}
+
+		// The main thread does its share of the work, if no threads could be created it does all of it.
+		decompressThreadFunc(nullptr);
+		for (s32 t = 0; t < threadCount; t++)
+		{
+			SDL_WaitThread(threads[t], nullptr);
+		}
+
+		for (s32 j = 0; j < jobCount; j++)
+		{
+			free(s_decompressJobs[j].compressed);
+		}
+		s_decompressJobs.clear();
+	}
+
+	void bitmap_beginDecompressBatch()
+	{
+		s_decompressBatch++;
+	}
+
+	void bitmap_endDecompressBatch()
+	{
+		assert(s_decompressBatch > 0);
+		s_decompressBatch--;
+		if (!s_decompressBatch)
+		{
+			bitmap_decompressQueued();
+		}
+	}
+
+	////////////////////////////////////////////
+	// Decoder test
+	////////////////////////////////////////////
+	// The per-byte decoders the block copy decoders above replaced, kept as the reference for bitmap_testDecompress().
+	static void decompressColumn_Reference(const u8* src, u8* dst, s32 pixelCount, s32 type)
+	{
+		while (pixelCount)
+		{
+			const u8 value = *src;
+			src++;
+
+			if (value & 0x80)
+			{
+				const u32 count = value & 0x7f;
+				const u8 color = (type == 1) ? *src : 0;
+				if (type == 1) { src++; }
+				for (u32 i = 0; i < count; i++, dst++)
+				{
+					*dst = color;
+				}
 				pixelCount -= count;
 			}
 			else
 			{
 				const u32 count = value;
-				// store packed at dst
 				for (u32 i = 0; i < count; i++, dst++, src++)
 				{
 					*dst = *src;
@@ -790,4 +1306,91 @@ namespace TFE_Jedi
 			}
 		}
 	}
+
+	struct DecompressTest
+	{
+		std::vector<u8> reference;
+		std::vector<u8> batched;
+		char name[32];
+	};
+
+	s32 bitmap_testDecompress(Archive* archive, s32* bmCount)
+	{
+		*bmCount = 0;
+		if (!archive || s_decompressBatch) { return 0; }
+
+		std::vector<DecompressTest> tests;
+		std::vector<u8> file;
+		std::vector<u8> image;
+		s32 diffCount = 0;
+
+		// Decode each compressed BM with the reference and the current decoder, and queue it for the batched (threaded) path.
+		bitmap_beginDecompressBatch();
+		const u32 fileCount = archive->getFileCount();
+		tests.reserve(fileCount);
+		for (u32 f = 0; f < fileCount; f++)
+		{
+			const char* fileName = archive->getFileName(f);
+			char ext[16];
+			FileUtil::getFileExtension(fileName, ext);
+			if (strcasecmp(ext, "BM") || !archive->openFile(f)) { continue; }
+
+			file.resize(archive->getFileLength());
+			const size_t size = archive->readFile(file.data(), file.size());
+			archive->closeFile();
+
+			const u8* data = file.data();
+			if (size < 32 || strncmp((const char*)data, "BM ", 3) || data[3] != DF_BM_VERSION) { continue; }
+			data += 4;
+			const s32 width  = readUShort(data);
+			const s32 height = readUShort(data);
+			data += 6;
+			const s32 type = readByte(data);
+			data++;
+			const s32 inSize = readInt(data);
+			data += 12;
+			if ((type != 1 && type != 2) || width < 1 || height < 1 || inSize < 0 || 32 + size_t(inSize) + sizeof(u32) * width > size) { continue; }
+
+			const u8* inBuffer = data;
+			const u32* columns = (const u32*)(data + inSize);
+			bool valid = true;
+			for (s32 i = 0; i < width && valid; i++)
+			{
+				valid = columns[i] < u32(inSize);
+			}
+			if (!valid) { continue; }
+
+			tests.push_back({});
+			DecompressTest* test = &tests.back();
+			strncpy(test->name, fileName, sizeof(test->name) - 1);
+			test->name[sizeof(test->name) - 1] = 0;
+			test->reference.resize(width * height);
+			test->batched.resize(width * height);
+			for (s32 i = 0; i < width; i++)
+			{
+				decompressColumn_Reference(&inBuffer[columns[i]], &test->reference[i * height], height, type);
+			}
+
+			image.resize(width * height);
+			bitmap_decompressImage(inBuffer, columns, image.data(), width, height, type);
+			if (memcmp(image.data(), test->reference.data(), image.size()))
+			{
+				TFE_System::logWrite(LOG_ERROR, "bitmap_testDecompress", "'%s' in '%s' decodes differently from the reference.", test->name, archive->getName());
+				diffCount++;
+			}
+			bitmap_queueDecompress(inBuffer, inSize, columns, test->batched.data(), width, height, type);
+		}
+		bitmap_endDecompressBatch();
+
+		for (size_t t = 0; t < tests.size(); t++)
+		{
+			if (memcmp(tests[t].batched.data(), tests[t].reference.data(), tests[t].reference.size()))
+			{
+				TFE_System::logWrite(LOG_ERROR, "bitmap_testDecompress", "'%s' in '%s' decodes differently from the reference when batched.", tests[t].name, archive->getName());
+				diffCount++;
+			}
+		}
+		*bmCount = s32(tests.size());
+		return diffCount;
+	}
 }
\ No newline at end of file
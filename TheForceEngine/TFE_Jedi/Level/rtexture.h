@@ -90,6 +90,7 @@ enum
 };
 
 struct MemoryRegion;
+class Archive;
 
 namespace TFE_Jedi
 {
@@ -103,6 +104,13 @@ namespace TFE_Jedi
 	// levelTexture bool was added for TFE to make serializing texture state easier.
 	// if levelTexture is false, then textures are not serialized and not cleared at level end.
 	TextureData* bitmap_load(const char* name, u32 decompress, AssetPool pool = POOL_LEVEL, bool addToCache = true);
+	// TFE: Textures loaded between begin and end are decompressed together, in parallel, when the batch ends.
+	// Image data is not valid until then (animated textures are the exception and are decompressed immediately).
+	void bitmap_beginDecompressBatch();
+	void bitmap_endDecompressBatch();
+	// TFE: Decode every compressed BM in the archive with the reference per-byte decoders, the current decoders and a
+	// decompression batch, and return the number of decoded images that differ from the reference (details are logged).
+	s32 bitmap_testDecompress(Archive* archive, s32* bmCount);
 	bool bitmap_setupAnimatedTexture(TextureData** texture, s32 index);
 
 	Allocator* bitmap_getAnimatedTextures();
@@ -112,6 +120,16 @@ namespace TFE_Jedi
 	TextureData* bitmap_getTextureByIndex(s32 index, AssetPool pool);
 	const char* bitmap_getTextureName(s32 index, AssetPool pool);
 
+	// TFE: HD texture streaming.
+	// Streamed textures reserve full size space for HD data but only read it once marked visible. Until then
+	// 'hdAssetData' is null and the renderer should fall back to the base texture.
+	// The callback copies the HD data and returns true, the data is released right after the callback.
+	typedef bool(*HdResidentCallback)(TextureData* texture);
+	bool bitmap_isHdPending(const TextureData* texData);
+	void bitmap_markHdVisible(const TextureData* texData);
+	// Call once per frame, after visible textures have been marked.
+	void bitmap_updateHdStreaming(HdResidentCallback onResident);
+
 	// Used for tools.
 	TextureData* bitmap_loadFromMemory(const u8* data, size_t size, u32 decompress);
 	Allocator* bitmap_getAnimTextureAlloc();
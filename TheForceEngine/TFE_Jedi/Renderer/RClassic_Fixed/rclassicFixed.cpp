@@ -171,17 +171,26 @@ namespace RClassic_Fixed
 
 	void resetState()
 	{
+		free(s_rcfState.depth1d_all);
 		s_rcfState.depth1d_all = nullptr;
+		free(s_rcfState.skyTable);
 		s_rcfState.skyTable = nullptr;
+		free(s_rcfState.column_Z_Over_X);
 		s_rcfState.column_Z_Over_X = nullptr;
+		free(s_rcfState.column_X_Over_Z);
 		s_rcfState.column_X_Over_Z = nullptr;
+		free(s_rcfState.rcpY);
 		s_rcfState.rcpY = nullptr;
 
 		// Shared state
 		s_flatCount = 0;
+		free(s_columnTop);
 		s_columnTop = nullptr;
+		free(s_columnBot);
 		s_columnBot = nullptr;
+		free(s_windowTop_all);
 		s_windowTop_all = nullptr;
+		free(s_windowBot_all);
 		s_windowBot_all = nullptr;
 	}
 
@@ -198,21 +207,21 @@ namespace RClassic_Fixed
 
 		EdgePairFixed* flatEdge = &s_rcfState.flatEdgeList[s_flatCount];
 		s_rcfState.flatEdge = flatEdge;
-		flat_addEdges(s_screenWidth, s_minScreenX_Pixels, 0, s_rcfState.windowMaxY, 0, s_rcfState.windowMinY);
+		flat_addEdges(&s_rcfState, s_screenWidth, s_minScreenX_Pixels, 0, s_rcfState.windowMaxY, 0, s_rcfState.windowMinY);
 		
-		s_columnTop = (s32*)game_realloc(s_columnTop, s_width * sizeof(s32));
-		s_columnBot = (s32*)game_realloc(s_columnBot, s_width * sizeof(s32));
-		s_rcfState.depth1d_all = (fixed16_16*)game_realloc(s_rcfState.depth1d_all, s_width * sizeof(fixed16_16) * (MAX_ADJOIN_DEPTH + 1));
-		s_windowTop_all = (s32*)game_realloc(s_windowTop_all, s_width * sizeof(s32) * (MAX_ADJOIN_DEPTH + 1));
-		s_windowBot_all = (s32*)game_realloc(s_windowBot_all, s_width * sizeof(s32) * (MAX_ADJOIN_DEPTH + 1));
+		s_columnTop = (s32*)realloc(s_columnTop, s_width * sizeof(s32));
+		s_columnBot = (s32*)realloc(s_columnBot, s_width * sizeof(s32));
+		s_rcfState.depth1d_all = (fixed16_16*)realloc(s_rcfState.depth1d_all, s_width * sizeof(fixed16_16) * (MAX_ADJOIN_DEPTH + 1));
+		s_windowTop_all = (s32*)realloc(s_windowTop_all, s_width * sizeof(s32) * (MAX_ADJOIN_DEPTH + 1));
+		s_windowBot_all = (s32*)realloc(s_windowBot_all, s_width * sizeof(s32) * (MAX_ADJOIN_DEPTH + 1));
 
 		memset(s_windowTop_all, s_minScreenY, 320);
 		memset(s_windowBot_all, s_maxScreenY, 320);
 
 		// Build tables
-		s_rcfState.column_Z_Over_X = (fixed16_16*)game_realloc(s_rcfState.column_Z_Over_X, s_width * sizeof(fixed16_16));
-		s_rcfState.column_X_Over_Z = (fixed16_16*)game_realloc(s_rcfState.column_X_Over_Z, s_width * sizeof(fixed16_16));
-		s_rcfState.skyTable = (fixed16_16*)game_realloc(s_rcfState.skyTable, (s_width + 1) * sizeof(fixed16_16));
+		s_rcfState.column_Z_Over_X = (fixed16_16*)realloc(s_rcfState.column_Z_Over_X, s_width * sizeof(fixed16_16));
+		s_rcfState.column_X_Over_Z = (fixed16_16*)realloc(s_rcfState.column_X_Over_Z, s_width * sizeof(fixed16_16));
+		s_rcfState.skyTable = (fixed16_16*)realloc(s_rcfState.skyTable, (s_width + 1) * sizeof(fixed16_16));
 
 		// Here we assume a 90 degree field of view, this forms a frustum (not drawn to scale):
 		//     W = width of plane in pixels
@@ -244,7 +253,7 @@ namespace RClassic_Fixed
 			}
 		}
 
-		s_rcfState.rcpY = (fixed16_16*)game_realloc(s_rcfState.rcpY, 4 * s_height * sizeof(fixed16_16));
+		s_rcfState.rcpY = (fixed16_16*)realloc(s_rcfState.rcpY, 4 * s_height * sizeof(fixed16_16));
 		buildRcpYTable();
 	}
 
@@ -1,10 +1,16 @@
 #pragma once
 //////////////////////////////////////////////////////////////////////
 // Fixed-point shared state used by the Jedi Renderer.
-// The floating-point sub-renderer will have its own mirrored struct
-// of shared state.
+// The floating-point sub-renderer has its own mirrored struct of
+// shared state.
+//
+// The wall, flat and sprite code receives the state as a parameter
+// rather than reading s_rcfState, the sector renderer passes the
+// state it was created with. The screen and window values in rcommon
+// and the 3D object code are still shared.
 //////////////////////////////////////////////////////////////////////
 #include <TFE_System/types.h>
+#include <TFE_Asset/spriteAsset_Jedi.h>
 #include <TFE_Jedi/Math/core_math.h>
 #include <TFE_Jedi/Renderer/redgePair.h>
 #include <TFE_Jedi/Renderer/rlimits.h>
@@ -63,6 +69,48 @@ namespace TFE_Jedi
 		RWallSegmentFixed   wallSegListDst[MAX_SEG];
 		RWallSegmentFixed   wallSegListSrc[MAX_SEG];
 		RWallSegmentFixed** adjoinSegment;
+
+		// Wall merge/sort scratch space.
+		RWallSegmentFixed   wallSegListMerge[MAX_SEG];
+		s32 wallSegMergeOrder[MAX_SEG];
+		s32 wallSegMergeVisit[MAX_SEG];
+
+		// Walls and sprites, the column currently being set up.
+		fixed16_16 segmentCross;
+		s32  texHeightMask;
+		s32  yPixelCount;
+		fixed16_16 vCoordStep;
+		fixed16_16 vCoordFixed;
+		const u8* columnLight;
+		u8*  texImage;
+		u8*  columnOut;
+		u8   workBuffer[WAX_DECOMPRESS_SIZE];
+
+		// Flats, the scanline currently being set up.
+		s32  scanlineX0;
+		fixed16_16 scanlineU0;
+		fixed16_16 scanlineV0;
+		fixed16_16 scanline_dUdX;
+		fixed16_16 scanline_dVdX;
+		s32  scanlineWidth;
+		const u8* scanlineLight;
+		u8*  scanlineOut;
+
+		u8*  ftexImage;
+		s32  ftexDataEnd;
+		s32  ftexHeight;
+		s32  ftexWidthMask;
+		s32  ftexHeightMask;
+		s32  ftexHeightLog2;
+
+		// 3D object polygons drawn as flats.
+		fixed16_16 poly_offsetX;
+		fixed16_16 poly_offsetZ;
+		fixed16_16 poly_scaledHOffset;
+		fixed16_16 poly_sinYawHOffset;
+		fixed16_16 poly_cosYawHOffset;
+		fixed16_16 poly_cosYawScaledHOffset;
+		fixed16_16 poly_sinYawScaledHOffset;
 	};
 	extern RClassicFixedState s_rcfState;
 }  // TFE_Jedi
\ No newline at end of file
@@ -12,15 +12,17 @@ struct EdgePairFixed;
 
 namespace TFE_Jedi
 {
+	struct RClassicFixedState;
+
 	namespace RClassic_Fixed
 	{
-		void flat_addEdges(s32 length, s32 x0, fixed16_16 dyFloor_dx, fixed16_16 yFloor, fixed16_16 dyCeil_dx, fixed16_16 yCeil);
+		void flat_addEdges(RClassicFixedState* state, s32 length, s32 x0, fixed16_16 dyFloor_dx, fixed16_16 yFloor, fixed16_16 dyCeil_dx, fixed16_16 yCeil);
 
-		void flat_drawCeiling(RSector* sector, EdgePairFixed* edges, s32 count);
-		void flat_drawFloor(RSector* sector, EdgePairFixed* edges, s32 count);
+		void flat_drawCeiling(RClassicFixedState* state, RSector* sector, EdgePairFixed* edges, s32 count);
+		void flat_drawFloor(RClassicFixedState* state, RSector* sector, EdgePairFixed* edges, s32 count);
 
 		// Set Parameters for 3D object rendering.
-		void flat_preparePolygon(fixed16_16 heightOffset, fixed16_16 offsetX, fixed16_16 offsetZ, TextureData* texture);
-		void flat_drawPolygonScanline(s32 x0, s32 x1, s32 y, bool trans);
+		void flat_preparePolygon(RClassicFixedState* state, fixed16_16 heightOffset, fixed16_16 offsetX, fixed16_16 offsetZ, TextureData* texture);
+		void flat_drawPolygonScanline(RClassicFixedState* state, s32 x0, s32 x1, s32 y, bool trans);
 	}
 }
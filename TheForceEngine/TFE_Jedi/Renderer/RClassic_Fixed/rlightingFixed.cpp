@@ -4,6 +4,7 @@
 #include "rclassicFixed.h"
 #include "../rcommon.h"
 #include "../rlimits.h"
+#include "../rlightTable.h"
 
 namespace TFE_Jedi
 {
@@ -39,6 +40,18 @@ namespace RClassic_Fixed
 		return u32(atten - s_colorMap) >> 8u;
 	}
 
+	static const u8* light_applyOffset(s32 light, s32 lightOffset)
+	{
+		if (lightOffset != 0)
+		{
+			light += lightOffset;
+		}
+		if (light >= MAX_LIGHT_LEVEL) { return nullptr; }
+		light = max(light, 0);
+
+		return &s_colorMap[light << 8];
+	}
+
 	const u8* computeLighting(fixed16_16 depth, s32 lightOffset)
 	{
 		if (s_sectorAmbient >= MAX_LIGHT_LEVEL) { return nullptr; }
@@ -46,6 +59,12 @@ namespace RClassic_Fixed
 		depth = max(depth, 0);
 		s32 light = 0;
 
+		// Most columns and scanlines use the light level tabulated for the sector ambient this frame.
+		if (lightTable_getLevel(u32(depth >> LIGHT_SCALE), &light))
+		{
+			return light_applyOffset(light, lightOffset);
+		}
+
 		// handle camera lightsource
 		if (s_worldAmbient < MAX_LIGHT_LEVEL || s_cameraLightSource)
 		{
@@ -62,15 +81,7 @@ namespace RClassic_Fixed
 
 		s32 depthAtten = s32((depth >> LIGHT_ATTEN0) + (depth >> LIGHT_ATTEN1));		// depth * 3/32
 		light = max(light - depthAtten, s_scaledAmbient);
-
-		if (lightOffset != 0)
-		{
-			light += lightOffset;
-		}
-		if (light >= MAX_LIGHT_LEVEL) { return nullptr; }
-		light = max(light, 0);
-
-		return &s_colorMap[light << 8];
+		return light_applyOffset(light, lightOffset);
 	}
 }  // RLightingFixed
 
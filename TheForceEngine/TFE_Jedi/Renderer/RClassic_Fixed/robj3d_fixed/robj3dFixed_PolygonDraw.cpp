@@ -357,11 +357,11 @@ namespace RClassic_Fixed
 		// TODO: Figure out why s_heightInPixels has the wrong sign here.
 		if (yMax <= s_screenYMidFix)
 		{
-			flat_preparePolygon(heightOffset, ceilOffsetX, ceilOffsetZ, texture);
+			flat_preparePolygon(&s_rcfState, heightOffset, ceilOffsetX, ceilOffsetZ, texture);
 		}
 		else
 		{
-			flat_preparePolygon(heightOffset, floorOffsetX, floorOffsetZ, texture);
+			flat_preparePolygon(&s_rcfState, heightOffset, floorOffsetX, floorOffsetZ, texture);
 		}
 
 		s32 edgeFound = 0;
@@ -369,7 +369,7 @@ namespace RClassic_Fixed
 		{
 			if (s_rowY >= s_windowMinY_Pixels && s_windowMaxY_Pixels != 0 && s_edgeLeft_X0_Pixel <= s_windowMaxX_Pixels && s_edgeRight_X0_Pixel >= s_windowMinX_Pixels)
 			{
-				flat_drawPolygonScanline(s_edgeLeft_X0_Pixel, s_edgeRight_X0_Pixel, s_rowY, trans);
+				flat_drawPolygonScanline(&s_rcfState, s_edgeLeft_X0_Pixel, s_edgeRight_X0_Pixel, s_rowY, trans);
 			}
 
 			s_edgeLeftLength--;
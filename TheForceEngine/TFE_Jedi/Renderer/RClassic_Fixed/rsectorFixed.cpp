@@ -69,7 +69,7 @@ namespace TFE_Jedi
 			return obj1->posVS.z - obj0->posVS.z;
 		}
 				
-		s32 cullObjects(RSector* sector, SecObject** buffer)
+		s32 cullObjects(RClassicFixedState* state, RSector* sector, SecObject** buffer)
 		{
 			s32 drawCount = 0;
 			SecObject** obj = sector->objectList;
@@ -120,10 +120,10 @@ namespace TFE_Jedi
 
 						// Cull against the current "window."
 						const fixed16_16 z = curObj->posVS.z;
-						const s32 x0 = round16(div16(mul16(xMin, s_rcfState.focalLength), z)) + s_screenXMid;
+						const s32 x0 = round16(div16(mul16(xMin, state->focalLength), z)) + s_screenXMid;
 						if (x0 > s_windowMaxX_Pixels) { continue; }
 
-						const s32 x1 = round16(div16(mul16(xMax, s_rcfState.focalLength), z)) + s_screenXMid;
+						const s32 x1 = round16(div16(mul16(xMax, state->focalLength), z)) + s_screenXMid;
 						if (x1 < s_windowMinX_Pixels) { continue; }
 
 						// Finally add the object to render.
@@ -135,7 +135,7 @@ namespace TFE_Jedi
 			return drawCount;
 		}
 
-		void sprite_drawWax(s32 angle, SecObject* obj)
+		void sprite_drawWax(RClassicFixedState* state, s32 angle, SecObject* obj)
 		{
 			// Angles range from [0, 16384), divide by 512 to get 32 even buckets.
 			s32 angleDiff = (angle - obj->yaw) >> 9;
@@ -151,16 +151,16 @@ namespace TFE_Jedi
 				// And finall the frame from the current sequence.
 				WaxFrame* frame = WAX_FramePtr(wax, view, obj->frame & 0x1f);
 				// Draw the frame.
-				sprite_drawFrame((u8*)wax, frame, obj);
+				sprite_drawFrame(state, (u8*)wax, frame, obj);
 			}
 		}
 	}
 
 	void TFE_Sectors_Fixed::prepare()
 	{
-		EdgePairFixed* flatEdge = &s_rcfState.flatEdgeList[s_flatCount];
-		s_rcfState.flatEdge = flatEdge;
-		flat_addEdges(s_screenWidth, s_minScreenX_Pixels, 0, s_rcfState.windowMaxY, 0, s_rcfState.windowMinY);
+		EdgePairFixed* flatEdge = &m_state->flatEdgeList[s_flatCount];
+		m_state->flatEdge = flatEdge;
+		flat_addEdges(m_state, s_screenWidth, s_minScreenX_Pixels, 0, m_state->windowMaxY, 0, m_state->windowMinY);
 
 		light_transformDirLights();
 	}
@@ -188,7 +188,7 @@ namespace TFE_Jedi
 		s32* winTopNext = &s_windowTop_all[s_adjoinDepth * s_width];
 		s32* winBotNext = &s_windowBot_all[s_adjoinDepth * s_width];
 
-		s_rcfState.depth1d = &s_rcfState.depth1d_all[(s_adjoinDepth - 1) * s_width];
+		m_state->depth1d = &m_state->depth1d_all[(s_adjoinDepth - 1) * s_width];
 
 		s32 startWall = s_curSector->startWall;
 		s32 drawWallCount = s_curSector->drawWallCnt;
@@ -209,8 +209,8 @@ namespace TFE_Jedi
 		fixed16_16* depthPrev = nullptr;
 		if (s_adjoinDepth > 1)
 		{
-			depthPrev = &s_rcfState.depth1d_all[(s_adjoinDepth - 2) * s_width];
-			memcpy(&s_rcfState.depth1d[s_minScreenX_Pixels], &depthPrev[s_minScreenX_Pixels], s_width * 4);
+			depthPrev = &m_state->depth1d_all[(s_adjoinDepth - 2) * s_width];
+			memcpy(&m_state->depth1d[s_minScreenX_Pixels], &depthPrev[s_minScreenX_Pixels], s_width * 4);
 		}
 
 		s_wallMaxCeilY = s_windowMinY_Pixels;
@@ -223,8 +223,8 @@ namespace TFE_Jedi
 				vec2_fixed* vtxVS = s_curSector->verticesVS;
 				for (s32 v = 0; v < s_curSector->vertexCount; v++)
 				{
-					vtxVS->x = mul16(vtxWS->x, s_rcfState.cosYaw)    + mul16(vtxWS->z, s_rcfState.sinYaw) + s_rcfState.cameraTrans.x;
-					vtxVS->z = mul16(vtxWS->x, s_rcfState.negSinYaw) + mul16(vtxWS->z, s_rcfState.cosYaw) + s_rcfState.cameraTrans.z;
+					vtxVS->x = mul16(vtxWS->x, m_state->cosYaw)    + mul16(vtxWS->z, m_state->sinYaw) + m_state->cameraTrans.x;
+					vtxVS->z = mul16(vtxWS->x, m_state->negSinYaw) + mul16(vtxWS->z, m_state->cosYaw) + m_state->cameraTrans.z;
 					vtxVS++;
 					vtxWS++;
 				}
@@ -253,7 +253,7 @@ namespace TFE_Jedi
 				RWall* wall = s_curSector->walls;
 				for (s32 i = 0; i < s_curSector->wallCount; i++, wall++)
 				{
-					wall_process(wall);
+					wall_process(m_state, wall);
 				}
 				drawWallCount = s_nextWall - startWall;
 
@@ -263,8 +263,8 @@ namespace TFE_Jedi
 			TFE_ZONE_END(wallProcess);
 		}
 
-		RWallSegmentFixed* wallSegment = &s_rcfState.wallSegListDst[s_curWallSeg];
-		s32 drawSegCnt = wall_mergeSort(wallSegment, MAX_SEG - s_curWallSeg, startWall, drawWallCount);
+		RWallSegmentFixed* wallSegment = &m_state->wallSegListDst[s_curWallSeg];
+		s32 drawSegCnt = wall_mergeSort(m_state, wallSegment, MAX_SEG - s_curWallSeg, startWall, drawWallCount);
 		s_curWallSeg += drawSegCnt;
 
 		TFE_ZONE_BEGIN(wallQSort, "Wall QSort");
@@ -272,15 +272,15 @@ namespace TFE_Jedi
 		TFE_ZONE_END(wallQSort);
 
 		s32 flatCount = s_flatCount;
-		EdgePairFixed* flatEdge = &s_rcfState.flatEdgeList[s_flatCount];
-		s_rcfState.flatEdge = flatEdge;
+		EdgePairFixed* flatEdge = &m_state->flatEdgeList[s_flatCount];
+		m_state->flatEdge = flatEdge;
 
 		s32 adjoinStart = s_adjoinSegCount;
-		EdgePairFixed* adjoinEdges = &s_rcfState.adjoinEdgeList[adjoinStart];
+		EdgePairFixed* adjoinEdges = &m_state->adjoinEdgeList[adjoinStart];
 		RWallSegmentFixed* adjoinList[MAX_ADJOIN_DEPTH];
 
-		s_rcfState.adjoinEdge = adjoinEdges;
-		s_rcfState.adjoinSegment = adjoinList;
+		m_state->adjoinEdge = adjoinEdges;
+		m_state->adjoinSegment = adjoinList;
 
 		// Draw each wall segment in the sector.
 		TFE_ZONE_BEGIN(secDrawWalls, "Draw Walls");
@@ -291,7 +291,7 @@ namespace TFE_Jedi
 
 			if (!nextSector)
 			{
-				wall_drawSolid(wallSegment);
+				wall_drawSolid(m_state, wallSegment);
 			}
 			else
 			{
@@ -301,52 +301,52 @@ namespace TFE_Jedi
 				{
 					if (df == WDF_MIDDLE || (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ))
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawBottom(wallSegment);
+						wall_drawBottom(m_state, wallSegment);
 					}
 				}
 				else if (df == WDF_TOP)
 				{
 					if (nextSector->flags1 & SEC_FLAGS1_EXT_ADJ)
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawTop(wallSegment);
+						wall_drawTop(m_state, wallSegment);
 					}
 				}
 				else if (df == WDF_TOP_AND_BOT)
 				{
 					if ((nextSector->flags1 & SEC_FLAGS1_EXT_ADJ) && (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ))
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else if (nextSector->flags1 & SEC_FLAGS1_EXT_ADJ)
 					{
-						wall_drawBottom(wallSegment);
+						wall_drawBottom(m_state, wallSegment);
 					}
 					else if (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ)
 					{
-						wall_drawTop(wallSegment);
+						wall_drawTop(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawTopAndBottom(wallSegment);
+						wall_drawTopAndBottom(m_state, wallSegment);
 					}
 				}
 				else // WDF_BOT
 				{
 					if (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ)
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawBottom(wallSegment);
+						wall_drawBottom(m_state, wallSegment);
 					}
 				}
 			}
@@ -363,31 +363,31 @@ namespace TFE_Jedi
 			{
 				if (s_curSector->flags1 & SEC_FLAGS1_NOWALL_DRAW)
 				{
-					wall_drawSkyTopNoWall(s_curSector);
+					wall_drawSkyTopNoWall(m_state, s_curSector);
 				}
 				else
 				{
-					wall_drawSkyTop(s_curSector);
+					wall_drawSkyTop(m_state, s_curSector);
 				}
 			}
 			else
 			{
-				flat_drawCeiling(s_curSector, flatEdge, newFlatCount);
+				flat_drawCeiling(m_state, s_curSector, flatEdge, newFlatCount);
 			}
 			if (s_curSector->flags1 & SEC_FLAGS1_PIT)
 			{
 				if (s_curSector->flags1 & SEC_FLAGS1_NOWALL_DRAW)
 				{
-					wall_drawSkyBottomNoWall(s_curSector);
+					wall_drawSkyBottomNoWall(m_state, s_curSector);
 				}
 				else
 				{
-					wall_drawSkyBottom(s_curSector);
+					wall_drawSkyBottom(m_state, s_curSector);
 				}
 			}
 			else
 			{
-				flat_drawFloor(s_curSector, flatEdge, newFlatCount);
+				flat_drawFloor(m_state, s_curSector, flatEdge, newFlatCount);
 			}
 		TFE_ZONE_END(secDrawFlats);
 
@@ -439,7 +439,7 @@ namespace TFE_Jedi
 						}
 					}
 
-					s_rcfState.windowMinZ = min(curAdjoinSeg->z0, curAdjoinSeg->z1);
+					m_state->windowMinZ = min(curAdjoinSeg->z0, curAdjoinSeg->z1);
 					draw(nextSector);
 					
 					if (s_adjoinDepth)
@@ -452,7 +452,7 @@ namespace TFE_Jedi
 					if (srcWall->flags1 & WF1_ADJ_MID_TEX)
 					{
 						TFE_ZONE("Draw Transparent Walls");
-						wall_drawTransparent(curAdjoinSeg, adjoinEdges);
+						wall_drawTransparent(m_state, curAdjoinSeg, adjoinEdges);
 					}
 				}
 			}
@@ -460,12 +460,12 @@ namespace TFE_Jedi
 
 		if (!(s_curSector->flags1 & SEC_FLAGS1_SUBSECTOR) && depthPrev && s_drawFrame != s_prevSector->prevDrawFrame2)
 		{
-			memcpy(&depthPrev[s_windowMinX_Pixels], &s_rcfState.depth1d[s_windowMinX_Pixels], (s_windowMaxX_Pixels - s_windowMinX_Pixels + 1) * sizeof(fixed16_16));
+			memcpy(&depthPrev[s_windowMinX_Pixels], &m_state->depth1d[s_windowMinX_Pixels], (s_windowMaxX_Pixels - s_windowMinX_Pixels + 1) * sizeof(fixed16_16));
 		}
 
 		// Objects
 		TFE_ZONE_BEGIN(secDrawObjects, "Draw Objects");
-		const s32 objCount = cullObjects(s_curSector, s_objBuffer);
+		const s32 objCount = cullObjects(m_state, s_curSector, s_objBuffer);
 		if (objCount > 0)
 		{
 			// Which top and bottom edges are we going to use to clip objects?
@@ -498,11 +498,11 @@ namespace TFE_Jedi
 				{
 					TFE_ZONE("Draw WAX");
 
-					fixed16_16 dx = s_rcfState.cameraPos.x - obj->posWS.x;
-					fixed16_16 dz = s_rcfState.cameraPos.z - obj->posWS.z;
+					fixed16_16 dx = m_state->cameraPos.x - obj->posWS.x;
+					fixed16_16 dz = m_state->cameraPos.z - obj->posWS.z;
 					angle14_32 angle = vec2ToAngle(dx, dz);
 
-					sprite_drawWax(angle, obj);
+					sprite_drawWax(m_state, angle, obj);
 				}
 				else if (type == OBJ_TYPE_3D)
 				{
@@ -514,7 +514,7 @@ namespace TFE_Jedi
 				{
 					TFE_ZONE("Draw Frame");
 
-					sprite_drawFrame((u8*)obj->fme, obj->fme, obj);
+					sprite_drawFrame(m_state, (u8*)obj->fme, obj->fme, obj);
 				}
 			}
 		}
@@ -603,7 +603,7 @@ namespace TFE_Jedi
 		SectorSaveValues* dst = &s_sectorStack[index];
 		dst->curSector = s_curSector;
 		dst->prevSector = s_prevSector;
-		dst->depth1d = s_rcfState.depth1d;
+		dst->depth1d = m_state->depth1d;
 		dst->windowX0 = s_windowX0;
 		dst->windowX1 = s_windowX1;
 		dst->windowMinY = s_windowMinY_Pixels;
@@ -628,7 +628,7 @@ namespace TFE_Jedi
 		const SectorSaveValues* src = &s_sectorStack[index];
 		s_curSector = src->curSector;
 		s_prevSector = src->prevSector;
-		s_rcfState.depth1d = (fixed16_16*)src->depth1d;
+		m_state->depth1d = (fixed16_16*)src->depth1d;
 		s_windowX0 = src->windowX0;
 		s_windowX1 = src->windowX1;
 		s_windowMinY_Pixels = src->windowMinY;
@@ -7,6 +7,7 @@
 #include <TFE_Jedi/Math/fixedPoint.h>
 #include <TFE_Jedi/Math/core_math.h>
 #include "rwallFixed.h"
+#include "rclassicFixedSharedState.h"
 #include "../rsectorRender.h"
 
 struct RWall;
@@ -17,6 +18,8 @@ namespace TFE_Jedi
 	class TFE_Sectors_Fixed : public TFE_Sectors
 	{
 	public:
+		TFE_Sectors_Fixed() : m_state(&s_rcfState) {}
+
 		// Sub-Renderer specific
 		void destroy() override;
 		void reset() override;
@@ -29,5 +32,8 @@ namespace TFE_Jedi
 		void restoreValues(s32 index);
 		void adjoin_computeWindowBounds(EdgePairFixed* adjoinEdges);
 		void adjoin_setupAdjoinWindow(s32* winBot, s32* winBotNext, s32* winTop, s32* winTopNext, EdgePairFixed* adjoinEdges, s32 adjoinCount);
+
+		// The state this view is drawn with, passed explicitly to the wall, flat and sprite code.
+		RClassicFixedState* m_state;
 	};
 }  // TFE_Jedi
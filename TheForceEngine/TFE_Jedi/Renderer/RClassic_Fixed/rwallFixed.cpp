@@ -12,6 +12,8 @@
 #include "redgePairFixed.h"
 #include "rclassicFixedSharedState.h"
 #include "../rcommon.h"
+#include "../rcolumn.h"
+#include "../rspriteCache.h"
 #include "../jediRenderer.h"
 
 namespace TFE_Jedi
@@ -27,23 +29,13 @@ namespace RClassic_Fixed
 		BACK = 0,
 	};
 
-	static fixed16_16 s_segmentCross;
-	static s32 s_texHeightMask;
-	static s32 s_yPixelCount;
-	static fixed16_16 s_vCoordStep;
-	static fixed16_16 s_vCoordFixed;
-	static const u8* s_columnLight;
-	static u8* s_texImage;
-	static u8* s_columnOut;
-	static u8  s_workBuffer[WAX_DECOMPRESS_SIZE];
-
-	s32 segmentCrossesLine(fixed16_16 ax0, fixed16_16 ay0, fixed16_16 ax1, fixed16_16 ay1, fixed16_16 bx0, fixed16_16 by0, fixed16_16 bx1, fixed16_16 by1);
+	s32 segmentCrossesLine(RClassicFixedState* state, fixed16_16 ax0, fixed16_16 ay0, fixed16_16 ax1, fixed16_16 ay1, fixed16_16 bx0, fixed16_16 by0, fixed16_16 bx1, fixed16_16 by1);
 	fixed16_16 solveForZ_Numerator(RWallSegmentFixed* wallSegment);
-	fixed16_16 solveForZ(RWallSegmentFixed* wallSegment, s32 x, fixed16_16 numerator, fixed16_16* outViewDx=nullptr);
-	void drawColumn_Fullbright();
-	void drawColumn_Lit();
-	void drawColumn_Fullbright_Trans();
-	void drawColumn_Lit_Trans();
+	fixed16_16 solveForZ(RClassicFixedState* state, RWallSegmentFixed* wallSegment, s32 x, fixed16_16 numerator, fixed16_16* outViewDx=nullptr);
+	void drawColumn_Fullbright(RClassicFixedState* state);
+	void drawColumn_Lit(RClassicFixedState* state);
+	void drawColumn_Fullbright_Trans(RClassicFixedState* state);
+	void drawColumn_Lit_Trans(RClassicFixedState* state);
 
 	// Column rendering functions that can be chosen at runtime.
 	enum ColumnFuncId
@@ -56,7 +48,7 @@ namespace RClassic_Fixed
 		COLFUNC_COUNT
 	};
 
-	typedef void(*ColumnFunction)();
+	typedef void(*ColumnFunction)(RClassicFixedState* state);
 	ColumnFunction s_columnFunc[COLFUNC_COUNT] =
 	{
 		drawColumn_Fullbright,			// COLFUNC_FULLBRIGHT
@@ -78,7 +70,7 @@ namespace RClassic_Fixed
 	}
 
 	// Process the wall and produce an RWallSegment for rendering if the wall is potentially visible.
-	void wall_process(RWall* wall)
+	void wall_process(RClassicFixedState* state, RWall* wall)
 	{
 		const vec2_fixed* p0 = wall->v0;
 		const vec2_fixed* p1 = wall->v1;
@@ -214,7 +206,7 @@ namespace RClassic_Fixed
 		//////////////////////////////////////////////////
 		// Clip the Wall Segment by the near plane.
 		//////////////////////////////////////////////////
-		if ((z0 < 0 || z1 < 0) && segmentCrossesLine(0, 0, 0, -s_rcfState.halfHeight, x0, x0, x1, z1) != 0)
+		if ((z0 < 0 || z1 < 0) && segmentCrossesLine(state, 0, 0, 0, -state->halfHeight, x0, x0, x1, z1) != 0)
 		{
 			wall->visible = 0;
 			return;
@@ -304,8 +296,8 @@ namespace RClassic_Fixed
 		// Project.
 		//////////////////////////////////////////////////
 		s32 x0pixel, x1pixel;
-		fixed16_16 x0proj = div16(mul16(x0, s_rcfState.focalLength), z0) + s_rcfState.projOffsetX;
-		fixed16_16 x1proj = div16(mul16(x1, s_rcfState.focalLength), z1) + s_rcfState.projOffsetX;
+		fixed16_16 x0proj = div16(mul16(x0, state->focalLength), z0) + state->projOffsetX;
+		fixed16_16 x1proj = div16(mul16(x1, state->focalLength), z1) + state->projOffsetX;
 		x0pixel = round16(x0proj);
 		x1pixel = round16(x1proj) - 1;
 		
@@ -341,7 +333,7 @@ namespace RClassic_Fixed
 			return;
 		}
 	
-		RWallSegmentFixed* wallSeg = &s_rcfState.wallSegListSrc[s_nextWall];
+		RWallSegmentFixed* wallSeg = &state->wallSegListSrc[s_nextWall];
 		s_nextWall++;
 
 		if (x0pixel < s_minScreenX_Pixels)
@@ -389,7 +381,40 @@ namespace RClassic_Fixed
 		wall->visible = 1;
 	}
 
-	s32 wall_mergeSort(RWallSegmentFixed* segOutList, s32 availSpace, s32 start, s32 count)
+	// The merged segments never overlap in screenspace, so their order by wallX0 is also their order by wallX1.
+	// Returns the position in 'order' of the first segment that ends at or after 'x'.
+	static s32 wall_mergeOrderSearch(const RWallSegmentFixed* mergeList, const s32* order, s32 orderCount, s32 x)
+	{
+		s32 lo = 0;
+		s32 hi = orderCount;
+		while (lo < hi)
+		{
+			const s32 mid = (lo + hi) >> 1;
+			if (mergeList[order[mid]].wallX1 < x) { lo = mid + 1; }
+			else { hi = mid; }
+		}
+		return lo;
+	}
+
+	// Removes the deleted segments from the merge list while keeping the insertion order, 'remap' is scratch space.
+	static s32 wall_mergeCompact(RWallSegmentFixed* mergeList, s32 mergeCount, s32* order, s32 orderCount, s32* remap)
+	{
+		s32 liveCount = 0;
+		for (s32 i = 0; i < mergeCount; i++)
+		{
+			if (!mergeList[i].srcWall) { continue; }
+			if (i != liveCount) { mergeList[liveCount] = mergeList[i]; }
+			remap[i] = liveCount;
+			liveCount++;
+		}
+		for (s32 i = 0; i < orderCount; i++)
+		{
+			order[i] = remap[order[i]];
+		}
+		return liveCount;
+	}
+
+	s32 wall_mergeSort(RClassicFixedState* state, RWallSegmentFixed* segOutList, s32 availSpace, s32 start, s32 count)
 	{
 		TFE_ZONE("Wall Merge/Sort");
 
@@ -401,8 +426,15 @@ namespace RClassic_Fixed
 		s32 splitWallCount = 0;
 		s32 splitWallIndex = -count;
 
-		RWallSegmentFixed* srcSeg = &s_rcfState.wallSegListSrc[start];
-		RWallSegmentFixed* curSegOut = segOutList;
+		RWallSegmentFixed* srcSeg = &state->wallSegListSrc[start];
+
+		// Merged segments are kept in insertion order, which is the order they are compared against new segments,
+		// deleted segments are left in place with a null srcWall. 'mergeOrder' indexes the live segments sorted by screen x
+		// so only the segments overlapping a new segment have to be visited.
+		RWallSegmentFixed* mergeList = state->wallSegListMerge;
+		s32* mergeOrder = state->wallSegMergeOrder;
+		s32* mergeVisit = state->wallSegMergeVisit;
+		s32 mergeCount = 0;
 
 		RWallSegmentFixed  tempSeg;
 		RWallSegmentFixed* newSeg = &tempSeg;
@@ -412,7 +444,7 @@ namespace RClassic_Fixed
 		{
 			RWall* srcWall = srcSeg->srcWall;
 			JBool processed = (s_drawFrame == srcWall->drawFrame) ? JTRUE : JFALSE;
-			JBool insideWindow = ((srcSeg->z0 >= s_rcfState.windowMinZ || srcSeg->z1 >= s_rcfState.windowMinZ) && srcSeg->wallX0 <= s_windowMaxX_Pixels && srcSeg->wallX1 >= s_windowMinX_Pixels) ? JTRUE : JFALSE;
+			JBool insideWindow = ((srcSeg->z0 >= state->windowMinZ || srcSeg->z1 >= state->windowMinZ) && srcSeg->wallX0 <= s_windowMaxX_Pixels && srcSeg->wallX1 >= s_windowMinX_Pixels) ? JTRUE : JFALSE;
 			if (!processed && insideWindow)
 			{
 				// Copy the source segment into "newSeg" so it can be modified.
@@ -422,11 +454,24 @@ namespace RClassic_Fixed
 				if (newSeg->wallX0 < s_windowMinX_Pixels) { newSeg->wallX0 = s_windowMinX_Pixels; }
 				if (newSeg->wallX1 > s_windowMaxX_Pixels) { newSeg->wallX1 = s_windowMaxX_Pixels; }
 
-				// Check 'newSeg' versus all of the segments already added for this sector.
-				RWallSegmentFixed* sortedSeg = segOutList;
+				// Check 'newSeg' versus the segments already added for this sector that overlap it in screenspace.
+				// These are contiguous in 'mergeOrder' and are visited in insertion order.
+				s32 visitCount = 0;
+				for (s32 i = wall_mergeOrderSearch(mergeList, mergeOrder, outIndex, newSeg->wallX0); i < outIndex && mergeList[mergeOrder[i]].wallX0 <= newSeg->wallX1; i++)
+				{
+					s32 v = visitCount;
+					for (; v > 0 && mergeVisit[v - 1] > mergeOrder[i]; v--)
+					{
+						mergeVisit[v] = mergeVisit[v - 1];
+					}
+					mergeVisit[v] = mergeOrder[i];
+					visitCount++;
+				}
+
 				s32 segHidden = 0;
-				for (s32 n = 0; n < outIndex && segHidden == 0; n++, sortedSeg++)
+				for (s32 n = 0; n < visitCount && segHidden == 0; n++)
 				{
+					RWallSegmentFixed* sortedSeg = &mergeList[mergeVisit[n]];
 					// Trivially skip segments that do not overlap in screenspace.
 					if (!(newSeg->wallX0 <= sortedSeg->wallX1 && sortedSeg->wallX0 <= newSeg->wallX1)) { continue; }
 
@@ -454,10 +499,10 @@ namespace RClassic_Fixed
 						else if (newV0->z < outV0->z)
 						{
 							side = FRONT;
-							if ((segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||		// (outV0, 0) does NOT cross (newV0, newV1)
-								 segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&	    // (outV1, 0) does NOT cross (newV0, newV1)
-								(!segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||		// (newV0, 0) crosses (outV0, outV1)
-								 !segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))		// (newV1, 0) crosses (outV0, outV1)
+							if ((segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||		// (outV0, 0) does NOT cross (newV0, newV1)
+								 segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&	    // (outV1, 0) does NOT cross (newV0, newV1)
+								(!segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||		// (newV0, 0) crosses (outV0, outV1)
+								 !segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))		// (newV1, 0) crosses (outV0, outV1)
 							{
 								side = BACK;
 							}
@@ -465,10 +510,10 @@ namespace RClassic_Fixed
 						else  // newV0->z >= outV0->z
 						{
 							side = BACK;
-							if ((segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||		// (newV0, 0) does NOT cross (outV0, outV1)
-								 segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&	    // (newV1, 0) does NOT cross (outV0, outV1)
-								(!segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||		// (outV0, 0) crosses (newV0, newV1)
-								 !segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))		// (outV1, 0) crosses (newV0, newV1)
+							if ((segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||		// (newV0, 0) does NOT cross (outV0, outV1)
+								 segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&	    // (newV1, 0) does NOT cross (outV0, outV1)
+								(!segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||		// (outV0, 0) crosses (newV0, newV1)
+								 !segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))		// (outV1, 0) crosses (newV0, newV1)
 							{
 								side = FRONT;
 							}
@@ -477,19 +522,11 @@ namespace RClassic_Fixed
 						// 'newSeg' is in front of 'sortedSeg' and it completely hides it.
 						if (side == FRONT)
 						{
-							s32 copyCount = outIndex - 1 - n;
-							RWallSegmentFixed* outCur = sortedSeg;
-							RWallSegmentFixed* outNext = sortedSeg + 1;
-
-							// We are deleting outCur since it is completely hidden by moving all segments from outNext onwards to outCur.
-							memmove(outCur, outNext, copyCount * sizeof(RWallSegmentFixed));
-
-							// We are deleting outCur since it is completely hidden by 'newSeg'
-							// Back up 1 step in the loop, so that outNext is processed (it will hold the same location as outCur before deletion).
-							curSegOut = curSegOut - 1;
-							sortedSeg = sortedSeg - 1;
+							// We are deleting 'sortedSeg' since it is completely hidden by 'newSeg'.
+							s32 orderIndex = wall_mergeOrderSearch(mergeList, mergeOrder, outIndex, sortedSeg->wallX1);
+							memmove(&mergeOrder[orderIndex], &mergeOrder[orderIndex + 1], (outIndex - 1 - orderIndex) * sizeof(s32));
+							sortedSeg->srcWall = nullptr;
 							outIndex--;
-							n--;
 						}
 						// 'newSeg' is behind 'sortedSeg' and they overlap.
 						else    // (side == BACK)
@@ -539,10 +576,10 @@ namespace RClassic_Fixed
 						else if (newV0->z < outV0->z)
 						{
 							side = FRONT;
-							if ((segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
-								 segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&
-								(!segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
-								 !segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))
+							if ((segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
+								 segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&
+								(!segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
+								 !segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))
 							{
 								side = BACK;
 							}
@@ -550,10 +587,10 @@ namespace RClassic_Fixed
 						else  // (newV0->z >= outV0->z)
 						{
 							side = BACK;
-							if ((segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
-								 segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&
-								(!segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
-								 !segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))
+							if ((segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
+								 segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&
+								(!segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
+								 !segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))
 							{
 								side = FRONT;
 							}
@@ -608,8 +645,8 @@ namespace RClassic_Fixed
 								newSeg->wallX1 = sortedSeg->wallX0 - 1;
 							}
 						}
-						else if (segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) &&
-								 !segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
+						else if (segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) &&
+								 !segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
 						{
 							sortedSeg->wallX0 = newSeg->wallX1 + 1;
 						}
@@ -629,8 +666,8 @@ namespace RClassic_Fixed
 							newSeg->wallX0 = sortedSeg->wallX1 + 1;
 						}
 					}
-					else if (segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) &&
-							 !segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
+					else if (segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) &&
+							 !segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
 					{
 						sortedSeg->wallX1 = newSeg->wallX0 - 1;
 					}
@@ -638,7 +675,7 @@ namespace RClassic_Fixed
 					{
 						newSeg->wallX0 = sortedSeg->wallX1 + 1;
 					}
-				} // for (s32 n = 0; n < outIndex && segHidden == 0; n++, sortedSeg++)
+				} // for (s32 n = 0; n < visitCount && segHidden == 0; n++)
 
 				// If the new segment is still visible and not back facing.
 				if (segHidden == 0 && newSeg->wallX0 <= newSeg->wallX1)
@@ -649,9 +686,17 @@ namespace RClassic_Fixed
 					}
 					else
 					{
-						// Copy the temporary segment to the current segment.
-						*curSegOut = *newSeg;
-						curSegOut++;
+						if (mergeCount == MAX_SEG)
+						{
+							mergeCount = wall_mergeCompact(mergeList, mergeCount, mergeOrder, outIndex, mergeVisit);
+						}
+
+						// Copy the temporary segment to the merge list and insert it into the screenspace order.
+						mergeList[mergeCount] = *newSeg;
+						s32 orderIndex = wall_mergeOrderSearch(mergeList, mergeOrder, outIndex, newSeg->wallX1);
+						memmove(&mergeOrder[orderIndex + 1], &mergeOrder[orderIndex], (outIndex - orderIndex) * sizeof(s32));
+						mergeOrder[orderIndex] = mergeCount;
+						mergeCount++;
 						outIndex++;
 					}
 				}
@@ -672,6 +717,16 @@ namespace RClassic_Fixed
 			}
 		}  // while (1)
 
+		// Copy the remaining segments out in insertion order.
+		RWallSegmentFixed* curSegOut = segOutList;
+		for (s32 i = 0; i < mergeCount; i++)
+		{
+			if (mergeList[i].srcWall)
+			{
+				*curSegOut = mergeList[i];
+				curSegOut++;
+			}
+		}
 		return outIndex;
 	}
 
@@ -706,7 +761,7 @@ namespace RClassic_Fixed
 		return signTex;
 	}
 
-	void wall_drawSolid(RWallSegmentFixed* wallSegment)
+	void wall_drawSolid(RClassicFixedState* state, RWallSegmentFixed* wallSegment)
 	{
 		RWall* srcWall = wallSegment->srcWall;
 		RSector* sector = srcWall->sector;
@@ -716,17 +771,17 @@ namespace RClassic_Fixed
 		fixed16_16 ceilingHeight = sector->ceilingHeight;
 		fixed16_16 floorHeight = sector->floorHeight;
 
-		fixed16_16 ceilEyeRel  = ceilingHeight - s_rcfState.eyeHeight;
-		fixed16_16 floorEyeRel = floorHeight   - s_rcfState.eyeHeight;
+		fixed16_16 ceilEyeRel  = ceilingHeight - state->eyeHeight;
+		fixed16_16 floorEyeRel = floorHeight   - state->eyeHeight;
 
 		fixed16_16 z0 = wallSegment->z0;
 		fixed16_16 z1 = wallSegment->z1;
 
 		fixed16_16 y0C, y0F, y1C, y1F;
-		y0C = div16(mul16(ceilEyeRel,  s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		y1C = div16(mul16(ceilEyeRel,  s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
-		y0F = div16(mul16(floorEyeRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		y1F = div16(mul16(floorEyeRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		y0C = div16(mul16(ceilEyeRel,  state->focalLenAspect), z0) + state->projOffsetY;
+		y1C = div16(mul16(ceilEyeRel,  state->focalLenAspect), z1) + state->projOffsetY;
+		y0F = div16(mul16(floorEyeRel, state->focalLenAspect), z0) + state->projOffsetY;
+		y1F = div16(mul16(floorEyeRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		s32 y0C_pixel = round16(y0C);
 		s32 y1C_pixel = round16(y1C);
@@ -741,11 +796,11 @@ namespace RClassic_Fixed
 		if (y0C_pixel > s_windowMaxY_Pixels && y1C_pixel > s_windowMaxY_Pixels)
 		{
 			fixed16_16 yMax = intToFixed16(s_windowMaxY_Pixels + 1);
-			flat_addEdges(length, x, 0, yMax, 0, yMax);
+			flat_addEdges(state, length, x, 0, yMax, 0, yMax);
 
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 
@@ -753,7 +808,7 @@ namespace RClassic_Fixed
 			return;
 		}
 
-		s_texHeightMask = texture ? texture->height - 1 : 0;
+		state->texHeightMask = texture ? texture->height - 1 : 0;
 
 		fixed16_16 signU0 = 0, signU1 = 0;
 		ColumnFunction signFullbright = nullptr, signLit = nullptr;
@@ -773,7 +828,7 @@ namespace RClassic_Fixed
 			y0C += mul16(dYdXtop, clippedXDelta);
 			y0F += mul16(dYdXbot, clippedXDelta);
 		}
-		flat_addEdges(length, wallSegment->wallX0, dYdXbot, y0F, dYdXtop, y0C);
+		flat_addEdges(state, length, wallSegment->wallX0, dYdXbot, y0F, dYdXtop, y0C);
 
 		const s32 texWidth = texture ? texture->width : 0;
 		const JBool flipHorz = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
@@ -787,17 +842,17 @@ namespace RClassic_Fixed
 
 			top = max(top, s_windowTop[x]);
 			bot = min(bot, s_windowBot[x]);
-			s_yPixelCount = bot - top + 1;
+			state->yPixelCount = bot - top + 1;
 
 			fixed16_16 dxView = 0;
-			fixed16_16 z = solveForZ(wallSegment, x, numerator, &dxView);
-			s_rcfState.depth1d[x] = z;
+			fixed16_16 z = solveForZ(state, wallSegment, x, numerator, &dxView);
+			state->depth1d[x] = z;
 
 			fixed16_16 uScale = wallSegment->uScale;
 			fixed16_16 uCoord0 = wallSegment->uCoord0 + srcWall->midOffset.x;
 			fixed16_16 uCoord = uCoord0 + ((wallSegment->orient == WORIENT_DZ_DX) ? mul16(dxView, uScale) : mul16(z - z0, uScale));
 
-			if (s_yPixelCount > 0)
+			if (state->yPixelCount > 0)
 			{
 				// texture wrapping, assumes texWidth is a power of 2.
 				s32 texelU = floor16(uCoord) & (texWidth - 1);
@@ -808,60 +863,60 @@ namespace RClassic_Fixed
 				fixed16_16 wallHeightPixels = y0F - y0C + ONE_16;
 				fixed16_16 wallHeightTexels = srcWall->midTexelHeight;
 
-				// s_vCoordStep = tex coord "v" step per y pixel step -> dVdY;
-				s_vCoordStep = div16(wallHeightTexels, wallHeightPixels);
+				// state->vCoordStep = tex coord "v" step per y pixel step -> dVdY;
+				state->vCoordStep = div16(wallHeightTexels, wallHeightPixels);
 
 				// texel offset from the actual fixed point y position and the truncated y position.
 				fixed16_16 vPixelOffset = y0F - intToFixed16(bot) + HALF_16;
 
 				// scale the texel offset based on the v coord step.
 				// the result is the sub-texel offset
-				fixed16_16 v0 = mul16(s_vCoordStep, vPixelOffset);
-				s_vCoordFixed = v0 + srcWall->midOffset.z;
+				fixed16_16 v0 = mul16(state->vCoordStep, vPixelOffset);
+				state->vCoordFixed = v0 + srcWall->midOffset.z;
 
 				// Texture image data = imageStart + u * texHeight
-				s_texImage = texture->image + (texelU << texture->logSizeY);
-				s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+				state->texImage = texture->image + (texelU << texture->logSizeY);
+				state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 				// column write output.
-				s_columnOut = &s_display[top * s_width + x];
+				state->columnOut = &s_display[top * s_width + x];
 
 				// draw the column
-				if (s_columnLight)
+				if (state->columnLight)
 				{
-					drawColumn_Lit();
+					drawColumn_Lit(state);
 				}
 				else
 				{
-					drawColumn_Fullbright();
+					drawColumn_Fullbright(state);
 				}
 
 				// Handle the "sign texture" - a wall overlay.
 				if (signTex && uCoord >= signU0 && uCoord <= signU1)
 				{
-					fixed16_16 signYbot = y0F + div16(srcWall->signOffset.z, s_vCoordStep);
-					fixed16_16 signYtop = signYbot - div16(intToFixed16(signTex->height), s_vCoordStep) + ONE_16;
+					fixed16_16 signYbot = y0F + div16(srcWall->signOffset.z, state->vCoordStep);
+					fixed16_16 signYtop = signYbot - div16(intToFixed16(signTex->height), state->vCoordStep) + ONE_16;
 					s32 y0 = max(round16(signYtop), top);
 					s32 y1 = min(round16(signYbot), bot);
-					s_yPixelCount = y1 - y0 + 1;
+					state->yPixelCount = y1 - y0 + 1;
 
-					if (s_yPixelCount > 0)
+					if (state->yPixelCount > 0)
 					{
-						s_vCoordFixed = mul16(signYbot - intToFixed16(y1) + HALF_16, s_vCoordStep);
-						s_columnOut = &s_display[y0*s_width + x];
+						state->vCoordFixed = mul16(signYbot - intToFixed16(y1) + HALF_16, state->vCoordStep);
+						state->columnOut = &s_display[y0*s_width + x];
 						texelU = floor16(uCoord - signU0);
-						s_texImage = &signTex->image[texelU << signTex->logSizeY];
+						state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-						s32 heightMask = s_texHeightMask;
-						s_texHeightMask = signTex->height - 1;
-						if (s_columnLight)
+						s32 heightMask = state->texHeightMask;
+						state->texHeightMask = signTex->height - 1;
+						if (state->columnLight)
 						{
-							signLit();
+							signLit(state);
 						}
 						else
 						{
-							signFullbright();
+							signFullbright(state);
 						}
-						s_texHeightMask = heightMask;
+						state->texHeightMask = heightMask;
 					}
 				}
 			}
@@ -873,7 +928,7 @@ namespace RClassic_Fixed
 		srcWall->seen = JTRUE;
 	}
 
-	void wall_drawTransparent(RWallSegmentFixed* wallSegment, EdgePairFixed* edge)
+	void wall_drawTransparent(RClassicFixedState* state, RWallSegmentFixed* wallSegment, EdgePairFixed* edge)
 	{
 		RWall* srcWall = wallSegment->srcWall;
 		RSector* sector = srcWall->sector;
@@ -886,7 +941,7 @@ namespace RClassic_Fixed
 		fixed16_16 uCoord0 = wallSegment->uCoord0 + srcWall->midOffset.x;
 		s32 lengthInPixels = edge->lengthInPixels;
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		JBool flipHorz = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 
 		fixed16_16 ceil_dYdX  = edge->dyCeil_dx;
@@ -901,11 +956,11 @@ namespace RClassic_Fixed
 			s32 yC_pixel = max(round16(yC0), top);
 			s32 yF_pixel = min(round16(yF0), bot);
 
-			s_yPixelCount = yF_pixel - yC_pixel + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = yF_pixel - yC_pixel + 1;
+			if (state->yPixelCount > 0)
 			{
 				fixed16_16 dxView;
-				fixed16_16 z = solveForZ(wallSegment, x, num, &dxView);
+				fixed16_16 z = solveForZ(state, wallSegment, x, num, &dxView);
 				fixed16_16 uCoord = uCoord0 + ((wallSegment->orient == WORIENT_DZ_DX) ? mul16(dxView, uScale) : mul16(z - z0, uScale));
 
 				s32 widthMask = texture->width - 1;
@@ -915,21 +970,21 @@ namespace RClassic_Fixed
 					texelU = widthMask - texelU;
 				}
 
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_vCoordStep  = div16(srcWall->midTexelHeight, yF0 - yC0 + ONE_16);
-				s_vCoordFixed = mul16(yF0 - intToFixed16(yF_pixel) + HALF_16, s_vCoordStep) + srcWall->midOffset.z;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->vCoordStep  = div16(srcWall->midTexelHeight, yF0 - yC0 + ONE_16);
+				state->vCoordFixed = mul16(yF0 - intToFixed16(yF_pixel) + HALF_16, state->vCoordStep) + srcWall->midOffset.z;
 
-				s_columnOut = &s_display[yC_pixel*s_width + x];
-				s_rcfState.depth1d[x] = z;
-				s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+				state->columnOut = &s_display[yC_pixel*s_width + x];
+				state->depth1d[x] = z;
+				state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 
-				if (s_columnLight)
+				if (state->columnLight)
 				{
-					drawColumn_Lit_Trans();
+					drawColumn_Lit_Trans(state);
 				}
 				else
 				{
-					drawColumn_Fullbright_Trans();
+					drawColumn_Fullbright_Trans(state);
 				}
 			}
 
@@ -938,7 +993,7 @@ namespace RClassic_Fixed
 		}
 	}
 
-	void wall_drawMask(RWallSegmentFixed* wallSegment)
+	void wall_drawMask(RClassicFixedState* state, RWallSegmentFixed* wallSegment)
 	{
 		RWall* srcWall = wallSegment->srcWall;
 		RSector* sector = srcWall->sector;
@@ -952,13 +1007,13 @@ namespace RClassic_Fixed
 		fixed16_16 cProj0, cProj1;
 		if ((flags1 & SEC_FLAGS1_EXTERIOR) && (nextFlags1 & SEC_FLAGS1_EXT_ADJ))  // ceiling
 		{
-			cProj0 = cProj1 = s_rcfState.windowMinY;
+			cProj0 = cProj1 = state->windowMinY;
 		}
 		else
 		{
-			fixed16_16 ceilRel = sector->ceilingHeight - s_rcfState.eyeHeight;
-			cProj0 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-			cProj1 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+			fixed16_16 ceilRel = sector->ceilingHeight - state->eyeHeight;
+			cProj0 = div16(mul16(ceilRel, state->focalLenAspect), z0) + state->projOffsetY;
+			cProj1 = div16(mul16(ceilRel, state->focalLenAspect), z1) + state->projOffsetY;
 		}
 
 		s32 c0pixel = round16(cProj0);
@@ -967,11 +1022,11 @@ namespace RClassic_Fixed
 		{
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - wallSegment->wallX0 + 1;
-			flat_addEdges(length, x, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, length, x, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
 			const fixed16_16 numerator = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 
@@ -983,13 +1038,13 @@ namespace RClassic_Fixed
 		fixed16_16 fProj0, fProj1;
 		if ((sector->flags1 & SEC_FLAGS1_PIT) && (nextFlags1 & SEC_FLAGS1_EXT_FLOOR_ADJ))	// floor
 		{
-			fProj0 = fProj1 = s_rcfState.windowMaxY;
+			fProj0 = fProj1 = state->windowMaxY;
 		}
 		else
 		{
-			fixed16_16 floorRel = sector->floorHeight - s_rcfState.eyeHeight;
-			fProj0 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-			fProj1 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+			fixed16_16 floorRel = sector->floorHeight - state->eyeHeight;
+			fProj0 = div16(mul16(floorRel, state->focalLenAspect), z0) + state->projOffsetY;
+			fProj1 = div16(mul16(floorRel, state->focalLenAspect), z1) + state->projOffsetY;
 		}
 
 		s32 f0pixel = round16(fProj0);
@@ -998,12 +1053,12 @@ namespace RClassic_Fixed
 		{
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - wallSegment->wallX0 + 1;
-			flat_addEdges(length, x, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, length, x, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
 
 			const fixed16_16 numerator = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			srcWall->visible = 0;
@@ -1032,13 +1087,13 @@ namespace RClassic_Fixed
 			y1 = mul16(dydxFloor, xStartOffset) + fProj0;
 		}
 
-		flat_addEdges(length, x, dydxFloor, y1, dydxCeil, y0);
+		flat_addEdges(state, length, x, dydxFloor, y1, dydxCeil, y0);
 		fixed16_16 nextFloor = nextSector->floorHeight;
 		fixed16_16 nextCeil  = nextSector->ceilingHeight;
 		// There is an opening in this wall to the next sector.
 		if (nextFloor > nextCeil)
 		{
-			wall_addAdjoinSegment(length, x, dydxFloor, y1, dydxCeil, y0, wallSegment);
+			wall_addAdjoinSegment(state, length, x, dydxFloor, y1, dydxCeil, y0, wallSegment);
 		}
 		if (length != 0)
 		{
@@ -1049,7 +1104,7 @@ namespace RClassic_Fixed
 				s_columnTop[x] = y0_pixel - 1;
 				s_columnBot[x] = y1_pixel + 1;
 
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				y0 += dydxCeil;
 				y1 += dydxFloor;
 			}
@@ -1058,7 +1113,7 @@ namespace RClassic_Fixed
 		srcWall->seen = JTRUE;
 	}
 
-	void wall_drawBottom(RWallSegmentFixed* wallSegment)
+	void wall_drawBottom(RClassicFixedState* state, RWallSegmentFixed* wallSegment)
 	{
 		RWall* wall = wallSegment->srcWall;
 		RSector* sector = wall->sector;
@@ -1072,14 +1127,14 @@ namespace RClassic_Fixed
 		fixed16_16 cProj0, cProj1;
 		if ((sector->flags1 & SEC_FLAGS1_EXTERIOR) && (nextSector->flags1 & SEC_FLAGS1_EXT_ADJ))
 		{
-			cProj0 = s_rcfState.windowMinY;
+			cProj0 = state->windowMinY;
 			cProj1 = cProj0;
 		}
 		else
 		{
-			fixed16_16 ceilRel = sector->ceilingHeight - s_rcfState.eyeHeight;
-			cProj0 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-			cProj1 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+			fixed16_16 ceilRel = sector->ceilingHeight - state->eyeHeight;
+			cProj0 = div16(mul16(ceilRel, state->focalLenAspect), z0) + state->projOffsetY;
+			cProj1 = div16(mul16(ceilRel, state->focalLenAspect), z1) + state->projOffsetY;
 		}
 
 		s32 cy0 = round16(cProj0);
@@ -1090,22 +1145,22 @@ namespace RClassic_Fixed
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - x + 1;
 
-			flat_addEdges(length, x, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, length, x, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
 
 			fixed16_16 num = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 			wall->seen = JTRUE;
 			return;
 		}
 
-		fixed16_16 floorRel = sector->floorHeight - s_rcfState.eyeHeight;
+		fixed16_16 floorRel = sector->floorHeight - state->eyeHeight;
 		fixed16_16 fProj0, fProj1;
-		fProj0 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		fProj1 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		fProj0 = div16(mul16(floorRel, state->focalLenAspect), z0) + state->projOffsetY;
+		fProj1 = div16(mul16(floorRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		s32 fy0 = round16(fProj0);
 		s32 fy1 = round16(fProj1);
@@ -1116,22 +1171,22 @@ namespace RClassic_Fixed
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - x + 1;
 
-			flat_addEdges(length, x, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, length, x, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
 
 			fixed16_16 num = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			wall->seen = JTRUE;
 			return;
 		}
 
-		fixed16_16 floorRelNext = nextSector->floorHeight - s_rcfState.eyeHeight;
+		fixed16_16 floorRelNext = nextSector->floorHeight - state->eyeHeight;
 		fixed16_16 fNextProj0, fNextProj1;
-		fNextProj0 = div16(mul16(floorRelNext, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		fNextProj1 = div16(mul16(floorRelNext, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		fNextProj0 = div16(mul16(floorRelNext, state->focalLenAspect), z0) + state->projOffsetY;
+		fNextProj1 = div16(mul16(floorRelNext, state->focalLenAspect), z1) + state->projOffsetY;
 
 		s32 xOffset = wallSegment->wallX0 - wallSegment->wallX0_raw;
 		s32 length = wallSegment->wallX1 - wallSegment->wallX0 + 1;
@@ -1159,13 +1214,13 @@ namespace RClassic_Fixed
 		fixed16_16 yC = cProj0;
 		fixed16_16 yBot = fProj0;
 		s32 x = wallSegment->wallX0;
-		flat_addEdges(length, wallSegment->wallX0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
+		flat_addEdges(state, length, wallSegment->wallX0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
 
 		s32 yTop0 = round16(fNextProj0);
 		s32 yTop1 = round16(fNextProj1);
 		if ((yTop0 > s_windowMinY_Pixels || yTop1 > s_windowMinY_Pixels) && sector->ceilingHeight < nextSector->floorHeight)
 		{
-			wall_addAdjoinSegment(length, wallSegment->wallX0, floorNext_dYdX, fNextProj0, ceil_dYdX, cProj0, wallSegment);
+			wall_addAdjoinSegment(state, length, wallSegment->wallX0, floorNext_dYdX, fNextProj0, ceil_dYdX, cProj0, wallSegment);
 		}
 
 		if (yTop0 > s_windowMaxY_Pixels && yTop1 > s_windowMaxY_Pixels)
@@ -1177,7 +1232,7 @@ namespace RClassic_Fixed
 				s32 yC_pixel = min(round16(yC), s_windowBot[x]);
 				s_columnTop[x] = yC_pixel - 1;
 				s_columnBot[x] = bot;
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 			}
 			wall->seen = JTRUE;
 			return;
@@ -1185,7 +1240,7 @@ namespace RClassic_Fixed
 
 		fixed16_16 u0 = wallSegment->uCoord0;
 		fixed16_16 num = solveForZ_Numerator(wallSegment);
-		s_texHeightMask = tex->height - 1;
+		state->texHeightMask = tex->height - 1;
 		JBool flipHorz  = ((wall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 		JBool illumSign = ((wall->flags1 & WF1_ILLUM_SIGN)!=0) ? JTRUE : JFALSE;
 
@@ -1214,11 +1269,11 @@ namespace RClassic_Fixed
 				{
 					yBot_pixel = s_windowBot[x];
 				}
-				s_yPixelCount = yBot_pixel - yTop_pixel + 1;
+				state->yPixelCount = yBot_pixel - yTop_pixel + 1;
 
 				// Calculate perspective correct Z and U (texture coordinate).
 				fixed16_16 dxView;
-				fixed16_16 z = solveForZ(wallSegment, x, num, &dxView);
+				fixed16_16 z = solveForZ(state, wallSegment, x, num, &dxView);
 				fixed16_16 uCoord;
 				if (wallSegment->orient == WORIENT_DZ_DX)
 				{
@@ -1229,8 +1284,8 @@ namespace RClassic_Fixed
 					fixed16_16 dz = z - z0;
 					uCoord = u0 + mul16(dz, wallSegment->uScale) + wall->botOffset.x;
 				}
-				s_rcfState.depth1d[x] = z;
-				if (s_yPixelCount > 0)
+				state->depth1d[x] = z;
+				if (state->yPixelCount > 0)
 				{
 					s32 widthMask = tex->width - 1;
 					s32 texelU = floor16(uCoord) & widthMask;
@@ -1239,47 +1294,47 @@ namespace RClassic_Fixed
 						texelU = widthMask - texelU;
 					}
 
-					s_vCoordStep = div16(wall->botTexelHeight, yBot - yTop + ONE_16);
-					fixed16_16 v0 = mul16(yBot - intToFixed16(yBot_pixel) + HALF_16, s_vCoordStep);
-					s_vCoordFixed = v0 + wall->botOffset.z;
-					s_texImage = &tex->image[texelU << tex->logSizeY];
-					s_columnOut = &s_display[yTop_pixel * s_width + x];
-					s_columnLight = computeLighting(z, floor16(wall->wallLight));
-					if (s_columnLight)
+					state->vCoordStep = div16(wall->botTexelHeight, yBot - yTop + ONE_16);
+					fixed16_16 v0 = mul16(yBot - intToFixed16(yBot_pixel) + HALF_16, state->vCoordStep);
+					state->vCoordFixed = v0 + wall->botOffset.z;
+					state->texImage = &tex->image[texelU << tex->logSizeY];
+					state->columnOut = &s_display[yTop_pixel * s_width + x];
+					state->columnLight = computeLighting(z, floor16(wall->wallLight));
+					if (state->columnLight)
 					{
-						drawColumn_Lit();
+						drawColumn_Lit(state);
 					}
 					else
 					{
-						drawColumn_Fullbright();
+						drawColumn_Fullbright(state);
 					}
 
 					// Handle the "sign texture" - a wall overlay.
 					if (signTex && uCoord >= signU0 && uCoord <= signU1)
 					{
-						fixed16_16 signYBase = yBot + div16(wall->signOffset.z, s_vCoordStep);
-						s32 y0 = max(floor16(signYBase - div16(intToFixed16(signTex->height), s_vCoordStep) + ONE_16 + HALF_16), yTop_pixel);
+						fixed16_16 signYBase = yBot + div16(wall->signOffset.z, state->vCoordStep);
+						s32 y0 = max(floor16(signYBase - div16(intToFixed16(signTex->height), state->vCoordStep) + ONE_16 + HALF_16), yTop_pixel);
 						s32 y1 = min(floor16(signYBase + HALF_16), yBot_pixel);
-						s_yPixelCount = y1 - y0 + 1;
+						state->yPixelCount = y1 - y0 + 1;
 
-						if (s_yPixelCount > 0)
+						if (state->yPixelCount > 0)
 						{
-							s_vCoordFixed = mul16(signYBase - intToFixed16(y1) + HALF_16, s_vCoordStep);
-							s_columnOut = &s_display[y0*s_width + x];
+							state->vCoordFixed = mul16(signYBase - intToFixed16(y1) + HALF_16, state->vCoordStep);
+							state->columnOut = &s_display[y0*s_width + x];
 							texelU = floor16(uCoord - signU0);
-							s_texImage = &signTex->image[texelU << signTex->logSizeY];
+							state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-							s32 heightMask = s_texHeightMask;
-							s_texHeightMask = signTex->height - 1;
-							if (s_columnLight)
+							s32 heightMask = state->texHeightMask;
+							state->texHeightMask = signTex->height - 1;
+							if (state->columnLight)
 							{
-								signLit();
+								signLit(state);
 							}
 							else
 							{
-								signFullbright();
+								signFullbright(state);
 							}
-							s_texHeightMask = heightMask;
+							state->texHeightMask = heightMask;
 						}
 					}
 				}
@@ -1291,7 +1346,7 @@ namespace RClassic_Fixed
 		wall->seen = JTRUE;
 	}
 
-	void wall_drawTop(RWallSegmentFixed* wallSegment)
+	void wall_drawTop(RClassicFixedState* state, RWallSegmentFixed* wallSegment)
 	{
 		RWall* srcWall = wallSegment->srcWall;
 		RSector* sector = srcWall->sector;
@@ -1306,24 +1361,24 @@ namespace RClassic_Fixed
 		s32 x0 = wallSegment->wallX0;
 		s32 lengthInPixels = wallSegment->wallX1 - wallSegment->wallX0 + 1;
 
-		fixed16_16 ceilRel = sector->ceilingHeight - s_rcfState.eyeHeight;
+		fixed16_16 ceilRel = sector->ceilingHeight - state->eyeHeight;
 		fixed16_16 yC0, yC1;
-		yC0 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		yC1 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		yC0 = div16(mul16(ceilRel, state->focalLenAspect), z0) + state->projOffsetY;
+		yC1 = div16(mul16(ceilRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		s32 yC0_pixel = round16(yC0);
 		s32 yC1_pixel = round16(yC1);
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 
 		if (yC0_pixel > s_windowMaxY_Pixels && yC1_pixel > s_windowMaxY_Pixels)
 		{
 			srcWall->visible = 0;
 			for (s32 i = 0; i < lengthInPixels; i++) { s_columnTop[x0 + i] = s_windowMaxY_Pixels; }
-			flat_addEdges(lengthInPixels, x0, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, lengthInPixels, x0, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
 			for (s32 i = 0, x = x0; i < lengthInPixels; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 			srcWall->seen = JTRUE;
@@ -1337,9 +1392,9 @@ namespace RClassic_Fixed
 		}
 		else
 		{
-			fixed16_16 floorRel = sector->floorHeight - s_rcfState.eyeHeight;
-			yF0 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-			yF1 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+			fixed16_16 floorRel = sector->floorHeight - state->eyeHeight;
+			yF0 = div16(mul16(floorRel, state->focalLenAspect), z0) + state->projOffsetY;
+			yF1 = div16(mul16(floorRel, state->focalLenAspect), z1) + state->projOffsetY;
 		}
 		s32 yF0_pixel = round16(yF0);
 		s32 yF1_pixel = round16(yF1);
@@ -1347,20 +1402,20 @@ namespace RClassic_Fixed
 		{
 			srcWall->visible = 0;
 			for (s32 i = 0; i < lengthInPixels; i++) { s_columnBot[x0 + i] = s_windowMinY_Pixels; }
-			flat_addEdges(lengthInPixels, x0, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, lengthInPixels, x0, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
 			for (s32 i = 0, x = x0; i < lengthInPixels; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			srcWall->seen = JTRUE;
 			return;
 		}
 
-		fixed16_16 next_ceilRel = next->ceilingHeight - s_rcfState.eyeHeight;
+		fixed16_16 next_ceilRel = next->ceilingHeight - state->eyeHeight;
 		fixed16_16 next_yC0, next_yC1;
-		next_yC0 = div16(mul16(next_ceilRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		next_yC1 = div16(mul16(next_ceilRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		next_yC0 = div16(mul16(next_ceilRel, state->focalLenAspect), z0) + state->projOffsetY;
+		next_yC1 = div16(mul16(next_ceilRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		fixed16_16 xOffset = intToFixed16(wallSegment->wallX0 - wallSegment->wallX0_raw);
 		fixed16_16 length = intToFixed16(wallSegment->wallX1_raw - wallSegment->wallX0_raw);
@@ -1380,12 +1435,12 @@ namespace RClassic_Fixed
 			yF0 += mul16(floor_dYdX, xOffset);
 		}
 
-		flat_addEdges(lengthInPixels, x0, floor_dYdX, yF0, ceil_dYdX, yC0);
+		flat_addEdges(state, lengthInPixels, x0, floor_dYdX, yF0, ceil_dYdX, yC0);
 		s32 next_yC0_pixel = round16(next_yC0);
 		s32 next_yC1_pixel = round16(next_yC1);
 		if ((next_yC0_pixel < s_windowMaxY_Pixels || next_yC1_pixel < s_windowMaxY_Pixels) && (sector->floorHeight > next->ceilingHeight))
 		{
-			wall_addAdjoinSegment(lengthInPixels, x0, floor_dYdX, yF0, next_ceil_dYdX, next_yC0, wallSegment);
+			wall_addAdjoinSegment(state, lengthInPixels, x0, floor_dYdX, yF0, next_ceil_dYdX, next_yC0, wallSegment);
 		}
 
 		if (next_yC0_pixel < s_windowMinY_Pixels && next_yC1_pixel < s_windowMinY_Pixels)
@@ -1400,7 +1455,7 @@ namespace RClassic_Fixed
 				}
 
 				s_columnBot[x] = yF0_pixel + 1;
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				yF0 += floor_dYdX;
 			}
 			srcWall->seen = JTRUE;
@@ -1434,17 +1489,17 @@ namespace RClassic_Fixed
 				next_yC0_pixel = bot;
 			}
 
-			s_yPixelCount = next_yC0_pixel - yC0_pixel + 1;
+			state->yPixelCount = next_yC0_pixel - yC0_pixel + 1;
 
 			fixed16_16 dxView;
-			fixed16_16 z = solveForZ(wallSegment, x, num, &dxView);
+			fixed16_16 z = solveForZ(state, wallSegment, x, num, &dxView);
 
 			fixed16_16 uScale = wallSegment->uScale;
 			fixed16_16 uCoord0 = wallSegment->uCoord0 + srcWall->topOffset.x;
 			fixed16_16 uCoord = uCoord0 + ((wallSegment->orient == WORIENT_DZ_DX) ? mul16(dxView, uScale) : mul16(z - z0, uScale));
 
-			s_rcfState.depth1d[x] = z;
-			if (s_yPixelCount > 0)
+			state->depth1d[x] = z;
+			if (state->yPixelCount > 0)
 			{
 				s32 widthMask = texture->width - 1;
 				s32 texelU = floor16(uCoord) & widthMask;
@@ -1454,47 +1509,47 @@ namespace RClassic_Fixed
 				}
 				assert(texelU >= 0 && texelU <= widthMask);
 
-				s_vCoordStep = div16(srcWall->topTexelHeight, next_yC0 - yC0 + ONE_16);
-				s_vCoordFixed = srcWall->topOffset.z + mul16(next_yC0 - intToFixed16(next_yC0_pixel) + HALF_16, s_vCoordStep);
-				s_texImage = &texture->image[texelU << texture->logSizeY];
+				state->vCoordStep = div16(srcWall->topTexelHeight, next_yC0 - yC0 + ONE_16);
+				state->vCoordFixed = srcWall->topOffset.z + mul16(next_yC0 - intToFixed16(next_yC0_pixel) + HALF_16, state->vCoordStep);
+				state->texImage = &texture->image[texelU << texture->logSizeY];
 
-				s_columnOut = &s_display[yC0_pixel * s_width + x];
-				s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
-				if (s_columnLight)
+				state->columnOut = &s_display[yC0_pixel * s_width + x];
+				state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
+				if (state->columnLight)
 				{
-					drawColumn_Lit();
+					drawColumn_Lit(state);
 				}
 				else
 				{
-					drawColumn_Fullbright();
+					drawColumn_Fullbright(state);
 				}
 
 				// Handle the "sign texture" - a wall overlay.
 				if (signTex && uCoord >= signU0 && uCoord <= signU1)
 				{
-					fixed16_16 signYBase = next_yC0 + div16(srcWall->signOffset.z, s_vCoordStep);
-					s32 y0 = max(floor16(signYBase - div16(intToFixed16(signTex->height), s_vCoordStep) + ONE_16 + HALF_16), yC0_pixel);
+					fixed16_16 signYBase = next_yC0 + div16(srcWall->signOffset.z, state->vCoordStep);
+					s32 y0 = max(floor16(signYBase - div16(intToFixed16(signTex->height), state->vCoordStep) + ONE_16 + HALF_16), yC0_pixel);
 					s32 y1 = min(floor16(signYBase + HALF_16), next_yC0_pixel);
-					s_yPixelCount = y1 - y0 + 1;
+					state->yPixelCount = y1 - y0 + 1;
 
-					if (s_yPixelCount > 0)
+					if (state->yPixelCount > 0)
 					{
-						s_vCoordFixed = mul16(signYBase - intToFixed16(y1) + HALF_16, s_vCoordStep);
-						s_columnOut = &s_display[y0*s_width + x];
+						state->vCoordFixed = mul16(signYBase - intToFixed16(y1) + HALF_16, state->vCoordStep);
+						state->columnOut = &s_display[y0*s_width + x];
 						texelU = floor16(uCoord - signU0);
-						s_texImage = &signTex->image[texelU << signTex->logSizeY];
+						state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-						s32 heightMask = s_texHeightMask;
-						s_texHeightMask = signTex->height - 1;
-						if (s_columnLight)
+						s32 heightMask = state->texHeightMask;
+						state->texHeightMask = signTex->height - 1;
+						if (state->columnLight)
 						{
-							signLit();
+							signLit(state);
 						}
 						else
 						{
-							signFullbright();
+							signFullbright(state);
 						}
-						s_texHeightMask = heightMask;
+						state->texHeightMask = heightMask;
 					}
 				}
 			}
@@ -1507,7 +1562,7 @@ namespace RClassic_Fixed
 		srcWall->seen = JTRUE;
 	}
 
-	void wall_drawTopAndBottom(RWallSegmentFixed* wallSegment)
+	void wall_drawTopAndBottom(RClassicFixedState* state, RWallSegmentFixed* wallSegment)
 	{
 		RWall* srcWall = wallSegment->srcWall;
 		RSector* sector = srcWall->sector;
@@ -1519,10 +1574,10 @@ namespace RClassic_Fixed
 		s32 length    =  wallSegment->wallX1 - wallSegment->wallX0 + 1;
 		fixed16_16 lengthRaw = intToFixed16(wallSegment->wallX1_raw - wallSegment->wallX0_raw);
 
-		fixed16_16 ceilRel = sector->ceilingHeight - s_rcfState.eyeHeight;
+		fixed16_16 ceilRel = sector->ceilingHeight - state->eyeHeight;
 		fixed16_16 cProj0, cProj1;
-		cProj0 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		cProj1 = div16(mul16(ceilRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		cProj0 = div16(mul16(ceilRel, state->focalLenAspect), z0) + state->projOffsetY;
+		cProj1 = div16(mul16(ceilRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		s32 c0_pixel = round16(cProj0);
 		s32 c1_pixel = round16(cProj1);
@@ -1532,21 +1587,21 @@ namespace RClassic_Fixed
 			srcWall->visible = 0;
 			for (s32 i = 0; i < length; i++) { s_columnTop[x0 + i] = s_windowMaxY_Pixels; }
 
-			flat_addEdges(length, x0, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, length, x0, 0, intToFixed16(s_windowMaxY_Pixels + 1), 0, intToFixed16(s_windowMaxY_Pixels + 1));
 			fixed16_16 num = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0, x = x0; i < length; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 			srcWall->seen = JTRUE;
 			return;
 		}
 
-		fixed16_16 floorRel = sector->floorHeight - s_rcfState.eyeHeight;
+		fixed16_16 floorRel = sector->floorHeight - state->eyeHeight;
 		fixed16_16 fProj0, fProj1;
-		fProj0 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		fProj1 = div16(mul16(floorRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		fProj0 = div16(mul16(floorRel, state->focalLenAspect), z0) + state->projOffsetY;
+		fProj1 = div16(mul16(floorRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		s32 f0_pixel = round16(fProj0);
 		s32 f1_pixel = round16(fProj1);
@@ -1555,12 +1610,12 @@ namespace RClassic_Fixed
 			srcWall->visible = 0;
 			for (s32 i = 0; i < length; i++) { s_columnBot[x0 + i] = s_windowMinY_Pixels; }
 
-			flat_addEdges(length, x0, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, length, x0, 0, intToFixed16(s_windowMinY_Pixels - 1), 0, intToFixed16(s_windowMinY_Pixels - 1));
 			fixed16_16 num = solveForZ_Numerator(wallSegment);
 
 			for (s32 i = 0, x = x0; i < length; i++, x++)
 			{
-				s_rcfState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			srcWall->seen = JTRUE;
@@ -1568,10 +1623,10 @@ namespace RClassic_Fixed
 		}
 
 		RSector* nextSector = srcWall->nextSector;
-		fixed16_16 next_ceilRel = nextSector->ceilingHeight - s_rcfState.eyeHeight;
+		fixed16_16 next_ceilRel = nextSector->ceilingHeight - state->eyeHeight;
 		fixed16_16 next_cProj0, next_cProj1;
-		next_cProj0 = div16(mul16(next_ceilRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		next_cProj1 = div16(mul16(next_ceilRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		next_cProj0 = div16(mul16(next_ceilRel, state->focalLenAspect), z0) + state->projOffsetY;
+		next_cProj1 = div16(mul16(next_ceilRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		fixed16_16 ceil_dYdX = 0;
 		fixed16_16 next_ceil_dYdX = 0;
@@ -1595,7 +1650,7 @@ namespace RClassic_Fixed
 		{
 			fixed16_16 u0 = wallSegment->uCoord0;
 			fixed16_16 num = solveForZ_Numerator(wallSegment);
-			s_texHeightMask = topTex->height - 1;
+			state->texHeightMask = topTex->height - 1;
 			JBool flipHorz = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 
 			for (s32 i = 0, x = x0; i < length; i++, x++)
@@ -1613,11 +1668,11 @@ namespace RClassic_Fixed
 				{
 					yC1_pixel = bot;
 				}
-				s_yPixelCount = yC1_pixel - yC0_pixel + 1;
+				state->yPixelCount = yC1_pixel - yC0_pixel + 1;
 
 				// Calculate perspective correct Z and U (texture coordinate).
 				fixed16_16 dxView;
-				fixed16_16 z = solveForZ(wallSegment, x, num, &dxView);
+				fixed16_16 z = solveForZ(state, wallSegment, x, num, &dxView);
 				fixed16_16 u;
 				if (wallSegment->orient == WORIENT_DZ_DX)
 				{
@@ -1628,8 +1683,8 @@ namespace RClassic_Fixed
 					fixed16_16 dz = z - z0;
 					u = u0 + mul16(dz, wallSegment->uScale) + srcWall->topOffset.x;
 				}
-				s_rcfState.depth1d[x] = z;
-				if (s_yPixelCount > 0)
+				state->depth1d[x] = z;
+				if (state->yPixelCount > 0)
 				{
 					s32 widthMask = topTex->width - 1;
 					s32 texelU = floor16(u) & widthMask;
@@ -1637,20 +1692,20 @@ namespace RClassic_Fixed
 					{
 						texelU = widthMask - texelU;
 					}
-					s_vCoordStep = div16(srcWall->topTexelHeight, yC1 - yC0 + ONE_16);
+					state->vCoordStep = div16(srcWall->topTexelHeight, yC1 - yC0 + ONE_16);
 					fixed16_16 yOffset = yC1 - intToFixed16(yC1_pixel) + HALF_16;
-					s_vCoordFixed = mul16(yOffset, s_vCoordStep) + srcWall->topOffset.z;
-					s_texImage = &topTex->image[texelU << topTex->logSizeY];
-					s_columnOut = &s_display[yC0_pixel * s_width + x];
-					s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+					state->vCoordFixed = mul16(yOffset, state->vCoordStep) + srcWall->topOffset.z;
+					state->texImage = &topTex->image[texelU << topTex->logSizeY];
+					state->columnOut = &s_display[yC0_pixel * s_width + x];
+					state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 
-					if (s_columnLight)
+					if (state->columnLight)
 					{
-						drawColumn_Lit();
+						drawColumn_Lit(state);
 					}
 					else
 					{
-						drawColumn_Fullbright();
+						drawColumn_Fullbright(state);
 					}
 				}
 				yC0 += ceil_dYdX;
@@ -1662,10 +1717,10 @@ namespace RClassic_Fixed
 			for (s32 i = 0; i < length; i++) { s_columnTop[x0 + i] = s_windowMinY_Pixels - 1; }
 		}
 
-		fixed16_16 next_floorRel = nextSector->floorHeight - s_rcfState.eyeHeight;
+		fixed16_16 next_floorRel = nextSector->floorHeight - state->eyeHeight;
 		fixed16_16 next_fProj0, next_fProj1;
-		next_fProj0 = div16(mul16(next_floorRel, s_rcfState.focalLenAspect), z0) + s_rcfState.projOffsetY;
-		next_fProj1 = div16(mul16(next_floorRel, s_rcfState.focalLenAspect), z1) + s_rcfState.projOffsetY;
+		next_fProj0 = div16(mul16(next_floorRel, state->focalLenAspect), z0) + state->projOffsetY;
+		next_fProj1 = div16(mul16(next_floorRel, state->focalLenAspect), z1) + state->projOffsetY;
 
 		fixed16_16 next_floor_dYdX = 0;
 		fixed16_16 floor_dYdX = 0;
@@ -1691,7 +1746,7 @@ namespace RClassic_Fixed
 			fixed16_16 u0 = wallSegment->uCoord0;
 			fixed16_16 num = solveForZ_Numerator(wallSegment);
 
-			s_texHeightMask = botTex->height - 1;
+			state->texHeightMask = botTex->height - 1;
 			JBool flipHorz  = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 			JBool illumSign = ((srcWall->flags1 & WF1_ILLUM_SIGN)!=0) ? JTRUE : JFALSE;
 
@@ -1716,11 +1771,11 @@ namespace RClassic_Fixed
 					{
 						yF1_pixel = bot;
 					}
-					s_yPixelCount = yF1_pixel - yF0_pixel + 1;	// eax
+					state->yPixelCount = yF1_pixel - yF0_pixel + 1;	// eax
 
 					// Calculate perspective correct Z and U (texture coordinate).
 					fixed16_16 dxView;
-					fixed16_16 z = solveForZ(wallSegment, x, num, &dxView);
+					fixed16_16 z = solveForZ(state, wallSegment, x, num, &dxView);
 					fixed16_16 uCoord;
 					if (wallSegment->orient == WORIENT_DZ_DX)
 					{
@@ -1731,8 +1786,8 @@ namespace RClassic_Fixed
 						fixed16_16 dz = z - z0;
 						uCoord = u0 + mul16(dz, wallSegment->uScale) + srcWall->botOffset.x;
 					}
-					s_rcfState.depth1d[x] = z;
-					if (s_yPixelCount > 0)
+					state->depth1d[x] = z;
+					if (state->yPixelCount > 0)
 					{
 						s32 widthMask = botTex->width - 1;
 						s32 texelU = floor16(uCoord) & widthMask;
@@ -1740,47 +1795,47 @@ namespace RClassic_Fixed
 						{
 							texelU = widthMask - texelU;
 						}
-						s_vCoordStep = div16(srcWall->botTexelHeight, yF1 - yF0 + ONE_16);
-						s_vCoordFixed = srcWall->botOffset.z + mul16(yF1 - intToFixed16(yF1_pixel) + HALF_16, s_vCoordStep);
-						s_texImage = &botTex->image[texelU << botTex->logSizeY];
-						s_columnOut = &s_display[yF0_pixel * s_width + x];
-						s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+						state->vCoordStep = div16(srcWall->botTexelHeight, yF1 - yF0 + ONE_16);
+						state->vCoordFixed = srcWall->botOffset.z + mul16(yF1 - intToFixed16(yF1_pixel) + HALF_16, state->vCoordStep);
+						state->texImage = &botTex->image[texelU << botTex->logSizeY];
+						state->columnOut = &s_display[yF0_pixel * s_width + x];
+						state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 
-						if (s_columnLight)
+						if (state->columnLight)
 						{
-							drawColumn_Lit();
+							drawColumn_Lit(state);
 						}
 						else
 						{
-							drawColumn_Fullbright();
+							drawColumn_Fullbright(state);
 						}
 
 						// Handle the "sign texture" - a wall overlay.
 						if (signTex && uCoord >= signU0 && uCoord <= signU1)
 						{
-							fixed16_16 signYBase = yF1 + div16(srcWall->signOffset.z, s_vCoordStep);
-							s32 y0 = max(floor16(signYBase - div16(intToFixed16(signTex->height), s_vCoordStep) + ONE_16 + HALF_16), yF0_pixel);
+							fixed16_16 signYBase = yF1 + div16(srcWall->signOffset.z, state->vCoordStep);
+							s32 y0 = max(floor16(signYBase - div16(intToFixed16(signTex->height), state->vCoordStep) + ONE_16 + HALF_16), yF0_pixel);
 							s32 y1 = min(floor16(signYBase + HALF_16), yF1_pixel);
-							s_yPixelCount = y1 - y0 + 1;
+							state->yPixelCount = y1 - y0 + 1;
 
-							if (s_yPixelCount > 0)
+							if (state->yPixelCount > 0)
 							{
-								s_vCoordFixed = mul16(signYBase - intToFixed16(y1) + HALF_16, s_vCoordStep);
-								s_columnOut = &s_display[y0*s_width + x];
+								state->vCoordFixed = mul16(signYBase - intToFixed16(y1) + HALF_16, state->vCoordStep);
+								state->columnOut = &s_display[y0*s_width + x];
 								texelU = floor16(uCoord - signU0);
-								s_texImage = &signTex->image[texelU << signTex->logSizeY];
+								state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-								s32 heightMask = s_texHeightMask;
-								s_texHeightMask = signTex->height - 1;
-								if (s_columnLight)
+								s32 heightMask = state->texHeightMask;
+								state->texHeightMask = signTex->height - 1;
+								if (state->columnLight)
 								{
-									signLit();
+									signLit(state);
 								}
 								else
 								{
-									signFullbright();
+									signFullbright(state);
 								}
-								s_texHeightMask = heightMask;
+								state->texHeightMask = heightMask;
 							}
 						}
 					}
@@ -1793,7 +1848,7 @@ namespace RClassic_Fixed
 		{
 			for (s32 i = 0; i < length; i++) { s_columnBot[x0 + i] = s_windowMaxY_Pixels + 1; }
 		}
-		flat_addEdges(length, x0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
+		flat_addEdges(state, length, x0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
 
 		s32 next_f0_pixel = round16(next_fProj0);
 		s32 next_f1_pixel = round16(next_fProj1);
@@ -1805,13 +1860,13 @@ namespace RClassic_Fixed
 			return;
 		}
 
-		wall_addAdjoinSegment(length, x0, next_floor_dYdX, next_fProj0 - ONE_16, next_ceil_dYdX, next_cProj0 + ONE_16, wallSegment);
+		wall_addAdjoinSegment(state, length, x0, next_floor_dYdX, next_fProj0 - ONE_16, next_ceil_dYdX, next_cProj0 + ONE_16, wallSegment);
 		srcWall->seen = JTRUE;
 	}
 
 	// Parts of the code inside 's_height == SKY_BASE_HEIGHT' are based on the original DOS exe.
 	// Other parts of those same conditionals are modified to handle higher resolutions.
-	void wall_drawSkyTop(RSector* sector)
+	void wall_drawSkyTop(RClassicFixedState* state, RSector* sector)
 	{
 		if (s_wallMaxCeilY < s_windowMinY_Pixels) { return; }
 		TFE_ZONE("Draw Sky");
@@ -1822,15 +1877,15 @@ namespace RClassic_Fixed
 		// However with higher resolutions this must be scaled to look the same.
 		if (s_height == SKY_BASE_HEIGHT)
 		{
-			s_vCoordStep = ONE_16;
+			state->vCoordStep = ONE_16;
 			heightScale = ONE_16;
 		}
 		else
 		{
-			s_vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
+			state->vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
 			heightScale = div16(intToFixed16(SKY_BASE_HEIGHT), intToFixed16(s_height));
 		}
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		const s32 texWidthMask = texture->width - 1;
 
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
@@ -1838,27 +1893,27 @@ namespace RClassic_Fixed
 			const s32 y0 = s_windowTop[x];
 			const s32 y1 = min(s_columnTop[x], s_windowBot[x]);
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask - y1) - s_rcfState.skyPitchOffset - sector->ceilOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask - y1) - state->skyPitchOffset - sector->ceilOffset.z;
 				}
 				else
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask) - mul16(intToFixed16(y1), heightScale) - s_rcfState.skyPitchOffset - sector->ceilOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask) - mul16(intToFixed16(y1), heightScale) - state->skyPitchOffset - sector->ceilOffset.z;
 				}
 
-				s32 texelU = ( floor16(sector->ceilOffset.x - s_rcfState.skyYawOffset + s_rcfState.skyTable[x]) ) & texWidthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
-				drawColumn_Fullbright();
+				s32 texelU = ( floor16(sector->ceilOffset.x - state->skyYawOffset + state->skyTable[x]) ) & texWidthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 
-	void wall_drawSkyTopNoWall(RSector* sector)
+	void wall_drawSkyTopNoWall(RClassicFixedState* state, RSector* sector)
 	{
 		TFE_ZONE("Draw Sky");
 		const TextureData* texture = *sector->ceilTex;
@@ -1868,46 +1923,46 @@ namespace RClassic_Fixed
 		// However with higher resolutions this must be scaled to look the same.
 		if (s_height == SKY_BASE_HEIGHT)
 		{
-			s_vCoordStep = ONE_16;
+			state->vCoordStep = ONE_16;
 			heightScale = ONE_16;
 		}
 		else
 		{
-			s_vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
+			state->vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
 			heightScale = div16(intToFixed16(SKY_BASE_HEIGHT), intToFixed16(s_height));
 		}
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
 		{
 			const s32 y0 = s_windowTop[x];
 			const s32 y1 = min(s_screenYMidFix - 1, s_windowBot[x]);
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask - y1) - s_rcfState.skyPitchOffset - sector->ceilOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask - y1) - state->skyPitchOffset - sector->ceilOffset.z;
 				}
 				else
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask) - mul16(intToFixed16(y1), heightScale) - s_rcfState.skyPitchOffset - sector->ceilOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask) - mul16(intToFixed16(y1), heightScale) - state->skyPitchOffset - sector->ceilOffset.z;
 				}
 
 				s32 widthMask = texture->width - 1;
-				s32 texelU = floor16(sector->ceilOffset.x - s_rcfState.skyYawOffset + s_rcfState.skyTable[x]) & widthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
+				s32 texelU = floor16(sector->ceilOffset.x - state->skyYawOffset + state->skyTable[x]) & widthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
 
-				drawColumn_Fullbright();
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 
 	// Parts of the code inside 's_height == SKY_BASE_HEIGHT' are based on the original DOS exe.
 	// Other parts of those same conditionals are modified to handle higher resolutions.
-	void wall_drawSkyBottom(RSector* sector)
+	void wall_drawSkyBottom(RClassicFixedState* state, RSector* sector)
 	{
 		if (s_wallMinFloorY > s_windowMaxY_Pixels) { return; }
 		TFE_ZONE("Draw Sky");
@@ -1918,15 +1973,15 @@ namespace RClassic_Fixed
 		// However with higher resolutions this must be scaled to look the same.
 		if (s_height == SKY_BASE_HEIGHT)
 		{
-			s_vCoordStep = ONE_16;
+			state->vCoordStep = ONE_16;
 			heightScale = ONE_16;
 		}
 		else
 		{
-			s_vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
+			state->vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
 			heightScale = div16(intToFixed16(SKY_BASE_HEIGHT), intToFixed16(s_height));
 		}
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		const s32 texWidthMask = texture->width - 1;
 
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
@@ -1934,27 +1989,27 @@ namespace RClassic_Fixed
 			const s32 y0 = max(s_columnBot[x], s_windowTop[x]);
 			const s32 y1 = s_windowBot[x];
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask - y1) - s_rcfState.skyPitchOffset - sector->floorOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask - y1) - state->skyPitchOffset - sector->floorOffset.z;
 				}
 				else
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask) - mul16(intToFixed16(y1), heightScale) - s_rcfState.skyPitchOffset - sector->floorOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask) - mul16(intToFixed16(y1), heightScale) - state->skyPitchOffset - sector->floorOffset.z;
 				}
 
-				s32 texelU = floor16(sector->floorOffset.x - s_rcfState.skyYawOffset + s_rcfState.skyTable[x]) & texWidthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
-				drawColumn_Fullbright();
+				s32 texelU = floor16(sector->floorOffset.x - state->skyYawOffset + state->skyTable[x]) & texWidthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 
-	void wall_drawSkyBottomNoWall(RSector* sector)
+	void wall_drawSkyBottomNoWall(RClassicFixedState* state, RSector* sector)
 	{
 		TFE_ZONE("Draw Sky");
 		const TextureData* texture = *sector->floorTex;
@@ -1964,46 +2019,46 @@ namespace RClassic_Fixed
 		// However with higher resolutions this must be scaled to look the same.
 		if (s_height == SKY_BASE_HEIGHT)
 		{
-			s_vCoordStep = ONE_16;
+			state->vCoordStep = ONE_16;
 			heightScale = ONE_16;
 		}
 		else
 		{
-			s_vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
+			state->vCoordStep = ONE_16 * SKY_BASE_HEIGHT / s_height;
 			heightScale = div16(intToFixed16(SKY_BASE_HEIGHT), intToFixed16(s_height));
 		}
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
 		{
 			const s32 y0 = max(s_screenYMidFix, s_windowTop[x]);
 			const s32 y1 = s_windowBot[x];
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask - y1) - s_rcfState.skyPitchOffset - sector->floorOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask - y1) - state->skyPitchOffset - sector->floorOffset.z;
 				}
 				else
 				{
-					s_vCoordFixed = intToFixed16(s_texHeightMask) - mul16(intToFixed16(y1), heightScale) - s_rcfState.skyPitchOffset - sector->floorOffset.z;
+					state->vCoordFixed = intToFixed16(state->texHeightMask) - mul16(intToFixed16(y1), heightScale) - state->skyPitchOffset - sector->floorOffset.z;
 				}
 
 				s32 widthMask = texture->width - 1;
-				s32 texelU = floor16(sector->floorOffset.x - s_rcfState.skyYawOffset + s_rcfState.skyTable[x]) & widthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
+				s32 texelU = floor16(sector->floorOffset.x - state->skyYawOffset + state->skyTable[x]) & widthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
 
-				drawColumn_Fullbright();
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 	
 	// Determines if segment A is disjoint from the line formed by B - i.e. they do not intersect.
 	// Returns 1 if segment A does NOT cross line B or 0 if it does.
-	s32 segmentCrossesLine(fixed16_16 ax0, fixed16_16 ay0, fixed16_16 ax1, fixed16_16 ay1, fixed16_16 bx0, fixed16_16 by0, fixed16_16 bx1, fixed16_16 by1)
+	s32 segmentCrossesLine(RClassicFixedState* state, fixed16_16 ax0, fixed16_16 ay0, fixed16_16 ax1, fixed16_16 ay1, fixed16_16 bx0, fixed16_16 by0, fixed16_16 bx1, fixed16_16 by1)
 	{
 		// Convert from 16 fractional bits to 12.
 		bx0 = fixed16to12(bx0);
@@ -2018,10 +2073,10 @@ namespace RClassic_Fixed
 		// mul16() functions on 12 bit values is equivalent to: a * b / 16
 		// [ (a1-b0)x(b1-b0) ].[ (a0-b0)x(b1 - b0) ]
 		// In 2D x = "perp product"
-		s_segmentCross = mul16(mul16(ax1 - bx0, by1 - by0) - mul16(ay1 - by0, bx1 - bx0),
+		state->segmentCross = mul16(mul16(ax1 - bx0, by1 - by0) - mul16(ay1 - by0, bx1 - bx0),
 			                   mul16(ax0 - bx0, by1 - by0) - mul16(ay0 - by0, bx1 - bx0));
 
-		return s_segmentCross > 0 ? 1 : 0;
+		return state->segmentCross > 0 ? 1 : 0;
 	}
 		
 	// When solving for Z, part of the computation can be done once per wall.
@@ -2043,13 +2098,13 @@ namespace RClassic_Fixed
 	}
 	
 	// Solve for perspective correct Z at the current x pixel coordinate.
-	fixed16_16 solveForZ(RWallSegmentFixed* wallSegment, s32 x, fixed16_16 numerator, fixed16_16* outViewDx/*=nullptr*/)
+	fixed16_16 solveForZ(RClassicFixedState* state, RWallSegmentFixed* wallSegment, s32 x, fixed16_16 numerator, fixed16_16* outViewDx/*=nullptr*/)
 	{
 		fixed16_16 z;	// perspective correct z coordinate at the current x pixel coordinate.
 		if (wallSegment->orient == WORIENT_DZ_DX)
 		{
 			// Solve for viewspace X at the current pixel x coordinate in order to get dx in viewspace.
-			fixed16_16 den = s_rcfState.column_Z_Over_X[x] - wallSegment->slope;
+			fixed16_16 den = state->column_Z_Over_X[x] - wallSegment->slope;
 			// Avoid divide by zero.
 			if (den == 0) { den = 1; }
 
@@ -2066,7 +2121,7 @@ namespace RClassic_Fixed
 		else  // WORIENT_DX_DZ
 		{
 			// Directly solve for Z at the current pixel x coordinate.
-			fixed16_16 den = s_rcfState.column_X_Over_Z[x] - wallSegment->slope;
+			fixed16_16 den = state->column_X_Over_Z[x] - wallSegment->slope;
 			// Avoid divide by 0.
 			if (den == 0) { den = 1; }
 
@@ -2076,79 +2131,111 @@ namespace RClassic_Fixed
 		return z;
 	}
 
-	void drawColumn_Fullbright()
+	// Draw using the SIMD column kernel if there is one for this CPU, otherwise the scalar code below is used.
+	bool drawColumn_Simd(RClassicFixedState* state, ColumnKernelId id)
+	{
+		const ColumnKernel kernel = column_getKernel(id);
+		if (!kernel || !column_supportsMask(state->texHeightMask, FRAC_BITS_16)) { return false; }
+
+		kernel(state->columnOut, s_width, state->yPixelCount, state->texImage, state->columnLight, u32(state->vCoordFixed), u32(state->vCoordStep), FRAC_BITS_16, state->texHeightMask);
+		return true;
+	}
+
+	void drawColumn_Fullbright(RClassicFixedState* state)
 	{
-		fixed16_16 vCoordFixed = s_vCoordFixed;
-		u8* tex = s_texImage;
+		if (drawColumn_Simd(state, COLKERNEL_FULLBRIGHT)) { return; }
 
-		s32 v = floor16(vCoordFixed) & s_texHeightMask;
-		s32 end = s_yPixelCount - 1;
+		fixed16_16 vCoordFixed = state->vCoordFixed;
+		u8* tex = state->texImage;
+		const fixed16_16 vCoordStep = state->vCoordStep;
+		const s32 texHeightMask = state->texHeightMask;
+		u8* columnOut = state->columnOut;
+
+		s32 v = floor16(vCoordFixed) & texHeightMask;
+		s32 end = state->yPixelCount - 1;
 
 		s32 offset = end * s_width;
 		for (s32 i = end; i >= 0; i--, offset -= s_width)
 		{
 			const u8 c = tex[v];
-			vCoordFixed += s_vCoordStep;
-			v = floor16(vCoordFixed) & s_texHeightMask;
-			s_columnOut[offset] = c;
+			vCoordFixed += vCoordStep;
+			v = floor16(vCoordFixed) & texHeightMask;
+			columnOut[offset] = c;
 		}
 	}
 
-	void drawColumn_Lit()
+	void drawColumn_Lit(RClassicFixedState* state)
 	{
-		fixed16_16 vCoordFixed = s_vCoordFixed;
-		u8* tex = s_texImage;
+		if (drawColumn_Simd(state, COLKERNEL_LIT)) { return; }
+
+		fixed16_16 vCoordFixed = state->vCoordFixed;
+		u8* tex = state->texImage;
+		const u8* columnLight = state->columnLight;
+		const fixed16_16 vCoordStep = state->vCoordStep;
+		const s32 texHeightMask = state->texHeightMask;
+		u8* columnOut = state->columnOut;
 
-		s32 v = floor16(vCoordFixed) & s_texHeightMask;
-		s32 end = s_yPixelCount - 1;
+		s32 v = floor16(vCoordFixed) & texHeightMask;
+		s32 end = state->yPixelCount - 1;
 
 		s32 offset = end * s_width;
 		for (s32 i = end; i >= 0; i--, offset -= s_width)
 		{
-			const u8 c = s_columnLight[tex[v]];
-			vCoordFixed += s_vCoordStep;
-			v = floor16(vCoordFixed) & s_texHeightMask;
-			s_columnOut[offset] = c;
+			const u8 c = columnLight[tex[v]];
+			vCoordFixed += vCoordStep;
+			v = floor16(vCoordFixed) & texHeightMask;
+			columnOut[offset] = c;
 		}
 	}
 
-	void drawColumn_Fullbright_Trans()
+	void drawColumn_Fullbright_Trans(RClassicFixedState* state)
 	{
-		fixed16_16 vCoordFixed = s_vCoordFixed;
-		u8* tex = s_texImage;
+		if (drawColumn_Simd(state, COLKERNEL_FULLBRIGHT_TRANS)) { return; }
 
-		s32 v = floor16(vCoordFixed) & s_texHeightMask;
-		s32 end = s_yPixelCount - 1;
+		fixed16_16 vCoordFixed = state->vCoordFixed;
+		u8* tex = state->texImage;
+		const fixed16_16 vCoordStep = state->vCoordStep;
+		const s32 texHeightMask = state->texHeightMask;
+		u8* columnOut = state->columnOut;
+
+		s32 v = floor16(vCoordFixed) & texHeightMask;
+		s32 end = state->yPixelCount - 1;
 
 		s32 offset = end * s_width;
 		for (s32 i = end; i >= 0; i--, offset -= s_width)
 		{
 			const u8 c = tex[v];
-			vCoordFixed += s_vCoordStep;
-			v = floor16(vCoordFixed) & s_texHeightMask;
-			if (c) { s_columnOut[offset] = c; }
+			vCoordFixed += vCoordStep;
+			v = floor16(vCoordFixed) & texHeightMask;
+			if (c) { columnOut[offset] = c; }
 		}
 	}
 
-	void drawColumn_Lit_Trans()
+	void drawColumn_Lit_Trans(RClassicFixedState* state)
 	{
-		fixed16_16 vCoordFixed = s_vCoordFixed;
-		u8* tex = s_texImage;
+		if (drawColumn_Simd(state, COLKERNEL_LIT_TRANS)) { return; }
+
+		fixed16_16 vCoordFixed = state->vCoordFixed;
+		u8* tex = state->texImage;
+		const fixed16_16 vCoordStep = state->vCoordStep;
+		const s32 texHeightMask = state->texHeightMask;
+		u8* columnOut = state->columnOut;
+		const u8* columnLight = state->columnLight;
 
-		s32 v = floor16(vCoordFixed) & s_texHeightMask;
-		s32 end = s_yPixelCount - 1;
+		s32 v = floor16(vCoordFixed) & texHeightMask;
+		s32 end = state->yPixelCount - 1;
 
 		s32 offset = end * s_width;
 		for (s32 i = end; i >= 0; i--, offset -= s_width)
 		{
 			const u8 c = tex[v];
-			vCoordFixed += s_vCoordStep;
-			v = floor16(vCoordFixed) & s_texHeightMask;
-			if (c) { s_columnOut[offset] = s_columnLight[c]; }
+			vCoordFixed += vCoordStep;
+			v = floor16(vCoordFixed) & texHeightMask;
+			if (c) { columnOut[offset] = columnLight[c]; }
 		}
 	}
 
-	void wall_addAdjoinSegment(s32 length, s32 x0, fixed16_16 top_dydx, fixed16_16 y1, fixed16_16 bot_dydx, fixed16_16 y0, RWallSegmentFixed* wallSegment)
+	void wall_addAdjoinSegment(RClassicFixedState* state, s32 length, s32 x0, fixed16_16 top_dydx, fixed16_16 y1, fixed16_16 bot_dydx, fixed16_16 y0, RWallSegmentFixed* wallSegment)
 	{
 		if (s_adjoinSegCount < MAX_ADJOIN_SEG)
 		{
@@ -2163,18 +2250,18 @@ namespace RClassic_Fixed
 			{
 				y1End += mul16(top_dydx, lengthFixed);
 			}
-			edgePair_setup(length, x0, top_dydx, y1End, y1, bot_dydx, y0, y0End, s_rcfState.adjoinEdge);
+			edgePair_setup(length, x0, top_dydx, y1End, y1, bot_dydx, y0, y0End, state->adjoinEdge);
 
-			s_rcfState.adjoinEdge++;
+			state->adjoinEdge++;
 			s_adjoinSegCount++;
 
-			*s_rcfState.adjoinSegment = wallSegment;
-			s_rcfState.adjoinSegment++;
+			*state->adjoinSegment = wallSegment;
+			state->adjoinSegment++;
 		}
 	}
 
 	// Refactor this into a sprite specific file.
-	void sprite_drawFrame(u8* basePtr, WaxFrame* frame, SecObject* obj)
+	void sprite_drawFrame(RClassicFixedState* state, u8* basePtr, WaxFrame* frame, SecObject* obj)
 	{
 		if (!frame) { return; }
 
@@ -2190,8 +2277,8 @@ namespace RClassic_Fixed
 		const fixed16_16 y0 = obj->posVS.y - yOffset;
 
 		const fixed16_16 rcpZ = div16(ONE_16, z);
-		const fixed16_16 projX0 = mul16(mul16(x0, s_rcfState.focalLength),    rcpZ) + s_rcfState.projOffsetX;
-		const fixed16_16 projY0 = mul16(mul16(y0, s_rcfState.focalLenAspect), rcpZ) + s_rcfState.projOffsetY;
+		const fixed16_16 projX0 = mul16(mul16(x0, state->focalLength),    rcpZ) + state->projOffsetX;
+		const fixed16_16 projY0 = mul16(mul16(y0, state->focalLenAspect), rcpZ) + state->projOffsetY;
 
 		s32 x0_pixel = round16(projX0);
 		s32 y0_pixel = round16(projY0);
@@ -2203,8 +2290,8 @@ namespace RClassic_Fixed
 		const fixed16_16 x1 = x0 + frame->widthWS;
 		const fixed16_16 y1 = y0 + frame->heightWS;
 
-		const fixed16_16 projX1 = mul16(mul16(x1, s_rcfState.focalLength),    rcpZ) + s_rcfState.projOffsetX;
-		const fixed16_16 projY1 = mul16(mul16(y1, s_rcfState.focalLenAspect), rcpZ) + s_rcfState.projOffsetY;
+		const fixed16_16 projX1 = mul16(mul16(x1, state->focalLength),    rcpZ) + state->projOffsetX;
+		const fixed16_16 projY1 = mul16(mul16(y1, state->focalLenAspect), rcpZ) + state->projOffsetY;
 
 		s32 x1_pixel = round16(projX1);
 		s32 y1_pixel = round16(projY1);
@@ -2222,7 +2309,7 @@ namespace RClassic_Fixed
 		const fixed16_16 height = projY1 - projY0 + ONE_16;
 		const fixed16_16 width = projX1 - projX0 + ONE_16;
 		const fixed16_16 uCoordStep = div16(intToFixed16(cell->sizeX), width);
-		s_vCoordStep = div16(intToFixed16(cell->sizeY), height);
+		state->vCoordStep = div16(intToFixed16(cell->sizeY), height);
 
 		fixed16_16 uCoord = 0;
 		if (x0_pixel < s_windowX0)
@@ -2237,11 +2324,11 @@ namespace RClassic_Fixed
 		}
 
 		// Compute the lighting for the whole sprite.
-		s_columnLight = computeLighting(z, 0);
+		state->columnLight = computeLighting(z, 0);
 
 		// Figure out the correct column function.
 		ColumnFunction spriteColumnFunc;
-		if (s_columnLight && !(obj->flags & OBJ_FLAG_FULLBRIGHT) && !s_flatLighting)
+		if (state->columnLight && !(obj->flags & OBJ_FLAG_FULLBRIGHT) && !s_flatLighting)
 		{
 			spriteColumnFunc = s_columnFunc[COLFUNC_LIT_TRANS];
 		}
@@ -2273,12 +2360,15 @@ namespace RClassic_Fixed
 		}
 
 		// This should be set to handle all sizes, repeating is not required.
-		s_texHeightMask = 0xffff;
+		state->texHeightMask = 0xffff;
+
+		// Compressed cells that are drawn often are decompressed once and then drawn from the sprite cache.
+		const u8* cellImage = compressed ? spriteCache_getCell(cell, basePtr) : nullptr;
 
 		const u32* columnOffset = (u32*)(basePtr + cell->columnOffset);
 		for (s32 x = x0_pixel; x <= x1_pixel; x++, uCoord += uCoordStep)
 		{
-			if (z < s_rcfState.depth1d[x])
+			if (z < state->depth1d[x])
 			{
 				s32 y0 = y0_pixel;
 				s32 y1 = y1_pixel;
@@ -2294,11 +2384,11 @@ namespace RClassic_Fixed
 					y1 = bot;
 				}
 
-				s_yPixelCount = y1 - y0 + 1;
-				if (s_yPixelCount > 0)
+				state->yPixelCount = y1 - y0 + 1;
+				if (state->yPixelCount > 0)
 				{
 					const fixed16_16 vOffset = intToFixed16(y1_pixel - y1);
-					s_vCoordFixed = mul16(vOffset, s_vCoordStep);
+					state->vCoordFixed = mul16(vOffset, state->vCoordStep);
 
 					s32 texelU = min(cell->sizeX-1, floor16(uCoord));
 					if (flip)
@@ -2306,24 +2396,28 @@ namespace RClassic_Fixed
 						texelU = cell->sizeX - texelU - 1;
 					}
 										
-					if (compressed)
+					if (cellImage)
+					{
+						state->texImage = (u8*)cellImage + texelU * cell->sizeY;
+					}
+					else if (compressed)
 					{
 						const u8* colPtr = (u8*)cell + columnOffset[texelU];
 
 						// Decompress the column into "work buffer."
 						assert(cell->sizeY <= 1024 && texelU >= 0 && texelU < cell->sizeX);
-						sprite_decompressColumn(colPtr, s_workBuffer, cell->sizeY);
-						s_texImage = (u8*)s_workBuffer;
+						sprite_decompressColumn(colPtr, state->workBuffer, cell->sizeY);
+						state->texImage = (u8*)state->workBuffer;
 					}
 					else
 					{
-						s_texImage = (u8*)image + columnOffset[texelU];
+						state->texImage = (u8*)image + columnOffset[texelU];
 					}
 					// Output.
-					s_columnOut = &s_display[y0 * s_width + x];
+					state->columnOut = &s_display[y0 * s_width + x];
 					// Draw the column.
-					spriteColumnFunc();
-					if (s_yPixelCount > 1) { drawn = JTRUE; }
+					spriteColumnFunc(state);
+					if (state->yPixelCount > 1) { drawn = JTRUE; }
 				}
 			}
 		}
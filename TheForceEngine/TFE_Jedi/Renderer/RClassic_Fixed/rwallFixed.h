@@ -17,26 +17,28 @@ struct EdgePairFixed;
 
 namespace TFE_Jedi
 {
+	struct RClassicFixedState;
+
 	namespace RClassic_Fixed
 	{
-		void wall_process(RWall* wall);
-		s32  wall_mergeSort(RWallSegmentFixed* segOutList, s32 availSpace, s32 start, s32 count);
+		void wall_process(RClassicFixedState* state, RWall* wall);
+		s32  wall_mergeSort(RClassicFixedState* state, RWallSegmentFixed* segOutList, s32 availSpace, s32 start, s32 count);
 
-		void wall_drawSolid(RWallSegmentFixed* wallSegment);
-		void wall_drawTransparent(RWallSegmentFixed* wallSegment, EdgePairFixed* edge);
-		void wall_drawMask(RWallSegmentFixed* wallSegment);
-		void wall_drawBottom(RWallSegmentFixed* wallSegment);
-		void wall_drawTop(RWallSegmentFixed* wallSegment);
-		void wall_drawTopAndBottom(RWallSegmentFixed* wallSegment);
+		void wall_drawSolid(RClassicFixedState* state, RWallSegmentFixed* wallSegment);
+		void wall_drawTransparent(RClassicFixedState* state, RWallSegmentFixed* wallSegment, EdgePairFixed* edge);
+		void wall_drawMask(RClassicFixedState* state, RWallSegmentFixed* wallSegment);
+		void wall_drawBottom(RClassicFixedState* state, RWallSegmentFixed* wallSegment);
+		void wall_drawTop(RClassicFixedState* state, RWallSegmentFixed* wallSegment);
+		void wall_drawTopAndBottom(RClassicFixedState* state, RWallSegmentFixed* wallSegment);
 
-		void wall_drawSkyTop(RSector* sector);
-		void wall_drawSkyTopNoWall(RSector* sector);
-		void wall_drawSkyBottom(RSector* sector);
-		void wall_drawSkyBottomNoWall(RSector* sector);
+		void wall_drawSkyTop(RClassicFixedState* state, RSector* sector);
+		void wall_drawSkyTopNoWall(RClassicFixedState* state, RSector* sector);
+		void wall_drawSkyBottom(RClassicFixedState* state, RSector* sector);
+		void wall_drawSkyBottomNoWall(RClassicFixedState* state, RSector* sector);
 
-		void wall_addAdjoinSegment(s32 length, s32 x0, fixed16_16 top_dydx, fixed16_16 y1, fixed16_16 bot_dydx, fixed16_16 y0, RWallSegmentFixed* wallSegment);
+		void wall_addAdjoinSegment(RClassicFixedState* state, s32 length, s32 x0, fixed16_16 top_dydx, fixed16_16 y1, fixed16_16 bot_dydx, fixed16_16 y0, RWallSegmentFixed* wallSegment);
 
 		// Sprite code for now because so much is shared.
-		void sprite_drawFrame(u8* basePtr, WaxFrame* frame, SecObject* obj);
+		void sprite_drawFrame(RClassicFixedState* state, u8* basePtr, WaxFrame* frame, SecObject* obj);
 	}
 }
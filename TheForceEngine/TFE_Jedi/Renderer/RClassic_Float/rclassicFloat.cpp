@@ -6,12 +6,15 @@
 #include <TFE_Jedi/Math/core_math.h>
 #include <TFE_RenderBackend/renderBackend.h>
 #include <TFE_Game/igame.h>
+#include <TFE_System/memoryPool.h>
+#include "rclassicFloat.h"
 #include "rclassicFloatSharedState.h"
 #include "rlightingFloat.h"
 #include "rflatFloat.h"
 #include "../redgePair.h"
 #include "rsectorFloat.h"
 #include "../rcommon.h"
+#include "../rsectorRender.h"
 
 namespace TFE_Jedi
 {
@@ -25,6 +28,7 @@ namespace RClassic_Float
 	static f32 s_maxScreenX;
 	static f32 s_screenWidthFract;
 	static f32 s_oneOverWidthFract;
+	static s32 s_windowRows = 0;
 	static f32 s_worldX;
 	static f32 s_worldY;
 	static f32 s_worldZ;
@@ -197,11 +201,101 @@ namespace RClassic_Float
 
 	void resetState()
 	{
+		free(s_rcfltState.depth1d_all);
 		s_rcfltState.depth1d_all = nullptr;
+		s_rcfltState.depthRows = 0;
+		free(s_rcfltState.skyTable);
 		s_rcfltState.skyTable = nullptr;
+		s_windowRows = 0;
 
-		free(s_rcfltState.adjoinEdgeList);
-		s_rcfltState.adjoinEdgeList = nullptr;
+		resetLimits();
+	}
+
+	void resetLimits()
+	{
+		// Release the frame arena so a level that needed large buffers does not keep them, the next frame starts
+		// again at the vanilla limits.
+		delete s_rcfltState.frameArena;
+		s_rcfltState.frameArena = nullptr;
+		s_rcfltState.segLimit = 0;
+		s_rcfltState.adjoinSegLimit = 0;
+		s_rcfltState.adjoinDepthLimit = 0;
+		s_rcfltState.segLimitHit = JFALSE;
+		s_rcfltState.adjoinSegLimitHit = JFALSE;
+		s_rcfltState.adjoinDepthLimitHit = JFALSE;
+	}
+
+	JBool limitsNeedToGrow()
+	{
+		const RClassicFloatState* state = &s_rcfltState;
+		return (state->segLimitHit && state->segLimit < s_maxSegCount) ||
+			(state->adjoinSegLimitHit && state->adjoinSegLimit < s_maxAdjoinSegCount) ||
+			(state->adjoinDepthLimitHit && state->adjoinDepthLimit < s_maxAdjoinDepthRecursion);
+	}
+
+	// Start at the vanilla limit, grow the limit by 4x if the previous pass ran out of room and stay within the maximum.
+	// Growing by 4x means a single redraw is almost always enough, see drawWorld().
+	static s32 updateLimit(s32 limit, JBool* limitHit, s32 initLimit, s32 maxLimit)
+	{
+		if (limit <= 0) { limit = initLimit; }
+		else if (*limitHit) { limit *= 4; }
+		*limitHit = JFALSE;
+		return min(limit, maxLimit);
+	}
+
+	template <typename T>
+	static T* allocateFrameArray(s32 count)
+	{
+		// The arena does not align allocations, so keep each array on a 16 byte boundary.
+		return (T*)s_rcfltState.frameArena->allocate((sizeof(T) * count + 15) & ~size_t(15));
+	}
+
+	// Depth and window rows, one per adjoin depth plus the top level.
+	static void allocateDepthRows()
+	{
+		const s32 rows = s_rcfltState.adjoinDepthLimit + 1;
+		if (s_rcfltState.depthRows != rows)
+		{
+			s_rcfltState.depth1d_all = (f32*)realloc(s_rcfltState.depth1d_all, s_width * sizeof(f32) * rows);
+			s_rcfltState.depthRows = rows;
+		}
+		// The window rows are shared with the fixed-point sub-renderer, which sizes them for itself when made current.
+		if (s_windowRows != rows)
+		{
+			s_windowTop_all = (s32*)realloc(s_windowTop_all, s_width * sizeof(s32) * rows);
+			s_windowBot_all = (s32*)realloc(s_windowBot_all, s_width * sizeof(s32) * rows);
+			s_windowRows = rows;
+		}
+	}
+
+	void beginFrame()
+	{
+		RClassicFloatState* state = &s_rcfltState;
+		state->segLimit = updateLimit(state->segLimit, &state->segLimitHit, min(MAX_SEG, s_maxSegCount), s_maxSegCount);
+		state->adjoinSegLimit = updateLimit(state->adjoinSegLimit, &state->adjoinSegLimitHit, min(MAX_ADJOIN_SEG, s_maxAdjoinSegCount), s_maxAdjoinSegCount);
+		state->adjoinDepthLimit = updateLimit(state->adjoinDepthLimit, &state->adjoinDepthLimitHit, min(MAX_ADJOIN_DEPTH, s_maxAdjoinDepthRecursion), s_maxAdjoinDepthRecursion);
+		allocateDepthRows();
+
+		const size_t segSize = 3 * sizeof(RWallSegmentFloat) + sizeof(EdgePairFloat) + 2 * sizeof(s32);
+		const size_t adjoinSegSize = sizeof(EdgePairFloat) + sizeof(RWallSegmentFloat*);
+		// Include the alignment padding of each array.
+		const size_t arenaSize = segSize * state->segLimit + adjoinSegSize * state->adjoinSegLimit + sizeof(SectorSaveValues) * state->adjoinDepthLimit + 16 * 9;
+		if (!state->frameArena)
+		{
+			state->frameArena = new MemoryPool();
+		}
+		// Only reallocates when the pool needs to grow, then starts the frame with an empty pool.
+		state->frameArena->init(arenaSize, "Classic Float Frame");
+
+		state->flatEdgeList      = allocateFrameArray<EdgePairFloat>(state->segLimit);
+		state->wallSegListDst    = allocateFrameArray<RWallSegmentFloat>(state->segLimit);
+		state->wallSegListSrc    = allocateFrameArray<RWallSegmentFloat>(state->segLimit);
+		state->wallSegListMerge  = allocateFrameArray<RWallSegmentFloat>(state->segLimit);
+		state->wallSegMergeOrder = allocateFrameArray<s32>(state->segLimit);
+		state->wallSegMergeVisit = allocateFrameArray<s32>(state->segLimit);
+		state->adjoinEdgeList    = allocateFrameArray<EdgePairFloat>(state->adjoinSegLimit);
+		state->adjoinSegList     = allocateFrameArray<RWallSegmentFloat*>(state->adjoinSegLimit);
+		state->sectorStack       = allocateFrameArray<SectorSaveValues>(state->adjoinDepthLimit);
 	}
 
 	void buildProjectionTables(s32 xc, s32 yc, s32 w, s32 h)
@@ -213,27 +307,23 @@ namespace RClassic_Float
 		setupProjectionParameters(f32(halfWidth), xc, yc);
 		setWidthFraction(1.0f);
 
+		// The rows depend on the width, so size them again.
+		s_rcfltState.depthRows = 0;
+		s_windowRows = 0;
+		beginFrame();
+
 		EdgePairFloat* flatEdge = &s_rcfltState.flatEdgeList[s_flatCount];
 		s_rcfltState.flatEdge = flatEdge;
-		flat_addEdges(s_screenWidth, s_minScreenX_Pixels, 0, s_rcfltState.windowMaxY, 0, s_rcfltState.windowMinY);
+		flat_addEdges(&s_rcfltState, s_screenWidth, s_minScreenX_Pixels, 0, s_rcfltState.windowMaxY, 0, s_rcfltState.windowMinY);
 		
-		s_columnTop = (s32*)game_realloc(s_columnTop, s_width * sizeof(s32));
-		s_columnBot = (s32*)game_realloc(s_columnBot, s_width * sizeof(s32));
-		s_rcfltState.depth1d_all = (f32*)game_realloc(s_rcfltState.depth1d_all, s_width * sizeof(f32) * (MAX_ADJOIN_DEPTH_EXT + 1));
-		s_windowTop_all = (s32*)game_realloc(s_windowTop_all, s_width * sizeof(s32) * (MAX_ADJOIN_DEPTH_EXT + 1));
-		s_windowBot_all = (s32*)game_realloc(s_windowBot_all, s_width * sizeof(s32) * (MAX_ADJOIN_DEPTH_EXT + 1));
-
-		// This table is giant with higher limits, so for now allocate directly from the heap (13 MB)
-		if (!s_rcfltState.adjoinEdgeList)
-		{
-			s_rcfltState.adjoinEdgeList = (EdgePairFloat*)malloc(sizeof(EdgePairFloat) * MAX_ADJOIN_SEG_EXT * MAX_ADJOIN_DEPTH_EXT);
-		}
+		s_columnTop = (s32*)realloc(s_columnTop, s_width * sizeof(s32));
+		s_columnBot = (s32*)realloc(s_columnBot, s_width * sizeof(s32));
 
 		memset(s_windowTop_all, s_minScreenY, s_width);
 		memset(s_windowBot_all, s_maxScreenY, s_width);
 
 		// Build tables
-		s_rcfltState.skyTable = (f32*)game_realloc(s_rcfltState.skyTable, (s_width + 1) * sizeof(f32));
+		s_rcfltState.skyTable = (f32*)realloc(s_rcfltState.skyTable, (s_width + 1) * sizeof(f32));
 	}
 
 	void computeSkyTable()
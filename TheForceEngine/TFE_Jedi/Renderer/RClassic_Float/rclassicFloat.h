@@ -12,8 +12,14 @@ namespace TFE_Jedi
 	namespace RClassic_Float
 	{
 		void resetState();
+		// Return the frame buffers to the vanilla limits, called when a level is loaded.
+		void resetLimits();
 		void setupInitCameraAndLights(s32 width, s32 height);
 		void changeResolution(s32 width, s32 height);
+		// Size the frame buffers for this frame, growing any limit the previous pass ran out of.
+		void beginFrame();
+		// Returns true if the last pass ran out of room in a limit that can still grow, the frame can then be drawn again.
+		JBool limitsNeedToGrow();
 
 		void computeCameraTransform(RSector* sector, f32 pitch, f32 yaw, f32 camX, f32 camY, f32 camZ);
 		void transformPointByCamera(vec3_float* worldPoint, vec3_float* viewPoint);
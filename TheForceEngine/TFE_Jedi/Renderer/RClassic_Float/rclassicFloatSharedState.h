@@ -1,17 +1,28 @@
 #pragma once
 //////////////////////////////////////////////////////////////////////
-// Fixed-point shared state used by the Jedi Renderer.
-// The floating-point sub-renderer will have its own mirrored struct
-// of shared state.
+// Floating-point shared state used by the Jedi Renderer.
+// This mirrors the fixed-point shared state and also holds the column
+// and scanline setup used by the floating-point wall and flat code.
+//
+// The wall, flat and sprite code receives the state as a parameter
+// rather than reading s_rcfltState, the sector renderer passes the
+// state it was created with. The screen and window values in rcommon
+// and the 3D object code are still shared.
 //////////////////////////////////////////////////////////////////////
 #include <TFE_System/types.h>
+#include <TFE_Asset/spriteAsset_Jedi.h>
 #include <TFE_Jedi/Math/core_math.h>
 #include <TFE_Jedi/Renderer/redgePair.h>
 #include <TFE_Jedi/Renderer/rlimits.h>
 #include <TFE_Jedi/Renderer/rwallSegment.h>
+#include "fixedPoint20.h"
+
+class MemoryPool;
 
 namespace TFE_Jedi
 {
+	struct SectorSaveValues;
+
 	struct RClassicFloatState
 	{
 		// Resolution
@@ -52,15 +63,74 @@ namespace TFE_Jedi
 		f32 windowMinY;
 		f32 windowMaxY;
 
+		// Frame buffers, allocated from the frame arena at the start of each frame and sized by the limits below.
+		// A frame that runs out of room sets the matching 'hit' flag, then the limit grows by 4x and the frame is drawn
+		// again once, up to s_maxSegCount, s_maxAdjoinSegCount and s_maxAdjoinDepthRecursion. Grown limits are kept
+		// for the rest of the level and return to the vanilla limits when the next level is loaded.
+		MemoryPool* frameArena;
+		s32   segLimit;				// Wall segments and flat edges.
+		s32   adjoinSegLimit;
+		s32   adjoinDepthLimit;
+		s32   depthRows;			// Rows allocated in depth1d_all.
+		JBool segLimitHit;
+		JBool adjoinSegLimitHit;
+		JBool adjoinDepthLimitHit;
+
 		// Flats
 		EdgePairFloat* flatEdge;
-		EdgePairFloat  flatEdgeList[MAX_SEG_EXT];
+		EdgePairFloat* flatEdgeList;
 		EdgePairFloat* adjoinEdge;
 		EdgePairFloat* adjoinEdgeList;
 
-		RWallSegmentFloat   wallSegListDst[MAX_SEG_EXT];
-		RWallSegmentFloat   wallSegListSrc[MAX_SEG_EXT];
+		RWallSegmentFloat*  wallSegListDst;
+		RWallSegmentFloat*  wallSegListSrc;
 		RWallSegmentFloat** adjoinSegment;
+		RWallSegmentFloat** adjoinSegList;
+
+		// Wall merge/sort scratch space.
+		RWallSegmentFloat* wallSegListMerge;
+		s32* wallSegMergeOrder;
+		s32* wallSegMergeVisit;
+
+		// Sector values saved at each adjoin depth.
+		SectorSaveValues* sectorStack;
+
+		// Walls and sprites, the column currently being set up.
+		f32  segmentCross;
+		s32  texHeightMask;
+		s32  yPixelCount;
+		fixed44_20 vCoordStep;
+		fixed44_20 vCoordFixed;
+		const u8* columnLight;
+		u8*  texImage;
+		u8*  columnOut;
+		u8   workBuffer[WAX_DECOMPRESS_SIZE];
+
+		// Flats, the scanline currently being set up.
+		s32  scanlineX0;
+		fixed44_20 scanlineU0;
+		fixed44_20 scanlineV0;
+		fixed44_20 scanline_dUdX;
+		fixed44_20 scanline_dVdX;
+		s32  scanlineWidth;
+		const u8* scanlineLight;
+		u8*  scanlineOut;
+
+		u8*  ftexImage;
+		s32  ftexDataEnd;
+		s32  ftexHeight;
+		s32  ftexWidthMask;
+		s32  ftexHeightMask;
+		s32  ftexHeightLog2;
+
+		// 3D object polygons drawn as flats.
+		f32  poly_offsetX;
+		f32  poly_offsetZ;
+		f32  poly_scaledHOffset;
+		f32  poly_sinYawHOffset;
+		f32  poly_cosYawHOffset;
+		f32  poly_cosYawScaledHOffset;
+		f32  poly_sinYawScaledHOffset;
 	};
 	extern RClassicFloatState s_rcfltState;
 }  // TFE_Jedi
\ No newline at end of file
@@ -7,7 +7,9 @@
 #include "rclassicFloat.h"
 #include "rclassicFloatSharedState.h"
 #include "fixedPoint20.h"
+#include "rstripFloat.h"
 #include "../rscanline.h"
+#include "../rscanlineKernel.h"
 #include "../rsectorRender.h"
 #include "../redgePair.h"
 #include "../rcommon.h"
@@ -18,27 +20,13 @@ namespace TFE_Jedi
 
 namespace RClassic_Float
 {
-	static s32 s_scanlineX0;
-
-	static fixed44_20 s_scanlineU0;
-	static fixed44_20 s_scanlineV0;
-	static fixed44_20 s_scanline_dUdX;
-	static fixed44_20 s_scanline_dVdX;
-
-	static s32 s_scanlineWidth;
-	static const u8* s_scanlineLight;
-	static u8* s_scanlineOut;
-
-	static u8* s_ftexImage;
-	static s32 s_ftexDataEnd;
-	static s32 s_ftexHeight;
-	static s32 s_ftexWidthMask;
-	static s32 s_ftexHeightMask;
-	static s32 s_ftexHeightLog2;
-		
-	void flat_addEdges(s32 length, s32 x0, f32 dyFloor_dx, f32 yFloor, f32 dyCeil_dx, f32 yCeil)
+	void flat_addEdges(RClassicFloatState* state, s32 length, s32 x0, f32 dyFloor_dx, f32 yFloor, f32 dyCeil_dx, f32 yCeil)
 	{
-		if (s_flatCount < s_maxSegCount && length > 0)
+		if (length > 0 && s_flatCount >= state->segLimit)
+		{
+			state->segLimitHit = JTRUE;
+		}
+		else if (length > 0)
 		{
 			const f32 lengthFlt = f32(length - 1);
 
@@ -53,15 +41,15 @@ namespace RClassic_Float
 				yFloor1 += dyFloor_dx * lengthFlt;
 			}
 
-			edgePair_setup(length, x0, dyFloor_dx, yFloor1, yFloor, dyCeil_dx, yCeil, yCeil1, s_rcfltState.flatEdge);
+			edgePair_setup(length, x0, dyFloor_dx, yFloor1, yFloor, dyCeil_dx, yCeil, yCeil1, state->flatEdge);
 
-			if (s_rcfltState.flatEdge->yPixel_C1 - 1 > s_wallMaxCeilY)
+			if (state->flatEdge->yPixel_C1 - 1 > s_wallMaxCeilY)
 			{
-				s_wallMaxCeilY = s_rcfltState.flatEdge->yPixel_C1 - 1;
+				s_wallMaxCeilY = state->flatEdge->yPixel_C1 - 1;
 			}
-			if (s_rcfltState.flatEdge->yPixel_F1 + 1 < s_wallMinFloorY)
+			if (state->flatEdge->yPixel_F1 + 1 < s_wallMinFloorY)
 			{
-				s_wallMinFloorY = s_rcfltState.flatEdge->yPixel_F1 + 1;
+				s_wallMinFloorY = state->flatEdge->yPixel_F1 + 1;
 			}
 			if (s_wallMaxCeilY < s_windowMinY_Pixels)
 			{
@@ -72,108 +60,180 @@ namespace RClassic_Float
 				s_wallMinFloorY = s_windowMaxY_Pixels;
 			}
 
-			s_rcfltState.flatEdge++;
+			state->flatEdge++;
 			s_flatCount++;
 		}
 	}
 				
 	// This produces functionally identical results to the original but splits apart the U/V and dUdx/dVdx into seperate variables
 	// to account for C vs ASM differences.
-	void drawScanline()
+	// The scanline kernels only use the StripDraw so they can run on any render thread.
+	// Draw using the SIMD scanline kernel if there is one for this CPU, otherwise the scalar code below is used.
+	bool drawScanlineStrip_Simd(const StripDraw* draw, ScanlineKernelId id)
+	{
+		const ScanlineKernel kernel = scanline_getKernel(id);
+		if (!kernel) { return false; }
+
+		kernel(draw->out, draw->count, draw->tex, draw->colorMap, u32(draw->u), u32(draw->v), u32(draw->dU), u32(draw->dV), FRAC_BITS_20, draw->texMask);
+		return true;
+	}
+
+	void drawScanlineStrip(const StripDraw* draw)
 	{
-		const fixed44_20 dVdX = s_scanline_dVdX;
-		const fixed44_20 dUdX = s_scanline_dUdX;
-		fixed44_20 V = s_scanlineV0;
-		fixed44_20 U = s_scanlineU0;
+		if (drawScanlineStrip_Simd(draw, SCANKERNEL_LIT)) { return; }
+
+		const fixed44_20 dVdX = draw->dV;
+		const fixed44_20 dUdX = draw->dU;
+		fixed44_20 V = draw->v;
+		fixed44_20 U = draw->u;
+		const u8* texImage = draw->tex;
+		const u8* scanlineLight = draw->colorMap;
+		const s32 texDataEnd = draw->texMask;
+		u8* scanlineOut = draw->out;
 
 		// Note this produces a distorted mapping if the texture is not 64x64.
 		// This behavior matches the original.
-		for (s32 i = s_scanlineWidth - 1; i >= 0; i--, U += dUdX, V += dVdX)
+		for (s32 i = draw->count - 1; i >= 0; i--, U += dUdX, V += dVdX)
 		{
-			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & s_ftexDataEnd;
-			s_scanlineOut[i] = s_scanlineLight[s_ftexImage[texel]];
+			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & texDataEnd;
+			scanlineOut[i] = scanlineLight[texImage[texel]];
 		}
 	}
 
-	void drawScanline_Fullbright()
+	void drawScanlineStrip_Fullbright(const StripDraw* draw)
 	{
-		const fixed44_20 dVdX = s_scanline_dVdX;
-		const fixed44_20 dUdX = s_scanline_dUdX;
-		fixed44_20 V = s_scanlineV0;
-		fixed44_20 U = s_scanlineU0;
+		if (drawScanlineStrip_Simd(draw, SCANKERNEL_FULLBRIGHT)) { return; }
+
+		const fixed44_20 dVdX = draw->dV;
+		const fixed44_20 dUdX = draw->dU;
+		fixed44_20 V = draw->v;
+		fixed44_20 U = draw->u;
+		const u8* texImage = draw->tex;
+		const s32 texDataEnd = draw->texMask;
+		u8* scanlineOut = draw->out;
 
 		// Note this produces a distorted mapping if the texture is not 64x64.
 		// This behavior matches the original.
-		for (s32 i = s_scanlineWidth - 1; i >= 0; i--, U += dUdX, V += dVdX)
+		for (s32 i = draw->count - 1; i >= 0; i--, U += dUdX, V += dVdX)
 		{
-			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & s_ftexDataEnd;
-			s_scanlineOut[i] = s_ftexImage[texel];
+			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & texDataEnd;
+			scanlineOut[i] = texImage[texel];
 		}
 	}
 
-	void drawScanline_Trans()
+	void drawScanlineStrip_Trans(const StripDraw* draw)
 	{
-		const fixed44_20 dVdX = s_scanline_dVdX;
-		const fixed44_20 dUdX = s_scanline_dUdX;
-		fixed44_20 V = s_scanlineV0;
-		fixed44_20 U = s_scanlineU0;
+		if (drawScanlineStrip_Simd(draw, SCANKERNEL_LIT_TRANS)) { return; }
+
+		const fixed44_20 dVdX = draw->dV;
+		const fixed44_20 dUdX = draw->dU;
+		fixed44_20 V = draw->v;
+		fixed44_20 U = draw->u;
+		const u8* texImage = draw->tex;
+		const u8* scanlineLight = draw->colorMap;
+		const s32 texDataEnd = draw->texMask;
+		u8* scanlineOut = draw->out;
 
 		// Note this produces a distorted mapping if the texture is not 64x64.
 		// This behavior matches the original.
-		for (s32 i = s_scanlineWidth - 1; i >= 0; i--, U += dUdX, V += dVdX)
+		for (s32 i = draw->count - 1; i >= 0; i--, U += dUdX, V += dVdX)
 		{
-			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & s_ftexDataEnd;
-			const u8 baseColor = s_ftexImage[texel];
+			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & texDataEnd;
+			const u8 baseColor = texImage[texel];
 
-			if (baseColor) { s_scanlineOut[i] = s_scanlineLight[baseColor]; }
+			if (baseColor) { scanlineOut[i] = scanlineLight[baseColor]; }
 		}
 	}
 
-	void drawScanline_Fullbright_Trans()
+	void drawScanlineStrip_Fullbright_Trans(const StripDraw* draw)
 	{
-		const fixed44_20 dVdX = s_scanline_dVdX;
-		const fixed44_20 dUdX = s_scanline_dUdX;
-		fixed44_20 V = s_scanlineV0;
-		fixed44_20 U = s_scanlineU0;
+		if (drawScanlineStrip_Simd(draw, SCANKERNEL_FULLBRIGHT_TRANS)) { return; }
+
+		const fixed44_20 dVdX = draw->dV;
+		const fixed44_20 dUdX = draw->dU;
+		fixed44_20 V = draw->v;
+		fixed44_20 U = draw->u;
+		const u8* texImage = draw->tex;
+		const s32 texDataEnd = draw->texMask;
+		u8* scanlineOut = draw->out;
 
 		// Note this produces a distorted mapping if the texture is not 64x64.
 		// This behavior matches the original.
-		for (s32 i = s_scanlineWidth - 1; i >= 0; i--, U += dUdX, V += dVdX)
+		for (s32 i = draw->count - 1; i >= 0; i--, U += dUdX, V += dVdX)
 		{
-			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & s_ftexDataEnd;
-			const u8 baseColor = s_ftexImage[texel];
+			const u32 texel = ((floor20(U) & 63) * 64 + (floor20(V) & 63)) & texDataEnd;
+			const u8 baseColor = texImage[texel];
 
-			if (baseColor) { s_scanlineOut[i] = baseColor; }
+			if (baseColor) { scanlineOut[i] = baseColor; }
 		}
 	}
+
+	// Capture the current scanline state and draw it or record it for the render threads.
+	void drawScanline(RClassicFloatState* state, StripDrawFunc func)
+	{
+		StripDraw draw = {};
+		draw.func = func;
+		draw.type = STRIP_SCANLINE;
+		draw.out = state->scanlineOut;
+		draw.x = state->scanlineX0;
+		draw.count = state->scanlineWidth;
+		draw.tex = state->ftexImage;
+		draw.texMask = state->ftexDataEnd;
+		draw.colorMap = state->scanlineLight;
+		draw.u = state->scanlineU0;
+		draw.v = state->scanlineV0;
+		draw.dU = state->scanline_dUdX;
+		draw.dV = state->scanline_dVdX;
+		strip_draw(&draw);
+	}
+
+	void drawScanline(RClassicFloatState* state)
+	{
+		drawScanline(state, drawScanlineStrip);
+	}
+
+	void drawScanline_Fullbright(RClassicFloatState* state)
+	{
+		drawScanline(state, drawScanlineStrip_Fullbright);
+	}
+
+	void drawScanline_Trans(RClassicFloatState* state)
+	{
+		drawScanline(state, drawScanlineStrip_Trans);
+	}
+
+	void drawScanline_Fullbright_Trans(RClassicFloatState* state)
+	{
+		drawScanline(state, drawScanlineStrip_Fullbright_Trans);
+	}
 			   
-	bool flat_setTexture(TextureData* tex)
+	bool flat_setTexture(RClassicFloatState* state, TextureData* tex)
 	{
 		if (!tex) { return false; }
 
-		s_ftexHeight = tex->height;
-		s_ftexWidthMask = tex->width - 1;
-		s_ftexHeightMask = tex->height - 1;
-		s_ftexHeightLog2 = tex->logSizeY;
-		s_ftexImage = tex->image;
-		s_ftexDataEnd = tex->width * tex->height - 1;
+		state->ftexHeight = tex->height;
+		state->ftexWidthMask = tex->width - 1;
+		state->ftexHeightMask = tex->height - 1;
+		state->ftexHeightLog2 = tex->logSizeY;
+		state->ftexImage = tex->image;
+		state->ftexDataEnd = tex->width * tex->height - 1;
 
 		return true;
 	}
 	
-	void flat_drawCeiling(SectorCached* sectorCached, EdgePairFloat* edges, s32 count)
+	void flat_drawCeiling(RClassicFloatState* state, SectorCached* sectorCached, EdgePairFloat* edges, s32 count)
 	{
-		f32 textureOffsetU = s_rcfltState.cameraPos.x - sectorCached->ceilOffset.x;
-		f32 textureOffsetV = sectorCached->ceilOffset.z - s_rcfltState.cameraPos.z;
+		f32 textureOffsetU = state->cameraPos.x - sectorCached->ceilOffset.x;
+		f32 textureOffsetV = sectorCached->ceilOffset.z - state->cameraPos.z;
 
-		f32 relCeil          = sectorCached->ceilingHeight - s_rcfltState.eyeHeight;
-		f32 scaledRelCeil    =  relCeil * s_rcfltState.focalLenAspect;
-		f32 cosScaledRelCeil =  scaledRelCeil * s_rcfltState.cosYaw;
-		f32 negSinRelCeil    = -relCeil * s_rcfltState.sinYaw;
-		f32 sinScaledRelCeil =  scaledRelCeil * s_rcfltState.sinYaw;
-		f32 negCosRelCeil    = -relCeil * s_rcfltState.cosYaw;
+		f32 relCeil          = sectorCached->ceilingHeight - state->eyeHeight;
+		f32 scaledRelCeil    =  relCeil * state->focalLenAspect;
+		f32 cosScaledRelCeil =  scaledRelCeil * state->cosYaw;
+		f32 negSinRelCeil    = -relCeil * state->sinYaw;
+		f32 sinScaledRelCeil =  scaledRelCeil * state->sinYaw;
+		f32 negCosRelCeil    = -relCeil * state->cosYaw;
 
-		if (!flat_setTexture(*sectorCached->sector->ceilTex)) { return; }
+		if (!flat_setTexture(state, *sectorCached->sector->ceilTex)) { return; }
 
 		for (s32 y = s_windowMinY_Pixels; y <= s_wallMaxCeilY && y < s_windowMaxY_Pixels; y++)
 		{
@@ -187,58 +247,58 @@ namespace RClassic_Float
 			s32 right = 0;
 			for (s32 i = 0; i < count;)
 			{
-				if (!flat_buildScanlineCeiling(i, count, x, y, left, right, s_scanlineWidth, (EdgePairFixed*)edges))
+				if (!flat_buildScanlineCeiling(i, count, x, y, left, right, state->scanlineWidth, (EdgePairFixed*)edges))
 				{
 					break;
 				}
 
-				if (s_scanlineWidth > 0)
+				if (state->scanlineWidth > 0)
 				{
-					assert(left >= 0 && left + s_scanlineWidth <= s_width);
+					assert(left >= 0 && left + state->scanlineWidth <= s_width);
 					assert(y >= 0 && y < s_height);
-					s_scanlineX0  = left;
-					s_scanlineOut = &s_display[left + yOffset];
+					state->scanlineX0  = left;
+					state->scanlineOut = &s_display[left + yOffset];
 
 					const f32 worldToTexelScale = 8.0f;
-					f32 rightClip = f32(right - s_screenXMid) * s_rcfltState.aspectScaleX;
+					f32 rightClip = f32(right - s_screenXMid) * state->aspectScaleX;
 					f32 v0 = (cosScaledRelCeil - (negSinRelCeil*rightClip)) * yRcp;
 					f32 u0 = (sinScaledRelCeil + (negCosRelCeil*rightClip)) * yRcp;
 
-					s_scanlineV0 = floatToFixed20((v0 - textureOffsetV) * worldToTexelScale);
-					s_scanlineU0 = floatToFixed20((u0 - textureOffsetU) * worldToTexelScale);
+					state->scanlineV0 = floatToFixed20((v0 - textureOffsetV) * worldToTexelScale);
+					state->scanlineU0 = floatToFixed20((u0 - textureOffsetU) * worldToTexelScale);
 
-					const f32 worldTexelScaleAspect = yRcp * worldToTexelScale * s_rcfltState.aspectScaleY;
-					s_scanline_dVdX =  floatToFixed20(negSinRelCeil * worldTexelScaleAspect);
-					s_scanline_dUdX = -floatToFixed20(negCosRelCeil * worldTexelScaleAspect);
-					s_scanlineLight =  computeLighting(z, 0);
+					const f32 worldTexelScaleAspect = yRcp * worldToTexelScale * state->aspectScaleY;
+					state->scanline_dVdX =  floatToFixed20(negSinRelCeil * worldTexelScaleAspect);
+					state->scanline_dUdX = -floatToFixed20(negCosRelCeil * worldTexelScaleAspect);
+					state->scanlineLight =  computeLighting(z, 0);
 					
-					if (s_scanlineLight)
+					if (state->scanlineLight)
 					{
-						drawScanline();
+						drawScanline(state);
 					}
 					else
 					{
-						drawScanline_Fullbright();
+						drawScanline_Fullbright(state);
 					}
 				}
 			} // while (i < count)
 		}
 	}
 		
-	void flat_drawFloor(SectorCached* sectorCached, EdgePairFloat* edges, s32 count)
+	void flat_drawFloor(RClassicFloatState* state, SectorCached* sectorCached, EdgePairFloat* edges, s32 count)
 	{
-		f32 textureOffsetU = s_rcfltState.cameraPos.x - sectorCached->floorOffset.x;
-		f32 textureOffsetV = sectorCached->floorOffset.z - s_rcfltState.cameraPos.z;
+		f32 textureOffsetU = state->cameraPos.x - sectorCached->floorOffset.x;
+		f32 textureOffsetV = sectorCached->floorOffset.z - state->cameraPos.z;
 
-		f32 relFloor       = sectorCached->floorHeight - s_rcfltState.eyeHeight;
-		f32 scaledRelFloor = relFloor * s_rcfltState.focalLenAspect;
+		f32 relFloor       = sectorCached->floorHeight - state->eyeHeight;
+		f32 scaledRelFloor = relFloor * state->focalLenAspect;
 
-		f32 cosScaledRelFloor = scaledRelFloor * s_rcfltState.cosYaw;
-		f32 negSinRelFloor    =-relFloor * s_rcfltState.sinYaw;
-		f32 sinScaledRelFloor = scaledRelFloor * s_rcfltState.sinYaw;
-		f32 negCosRelFloor    =-relFloor * s_rcfltState.cosYaw;
+		f32 cosScaledRelFloor = scaledRelFloor * state->cosYaw;
+		f32 negSinRelFloor    =-relFloor * state->sinYaw;
+		f32 sinScaledRelFloor = scaledRelFloor * state->sinYaw;
+		f32 negCosRelFloor    =-relFloor * state->cosYaw;
 
-		if (!flat_setTexture(*sectorCached->sector->floorTex)) { return; }
+		if (!flat_setTexture(state, *sectorCached->sector->floorTex)) { return; }
 
 		for (s32 y = max(s_wallMinFloorY, s_windowMinY_Pixels); y <= s_windowMaxY_Pixels; y++)
 		{
@@ -255,37 +315,37 @@ namespace RClassic_Float
 				s32 winMaxX = s_windowMaxX_Pixels;
 
 				// Search for the left edge of the scanline.
-				if (!flat_buildScanlineFloor(i, count, x, y, left, right, s_scanlineWidth, (EdgePairFixed*)edges))
+				if (!flat_buildScanlineFloor(i, count, x, y, left, right, state->scanlineWidth, (EdgePairFixed*)edges))
 				{
 					break;
 				}
 
-				if (s_scanlineWidth > 0)
+				if (state->scanlineWidth > 0)
 				{
-					assert(left >= 0 && left + s_scanlineWidth <= s_width);
+					assert(left >= 0 && left + state->scanlineWidth <= s_width);
 					assert(y >= 0 && y < s_height);
-					s_scanlineX0 = left;
-					s_scanlineOut = &s_display[left + yOffset];
+					state->scanlineX0 = left;
+					state->scanlineOut = &s_display[left + yOffset];
 
 					const f32 worldToTexelScale = 8.0f;
-					f32 rightClip = f32(right - s_screenXMid) * s_rcfltState.aspectScaleX;
+					f32 rightClip = f32(right - s_screenXMid) * state->aspectScaleX;
 					f32 v0 = (cosScaledRelFloor - (negSinRelFloor * rightClip)) * yRcp;
 					f32 u0 = (sinScaledRelFloor + (negCosRelFloor * rightClip)) * yRcp;
-					s_scanlineV0 = floatToFixed20((v0 - textureOffsetV) * worldToTexelScale);
-					s_scanlineU0 = floatToFixed20((u0 - textureOffsetU) * worldToTexelScale);
+					state->scanlineV0 = floatToFixed20((v0 - textureOffsetV) * worldToTexelScale);
+					state->scanlineU0 = floatToFixed20((u0 - textureOffsetU) * worldToTexelScale);
 
-					const f32 worldTexelScaleAspect = yRcp * worldToTexelScale * s_rcfltState.aspectScaleY;
-					s_scanline_dVdX =  floatToFixed20(negSinRelFloor * worldTexelScaleAspect);
-					s_scanline_dUdX = -floatToFixed20(negCosRelFloor * worldTexelScaleAspect);
-					s_scanlineLight = computeLighting(z, 0);
+					const f32 worldTexelScaleAspect = yRcp * worldToTexelScale * state->aspectScaleY;
+					state->scanline_dVdX =  floatToFixed20(negSinRelFloor * worldTexelScaleAspect);
+					state->scanline_dUdX = -floatToFixed20(negCosRelFloor * worldTexelScaleAspect);
+					state->scanlineLight = computeLighting(z, 0);
 
-					if (s_scanlineLight)
+					if (state->scanlineLight)
 					{
-						drawScanline();
+						drawScanline(state);
 					}
 					else
 					{
-						drawScanline_Fullbright();
+						drawScanline_Fullbright(state);
 					}
 				}
 			} // while (i < count)
@@ -295,7 +355,7 @@ namespace RClassic_Float
 	//////////////////////////////////////////////////////////////////////
 	// Polygon Scanline rendering using the same algorithms as flats.
 	//////////////////////////////////////////////////////////////////////
-	typedef void(*ScanlineFunction)();
+	typedef void(*ScanlineFunction)(RClassicFloatState* state);
 	static const ScanlineFunction c_scanlineDrawFunc[] =
 	{
 		drawScanline,
@@ -304,64 +364,54 @@ namespace RClassic_Float
 		drawScanline_Fullbright_Trans
 	};
 
-	static f32 s_poly_offsetX;
-	static f32 s_poly_offsetZ;
-
-	static f32 s_poly_scaledHOffset;
-	static f32 s_poly_sinYawHOffset;
-	static f32 s_poly_cosYawHOffset;
-
-	static f32 s_poly_cosYawScaledHOffset;
-	static f32 s_poly_sinYawScaledHOffset;
-		
-	void flat_preparePolygon(f32 heightOffset, f32 offsetX, f32 offsetZ, TextureData* texture)
+	void flat_preparePolygon(RClassicFloatState* state, f32 heightOffset, f32 offsetX, f32 offsetZ, TextureData* texture)
 	{
-		s_poly_offsetX = s_rcfltState.cameraPos.x - offsetX;
-		s_poly_offsetZ = offsetZ - s_rcfltState.cameraPos.z;
+		state->poly_offsetX = state->cameraPos.x - offsetX;
+		state->poly_offsetZ = offsetZ - state->cameraPos.z;
 
-		s_poly_scaledHOffset = heightOffset * s_rcfltState.focalLenAspect;
-		s_poly_sinYawHOffset = s_rcfltState.sinYaw * heightOffset;
-		s_poly_cosYawHOffset = s_rcfltState.cosYaw * heightOffset;
+		state->poly_scaledHOffset = heightOffset * state->focalLenAspect;
+		state->poly_sinYawHOffset = state->sinYaw * heightOffset;
+		state->poly_cosYawHOffset = state->cosYaw * heightOffset;
 
-		s_poly_cosYawScaledHOffset = s_rcfltState.cosYaw * s_poly_scaledHOffset;
-		s_poly_sinYawScaledHOffset = s_rcfltState.sinYaw * s_poly_scaledHOffset;
+		state->poly_cosYawScaledHOffset = state->cosYaw * state->poly_scaledHOffset;
+		state->poly_sinYawScaledHOffset = state->sinYaw * state->poly_scaledHOffset;
 
-		s_ftexWidthMask  = texture->width - 1;
-		s_ftexHeightMask = texture->height - 1;
-		s_ftexHeightLog2 = texture->logSizeY;
-		s_ftexImage      = texture->image;
-		s_ftexDataEnd    = texture->width * texture->height - 1;
+		state->ftexWidthMask  = texture->width - 1;
+		state->ftexHeightMask = texture->height - 1;
+		state->ftexHeightLog2 = texture->logSizeY;
+		state->ftexImage      = texture->image;
+		state->ftexDataEnd    = texture->width * texture->height - 1;
 	}
 
-	void flat_drawPolygonScanline(s32 x0, s32 x1, s32 y, bool trans)
+	void flat_drawPolygonScanline(RClassicFloatState* state, s32 x0, s32 x1, s32 y, bool trans)
 	{
 		x0 = max(x0, s_windowMinX_Pixels);
 		x1 = min(x1, s_windowMaxX_Pixels);
 		clipScanline(&x0, &x1, y);
 
-		s_scanlineWidth = x1 - x0 + 1;
-		if (s_scanlineWidth <= 0) { return; }
+		state->scanlineWidth = x1 - x0 + 1;
+		if (state->scanlineWidth <= 0) { return; }
 
-		s_scanlineX0  = x0;
-		s_scanlineOut = &s_display[y * s_width + x0];
+		state->scanlineX0  = x0;
+		state->scanlineOut = &s_display[y * s_width + x0];
 
 		const f32 yShear = f32(y - s_screenYMidFlt);
 		const f32 yRcp = (yShear != 0.0f) ? 1.0f/yShear : 1.0f;
-		const f32 z = s_poly_scaledHOffset * yRcp;
-		const f32 right = f32(x1 - 1 - s_screenXMid) * s_rcfltState.aspectScaleX;
+		const f32 z = state->poly_scaledHOffset * yRcp;
+		const f32 right = f32(x1 - 1 - s_screenXMid) * state->aspectScaleX;
 
-		const f32 u0 = s_poly_sinYawScaledHOffset - (s_poly_cosYawHOffset*right);
-		const f32 v0 = s_poly_cosYawScaledHOffset + (s_poly_sinYawHOffset*right);
-		s_scanlineU0 = floatToFixed20((u0*yRcp - s_poly_offsetX) * 8.0f);
-		s_scanlineV0 = floatToFixed20((v0*yRcp - s_poly_offsetZ) * 8.0f);
+		const f32 u0 = state->poly_sinYawScaledHOffset - (state->poly_cosYawHOffset*right);
+		const f32 v0 = state->poly_cosYawScaledHOffset + (state->poly_sinYawHOffset*right);
+		state->scanlineU0 = floatToFixed20((u0*yRcp - state->poly_offsetX) * 8.0f);
+		state->scanlineV0 = floatToFixed20((v0*yRcp - state->poly_offsetZ) * 8.0f);
 
-		const f32 worldTexelScaleAspect = yRcp * 8.0f * s_rcfltState.aspectScaleY;
-		s_scanline_dVdX = -floatToFixed20(s_poly_sinYawHOffset*worldTexelScaleAspect);
-		s_scanline_dUdX =  floatToFixed20(s_poly_cosYawHOffset*worldTexelScaleAspect);
+		const f32 worldTexelScaleAspect = yRcp * 8.0f * state->aspectScaleY;
+		state->scanline_dVdX = -floatToFixed20(state->poly_sinYawHOffset*worldTexelScaleAspect);
+		state->scanline_dUdX =  floatToFixed20(state->poly_cosYawHOffset*worldTexelScaleAspect);
 
-		s_scanlineLight = computeLighting(z, 0);
-		const s32 index = (!s_scanlineLight) + trans*2;
-		c_scanlineDrawFunc[index]();
+		state->scanlineLight = computeLighting(z, 0);
+		const s32 index = (!state->scanlineLight) + trans*2;
+		c_scanlineDrawFunc[index](state);
 	}
 
 }  // RFlatFixed
@@ -4,6 +4,7 @@
 #include "rclassicFloat.h"
 #include "../rcommon.h"
 #include "../rlimits.h"
+#include "../rlightTable.h"
 
 namespace TFE_Jedi
 {
@@ -38,6 +39,18 @@ namespace RClassic_Float
 		}
 	}
 
+	static const u8* light_applyOffset(s32 light, s32 lightOffset)
+	{
+		if (lightOffset != 0)
+		{
+			light += lightOffset;
+		}
+		if (light >= MAX_LIGHT_LEVEL) { return nullptr; }
+		light = max(light, 0);
+
+		return &s_colorMap[light << 8];
+	}
+
 	const u8* computeLighting(f32 depth, s32 lightOffset)
 	{
 		if (s_sectorAmbient >= MAX_LIGHT_LEVEL)	{ return nullptr; }
@@ -45,6 +58,12 @@ namespace RClassic_Float
 		depth = max(depth, 0.0f);
 		s32 light = 0;
 
+		// Most columns and scanlines use the light level tabulated for the sector ambient this frame.
+		if (lightTable_getLevel((depth < f32(LIGHT_TABLE_SIZE / 4)) ? u32(depth * 4.0f) : LIGHT_TABLE_SIZE, &light))
+		{
+			return light_applyOffset(light, lightOffset);
+		}
+
 		// handle camera lightsource
 		if (s_worldAmbient < MAX_LIGHT_LEVEL || s_cameraLightSource)
 		{
@@ -61,15 +80,7 @@ namespace RClassic_Float
 
 		s32 depthAtten = s32(depth / 16.0f) + s32(depth / 32.0f);		// depth * 3/32
 		light = max(light - depthAtten, s_scaledAmbient);
-
-		if (lightOffset != 0)
-		{
-			light += lightOffset;
-		}
-		if (light >= MAX_LIGHT_LEVEL) { return nullptr; }
-		light = max(light, 0);
-
-		return &s_colorMap[light << 8];
+		return light_applyOffset(light, lightOffset);
 	}
 }  // RLightingFixed
 
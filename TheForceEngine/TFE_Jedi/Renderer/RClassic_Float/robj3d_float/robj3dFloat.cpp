@@ -12,6 +12,7 @@
 #include "robj3dFloat_Clipping.h"
 #include "robj3dFloat_PolygonDraw.h"
 #include "../rclassicFloatSharedState.h"
+#include "../rstripFloat.h"
 #include "../../rcommon.h"
 
 namespace TFE_Jedi
@@ -79,6 +80,11 @@ namespace RClassic_Float
 		}
 	}
 		
+	void robj3d_drawPixelStrip(const StripDraw* draw)
+	{
+		*draw->out = draw->color;
+	}
+
 	void robj3d_drawVertices(s32 vertexCount, const vec3_float* vertices, u8 color, s32 size)
 	{
 		// cannot draw if the color is transparent.
@@ -111,7 +117,14 @@ namespace RClassic_Float
 			{
 				const s32 x = clamp(pixel_x - halfSize + (i % size), s_minScreenX_Pixels, s_maxScreenX_Pixels);
 				const s32 y = clamp(pixel_y - halfSize + (i / size), s_windowMinY_Pixels, s_windowMaxY_Pixels);
-				s_display[y*s_width + x] = color;
+				StripDraw draw = {};
+				draw.func = robj3d_drawPixelStrip;
+				draw.type = STRIP_COLUMN;
+				draw.out = &s_display[y*s_width + x];
+				draw.x = x;
+				draw.count = 1;
+				draw.color = color;
+				strip_draw(&draw);
 			}
 		}
 	}
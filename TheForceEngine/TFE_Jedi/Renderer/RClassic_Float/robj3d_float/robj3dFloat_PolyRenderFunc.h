@@ -166,99 +166,182 @@ s32 robj3d_findPrevEdge(s32 minXIndex)
 	return -1;
 }
 
+// The column kernels only use the StripDraw so they can run on any render thread.
 #if !defined(POLY_INTENSITY) && !defined(POLY_UV)
-void robj3d_drawColumnFlatColor()
+void robj3d_drawColumnStripFlatColor(const StripDraw* draw)
 {
-	s32 end = s_columnHeight - 1;
+	const u8 colorIndex = draw->color;
+	u8* columnOut = draw->out;
+
+	s32 end = draw->count - 1;
 	s32 offset = end * s_width;
 	for (s32 i = end; i >= 0; i--, offset -= s_width)
 	{
-		s_pcolumnOut[offset] = s_polyColorIndex;
+		columnOut[offset] = colorIndex;
 	}
 }
+
+void robj3d_drawColumnFlatColor()
+{
+	StripDraw draw = {};
+	draw.func = robj3d_drawColumnStripFlatColor;
+	draw.type = STRIP_COLUMN;
+	draw.out = s_pcolumnOut;
+	draw.x = s_columnX;
+	draw.count = s_columnHeight;
+	draw.color = s_polyColorIndex;
+	strip_draw(&draw);
+}
 #endif
 
 #if defined(POLY_INTENSITY) && !defined(POLY_UV)
-void robj3d_drawColumnShadedColor()
+void robj3d_drawColumnStripShadedColor(const StripDraw* draw)
 {
-	const u8* colorMap = s_polyColorMap;
+	const u8* colorMap = draw->colorMap;
+	const fixed44_20 dIdY = draw->dI;
+	const fixed44_20 ditherOffset = draw->v;
+	u8* columnOut = draw->out;
 
-	fixed44_20 intensity = s_col_I0;
-	u8  colorIndex = s_polyColorIndex;
-	s32 dither = s_dither;
+	fixed44_20 intensity = draw->i;
+	u8  colorIndex = draw->color;
+	s32 dither = draw->dither;
 
-	s32 end = s_columnHeight - 1;
+	s32 end = draw->count - 1;
 	s32 offset = end * s_width;
 	for (s32 i = end; i >= 0; i--, offset -= s_width)
 	{
 		s32 pixelIntensity = floor20(intensity);
 		if (dither)
 		{
-			const fixed44_20 iOffset = intensity - s_ditherOffset;
+			const fixed44_20 iOffset = intensity - ditherOffset;
 			if (iOffset >= 0)
 			{
 				pixelIntensity = floor20(iOffset);
 			}
 		}
-		s_pcolumnOut[offset] = colorMap[(pixelIntensity&31)*256 + colorIndex];
+		columnOut[offset] = colorMap[(pixelIntensity&31)*256 + colorIndex];
 
-		intensity += s_col_dIdY;
+		intensity += dIdY;
 		dither = !dither;
 	}
 }
+
+void robj3d_drawColumnShadedColor()
+{
+	StripDraw draw = {};
+	draw.func = robj3d_drawColumnStripShadedColor;
+	draw.type = STRIP_COLUMN;
+	draw.out = s_pcolumnOut;
+	draw.x = s_columnX;
+	draw.count = s_columnHeight;
+	draw.colorMap = s_polyColorMap;
+	draw.color = s_polyColorIndex;
+	draw.i = s_col_I0;
+	draw.dI = s_col_dIdY;
+	draw.v = s_ditherOffset;
+	draw.dither = s_dither;
+	strip_draw(&draw);
+}
 #endif
 
 #if !defined(POLY_INTENSITY) && defined(POLY_UV)
-void robj3d_drawColumnFlatTexture()
+void robj3d_drawColumnStripFlatTexture(const StripDraw* draw)
 {
-	const u8* colorMap = &s_polyColorMap[s_polyColorIndex * 256];
-	const u8* textureData = s_polyTexture->image;
-	const s32 texHeight = s_polyTexture->height;
-	const s32 texWidthMask = s_polyTexture->width - 1;
+	const u8* colorMap = draw->colorMap;
+	const u8* textureData = draw->tex;
+	const s32 texHeight = draw->texHeight;
+	const s32 texWidthMask = draw->texMask;
 	const s32 texHeightMask = texHeight - 1;
+	const fixed44_20 dUdY = draw->dU;
+	const fixed44_20 dVdY = draw->dV;
+	u8* columnOut = draw->out;
 
-	fixed44_20 U = s_col_Uv0.x;
-	fixed44_20 V = s_col_Uv0.z;
+	fixed44_20 U = draw->u;
+	fixed44_20 V = draw->v;
 	
-	s32 end = s_columnHeight - 1;
+	s32 end = draw->count - 1;
 	s32 offset = end * s_width;
 	for (s32 i = end; i >= 0; i--, offset -= s_width)
 	{
 		const u8 colorIndex = textureData[(floor20(U)&texWidthMask)*texHeight + (floor20(V)&texHeightMask)];
-		s_pcolumnOut[offset] = colorMap[colorIndex];
+		columnOut[offset] = colorMap[colorIndex];
 
-		U += s_col_dUVdY.x;
-		V += s_col_dUVdY.z;
+		U += dUdY;
+		V += dVdY;
 	}
 }
+
+void robj3d_drawColumnFlatTexture()
+{
+	StripDraw draw = {};
+	draw.func = robj3d_drawColumnStripFlatTexture;
+	draw.type = STRIP_COLUMN;
+	draw.out = s_pcolumnOut;
+	draw.x = s_columnX;
+	draw.count = s_columnHeight;
+	draw.colorMap = &s_polyColorMap[s_polyColorIndex * 256];
+	draw.tex = s_polyTexture->image;
+	draw.texHeight = s_polyTexture->height;
+	draw.texMask = s_polyTexture->width - 1;
+	draw.u = s_col_Uv0.x;
+	draw.v = s_col_Uv0.z;
+	draw.dU = s_col_dUVdY.x;
+	draw.dV = s_col_dUVdY.z;
+	strip_draw(&draw);
+}
 #endif
 
 #if defined(POLY_INTENSITY) && defined(POLY_UV)
-void robj3d_drawColumnShadedTexture()
+void robj3d_drawColumnStripShadedTexture(const StripDraw* draw)
 {
-	const u8* colorMap = s_polyColorMap;
-	const u8* textureData = s_polyTexture->image;
-	const s32 texHeight = s_polyTexture->height;
-	const s32 texWidthMask = s_polyTexture->width - 1;
+	const u8* colorMap = draw->colorMap;
+	const u8* textureData = draw->tex;
+	const s32 texHeight = draw->texHeight;
+	const s32 texWidthMask = draw->texMask;
 	const s32 texHeightMask = texHeight - 1;
+	const fixed44_20 dIdY = draw->dI;
+	const fixed44_20 dUdY = draw->dU;
+	const fixed44_20 dVdY = draw->dV;
+	u8* columnOut = draw->out;
 
-	fixed44_20 U = s_col_Uv0.x;
-	fixed44_20 V = s_col_Uv0.z;
-	fixed44_20 I = s_col_I0;
+	fixed44_20 U = draw->u;
+	fixed44_20 V = draw->v;
+	fixed44_20 I = draw->i;
 
-	s32 end = s_columnHeight - 1;
+	s32 end = draw->count - 1;
 	s32 offset = end * s_width;
 	for (s32 i = end; i >= 0; i--, offset -= s_width)
 	{
 		const u8 colorIndex = textureData[(floor20(U)&texWidthMask)*texHeight + (floor20(V)&texHeightMask)];
 		const s32 pixelIntensity = floor20(I)&31;
-		s_pcolumnOut[offset] = colorMap[pixelIntensity*256 + colorIndex];
+		columnOut[offset] = colorMap[pixelIntensity*256 + colorIndex];
 
-		I += s_col_dIdY;
-		U += s_col_dUVdY.x;
-		V += s_col_dUVdY.z;
+		I += dIdY;
+		U += dUdY;
+		V += dVdY;
 	}
 }
+
+void robj3d_drawColumnShadedTexture()
+{
+	StripDraw draw = {};
+	draw.func = robj3d_drawColumnStripShadedTexture;
+	draw.type = STRIP_COLUMN;
+	draw.out = s_pcolumnOut;
+	draw.x = s_columnX;
+	draw.count = s_columnHeight;
+	draw.colorMap = s_polyColorMap;
+	draw.tex = s_polyTexture->image;
+	draw.texHeight = s_polyTexture->height;
+	draw.texMask = s_polyTexture->width - 1;
+	draw.i = s_col_I0;
+	draw.dI = s_col_dIdY;
+	draw.u = s_col_Uv0.x;
+	draw.v = s_col_Uv0.z;
+	draw.dU = s_col_dUVdY.x;
+	draw.dV = s_col_dUVdY.z;
+	strip_draw(&draw);
+}
 #endif
 
 #undef FIND_NEXT_EDGE
@@ -14,6 +14,7 @@
 #include "../rflatFloat.h"
 #include "../rclassicFloatSharedState.h"
 #include "../rlightingFloat.h"
+#include "../rstripFloat.h"
 #include "../../rcommon.h"
 
 namespace TFE_Jedi
@@ -362,11 +363,11 @@ namespace RClassic_Float
 		// TODO: Figure out why s_heightInPixels has the wrong sign here.
 		if (yMax <= s_screenYMidFlt)
 		{
-			flat_preparePolygon(heightOffset, ceilOffsetX, ceilOffsetZ, texture);
+			flat_preparePolygon(&s_rcfltState, heightOffset, ceilOffsetX, ceilOffsetZ, texture);
 		}
 		else
 		{
-			flat_preparePolygon(heightOffset, floorOffsetX, floorOffsetZ, texture);
+			flat_preparePolygon(&s_rcfltState, heightOffset, floorOffsetX, floorOffsetZ, texture);
 		}
 
 		s32 edgeFound = 0;
@@ -374,7 +375,7 @@ namespace RClassic_Float
 		{
 			if (s_rowY >= s_windowMinY_Pixels && s_windowMaxY_Pixels != 0 && s_edgeLeft_X0_Pixel <= s_windowMaxX_Pixels && s_edgeRight_X0_Pixel >= s_windowMinX_Pixels)
 			{
-				flat_drawPolygonScanline(s_edgeLeft_X0_Pixel, s_edgeRight_X0_Pixel, s_rowY, trans);
+				flat_drawPolygonScanline(&s_rcfltState, s_edgeLeft_X0_Pixel, s_edgeRight_X0_Pixel, s_rowY, trans);
 			}
 
 			s_edgeLeftLength--;
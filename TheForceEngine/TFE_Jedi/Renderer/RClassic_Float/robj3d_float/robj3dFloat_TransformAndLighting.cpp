@@ -5,6 +5,17 @@
 #include "../rclassicFloatSharedState.h"
 #include "../rlightingFloat.h"
 #include "../../rcommon.h"
+#include <SDL_cpuinfo.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ROBJ3D_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define ROBJ3D_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace TFE_Jedi
 {
@@ -15,6 +26,7 @@ namespace RClassic_Float
 	// Settings
 	/////////////////////////////////////////////
 	s32 s_enableFlatShading = 1;	// Set to 0 to disable flat shading.
+	bool s_simdVertices = true;		// Transform and light 4 vertices at a time when supported by the CPU.
 
 	/////////////////////////////////////////////
 	// Vertex Processing
@@ -24,6 +36,9 @@ namespace RClassic_Float
 	std::vector<vec3_float> s_vertexNormalsVS;
 	// Vertex Lighting.
 	std::vector<f32> s_vertexIntensity;
+	// Viewspace vertices and normals as x, y, z arrays, used by the vectorized lighting.
+	static std::vector<f32> s_vertexArraysVS;
+	static std::vector<f32> s_normalArraysVS;
 
 	/////////////////////////////////////////////
 	// Polygon Processing
@@ -43,6 +58,90 @@ namespace RClassic_Float
 		}
 	}
 
+#if defined(ROBJ3D_SSE2) || defined(ROBJ3D_NEON)
+	// Returns true if the vectorized path can be used with the given model arrays.
+	bool robj3d_useSimd(const JmVertexArrays* arrays)
+	{
+	#ifdef ROBJ3D_SSE2
+		static const bool s_available = SDL_HasSSE2() != SDL_FALSE;
+	#else
+		static const bool s_available = SDL_HasNEON() != SDL_FALSE;
+	#endif
+		return s_simdVertices && s_available && arrays->x;
+	}
+#else
+	bool robj3d_useSimd(const JmVertexArrays* arrays)
+	{
+		return false;
+	}
+#endif
+
+	// Transforms 4 vertices at a time using the same operations as robj3d_transformVertices().
+	// 'vtxOut' must have room for 'vertexCount' rounded up to a multiple of 4. If 'arraysOut' is not null,
+	// the results are also written as x, y, z arrays of that size.
+	void robj3d_transformVerticesSimd(s32 vertexCount, const JmVertexArrays* vtxIn, const f32* xform, const vec3_float* offset, vec3_float* vtxOut, f32* arraysOut)
+	{
+		const s32 paddedCount = (vertexCount + 3) & ~3;
+		f32* outX = arraysOut;
+		f32* outY = arraysOut + paddedCount;
+		f32* outZ = arraysOut + paddedCount * 2;
+	#if defined(ROBJ3D_SSE2)
+		const __m128 m0 = _mm_set1_ps(xform[0]), m1 = _mm_set1_ps(xform[1]), m2 = _mm_set1_ps(xform[2]);
+		const __m128 m3 = _mm_set1_ps(xform[3]), m4 = _mm_set1_ps(xform[4]), m5 = _mm_set1_ps(xform[5]);
+		const __m128 m6 = _mm_set1_ps(xform[6]), m7 = _mm_set1_ps(xform[7]), m8 = _mm_set1_ps(xform[8]);
+		const __m128 offsetX = _mm_set1_ps(offset->x), offsetY = _mm_set1_ps(offset->y), offsetZ = _mm_set1_ps(offset->z);
+		for (s32 v = 0; v < paddedCount; v += 4)
+		{
+			const __m128 x = _mm_loadu_ps(&vtxIn->x[v]);
+			const __m128 y = _mm_loadu_ps(&vtxIn->y[v]);
+			const __m128 z = _mm_loadu_ps(&vtxIn->z[v]);
+
+			const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m3)), _mm_mul_ps(z, m6)), offsetX);
+			const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m1), _mm_mul_ps(y, m4)), _mm_mul_ps(z, m7)), offsetY);
+			const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m2), _mm_mul_ps(y, m5)), _mm_mul_ps(z, m8)), offsetZ);
+			if (arraysOut)
+			{
+				_mm_storeu_ps(&outX[v], rx);
+				_mm_storeu_ps(&outY[v], ry);
+				_mm_storeu_ps(&outZ[v], rz);
+			}
+
+			// Interleave into { x0 y0 z0 x1 } { y1 z1 x2 y2 } { z2 x3 y3 z3 }.
+			const __m128 xy01 = _mm_unpacklo_ps(rx, ry);
+			const __m128 zx01 = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0));
+			const __m128 yz11 = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1));
+			const __m128 xy22 = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2));
+			const __m128 zx23 = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2));
+			const __m128 yz33 = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3));
+			f32* out = &vtxOut[v].x;
+			_mm_storeu_ps(out,     _mm_shuffle_ps(xy01, zx01, _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(out + 4, _mm_shuffle_ps(yz11, xy22, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(out + 8, _mm_shuffle_ps(zx23, yz33, _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+	#elif defined(ROBJ3D_NEON)
+		const float32x4_t offsetX = vdupq_n_f32(offset->x), offsetY = vdupq_n_f32(offset->y), offsetZ = vdupq_n_f32(offset->z);
+		for (s32 v = 0; v < paddedCount; v += 4)
+		{
+			const float32x4_t x = vld1q_f32(&vtxIn->x[v]);
+			const float32x4_t y = vld1q_f32(&vtxIn->y[v]);
+			const float32x4_t z = vld1q_f32(&vtxIn->z[v]);
+
+			// Separate multiplies and adds rather than fused, to match the scalar math.
+			float32x4x3_t r;
+			r.val[0] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, xform[0]), vmulq_n_f32(y, xform[3])), vmulq_n_f32(z, xform[6])), offsetX);
+			r.val[1] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, xform[1]), vmulq_n_f32(y, xform[4])), vmulq_n_f32(z, xform[7])), offsetY);
+			r.val[2] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, xform[2]), vmulq_n_f32(y, xform[5])), vmulq_n_f32(z, xform[8])), offsetZ);
+			if (arraysOut)
+			{
+				vst1q_f32(&outX[v], r.val[0]);
+				vst1q_f32(&outY[v], r.val[1]);
+				vst1q_f32(&outZ[v], r.val[2]);
+			}
+			vst3q_f32(&vtxOut[v].x, r);
+		}
+	#endif
+	}
+
 	void robj3d_mulMatrix3x3(f32* mtx0, fixed16_16* mtx1, f32* mtxOut)
 	{
 		const f32 mtx1Flt[9]=
@@ -82,6 +181,30 @@ namespace RClassic_Float
 		return ndx + ndy + ndz;
 	}
 		
+	// Adds the sector ambient, camera light source and depth falloff to the directional lighting of a vertex.
+	f32 robj3d_shadeVertexDepth(f32 lightIntensity, f32 vertexZ)
+	{
+		f32 intensity = 0.0f;
+		intensity += lightIntensity * fixed16ToFloat(s_sectorAmbientFraction);
+
+		// Distance falloff
+		const f32 z = max(0.0f, vertexZ);
+		if (s_worldAmbient < 31 || s_cameraLightSource)
+		{
+			s32 depthScaled = min(s32(z * 4.0f), 127);
+			s32 lightSource = MAX_LIGHT_LEVEL - (s_lightSourceRamp[depthScaled] + s_worldAmbient);
+			if (lightSource > 0)
+			{
+				intensity += f32(lightSource);
+			}
+		}
+		intensity = max(intensity, f32(s_sectorAmbient));
+
+		const s32 falloff = s32(z / 16.0f) + s32(z / 32.0f);		// depth * 3/32
+		intensity = max(intensity - f32(falloff), f32(s_scaledAmbient));
+		return clamp(intensity, 0.0f, VSHADE_MAX_INTENSITY_FLT);
+	}
+
 	void robj3d_shadeVertices(s32 vertexCount, f32* outShading, const vec3_float* vertices, const vec3_float* normals)
 	{
 		const vec3_float* normal = normals;
@@ -116,40 +239,99 @@ namespace RClassic_Float
 						lightIntensity += (I * sourceIntensity);
 					}
 				}
-				intensity += lightIntensity * fixed16ToFloat(s_sectorAmbientFraction);
+				intensity = robj3d_shadeVertexDepth(lightIntensity, vertex->z);
+			}
+			*outShading = intensity;
+		}
+	}
 
-				// Distance falloff
-				const f32 z = max(0.0f, vertex->z);
-				if (s_worldAmbient < 31 || s_cameraLightSource)
-				{
-					s32 depthScaled = min(s32(z * 4.0f), 127);
-					s32 lightSource = MAX_LIGHT_LEVEL - (s_lightSourceRamp[depthScaled] + s_worldAmbient);
-					if (lightSource > 0)
-					{
-						intensity += f32(lightSource);
-					}
-				}
-				intensity = max(intensity, f32(s_sectorAmbient));
+	// Lights 4 vertices at a time using the same operations as robj3d_shadeVertices(), from the x, y, z arrays
+	// written by robj3d_transformVerticesSimd().
+	void robj3d_shadeVerticesSimd(s32 vertexCount, f32* outShading, const f32* vertexArrays, const f32* normalArrays)
+	{
+		if (s_sectorAmbient >= 31 || s_fullBright) // s_fullBright is for TFE cheat LABRIGHT.
+		{
+			for (s32 i = 0; i < vertexCount; i++)
+			{
+				outShading[i] = VSHADE_MAX_INTENSITY_FLT;
+			}
+			return;
+		}
+
+		const s32 paddedCount = (vertexCount + 3) & ~3;
+		alignas(16) f32 lightIntensity[4];
+		for (s32 v = 0; v < vertexCount; v += 4)
+		{
+		#if defined(ROBJ3D_SSE2)
+			const __m128 vx = _mm_loadu_ps(&vertexArrays[v]);
+			const __m128 vy = _mm_loadu_ps(&vertexArrays[v + paddedCount]);
+			const __m128 vz = _mm_loadu_ps(&vertexArrays[v + paddedCount * 2]);
+			const __m128 nx = _mm_sub_ps(_mm_loadu_ps(&normalArrays[v]), vx);
+			const __m128 ny = _mm_sub_ps(_mm_loadu_ps(&normalArrays[v + paddedCount]), vy);
+			const __m128 nz = _mm_sub_ps(_mm_loadu_ps(&normalArrays[v + paddedCount * 2]), vz);
+
+			__m128 intensity = _mm_setzero_ps();
+			for (s32 i = 0; i < s_lightCount; i++)
+			{
+				const CameraLightFlt* light = &s_cameraLight[i];
+				const __m128 dx = _mm_sub_ps(_mm_add_ps(vx, _mm_set1_ps(light->lightVS.x)), vx);
+				const __m128 dy = _mm_sub_ps(_mm_add_ps(vy, _mm_set1_ps(light->lightVS.y)), vy);
+				const __m128 dz = _mm_sub_ps(_mm_add_ps(vz, _mm_set1_ps(light->lightVS.z)), vz);
+				const __m128 I = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, dx), _mm_mul_ps(ny, dy)), _mm_mul_ps(nz, dz));
 
-				const s32 falloff = s32(z / 16.0f) + s32(z / 32.0f);		// depth * 3/32
-				intensity = max(intensity - f32(falloff), f32(s_scaledAmbient));
-				intensity = clamp(intensity, 0.0f, VSHADE_MAX_INTENSITY_FLT);
+				const __m128 sourceIntensity = _mm_set1_ps(VSHADE_MAX_INTENSITY_FLT * light->brightness);
+				const __m128 lit = _mm_cmpgt_ps(I, _mm_setzero_ps());
+				intensity = _mm_add_ps(intensity, _mm_and_ps(lit, _mm_mul_ps(I, sourceIntensity)));
+			}
+			_mm_store_ps(lightIntensity, intensity);
+		#elif defined(ROBJ3D_NEON)
+			const float32x4_t vx = vld1q_f32(&vertexArrays[v]);
+			const float32x4_t vy = vld1q_f32(&vertexArrays[v + paddedCount]);
+			const float32x4_t vz = vld1q_f32(&vertexArrays[v + paddedCount * 2]);
+			const float32x4_t nx = vsubq_f32(vld1q_f32(&normalArrays[v]), vx);
+			const float32x4_t ny = vsubq_f32(vld1q_f32(&normalArrays[v + paddedCount]), vy);
+			const float32x4_t nz = vsubq_f32(vld1q_f32(&normalArrays[v + paddedCount * 2]), vz);
+
+			float32x4_t intensity = vdupq_n_f32(0.0f);
+			for (s32 i = 0; i < s_lightCount; i++)
+			{
+				const CameraLightFlt* light = &s_cameraLight[i];
+				const float32x4_t dx = vsubq_f32(vaddq_f32(vx, vdupq_n_f32(light->lightVS.x)), vx);
+				const float32x4_t dy = vsubq_f32(vaddq_f32(vy, vdupq_n_f32(light->lightVS.y)), vy);
+				const float32x4_t dz = vsubq_f32(vaddq_f32(vz, vdupq_n_f32(light->lightVS.z)), vz);
+				const float32x4_t I = vaddq_f32(vaddq_f32(vmulq_f32(nx, dx), vmulq_f32(ny, dy)), vmulq_f32(nz, dz));
+
+				const uint32x4_t lit = vcgtq_f32(I, vdupq_n_f32(0.0f));
+				const float32x4_t lightI = vmulq_n_f32(I, VSHADE_MAX_INTENSITY_FLT * light->brightness);
+				intensity = vaddq_f32(intensity, vreinterpretq_f32_u32(vandq_u32(lit, vreinterpretq_u32_f32(lightI))));
+			}
+			vst1q_f32(lightIntensity, intensity);
+		#endif
+
+			const s32 laneCount = min(4, vertexCount - v);
+			for (s32 l = 0; l < laneCount; l++)
+			{
+				outShading[v + l] = robj3d_shadeVertexDepth(lightIntensity[l], vertexArrays[v + l + paddedCount * 2]);
 			}
-			*outShading = intensity;
 		}
 	}
 
 	void robj3d_allocateBuffers(JediModel* model)
 	{
-		if (model->vertexCount > s_verticesVS.size())
+		// Padded to a multiple of 4 for the vectorized transform.
+		const size_t vertexCount  = size_t(model->vertexCount + 3) & ~size_t(3);
+		const size_t polygonCount = size_t(model->polygonCount + 3) & ~size_t(3);
+		if (vertexCount > s_verticesVS.size())
 		{
-			s_verticesVS.resize(model->vertexCount);
-			s_vertexNormalsVS.resize(model->vertexCount);
-			s_vertexIntensity.resize(model->vertexCount);
+			s_verticesVS.resize(vertexCount);
+			s_vertexNormalsVS.resize(vertexCount);
+			s_vertexIntensity.resize(vertexCount);
+			s_vertexArraysVS.resize(vertexCount * 3);
+			s_normalArraysVS.resize(vertexCount * 3);
 		}
-		if (model->polygonCount > s_polygonNormalsVS.size())
+		if (polygonCount > s_polygonNormalsVS.size())
 		{
-			s_polygonNormalsVS.resize(model->polygonCount);
+			s_polygonNormalsVS.resize(polygonCount);
 		}
 	}
 		
@@ -171,17 +353,40 @@ namespace RClassic_Float
 		f32 xform[9];
 		robj3d_mulMatrix3x3(s_rcfltState.cameraMtx, obj->transform, xform);
 
+		// The vectorized lighting reads the viewspace vertices and normals as x, y, z arrays.
+		const bool vertexLit = (model->flags & MFLAG_VERTEX_LIT) && !(model->flags & MFLAG_DRAW_VERTICES);
+		const bool simdLighting = vertexLit && robj3d_useSimd(&model->verticesFlt) && robj3d_useSimd(&model->vertexNormalsFlt);
+
 		// Transform model vertices into view space.
-		robj3d_transformVertices(model->vertexCount, (vec3_fixed*)model->vertices, xform, &offsetVS, s_verticesVS.data());
+		if (robj3d_useSimd(&model->verticesFlt))
+		{
+			robj3d_transformVerticesSimd(model->vertexCount, &model->verticesFlt, xform, &offsetVS, s_verticesVS.data(), simdLighting ? s_vertexArraysVS.data() : nullptr);
+		}
+		else
+		{
+			robj3d_transformVertices(model->vertexCount, (vec3_fixed*)model->vertices, xform, &offsetVS, s_verticesVS.data());
+		}
 
 		// No need for polygon normals or lighting if MFLAG_DRAW_VERTICES is set.
 		if (model->flags & MFLAG_DRAW_VERTICES) { return; }
 
 		// Polygon normals (used for backface culling)
-		robj3d_transformVertices(model->polygonCount, (vec3_fixed*)model->polygonNormals, xform, &offsetVS, s_polygonNormalsVS.data());
+		if (robj3d_useSimd(&model->polygonNormalsFlt))
+		{
+			robj3d_transformVerticesSimd(model->polygonCount, &model->polygonNormalsFlt, xform, &offsetVS, s_polygonNormalsVS.data(), nullptr);
+		}
+		else
+		{
+			robj3d_transformVertices(model->polygonCount, (vec3_fixed*)model->polygonNormals, xform, &offsetVS, s_polygonNormalsVS.data());
+		}
 
 		// Lighting
-		if (model->flags & MFLAG_VERTEX_LIT)
+		if (simdLighting)
+		{
+			robj3d_transformVerticesSimd(model->vertexCount, &model->vertexNormalsFlt, xform, &offsetVS, s_vertexNormalsVS.data(), s_normalArraysVS.data());
+			robj3d_shadeVerticesSimd(model->vertexCount, s_vertexIntensity.data(), s_vertexArraysVS.data(), s_normalArraysVS.data());
+		}
+		else if (vertexLit)
 		{
 			robj3d_transformVertices(model->vertexCount, (vec3_fixed*)model->vertexNormals, xform, &offsetVS, s_vertexNormalsVS.data());
 			robj3d_shadeVertices(model->vertexCount, s_vertexIntensity.data(), s_verticesVS.data(), s_vertexNormalsVS.data());
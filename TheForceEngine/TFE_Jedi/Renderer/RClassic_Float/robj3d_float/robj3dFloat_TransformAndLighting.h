@@ -16,6 +16,7 @@ namespace TFE_Jedi
 	namespace RClassic_Float
 	{
 		extern s32 s_enableFlatShading;
+		extern bool s_simdVertices;
 		// Vertex attributes transformed to viewspace.
 		extern std::vector<vec3_float> s_verticesVS;
 		extern std::vector<vec3_float> s_vertexNormalsVS;
@@ -10,6 +10,7 @@
 #include <TFE_Jedi/Level/rtexture.h>
 #include <TFE_Jedi/Math/fixedPoint.h>
 #include <TFE_Jedi/Math/core_math.h>
+#include <TFE_Jedi/Serialization/serialization.h>
 
 #include "rclassicFloat.h"
 #include "rsectorFloat.h"
@@ -17,6 +18,7 @@
 #include "rlightingFloat.h"
 #include "redgePairFloat.h"
 #include "rclassicFloatSharedState.h"
+#include "rstripFloat.h"
 #include "robj3d_float/robj3dFloat.h"
 #include "../rcommon.h"
 
@@ -78,7 +80,7 @@ namespace TFE_Jedi
 			return signZero(cached1->objPosVS[obj1->index].z - cached0->objPosVS[obj0->index].z);
 		}
 
-		s32 cullObjects(RSector* sector, SecObject** buffer)
+		s32 cullObjects(RClassicFloatState* state, RSector* sector, SecObject** buffer)
 		{
 			s32 drawCount = 0;
 			SecObject** obj = sector->objectList;
@@ -131,10 +133,10 @@ namespace TFE_Jedi
 
 						// Cull against the current "window."
 						const f32 rcpZ = 1.0f / cached->objPosVS[curObj->index].z;
-						const s32 x0 = roundFloat((xMin*s_rcfltState.focalLength)*rcpZ) + s_screenXMid;
+						const s32 x0 = roundFloat((xMin*state->focalLength)*rcpZ) + s_screenXMid;
 						if (x0 > s_windowMaxX_Pixels) { continue; }
 
-						const s32 x1 = roundFloat((xMax*s_rcfltState.focalLength)*rcpZ) + s_screenXMid;
+						const s32 x1 = roundFloat((xMax*state->focalLength)*rcpZ) + s_screenXMid;
 						if (x1 < s_windowMinX_Pixels) { continue; }
 
 						// Finally add the object to render.
@@ -146,7 +148,7 @@ namespace TFE_Jedi
 			return drawCount;
 		}
 
-		void sprite_drawWax(s32 angle, SecObject* obj, vec3_float* cachedPosVS)
+		void sprite_drawWax(RClassicFloatState* state, s32 angle, SecObject* obj, vec3_float* cachedPosVS)
 		{
 			// Angles range from [0, 16384), divide by 512 to get 32 even buckets.
 			s32 angleDiff = (angle - obj->yaw) >> 9;
@@ -162,13 +164,14 @@ namespace TFE_Jedi
 				// And finall the frame from the current sequence.
 				WaxFrame* frame = WAX_FramePtr(wax, view, obj->frame & 0x1f);
 				// Draw the frame.
-				sprite_drawFrame((u8*)wax, frame, obj, cachedPosVS);
+				sprite_drawFrame(state, (u8*)wax, frame, obj, cachedPosVS);
 			}
 		}
 	}
 
 	void TFE_Sectors_Float::destroy()
 	{
+		strip_destroy();
 	}
 
 	void TFE_Sectors_Float::reset()
@@ -181,22 +184,28 @@ namespace TFE_Jedi
 	{
 		allocateCachedData();
 
-		EdgePairFloat* flatEdge = &s_rcfltState.flatEdgeList[s_flatCount];
-		s_rcfltState.flatEdge = flatEdge;
-		flat_addEdges(s_screenWidth, s_minScreenX_Pixels, 0, s_rcfltState.windowMaxY, 0, s_rcfltState.windowMinY);
+		EdgePairFloat* flatEdge = &m_state->flatEdgeList[s_flatCount];
+		m_state->flatEdge = flatEdge;
+		flat_addEdges(m_state, s_screenWidth, s_minScreenX_Pixels, 0, m_state->windowMaxY, 0, m_state->windowMinY);
 
 		light_transformDirLights();
+		strip_beginFrame(s_minScreenX_Pixels, s_maxScreenX_Pixels);
 	}
 
-	void transformPointByCameraFixedToFloat(vec3_fixed* worldPoint, vec3_float* viewPoint)
+	void TFE_Sectors_Float::finish()
+	{
+		strip_endFrame();
+	}
+
+	void transformPointByCameraFixedToFloat(RClassicFloatState* state, vec3_fixed* worldPoint, vec3_float* viewPoint)
 	{
 		const f32 x = fixed16ToFloat(worldPoint->x);
 		const f32 y = fixed16ToFloat(worldPoint->y);
 		const f32 z = fixed16ToFloat(worldPoint->z);
 
-		viewPoint->x = x*s_rcfltState.cosYaw + z*s_rcfltState.sinYaw + s_rcfltState.cameraTrans.x;
-		viewPoint->y = y - s_rcfltState.eyeHeight;
-		viewPoint->z = z*s_rcfltState.cosYaw + x*s_rcfltState.negSinYaw + s_rcfltState.cameraTrans.z;
+		viewPoint->x = x*state->cosYaw + z*state->sinYaw + state->cameraTrans.x;
+		viewPoint->y = y - state->eyeHeight;
+		viewPoint->z = z*state->cosYaw + x*state->negSinYaw + state->cameraTrans.z;
 	}
 	
 	void TFE_Sectors_Float::draw(RSector* sector)
@@ -215,7 +224,7 @@ namespace TFE_Jedi
 		s32* winTopNext = &s_windowTop_all[s_adjoinDepth * s_width];
 		s32* winBotNext = &s_windowBot_all[s_adjoinDepth * s_width];
 
-		s_rcfltState.depth1d = &s_rcfltState.depth1d_all[(s_adjoinDepth - 1) * s_width];
+		m_state->depth1d = &m_state->depth1d_all[(s_adjoinDepth - 1) * s_width];
 
 		s32 startWall = s_curSector->startWall;
 		s32 drawWallCount = s_curSector->drawWallCnt;
@@ -236,8 +245,8 @@ namespace TFE_Jedi
 		f32* depthPrev = nullptr;
 		if (s_adjoinDepth > 1)
 		{
-			depthPrev = &s_rcfltState.depth1d_all[(s_adjoinDepth - 2) * s_width];
-			memcpy(&s_rcfltState.depth1d[s_minScreenX_Pixels], &depthPrev[s_minScreenX_Pixels], s_width * 4);
+			depthPrev = &m_state->depth1d_all[(s_adjoinDepth - 2) * s_width];
+			memcpy(&m_state->depth1d[s_minScreenX_Pixels], &depthPrev[s_minScreenX_Pixels], s_width * 4);
 		}
 
 		s_wallMaxCeilY  = s_windowMinY_Pixels;
@@ -258,8 +267,8 @@ namespace TFE_Jedi
 					const f32 x = fixed16ToFloat(vtxWS->x);
 					const f32 z = fixed16ToFloat(vtxWS->z);
 
-					vtxVS->x = x*s_rcfltState.cosYaw     + z*s_rcfltState.sinYaw + s_rcfltState.cameraTrans.x;
-					vtxVS->z = x*s_rcfltState.negSinYaw  + z*s_rcfltState.cosYaw + s_rcfltState.cameraTrans.z;
+					vtxVS->x = x*m_state->cosYaw     + z*m_state->sinYaw + m_state->cameraTrans.x;
+					vtxVS->z = x*m_state->negSinYaw  + z*m_state->cosYaw + m_state->cameraTrans.z;
 					vtxVS++;
 					vtxWS++;
 				}
@@ -279,7 +288,7 @@ namespace TFE_Jedi
 
 					if (curObj->flags & OBJ_FLAG_NEEDS_TRANSFORM)
 					{
-						transformPointByCameraFixedToFloat(&curObj->posWS, &objPosVS[curObj->index]);
+						transformPointByCameraFixedToFloat(m_state, &curObj->posWS, &objPosVS[curObj->index]);
 					}
 				}
 			TFE_ZONE_END(objXform);
@@ -289,7 +298,7 @@ namespace TFE_Jedi
 				WallCached* wall = cachedSector->cachedWalls;
 				for (s32 i = 0; i < s_curSector->wallCount; i++, wall++)
 				{
-					wall_process(wall);
+					wall_process(m_state, wall);
 				}
 				drawWallCount = s_nextWall - startWall;
 
@@ -299,8 +308,8 @@ namespace TFE_Jedi
 			TFE_ZONE_END(wallProcess);
 		}
 
-		RWallSegmentFloat* wallSegment = &s_rcfltState.wallSegListDst[s_curWallSeg];
-		s32 drawSegCnt = wall_mergeSort(wallSegment, s_maxSegCount - s_curWallSeg, startWall, drawWallCount);
+		RWallSegmentFloat* wallSegment = &m_state->wallSegListDst[s_curWallSeg];
+		s32 drawSegCnt = wall_mergeSort(m_state, wallSegment, m_state->segLimit - s_curWallSeg, startWall, drawWallCount);
 		s_curWallSeg += drawSegCnt;
 
 		TFE_ZONE_BEGIN(wallQSort, "Wall QSort");
@@ -308,15 +317,15 @@ namespace TFE_Jedi
 		TFE_ZONE_END(wallQSort);
 
 		s32 flatCount = s_flatCount;
-		EdgePairFloat* flatEdge = &s_rcfltState.flatEdgeList[s_flatCount];
-		s_rcfltState.flatEdge = flatEdge;
+		EdgePairFloat* flatEdge = &m_state->flatEdgeList[s_flatCount];
+		m_state->flatEdge = flatEdge;
 
 		s32 adjoinStart = s_adjoinSegCount;
-		EdgePairFloat* adjoinEdges = &s_rcfltState.adjoinEdgeList[adjoinStart];
-		RWallSegmentFloat* adjoinList[MAX_ADJOIN_DEPTH_EXT];
+		EdgePairFloat* adjoinEdges = &m_state->adjoinEdgeList[adjoinStart];
+		RWallSegmentFloat** adjoinList = &m_state->adjoinSegList[adjoinStart];
 
-		s_rcfltState.adjoinEdge = adjoinEdges;
-		s_rcfltState.adjoinSegment = adjoinList;
+		m_state->adjoinEdge = adjoinEdges;
+		m_state->adjoinSegment = adjoinList;
 
 		// Draw each wall segment in the sector.
 		TFE_ZONE_BEGIN(secDrawWalls, "Draw Walls");
@@ -327,7 +336,7 @@ namespace TFE_Jedi
 
 			if (!nextSector)
 			{
-				wall_drawSolid(wallSegment);
+				wall_drawSolid(m_state, wallSegment);
 			}
 			else
 			{
@@ -337,52 +346,52 @@ namespace TFE_Jedi
 				{
 					if (df == WDF_MIDDLE || (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ))
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawBottom(wallSegment);
+						wall_drawBottom(m_state, wallSegment);
 					}
 				}
 				else if (df == WDF_TOP)
 				{
 					if (nextSector->flags1 & SEC_FLAGS1_EXT_ADJ)
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawTop(wallSegment);
+						wall_drawTop(m_state, wallSegment);
 					}
 				}
 				else if (df == WDF_TOP_AND_BOT)
 				{
 					if ((nextSector->flags1 & SEC_FLAGS1_EXT_ADJ) && (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ))
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else if (nextSector->flags1 & SEC_FLAGS1_EXT_ADJ)
 					{
-						wall_drawBottom(wallSegment);
+						wall_drawBottom(m_state, wallSegment);
 					}
 					else if (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ)
 					{
-						wall_drawTop(wallSegment);
+						wall_drawTop(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawTopAndBottom(wallSegment);
+						wall_drawTopAndBottom(m_state, wallSegment);
 					}
 				}
 				else // WDF_BOT
 				{
 					if (nextSector->flags1 & SEC_FLAGS1_EXT_FLOOR_ADJ)
 					{
-						wall_drawMask(wallSegment);
+						wall_drawMask(m_state, wallSegment);
 					}
 					else
 					{
-						wall_drawBottom(wallSegment);
+						wall_drawBottom(m_state, wallSegment);
 					}
 				}
 			}
@@ -399,37 +408,41 @@ namespace TFE_Jedi
 			{
 				if (s_curSector->flags1 & SEC_FLAGS1_NOWALL_DRAW)
 				{
-					wall_drawSkyTopNoWall(s_curSector);
+					wall_drawSkyTopNoWall(m_state, s_curSector);
 				}
 				else
 				{
-					wall_drawSkyTop(s_curSector);
+					wall_drawSkyTop(m_state, s_curSector);
 				}
 			}
 			else
 			{
-				flat_drawCeiling(cachedSector, flatEdge, newFlatCount);
+				flat_drawCeiling(m_state, cachedSector, flatEdge, newFlatCount);
 			}
 			if (s_curSector->flags1 & SEC_FLAGS1_PIT)
 			{
 				if (s_curSector->flags1 & SEC_FLAGS1_NOWALL_DRAW)
 				{
-					wall_drawSkyBottomNoWall(s_curSector);
+					wall_drawSkyBottomNoWall(m_state, s_curSector);
 				}
 				else
 				{
-					wall_drawSkyBottom(s_curSector);
+					wall_drawSkyBottom(m_state, s_curSector);
 				}
 			}
 			else
 			{
-				flat_drawFloor(cachedSector, flatEdge, newFlatCount);
+				flat_drawFloor(m_state, cachedSector, flatEdge, newFlatCount);
 			}
 		TFE_ZONE_END(secDrawFlats);
 
 		// Adjoins
 		s32 adjoinCount = s_adjoinSegCount - adjoinStart;
-		if (adjoinCount && s_adjoinDepth < s_maxAdjoinDepthRecursion)
+		if (adjoinCount && s_adjoinDepth >= m_state->adjoinDepthLimit)
+		{
+			m_state->adjoinDepthLimitHit = JTRUE;
+		}
+		else if (adjoinCount)
 		{
 			adjoin_setupAdjoinWindow(winBot, winBotNext, winTop, winTopNext, adjoinEdges, adjoinCount);
 			RWallSegmentFloat** seg = adjoinList;
@@ -445,7 +458,7 @@ namespace TFE_Jedi
 				RWall* srcWall = curAdjoinSeg->srcWall->wall;
 				RWallSegmentFloat* nextAdjoin = (i < adjoinEnd) ? *(seg + 1) : nullptr;
 				RSector* nextSector = srcWall->nextSector;
-				if (s_adjoinDepth < s_maxAdjoinDepthRecursion && s_adjoinDepth < s_maxDepthCount)
+				if (s_adjoinDepth < m_state->adjoinDepthLimit && s_adjoinDepth < s_maxDepthCount)
 				{
 					s32 index = s_adjoinDepth - 1;
 					saveValues(index);
@@ -475,7 +488,7 @@ namespace TFE_Jedi
 						}
 					}
 
-					s_rcfltState.windowMinZ = min(curAdjoinSeg->z0, curAdjoinSeg->z1);
+					m_state->windowMinZ = min(curAdjoinSeg->z0, curAdjoinSeg->z1);
 					draw(nextSector);
 					
 					if (s_adjoinDepth)
@@ -488,7 +501,7 @@ namespace TFE_Jedi
 					if (srcWall->flags1 & WF1_ADJ_MID_TEX)
 					{
 						TFE_ZONE("Draw Transparent Walls");
-						wall_drawTransparent(curAdjoinSeg, adjoinEdges);
+						wall_drawTransparent(m_state, curAdjoinSeg, adjoinEdges);
 					}
 				}
 			}
@@ -496,12 +509,12 @@ namespace TFE_Jedi
 
 		if (!(s_curSector->flags1 & SEC_FLAGS1_SUBSECTOR) && depthPrev && s_drawFrame != s_prevSector->prevDrawFrame2)
 		{
-			memcpy(&depthPrev[s_windowMinX_Pixels], &s_rcfltState.depth1d[s_windowMinX_Pixels], (s_windowMaxX_Pixels - s_windowMinX_Pixels + 1) * sizeof(f32));
+			memcpy(&depthPrev[s_windowMinX_Pixels], &m_state->depth1d[s_windowMinX_Pixels], (s_windowMaxX_Pixels - s_windowMinX_Pixels + 1) * sizeof(f32));
 		}
 
 		// Objects
 		TFE_ZONE_BEGIN(secDrawObjects, "Draw Objects");
-		const s32 objCount = cullObjects(s_curSector, s_objBuffer);
+		const s32 objCount = cullObjects(m_state, s_curSector, s_objBuffer);
 		if (objCount > 0)
 		{
 			// Which top and bottom edges are we going to use to clip objects?
@@ -535,11 +548,11 @@ namespace TFE_Jedi
 				{
 					TFE_ZONE("Draw WAX");
 
-					f32 dx = s_rcfltState.cameraPos.x - fixed16ToFloat(obj->posWS.x);
-					f32 dz = s_rcfltState.cameraPos.z - fixed16ToFloat(obj->posWS.z);
+					f32 dx = m_state->cameraPos.x - fixed16ToFloat(obj->posWS.x);
+					f32 dz = m_state->cameraPos.z - fixed16ToFloat(obj->posWS.z);
 					s32 angle = vec2ToAngle(dx, dz);
 
-					sprite_drawWax(angle, obj, &cachedPosVS[obj->index]);
+					sprite_drawWax(m_state, angle, obj, &cachedPosVS[obj->index]);
 				}
 				else if (type == OBJ_TYPE_3D)
 				{
@@ -551,7 +564,7 @@ namespace TFE_Jedi
 				{
 					TFE_ZONE("Draw Frame");
 
-					sprite_drawFrame((u8*)obj->fme, obj->fme, obj, &cachedPosVS[obj->index]);
+					sprite_drawFrame(m_state, (u8*)obj->fme, obj->fme, obj, &cachedPosVS[obj->index]);
 				}
 			}
 		}
@@ -637,10 +650,10 @@ namespace TFE_Jedi
 
 	void TFE_Sectors_Float::saveValues(s32 index)
 	{
-		SectorSaveValues* dst = &s_sectorStack[index];
+		SectorSaveValues* dst = &m_state->sectorStack[index];
 		dst->curSector = s_curSector;
 		dst->prevSector = s_prevSector;
-		dst->depth1d = s_rcfltState.depth1d;
+		dst->depth1d = m_state->depth1d;
 		dst->windowX0 = s_windowX0;
 		dst->windowX1 = s_windowX1;
 		dst->windowMinY = s_windowMinY_Pixels;
@@ -662,10 +675,10 @@ namespace TFE_Jedi
 
 	void TFE_Sectors_Float::restoreValues(s32 index)
 	{
-		const SectorSaveValues* src = &s_sectorStack[index];
+		const SectorSaveValues* src = &m_state->sectorStack[index];
 		s_curSector = src->curSector;
 		s_prevSector = src->prevSector;
-		s_rcfltState.depth1d = (f32*)src->depth1d;
+		m_state->depth1d = (f32*)src->depth1d;
 		s_windowX0 = src->windowX0;
 		s_windowX1 = src->windowX1;
 		s_windowMinY_Pixels = src->windowMinY;
@@ -804,5 +817,12 @@ namespace TFE_Jedi
 	void TFE_Sectors_Float::subrendererChanged()
 	{
 		freeCachedData();
+		strip_destroy();
+	}
+
+	void TFE_Sectors_Float::serializeInPlace(Stream* stream)
+	{
+		SERIALIZE_INPLACE(m_cachedSectors);
+		SERIALIZE_INPLACE(m_cachedSectorCount);
 	}
-}
\ No newline at end of file
+}
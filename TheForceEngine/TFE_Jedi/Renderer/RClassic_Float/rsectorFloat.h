@@ -8,6 +8,7 @@
 #include <TFE_Jedi/Math/core_math.h>
 #include "rwallFloat.h"
 #include "rflatFloat.h"
+#include "rclassicFloatSharedState.h"
 #include "../rsectorRender.h"
 
 struct RWall;
@@ -35,14 +36,16 @@ namespace TFE_Jedi
 	class TFE_Sectors_Float : public TFE_Sectors
 	{
 	public:
-		TFE_Sectors_Float() : m_cachedSectors(nullptr), m_cachedSectorCount(0) {}
+		TFE_Sectors_Float() : m_cachedSectors(nullptr), m_cachedSectorCount(0), m_state(&s_rcfltState) {}
 
 		// Sub-Renderer specific
 		void destroy() override;
 		void reset() override;
 		void prepare() override;
 		void draw(RSector* sector) override;
+		void finish() override;
 		void subrendererChanged() override;
+		void serializeInPlace(Stream* stream) override;
 
 	private:
 		void saveValues(s32 index);
@@ -58,5 +61,7 @@ namespace TFE_Jedi
 	public:
 		SectorCached* m_cachedSectors = nullptr;
 		u32 m_cachedSectorCount = 0;
+		// The state this view is drawn with, passed explicitly to the wall, flat and sprite code.
+		RClassicFloatState* m_state = nullptr;
 	};
 }  // TFE_Jedi
@@ -0,0 +1,290 @@
+#include <TFE_System/system.h>
+#include <TFE_System/profiler.h>
+#include <TFE_Settings/settings.h>
+#include "rstripFloat.h"
+#include "../rcommon.h"
+#include <SDL_cpuinfo.h>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include <SDL_atomic.h>
+#include <vector>
+
+namespace TFE_Jedi
+{
+
+namespace RClassic_Float
+{
+	enum StripConst
+	{
+		STRIP_MAX_THREADS = 16,
+		// More strips than threads so that threads that finish early can pick up more work.
+		STRIP_PER_THREAD = 2,
+		STRIP_MAX_COUNT = STRIP_MAX_THREADS * STRIP_PER_THREAD,
+		STRIP_FRAME_BLOCK_SIZE = 256 * 1024,
+	};
+
+	static bool s_recording = false;
+	static std::vector<StripDraw> s_draws;
+	static std::vector<u32> s_stripDraws[STRIP_MAX_COUNT];
+	static s32 s_stripCount = 0;
+	static s32 s_stripWidth = 0;
+	static s32 s_stripMinX = 0;
+	static s32 s_stripMaxX = 0;
+	static s32 s_threadCountOverride = 0;
+
+	// Frame memory, blocks are kept between frames.
+	static std::vector<u8*> s_frameBlocks;
+	static s32 s_frameBlock = 0;
+	static u32 s_frameBlockUsed = 0;
+
+	// Worker threads, the calling thread draws strips as well.
+	static SDL_Thread* s_workers[STRIP_MAX_THREADS];
+	static s32 s_workerCount = 0;
+	static SDL_sem* s_workStart = nullptr;
+	static SDL_sem* s_workDone = nullptr;
+	static SDL_atomic_t s_nextStrip;
+	static SDL_atomic_t s_workerQuit;
+
+	void strip_drawStrip(s32 strip)
+	{
+		const s32 x0 = s_stripMinX + strip * s_stripWidth;
+		const s32 x1 = min(x0 + s_stripWidth - 1, s_stripMaxX);
+		const StripDraw* draws = s_draws.data();
+		const u32* index = s_stripDraws[strip].data();
+		const size_t count = s_stripDraws[strip].size();
+
+		for (size_t d = 0; d < count; d++)
+		{
+			const StripDraw* draw = &draws[index[d]];
+			if (draw->type == STRIP_COLUMN)
+			{
+				draw->func(draw);
+				continue;
+			}
+
+			// Clip the scanline to the strip. Scanlines step from right to left, so the
+			// interpolants are advanced past any pixels clipped on the right.
+			StripDraw clipped = *draw;
+			const s32 right = clipped.x + clipped.count - 1;
+			if (right > x1)
+			{
+				const s32 skip = right - x1;
+				clipped.u += clipped.dU * skip;
+				clipped.v += clipped.dV * skip;
+				clipped.i += clipped.dI * skip;
+				clipped.count -= skip;
+			}
+			if (clipped.x < x0)
+			{
+				const s32 skip = x0 - clipped.x;
+				clipped.out += skip;
+				clipped.x = x0;
+				clipped.count -= skip;
+			}
+			if (clipped.count > 0)
+			{
+				clipped.func(&clipped);
+			}
+		}
+	}
+
+	void strip_drawStrips()
+	{
+		s32 strip;
+		while ((strip = SDL_AtomicAdd(&s_nextStrip, 1)) < s_stripCount)
+		{
+			strip_drawStrip(strip);
+		}
+	}
+
+	s32 strip_workerFunc(void* userData)
+	{
+		while (1)
+		{
+			SDL_SemWait(s_workStart);
+			if (SDL_AtomicGet(&s_workerQuit)) { break; }
+
+			strip_drawStrips();
+			SDL_SemPost(s_workDone);
+		}
+		return 0;
+	}
+
+	void strip_stopWorkers()
+	{
+		if (!s_workerCount) { return; }
+
+		SDL_AtomicSet(&s_workerQuit, 1);
+		for (s32 i = 0; i < s_workerCount; i++)
+		{
+			SDL_SemPost(s_workStart);
+		}
+		for (s32 i = 0; i < s_workerCount; i++)
+		{
+			SDL_WaitThread(s_workers[i], nullptr);
+		}
+		s_workerCount = 0;
+	}
+
+	bool strip_startWorkers(s32 count)
+	{
+		if (!s_workStart)
+		{
+			s_workStart = SDL_CreateSemaphore(0);
+			s_workDone = SDL_CreateSemaphore(0);
+		}
+		if (!s_workStart || !s_workDone) { return false; }
+
+		SDL_AtomicSet(&s_workerQuit, 0);
+		for (s32 i = 0; i < count; i++)
+		{
+			s_workers[i] = SDL_CreateThread(strip_workerFunc, "TFE_RenderStrip", nullptr);
+			if (!s_workers[i])
+			{
+				TFE_System::logWrite(LOG_WARNING, "Renderer", "Cannot create render thread %d, using %d threads.", i + 1, i);
+				break;
+			}
+			s_workerCount++;
+		}
+		return s_workerCount > 0;
+	}
+
+	void strip_setThreadCountOverride(s32 count)
+	{
+		s_threadCountOverride = max(count, 0);
+	}
+
+	s32 strip_getThreadCount()
+	{
+		s32 threadCount = s_threadCountOverride ? s_threadCountOverride : TFE_Settings::getGraphicsSettings()->rendererThreads;
+		if (threadCount <= 0)
+		{
+			threadCount = SDL_GetCPUCount();
+		}
+		return clamp(threadCount, 1, (s32)STRIP_MAX_THREADS);
+	}
+
+	void strip_destroy()
+	{
+		strip_stopWorkers();
+		if (s_workStart)
+		{
+			SDL_DestroySemaphore(s_workStart);
+			SDL_DestroySemaphore(s_workDone);
+			s_workStart = nullptr;
+			s_workDone = nullptr;
+		}
+		for (size_t i = 0; i < s_frameBlocks.size(); i++)
+		{
+			free(s_frameBlocks[i]);
+		}
+		s_frameBlocks.clear();
+		s_draws.clear();
+		s_recording = false;
+	}
+
+	void strip_beginFrame(s32 minX, s32 maxX)
+	{
+		s_recording = false;
+
+		const s32 threadCount = strip_getThreadCount();
+		if (threadCount - 1 != s_workerCount)
+		{
+			strip_stopWorkers();
+			if (threadCount > 1)
+			{
+				strip_startWorkers(threadCount - 1);
+			}
+		}
+		if (!s_workerCount) { return; }
+
+		const s32 width = maxX - minX + 1;
+		s_stripCount = min((s_workerCount + 1) * STRIP_PER_THREAD, width);
+		s_stripWidth = (width + s_stripCount - 1) / s_stripCount;
+		s_stripCount = (width + s_stripWidth - 1) / s_stripWidth;
+		s_stripMinX = minX;
+		s_stripMaxX = maxX;
+
+		s_draws.clear();
+		for (s32 i = 0; i < s_stripCount; i++)
+		{
+			s_stripDraws[i].clear();
+		}
+		s_frameBlock = 0;
+		s_frameBlockUsed = 0;
+		s_recording = true;
+	}
+
+	void strip_endFrame()
+	{
+		if (!s_recording) { return; }
+		s_recording = false;
+
+		TFE_ZONE("Draw Strips");
+		SDL_AtomicSet(&s_nextStrip, 0);
+		for (s32 i = 0; i < s_workerCount; i++)
+		{
+			SDL_SemPost(s_workStart);
+		}
+		strip_drawStrips();
+		for (s32 i = 0; i < s_workerCount; i++)
+		{
+			SDL_SemWait(s_workDone);
+		}
+	}
+
+	bool strip_isRecording()
+	{
+		return s_recording;
+	}
+
+	void strip_draw(const StripDraw* draw)
+	{
+		if (!s_recording)
+		{
+			draw->func(draw);
+			return;
+		}
+
+		s32 x0 = draw->x, x1 = draw->x;
+		if (draw->type == STRIP_SCANLINE)
+		{
+			x1 = draw->x + draw->count - 1;
+		}
+		x0 = max(x0, s_stripMinX);
+		x1 = min(x1, s_stripMaxX);
+		if (x0 > x1) { return; }
+
+		const u32 index = (u32)s_draws.size();
+		s_draws.push_back(*draw);
+
+		const s32 strip0 = (x0 - s_stripMinX) / s_stripWidth;
+		const s32 strip1 = (x1 - s_stripMinX) / s_stripWidth;
+		for (s32 s = strip0; s <= strip1; s++)
+		{
+			s_stripDraws[s].push_back(index);
+		}
+	}
+
+	u8* strip_allocFrameMemory(u32 size)
+	{
+		if (size > STRIP_FRAME_BLOCK_SIZE) { return nullptr; }
+		if (s_frameBlock < (s32)s_frameBlocks.size() && s_frameBlockUsed + size > STRIP_FRAME_BLOCK_SIZE)
+		{
+			s_frameBlock++;
+			s_frameBlockUsed = 0;
+		}
+		if (s_frameBlock >= (s32)s_frameBlocks.size())
+		{
+			u8* block = (u8*)malloc(STRIP_FRAME_BLOCK_SIZE);
+			if (!block) { return nullptr; }
+			s_frameBlocks.push_back(block);
+		}
+
+		u8* mem = s_frameBlocks[s_frameBlock] + s_frameBlockUsed;
+		s_frameBlockUsed += size;
+		return mem;
+	}
+}  // RClassic_Float
+
+}  // TFE_Jedi
@@ -0,0 +1,69 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Screen Strips
+// Dark Forces Derived Renderer - Column and scanline draws
+//
+// The column and scanline kernels are given a StripDraw describing
+// the draw. When rendering with a single thread the draw runs right
+// away, otherwise it is recorded during the sector traversal and the
+// frame is replayed by worker threads at the end, each worker owning
+// a range of screen columns. Every strip replays the same draws in
+// the same order, so the result matches the single-threaded frame.
+// The sector traversal itself stays single-threaded, it updates
+// shared renderer state (the rcommon globals, sector and wall draw
+// frames, merged wall lists) that is not split by screen region.
+// Threading is opt-in through the rendererThreads setting.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+#include "fixedPoint20.h"
+
+namespace TFE_Jedi
+{
+	namespace RClassic_Float
+	{
+		struct StripDraw;
+		typedef void(*StripDrawFunc)(const StripDraw* draw);
+
+		enum StripDrawType : u8
+		{
+			STRIP_COLUMN = 0,	// Draws 'count' pixels of column 'x'.
+			STRIP_SCANLINE,		// Draws 'count' pixels starting at 'x', stepping from right to left.
+		};
+
+		struct StripDraw
+		{
+			StripDrawFunc func;
+			u8* out;
+			const u8* tex;
+			const u8* colorMap;
+
+			// Interpolants, a scanline clipped on the right is advanced by the skipped pixels.
+			fixed44_20 u, v, i;
+			fixed44_20 dU, dV, dI;
+
+			s32 x;
+			s32 count;
+			s32 texMask;
+			s32 texHeight;
+			s32 dither;
+			u8  type;
+			u8  color;
+		};
+
+		void strip_destroy();
+		// Use 'count' threads instead of the rendererThreads setting, 0 returns to the setting. Used to compare the paths.
+		void strip_setThreadCountOverride(s32 count);
+
+		// Start recording the frame if more than one render thread is enabled.
+		void strip_beginFrame(s32 minX, s32 maxX);
+		// Draw the recorded frame and wait for the workers to finish.
+		void strip_endFrame();
+
+		// Draw now or record for the end of the frame.
+		void strip_draw(const StripDraw* draw);
+		bool strip_isRecording();
+		// Memory that remains valid until the end of the frame, used when source data
+		// is generated on the fly (such as decompressed sprite columns).
+		u8*  strip_allocFrameMemory(u32 size);
+	}
+}
@@ -12,7 +12,10 @@
 #include "rsectorFloat.h"
 #include "redgePairFloat.h"
 #include "rclassicFloatSharedState.h"
+#include "rstripFloat.h"
 #include "../rcommon.h"
+#include "../rcolumn.h"
+#include "../rspriteCache.h"
 #include "../jediRenderer.h"
 
 namespace TFE_Jedi
@@ -28,23 +31,13 @@ namespace RClassic_Float
 		BACK = 0,
 	};
 
-	static f32 s_segmentCross;
-	static s32 s_texHeightMask;
-	static s32 s_yPixelCount;
-	static fixed44_20 s_vCoordStep;
-	static fixed44_20 s_vCoordFixed;
-	static const u8* s_columnLight;
-	static u8* s_texImage;
-	static u8* s_columnOut;
-	static u8  s_workBuffer[WAX_DECOMPRESS_SIZE];
-
-	s32 segmentCrossesLine(f32 ax0, f32 ay0, f32 ax1, f32 ay1, f32 bx0, f32 by0, f32 bx1, f32 by1);
+	s32 segmentCrossesLine(RClassicFloatState* state, f32 ax0, f32 ay0, f32 ax1, f32 ay1, f32 bx0, f32 by0, f32 bx1, f32 by1);
 	f32 solveForZ_Numerator(RWallSegmentFloat* wallSegment);
-	f32 solveForZ(RWallSegmentFloat* wallSegment, s32 x, f32 numerator, f32* outViewDx=nullptr);
-	void drawColumn_Fullbright();
-	void drawColumn_Lit();
-	void drawColumn_Fullbright_Trans();
-	void drawColumn_Lit_Trans();
+	f32 solveForZ(RClassicFloatState* state, RWallSegmentFloat* wallSegment, s32 x, f32 numerator, f32* outViewDx=nullptr);
+	void drawColumn_Fullbright(RClassicFloatState* state);
+	void drawColumn_Lit(RClassicFloatState* state);
+	void drawColumn_Fullbright_Trans(RClassicFloatState* state);
+	void drawColumn_Lit_Trans(RClassicFloatState* state);
 
 	// Column rendering functions that can be chosen at runtime.
 	enum ColumnFuncId
@@ -57,7 +50,7 @@ namespace RClassic_Float
 		COLFUNC_COUNT
 	};
 
-	typedef void(*ColumnFunction)();
+	typedef void(*ColumnFunction)(RClassicFloatState* state);
 	ColumnFunction s_columnFunc[COLFUNC_COUNT] =
 	{
 		drawColumn_Fullbright,			// COLFUNC_FULLBRIGHT
@@ -87,11 +80,11 @@ namespace RClassic_Float
 		return param;
 	}
 
-	f32 frustumIntersect(f32 x0, f32 z0, f32 x1, f32 z1, f32 dx, f32 dz)
+	f32 frustumIntersect(RClassicFloatState* state, f32 x0, f32 z0, f32 x1, f32 z1, f32 dx, f32 dz)
 	{
 		f32 xz;
 		xz = (x0 * z1) - (z0 * x1);
-		f32 dyx = dz * s_rcfltState.nearPlaneHalfLen - dx;
+		f32 dyx = dz * state->nearPlaneHalfLen - dx;
 		if (dyx != 0.0f)
 		{
 			xz /= dyx;
@@ -101,7 +94,7 @@ namespace RClassic_Float
 
 	// Returns true if the wall is potentially visible.
 	// Original DOS clipping code converted to floating point with small additions to support widescreen.
-	bool wall_clipToFrustum(f32& x0, f32& z0, f32& x1, f32& z1, f32& dx, f32& dz, f32& curU, f32& texelLen, f32& texelLenRem, s32& clipX0_Near, s32& clipX1_Near, f32 left0, f32 right0, f32 left1, f32 right1)
+	bool wall_clipToFrustum(RClassicFloatState* state, f32& x0, f32& z0, f32& x1, f32& z1, f32& dx, f32& dz, f32& curU, f32& texelLen, f32& texelLenRem, s32& clipX0_Near, s32& clipX1_Near, f32 left0, f32 right0, f32 left1, f32 right1)
 	{
 		//////////////////////////////////////////////
 		// Clip the Wall Segment by the left and right
@@ -114,7 +107,7 @@ namespace RClassic_Float
 		if (x0 < left0)
 		{
 			// Intersect the segment (x0, z0),(x1, z1) with the frustum line that passes through (-z0, z0) and (-z1, z1)
-			const f32 xz = frustumIntersect(x0, z0, x1, z1, dx, -dz);
+			const f32 xz = frustumIntersect(state, x0, z0, x1, z1, dx, -dz);
 
 			// Compute the parametric intersection of the segment and the left frustum line
 			// where s is in the range of [0.0, 1.0]
@@ -125,11 +118,11 @@ namespace RClassic_Float
 			}
 			else if (dx != 0)
 			{
-				s = (-xz * s_rcfltState.nearPlaneHalfLen - x0) / dx;
+				s = (-xz * state->nearPlaneHalfLen - x0) / dx;
 			}
 
 			// Update the x0,y0 coordinate of the segment.
-			x0 = -xz * s_rcfltState.nearPlaneHalfLen;
+			x0 = -xz * state->nearPlaneHalfLen;
 			z0 = xz;
 
 			if (s != 0)
@@ -154,7 +147,7 @@ namespace RClassic_Float
 			// Compute the coordinate where x0 + s*dx = z0 + s*dz
 			// Solve for s = (x0 - y0)/(dz - dx)
 			// Substitute: x = x0 + ((x0 - z0)/(dz - dx))*dx = (x0*z1 - z0*x1) / (dz - dx)
-			const f32 xz = frustumIntersect(x0, z0, x1, z1, dx, dz);
+			const f32 xz = frustumIntersect(state, x0, z0, x1, z1, dx, dz);
 
 			// Compute the parametric intersection of the segment and the left frustum line
 			// where s is in the range of [0.0, 1.0]
@@ -166,11 +159,11 @@ namespace RClassic_Float
 			}
 			else if (dx != 0)
 			{
-				s = (xz*s_rcfltState.nearPlaneHalfLen - x1) / dx;
+				s = (xz*state->nearPlaneHalfLen - x1) / dx;
 			}
 
 			// Update the x1,y1 coordinate of the segment.
-			x1 = xz * s_rcfltState.nearPlaneHalfLen;
+			x1 = xz * state->nearPlaneHalfLen;
 			z1 = xz;
 			if (s != 0)
 			{
@@ -191,7 +184,7 @@ namespace RClassic_Float
 		//////////////////////////////////////////////////
 		// Clip the Wall Segment by the near plane.
 		//////////////////////////////////////////////////
-		if ((z0 < 0 || z1 < 0) && segmentCrossesLine(0.0f, 0.0f, 0.0f, -s_rcfltState.halfHeight, x0, x0, x1, z1) != 0)
+		if ((z0 < 0 || z1 < 0) && segmentCrossesLine(state, 0.0f, 0.0f, 0.0f, -state->halfHeight, x0, x0, x1, z1) != 0)
 		{
 			return false;
 		}
@@ -278,7 +271,7 @@ namespace RClassic_Float
 	}
 
 	// Process the wall and produce an RWallSegment for rendering if the wall is potentially visible.
-	void wall_process(WallCached* wallCached)
+	void wall_process(RClassicFloatState* state, WallCached* wallCached)
 	{
 		const vec2_float* p0 = wallCached->v0;
 		const vec2_float* p1 = wallCached->v1;
@@ -291,10 +284,10 @@ namespace RClassic_Float
 		f32 z1 = p1->z;
 
 		// x values of frustum lines that pass through (x0,z0) and (x1,z1)
-		f32 left0 = -z0 * s_rcfltState.nearPlaneHalfLen;
-		f32 left1 = -z1 * s_rcfltState.nearPlaneHalfLen;
-		f32 right0 = z0 * s_rcfltState.nearPlaneHalfLen;
-		f32 right1 = z1 * s_rcfltState.nearPlaneHalfLen;
+		f32 left0 = -z0 * state->nearPlaneHalfLen;
+		f32 left1 = -z1 * state->nearPlaneHalfLen;
+		f32 right0 = z0 * state->nearPlaneHalfLen;
+		f32 right1 = z1 * state->nearPlaneHalfLen;
 
 		// Cull the wall if it is completely beyind the camera.
 		if (z0 < 0.0f && z1 < 0.0f)
@@ -333,7 +326,7 @@ namespace RClassic_Float
 		// Clip the Wall Segment by the left and right
 		// frustum lines.
 		//////////////////////////////////////////////
-		if (!wall_clipToFrustum(x0, z0, x1, z1, dx, dz, curU, texelLen, texelLenRem, clipX0_Near, clipX1_Near, left0, right0, left1, right1))
+		if (!wall_clipToFrustum(state, x0, z0, x1, z1, dx, dz, curU, texelLen, texelLenRem, clipX0_Near, clipX1_Near, left0, right0, left1, right1))
 		{
 			wall->visible = 0;
 			return;
@@ -342,21 +335,21 @@ namespace RClassic_Float
 		//////////////////////////////////////////////////
 		// Project.
 		//////////////////////////////////////////////////
-		f32 x0proj = (x0*s_rcfltState.focalLength)/z0 + s_rcfltState.projOffsetX;
-		f32 x1proj = (x1*s_rcfltState.focalLength)/z1 + s_rcfltState.projOffsetX;
+		f32 x0proj = (x0*state->focalLength)/z0 + state->projOffsetX;
+		f32 x1proj = (x1*state->focalLength)/z1 + state->projOffsetX;
 		s32 x0pixel = roundFloat(x0proj);
 		s32 x1pixel = roundFloat(x1proj) - 1;
 		
 		// Handle near plane clipping by adjusting the walls to avoid holes.
 		if (clipX0_Near != 0 && x0pixel > s_minScreenX_Pixels)
 		{
-			x0 = -s_rcfltState.nearPlaneHalfLen;
-			dx = x1 + s_rcfltState.nearPlaneHalfLen;
+			x0 = -state->nearPlaneHalfLen;
+			dx = x1 + state->nearPlaneHalfLen;
 			x0pixel = s_minScreenX_Pixels;
 		}
 		if (clipX1_Near != 0 && x1pixel < s_maxScreenX_Pixels)
 		{
-			dx = s_rcfltState.nearPlaneHalfLen - x0;
+			dx = state->nearPlaneHalfLen - x0;
 			x1pixel = s_maxScreenX_Pixels;
 		}
 
@@ -372,14 +365,19 @@ namespace RClassic_Float
 			wall->visible = 0;
 			return;
 		}
-		if (s_nextWall == s_maxSegCount)
+		if (s_nextWall == state->segLimit)
 		{
-			TFE_System::logWrite(LOG_ERROR, "ClassicRenderer", "Wall_Process : Maximum processed walls exceeded!");
+			// The buffers grow and the frame is drawn again, only report running out of room at the maximum.
+			if (state->segLimit >= s_maxSegCount)
+			{
+				TFE_System::logWrite(LOG_ERROR, "ClassicRenderer", "Wall_Process : Maximum processed walls exceeded!");
+			}
+			state->segLimitHit = JTRUE;
 			wall->visible = 0;
 			return;
 		}
 	
-		RWallSegmentFloat* wallSeg = &s_rcfltState.wallSegListSrc[s_nextWall];
+		RWallSegmentFloat* wallSeg = &state->wallSegListSrc[s_nextWall];
 		s_nextWall++;
 
 		if (x0pixel < s_minScreenX_Pixels)
@@ -422,7 +420,40 @@ namespace RClassic_Float
 		wall->visible = 1;
 	}
 
-	s32 wall_mergeSort(RWallSegmentFloat* segOutList, s32 availSpace, s32 start, s32 count)
+	// The merged segments never overlap in screenspace, so their order by wallX0 is also their order by wallX1.
+	// Returns the position in 'order' of the first segment that ends at or after 'x'.
+	static s32 wall_mergeOrderSearch(const RWallSegmentFloat* mergeList, const s32* order, s32 orderCount, s32 x)
+	{
+		s32 lo = 0;
+		s32 hi = orderCount;
+		while (lo < hi)
+		{
+			const s32 mid = (lo + hi) >> 1;
+			if (mergeList[order[mid]].wallX1 < x) { lo = mid + 1; }
+			else { hi = mid; }
+		}
+		return lo;
+	}
+
+	// Removes the deleted segments from the merge list while keeping the insertion order, 'remap' is scratch space.
+	static s32 wall_mergeCompact(RWallSegmentFloat* mergeList, s32 mergeCount, s32* order, s32 orderCount, s32* remap)
+	{
+		s32 liveCount = 0;
+		for (s32 i = 0; i < mergeCount; i++)
+		{
+			if (!mergeList[i].srcWall) { continue; }
+			if (i != liveCount) { mergeList[liveCount] = mergeList[i]; }
+			remap[i] = liveCount;
+			liveCount++;
+		}
+		for (s32 i = 0; i < orderCount; i++)
+		{
+			order[i] = remap[order[i]];
+		}
+		return liveCount;
+	}
+
+	s32 wall_mergeSort(RClassicFloatState* state, RWallSegmentFloat* segOutList, s32 availSpace, s32 start, s32 count)
 	{
 		TFE_ZONE("Wall Merge/Sort");
 
@@ -434,8 +465,15 @@ namespace RClassic_Float
 		s32 splitWallCount = 0;
 		s32 splitWallIndex = -count;
 
-		RWallSegmentFloat* srcSeg = &s_rcfltState.wallSegListSrc[start];
-		RWallSegmentFloat* curSegOut = segOutList;
+		RWallSegmentFloat* srcSeg = &state->wallSegListSrc[start];
+
+		// Merged segments are kept in insertion order, which is the order they are compared against new segments,
+		// deleted segments are left in place with a null srcWall. 'mergeOrder' indexes the live segments sorted by screen x
+		// so only the segments overlapping a new segment have to be visited.
+		RWallSegmentFloat* mergeList = state->wallSegListMerge;
+		s32* mergeOrder = state->wallSegMergeOrder;
+		s32* mergeVisit = state->wallSegMergeVisit;
+		s32 mergeCount = 0;
 
 		RWallSegmentFloat  tempSeg;
 		RWallSegmentFloat* newSeg = &tempSeg;
@@ -445,7 +483,7 @@ namespace RClassic_Float
 		{
 			WallCached* srcWall = srcSeg->srcWall;
 			JBool processed = (s_drawFrame == srcWall->wall->drawFrame) ? JTRUE : JFALSE;
-			JBool insideWindow = ((srcSeg->z0 >= s_rcfltState.windowMinZ || srcSeg->z1 >= s_rcfltState.windowMinZ) && srcSeg->wallX0 <= s_windowMaxX_Pixels && srcSeg->wallX1 >= s_windowMinX_Pixels) ? JTRUE : JFALSE;
+			JBool insideWindow = ((srcSeg->z0 >= state->windowMinZ || srcSeg->z1 >= state->windowMinZ) && srcSeg->wallX0 <= s_windowMaxX_Pixels && srcSeg->wallX1 >= s_windowMinX_Pixels) ? JTRUE : JFALSE;
 			if (!processed && insideWindow)
 			{
 				// Copy the source segment into "newSeg" so it can be modified.
@@ -455,11 +493,24 @@ namespace RClassic_Float
 				if (newSeg->wallX0 < s_windowMinX_Pixels) { newSeg->wallX0 = s_windowMinX_Pixels; }
 				if (newSeg->wallX1 > s_windowMaxX_Pixels) { newSeg->wallX1 = s_windowMaxX_Pixels; }
 
-				// Check 'newSeg' versus all of the segments already added for this sector.
-				RWallSegmentFloat* sortedSeg = segOutList;
+				// Check 'newSeg' versus the segments already added for this sector that overlap it in screenspace.
+				// These are contiguous in 'mergeOrder' and are visited in insertion order.
+				s32 visitCount = 0;
+				for (s32 i = wall_mergeOrderSearch(mergeList, mergeOrder, outIndex, newSeg->wallX0); i < outIndex && mergeList[mergeOrder[i]].wallX0 <= newSeg->wallX1; i++)
+				{
+					s32 v = visitCount;
+					for (; v > 0 && mergeVisit[v - 1] > mergeOrder[i]; v--)
+					{
+						mergeVisit[v] = mergeVisit[v - 1];
+					}
+					mergeVisit[v] = mergeOrder[i];
+					visitCount++;
+				}
+
 				s32 segHidden = 0;
-				for (s32 n = 0; n < outIndex && segHidden == 0; n++, sortedSeg++)
+				for (s32 n = 0; n < visitCount && segHidden == 0; n++)
 				{
+					RWallSegmentFloat* sortedSeg = &mergeList[mergeVisit[n]];
 					// Trivially skip segments that do not overlap in screenspace.
 					if (!(newSeg->wallX0 <= sortedSeg->wallX1 && sortedSeg->wallX0 <= newSeg->wallX1)) { continue; }
 
@@ -487,10 +538,10 @@ namespace RClassic_Float
 						else if (newV0->z < outV0->z)
 						{
 							side = FRONT;
-							if ((segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||	// (outV0, 0) does NOT cross (newV0, newV1)
-								 segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&	// (outV1, 0) does NOT cross (newV0, newV1)
-								(!segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||	// (newV0, 0) crosses (outV0, outV1)
-								 !segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))	// (newV1, 0) crosses (outV0, outV1)
+							if ((segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||	// (outV0, 0) does NOT cross (newV0, newV1)
+								 segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&	// (outV1, 0) does NOT cross (newV0, newV1)
+								(!segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||	// (newV0, 0) crosses (outV0, outV1)
+								 !segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))	// (newV1, 0) crosses (outV0, outV1)
 							{
 								side = BACK;
 							}
@@ -498,10 +549,10 @@ namespace RClassic_Float
 						else  // newV0->z >= outV0->z
 						{
 							side = BACK;
-							if ((segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||	// (newV0, 0) does NOT cross (outV0, outV1)
-								 segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&	// (newV1, 0) does NOT cross (outV0, outV1)
-								(!segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||	// (outV0, 0) crosses (newV0, newV1)
-								 !segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))	// (outV1, 0) crosses (newV0, newV1)
+							if ((segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||	// (newV0, 0) does NOT cross (outV0, outV1)
+								 segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&	// (newV1, 0) does NOT cross (outV0, outV1)
+								(!segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||	// (outV0, 0) crosses (newV0, newV1)
+								 !segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))	// (outV1, 0) crosses (newV0, newV1)
 							{
 								side = FRONT;
 							}
@@ -510,19 +561,11 @@ namespace RClassic_Float
 						// 'newSeg' is in front of 'sortedSeg' and it completely hides it.
 						if (side == FRONT)
 						{
-							s32 copyCount = outIndex - 1 - n;
-							RWallSegmentFloat* outCur = sortedSeg;
-							RWallSegmentFloat* outNext = sortedSeg + 1;
-
-							// We are deleting outCur since it is completely hidden by moving all segments from outNext onwards to outCur.
-							memmove(outCur, outNext, copyCount * sizeof(RWallSegmentFloat));
-
-							// We are deleting outCur since it is completely hidden by 'newSeg'
-							// Back up 1 step in the loop, so that outNext is processed (it will hold the same location as outCur before deletion).
-							curSegOut = curSegOut - 1;
-							sortedSeg = sortedSeg - 1;
+							// We are deleting 'sortedSeg' since it is completely hidden by 'newSeg'.
+							s32 orderIndex = wall_mergeOrderSearch(mergeList, mergeOrder, outIndex, sortedSeg->wallX1);
+							memmove(&mergeOrder[orderIndex], &mergeOrder[orderIndex + 1], (outIndex - 1 - orderIndex) * sizeof(s32));
+							sortedSeg->srcWall = nullptr;
 							outIndex--;
-							n--;
 						}
 						// 'newSeg' is behind 'sortedSeg' and they overlap.
 						else    // (side == BACK)
@@ -572,10 +615,10 @@ namespace RClassic_Float
 						else if (newV0->z < outV0->z)
 						{
 							side = FRONT;
-							if ((segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
-								 segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&
-								(!segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
-								 !segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))
+							if ((segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
+								 segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)) &&
+								(!segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
+								 !segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)))
 							{
 								side = BACK;
 							}
@@ -583,10 +626,10 @@ namespace RClassic_Float
 						else  // (newV0->z >= outV0->z)
 						{
 							side = BACK;
-							if ((segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
-								 segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&
-								(!segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
-								 !segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))
+							if ((segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
+								 segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z)) &&
+								(!segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z) ||
+								 !segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z)))
 							{
 								side = FRONT;
 							}
@@ -641,8 +684,8 @@ namespace RClassic_Float
 								newSeg->wallX1 = sortedSeg->wallX0 - 1;
 							}
 						}
-						else if (segmentCrossesLine(newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
-								 !segmentCrossesLine(outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
+						else if (segmentCrossesLine(state, newV1->x, newV1->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
+								 !segmentCrossesLine(state, outV0->x, outV0->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
 						{
 							sortedSeg->wallX0 = newSeg->wallX1 + 1;
 						}
@@ -662,8 +705,8 @@ namespace RClassic_Float
 							newSeg->wallX0 = sortedSeg->wallX1 + 1;
 						}
 					}
-					else if (segmentCrossesLine(newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
-							 !segmentCrossesLine(outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
+					else if (segmentCrossesLine(state, newV0->x, newV0->z, 0, 0, outV0->x, outV0->z, outV1->x, outV1->z) ||
+							 !segmentCrossesLine(state, outV1->x, outV1->z, 0, 0, newV0->x, newV0->z, newV1->x, newV1->z))
 					{
 						sortedSeg->wallX1 = newSeg->wallX0 - 1;
 					}
@@ -671,20 +714,32 @@ namespace RClassic_Float
 					{
 						newSeg->wallX0 = sortedSeg->wallX1 + 1;
 					}
-				} // for (s32 n = 0; n < outIndex && segHidden == 0; n++, sortedSeg++)
+				} // for (s32 n = 0; n < visitCount && segHidden == 0; n++)
 
 				// If the new segment is still visible and not back facing.
 				if (segHidden == 0 && newSeg->wallX0 <= newSeg->wallX1)
 				{
 					if (outIndex == availSpace)
 					{
-						TFE_System::logWrite(LOG_ERROR, "RendererClassic", "Wall_MergeSort : Maximum merged walls exceeded!");
+						if (state->segLimit >= s_maxSegCount)
+						{
+							TFE_System::logWrite(LOG_ERROR, "RendererClassic", "Wall_MergeSort : Maximum merged walls exceeded!");
+						}
+						state->segLimitHit = JTRUE;
 					}
 					else
 					{
-						// Copy the temporary segment to the current segment.
-						*curSegOut = *newSeg;
-						curSegOut++;
+						if (mergeCount == state->segLimit)
+						{
+							mergeCount = wall_mergeCompact(mergeList, mergeCount, mergeOrder, outIndex, mergeVisit);
+						}
+
+						// Copy the temporary segment to the merge list and insert it into the screenspace order.
+						mergeList[mergeCount] = *newSeg;
+						s32 orderIndex = wall_mergeOrderSearch(mergeList, mergeOrder, outIndex, newSeg->wallX1);
+						memmove(&mergeOrder[orderIndex + 1], &mergeOrder[orderIndex], (outIndex - orderIndex) * sizeof(s32));
+						mergeOrder[orderIndex] = mergeCount;
+						mergeCount++;
 						outIndex++;
 					}
 				}
@@ -705,6 +760,16 @@ namespace RClassic_Float
 			}
 		}  // while (1)
 
+		// Copy the remaining segments out in insertion order.
+		RWallSegmentFloat* curSegOut = segOutList;
+		for (s32 i = 0; i < mergeCount; i++)
+		{
+			if (mergeList[i].srcWall)
+			{
+				*curSegOut = mergeList[i];
+				curSegOut++;
+			}
+		}
 		return outIndex;
 	}
 
@@ -739,7 +804,7 @@ namespace RClassic_Float
 		return signTex;
 	}
 
-	void wall_drawSolid(RWallSegmentFloat* wallSegment)
+	void wall_drawSolid(RClassicFloatState* state, RWallSegmentFloat* wallSegment)
 	{
 		WallCached* cachedWall = wallSegment->srcWall;
 		SectorCached* cachedSector = cachedWall->sector;
@@ -752,16 +817,16 @@ namespace RClassic_Float
 		f32 ceilingHeight = cachedSector->ceilingHeight;
 		f32 floorHeight = cachedSector->floorHeight;
 
-		f32 ceilEyeRel  = ceilingHeight - s_rcfltState.eyeHeight;
-		f32 floorEyeRel = floorHeight   - s_rcfltState.eyeHeight;
+		f32 ceilEyeRel  = ceilingHeight - state->eyeHeight;
+		f32 floorEyeRel = floorHeight   - state->eyeHeight;
 
 		f32 z0 = wallSegment->z0;
 		f32 z1 = wallSegment->z1;
 
-		f32 y0C = (ceilEyeRel  * s_rcfltState.focalLenAspect) / z0 + s_rcfltState.projOffsetY;
-		f32 y1C = (ceilEyeRel  * s_rcfltState.focalLenAspect) / z1 + s_rcfltState.projOffsetY;
-		f32 y0F = (floorEyeRel * s_rcfltState.focalLenAspect) / z0 + s_rcfltState.projOffsetY;
-		f32 y1F = (floorEyeRel * s_rcfltState.focalLenAspect) / z1 + s_rcfltState.projOffsetY;
+		f32 y0C = (ceilEyeRel  * state->focalLenAspect) / z0 + state->projOffsetY;
+		f32 y1C = (ceilEyeRel  * state->focalLenAspect) / z1 + state->projOffsetY;
+		f32 y0F = (floorEyeRel * state->focalLenAspect) / z0 + state->projOffsetY;
+		f32 y1F = (floorEyeRel * state->focalLenAspect) / z1 + state->projOffsetY;
 
 		s32 y0C_pixel = roundFloat(y0C);
 		s32 y1C_pixel = roundFloat(y1C);
@@ -776,11 +841,11 @@ namespace RClassic_Float
 		if (y0C_pixel > s_windowMaxY_Pixels && y1C_pixel > s_windowMaxY_Pixels)
 		{
 			f32 yMax = f32(s_windowMaxY_Pixels + 1);
-			flat_addEdges(length, x, 0, yMax, 0, yMax);
+			flat_addEdges(state, length, x, 0, yMax, 0, yMax);
 
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 
@@ -788,7 +853,7 @@ namespace RClassic_Float
 			return;
 		}
 
-		s_texHeightMask = texture ? texture->height - 1 : 0;
+		state->texHeightMask = texture ? texture->height - 1 : 0;
 
 		f32 signU0 = 0, signU1 = 0;
 		ColumnFunction signFullbright = nullptr, signLit = nullptr;
@@ -808,7 +873,7 @@ namespace RClassic_Float
 			y0C += (dYdXtop * clippedXDelta);
 			y0F += (dYdXbot * clippedXDelta);
 		}
-		flat_addEdges(length, wallSegment->wallX0, dYdXbot, y0F, dYdXtop, y0C);
+		flat_addEdges(state, length, wallSegment->wallX0, dYdXbot, y0F, dYdXtop, y0C);
 
 		const s32 texWidth = texture ? texture->width : 0;
 		const JBool flipHorz = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
@@ -822,17 +887,17 @@ namespace RClassic_Float
 
 			top = max(top, s_windowTop[x]);
 			bot = min(bot, s_windowBot[x]);
-			s_yPixelCount = bot - top + 1;
+			state->yPixelCount = bot - top + 1;
 
 			f32 dxView = 0;
-			f32 z = solveForZ(wallSegment, x, numerator, &dxView);
-			s_rcfltState.depth1d[x] = z;
+			f32 z = solveForZ(state, wallSegment, x, numerator, &dxView);
+			state->depth1d[x] = z;
 
 			f32 uScale  = wallSegment->uScale;
 			f32 uCoord0 = wallSegment->uCoord0 + cachedWall->midOffset.x;
 			f32 uCoord = uCoord0 + ((wallSegment->orient == WORIENT_DZ_DX) ? dxView*uScale : (z - z0)*uScale);
 
-			if (s_yPixelCount > 0)
+			if (state->yPixelCount > 0)
 			{
 				// texture wrapping, assumes texWidth is a power of 2.
 				s32 texelU = floorFloat(uCoord) & (texWidth - 1);
@@ -843,9 +908,9 @@ namespace RClassic_Float
 				f32 wallHeightPixels = y0F - y0C + 1.0f;
 				f32 wallHeightTexels = cachedWall->midTexelHeight;
 
-				// s_vCoordStep = tex coord "v" step per y pixel step -> dVdY;
+				// state->vCoordStep = tex coord "v" step per y pixel step -> dVdY;
 				f32 vCoordStep = wallHeightTexels / wallHeightPixels;
-				s_vCoordStep = floatToFixed20(vCoordStep);
+				state->vCoordStep = floatToFixed20(vCoordStep);
 
 				// texel offset from the actual fixed point y position and the truncated y position.
 				f32 vPixelOffset = y0F - f32(bot) + 0.5f;
@@ -853,22 +918,22 @@ namespace RClassic_Float
 				// scale the texel offset based on the v coord step.
 				// the result is the sub-texel offset
 				f32 v0 = vCoordStep * vPixelOffset;
-				s_vCoordFixed = floatToFixed20(v0 + cachedWall->midOffset.z);
+				state->vCoordFixed = floatToFixed20(v0 + cachedWall->midOffset.z);
 
 				// Texture image data = imageStart + u * texHeight
-				s_texImage = texture->image + (texelU << texture->logSizeY);
-				s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+				state->texImage = texture->image + (texelU << texture->logSizeY);
+				state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 				// column write output.
-				s_columnOut = &s_display[top * s_width + x];
+				state->columnOut = &s_display[top * s_width + x];
 
 				// draw the column
-				if (s_columnLight)
+				if (state->columnLight)
 				{
-					drawColumn_Lit();
+					drawColumn_Lit(state);
 				}
 				else
 				{
-					drawColumn_Fullbright();
+					drawColumn_Fullbright(state);
 				}
 
 				// Handle the "sign texture" - a wall overlay.
@@ -877,26 +942,26 @@ namespace RClassic_Float
 					f32 signYBase = y0F + (cachedWall->signOffset.z / vCoordStep);
 					s32 y0 = max(floorFloat(signYBase - (f32(signTex->height) / vCoordStep) + 1.5f), top);
 					s32 y1 = min(floorFloat(signYBase + 0.5f), bot);
-					s_yPixelCount = y1 - y0 + 1;
+					state->yPixelCount = y1 - y0 + 1;
 
-					if (s_yPixelCount > 0)
+					if (state->yPixelCount > 0)
 					{
-						s_vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f) * vCoordStep);
-						s_columnOut = &s_display[y0*s_width + x];
+						state->vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f) * vCoordStep);
+						state->columnOut = &s_display[y0*s_width + x];
 						texelU = floorFloat(uCoord - signU0);
-						s_texImage = &signTex->image[texelU << signTex->logSizeY];
+						state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-						s32 heightMask = s_texHeightMask;
-						s_texHeightMask = signTex->height - 1;
-						if (s_columnLight)
+						s32 heightMask = state->texHeightMask;
+						state->texHeightMask = signTex->height - 1;
+						if (state->columnLight)
 						{
-							signLit();
+							signLit(state);
 						}
 						else
 						{
-							signFullbright();
+							signFullbright(state);
 						}
-						s_texHeightMask = heightMask;
+						state->texHeightMask = heightMask;
 					}
 				}
 			}
@@ -908,7 +973,7 @@ namespace RClassic_Float
 		srcWall->seen = JTRUE;
 	}
 
-	void wall_drawTransparent(RWallSegmentFloat* wallSegment, EdgePairFloat* edge)
+	void wall_drawTransparent(RClassicFloatState* state, RWallSegmentFloat* wallSegment, EdgePairFloat* edge)
 	{
 		WallCached* cachedWall = wallSegment->srcWall;
 		SectorCached* cachedSector = cachedWall->sector;
@@ -924,7 +989,7 @@ namespace RClassic_Float
 		f32 uCoord0 = wallSegment->uCoord0 + cachedWall->midOffset.x;
 		s32 lengthInPixels = edge->lengthInPixels;
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		JBool flipHorz = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 
 		f32 ceil_dYdX  = edge->dyCeil_dx;
@@ -939,11 +1004,11 @@ namespace RClassic_Float
 			s32 yC_pixel = max(roundFloat(yC0), top);
 			s32 yF_pixel = min(roundFloat(yF0), bot);
 
-			s_yPixelCount = yF_pixel - yC_pixel + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = yF_pixel - yC_pixel + 1;
+			if (state->yPixelCount > 0)
 			{
 				f32 dxView;
-				f32 z = solveForZ(wallSegment, x, num, &dxView);
+				f32 z = solveForZ(state, wallSegment, x, num, &dxView);
 				f32 uCoord = uCoord0 + ((wallSegment->orient == WORIENT_DZ_DX) ? dxView*uScale : (z - z0)*uScale);
 
 				s32 widthMask = texture->width - 1;
@@ -953,22 +1018,22 @@ namespace RClassic_Float
 					texelU = widthMask - texelU;
 				}
 
-				s_texImage = &texture->image[texelU << texture->logSizeY];
+				state->texImage = &texture->image[texelU << texture->logSizeY];
 				f32 vCoordStep = cachedWall->midTexelHeight / (yF0 - yC0 + 1.0f);
-				s_vCoordStep  = floatToFixed20(vCoordStep);
-				s_vCoordFixed = floatToFixed20((yF0 - f32(yF_pixel) + 0.5f)*vCoordStep + cachedWall->midOffset.z);
+				state->vCoordStep  = floatToFixed20(vCoordStep);
+				state->vCoordFixed = floatToFixed20((yF0 - f32(yF_pixel) + 0.5f)*vCoordStep + cachedWall->midOffset.z);
 
-				s_columnOut = &s_display[yC_pixel*s_width + x];
-				s_rcfltState.depth1d[x] = z;
-				s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+				state->columnOut = &s_display[yC_pixel*s_width + x];
+				state->depth1d[x] = z;
+				state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 
-				if (s_columnLight)
+				if (state->columnLight)
 				{
-					drawColumn_Lit_Trans();
+					drawColumn_Lit_Trans(state);
 				}
 				else
 				{
-					drawColumn_Fullbright_Trans();
+					drawColumn_Fullbright_Trans(state);
 				}
 			}
 
@@ -977,7 +1042,7 @@ namespace RClassic_Float
 		}
 	}
 
-	void wall_drawMask(RWallSegmentFloat* wallSegment)
+	void wall_drawMask(RClassicFloatState* state, RWallSegmentFloat* wallSegment)
 	{
 		WallCached* cachedWall = wallSegment->srcWall;
 		SectorCached* cachedSector = cachedWall->sector;
@@ -994,13 +1059,13 @@ namespace RClassic_Float
 		f32 cProj0, cProj1;
 		if ((flags1 & SEC_FLAGS1_EXTERIOR) && (nextFlags1 & SEC_FLAGS1_EXT_ADJ))  // ceiling
 		{
-			cProj0 = cProj1 = s_rcfltState.windowMinY;
+			cProj0 = cProj1 = state->windowMinY;
 		}
 		else
 		{
-			f32 ceilRel = cachedSector->ceilingHeight - s_rcfltState.eyeHeight;
-			cProj0 = ((ceilRel*s_rcfltState.focalLenAspect)/z0) + s_rcfltState.projOffsetY;
-			cProj1 = ((ceilRel*s_rcfltState.focalLenAspect)/z1) + s_rcfltState.projOffsetY;
+			f32 ceilRel = cachedSector->ceilingHeight - state->eyeHeight;
+			cProj0 = ((ceilRel*state->focalLenAspect)/z0) + state->projOffsetY;
+			cProj1 = ((ceilRel*state->focalLenAspect)/z1) + state->projOffsetY;
 		}
 
 		s32 c0pixel = roundFloat(cProj0);
@@ -1009,11 +1074,11 @@ namespace RClassic_Float
 		{
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - wallSegment->wallX0 + 1;
-			flat_addEdges(length, x, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, length, x, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
 			const f32 numerator = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 
@@ -1025,13 +1090,13 @@ namespace RClassic_Float
 		f32 fProj0, fProj1;
 		if ((sector->flags1 & SEC_FLAGS1_PIT) && (nextFlags1 & SEC_FLAGS1_EXT_FLOOR_ADJ))	// floor
 		{
-			fProj0 = fProj1 = s_rcfltState.windowMaxY;
+			fProj0 = fProj1 = state->windowMaxY;
 		}
 		else
 		{
-			f32 floorRel = cachedSector->floorHeight - s_rcfltState.eyeHeight;
-			fProj0 = ((floorRel*s_rcfltState.focalLenAspect)/z0) + s_rcfltState.projOffsetY;
-			fProj1 = ((floorRel*s_rcfltState.focalLenAspect)/z1) + s_rcfltState.projOffsetY;
+			f32 floorRel = cachedSector->floorHeight - state->eyeHeight;
+			fProj0 = ((floorRel*state->focalLenAspect)/z0) + state->projOffsetY;
+			fProj1 = ((floorRel*state->focalLenAspect)/z1) + state->projOffsetY;
 		}
 
 		s32 f0pixel = roundFloat(fProj0);
@@ -1040,12 +1105,12 @@ namespace RClassic_Float
 		{
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - wallSegment->wallX0 + 1;
-			flat_addEdges(length, x, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, length, x, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
 
 			const f32 numerator = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			srcWall->visible = 0;
@@ -1074,13 +1139,13 @@ namespace RClassic_Float
 			y1 = dydxFloor*xStartOffset + fProj0;
 		}
 
-		flat_addEdges(length, x, dydxFloor, y1, dydxCeil, y0);
+		flat_addEdges(state, length, x, dydxFloor, y1, dydxCeil, y0);
 		f32 nextFloor = fixed16ToFloat(nextSector->floorHeight);
 		f32 nextCeil  = fixed16ToFloat(nextSector->ceilingHeight);
 		// There is an opening in this wall to the next sector.
 		if (nextFloor > nextCeil)
 		{
-			wall_addAdjoinSegment(length, x, dydxFloor, y1, dydxCeil, y0, wallSegment);
+			wall_addAdjoinSegment(state, length, x, dydxFloor, y1, dydxCeil, y0, wallSegment);
 		}
 		if (length != 0)
 		{
@@ -1091,7 +1156,7 @@ namespace RClassic_Float
 				s_columnTop[x] = y0_pixel - 1;
 				s_columnBot[x] = y1_pixel + 1;
 
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, numerator);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, numerator);
 				y0 += dydxCeil;
 				y1 += dydxFloor;
 			}
@@ -1100,7 +1165,7 @@ namespace RClassic_Float
 		srcWall->seen = JTRUE;
 	}
 
-	void wall_drawBottom(RWallSegmentFloat* wallSegment)
+	void wall_drawBottom(RClassicFloatState* state, RWallSegmentFloat* wallSegment)
 	{
 		WallCached* cachedWall = wallSegment->srcWall;
 		SectorCached* cachedSector = cachedWall->sector;
@@ -1117,14 +1182,14 @@ namespace RClassic_Float
 		f32 cProj0, cProj1;
 		if ((sector->flags1 & SEC_FLAGS1_EXTERIOR) && (nextSector->flags1 & SEC_FLAGS1_EXT_ADJ))
 		{
-			cProj0 = s_rcfltState.windowMinY;
+			cProj0 = state->windowMinY;
 			cProj1 = cProj0;
 		}
 		else
 		{
-			f32 ceilRel = cachedSector->ceilingHeight - s_rcfltState.eyeHeight;
-			cProj0 = (ceilRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-			cProj1 = (ceilRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+			f32 ceilRel = cachedSector->ceilingHeight - state->eyeHeight;
+			cProj0 = (ceilRel*state->focalLenAspect)/z0 + state->projOffsetY;
+			cProj1 = (ceilRel*state->focalLenAspect)/z1 + state->projOffsetY;
 		}
 
 		s32 cy0 = roundFloat(cProj0);
@@ -1135,21 +1200,21 @@ namespace RClassic_Float
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - x + 1;
 
-			flat_addEdges(length, x, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, length, x, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
 
 			f32 num = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 			srcWall->seen = JTRUE;
 			return;
 		}
 
-		f32 floorRel = cachedSector->floorHeight - s_rcfltState.eyeHeight;
-		f32 fProj0 = (floorRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-		f32 fProj1 = (floorRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+		f32 floorRel = cachedSector->floorHeight - state->eyeHeight;
+		f32 fProj0 = (floorRel*state->focalLenAspect)/z0 + state->projOffsetY;
+		f32 fProj1 = (floorRel*state->focalLenAspect)/z1 + state->projOffsetY;
 
 		s32 fy0 = roundFloat(fProj0);
 		s32 fy1 = roundFloat(fProj1);
@@ -1160,21 +1225,21 @@ namespace RClassic_Float
 			s32 x = wallSegment->wallX0;
 			s32 length = wallSegment->wallX1 - x + 1;
 
-			flat_addEdges(length, x, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, length, x, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
 
 			f32 num = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0; i < length; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			srcWall->seen = JTRUE;
 			return;
 		}
 
-		f32 floorRelNext = fixed16ToFloat(nextSector->floorHeight) - s_rcfltState.eyeHeight;
-		f32 fNextProj0 = (floorRelNext*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-		f32 fNextProj1 = (floorRelNext*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+		f32 floorRelNext = fixed16ToFloat(nextSector->floorHeight) - state->eyeHeight;
+		f32 fNextProj0 = (floorRelNext*state->focalLenAspect)/z0 + state->projOffsetY;
+		f32 fNextProj1 = (floorRelNext*state->focalLenAspect)/z1 + state->projOffsetY;
 
 		s32 xOffset = wallSegment->wallX0 - wallSegment->wallX0_raw;
 		s32 length  = wallSegment->wallX1 - wallSegment->wallX0 + 1;
@@ -1202,13 +1267,13 @@ namespace RClassic_Float
 		f32 yC = cProj0;
 		f32 yBot = fProj0;
 		s32 x = wallSegment->wallX0;
-		flat_addEdges(length, wallSegment->wallX0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
+		flat_addEdges(state, length, wallSegment->wallX0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
 
 		s32 yTop0 = roundFloat(fNextProj0);
 		s32 yTop1 = roundFloat(fNextProj1);
 		if ((yTop0 > s_windowMinY_Pixels || yTop1 > s_windowMinY_Pixels) && sector->ceilingHeight < nextSector->floorHeight)
 		{
-			wall_addAdjoinSegment(length, wallSegment->wallX0, floorNext_dYdX, fNextProj0, ceil_dYdX, cProj0, wallSegment);
+			wall_addAdjoinSegment(state, length, wallSegment->wallX0, floorNext_dYdX, fNextProj0, ceil_dYdX, cProj0, wallSegment);
 		}
 
 		if (yTop0 > s_windowMaxY_Pixels && yTop1 > s_windowMaxY_Pixels)
@@ -1220,7 +1285,7 @@ namespace RClassic_Float
 				s32 yC_pixel = min(roundFloat(yC), s_windowBot[x]);
 				s_columnTop[x] = yC_pixel - 1;
 				s_columnBot[x] = bot;
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 			}
 			srcWall->seen = JTRUE;
 			return;
@@ -1228,7 +1293,7 @@ namespace RClassic_Float
 
 		f32 u0 = wallSegment->uCoord0;
 		f32 num = solveForZ_Numerator(wallSegment);
-		s_texHeightMask = tex->height - 1;
+		state->texHeightMask = tex->height - 1;
 		JBool flipHorz  = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 		JBool illumSign = ((srcWall->flags1 & WF1_ILLUM_SIGN)!=0) ? JTRUE : JFALSE;
 
@@ -1257,11 +1322,11 @@ namespace RClassic_Float
 				{
 					yBot_pixel = s_windowBot[x];
 				}
-				s_yPixelCount = yBot_pixel - yTop_pixel + 1;
+				state->yPixelCount = yBot_pixel - yTop_pixel + 1;
 
 				// Calculate perspective correct Z and U (texture coordinate).
 				f32 dxView;
-				f32 z = solveForZ(wallSegment, x, num, &dxView);
+				f32 z = solveForZ(state, wallSegment, x, num, &dxView);
 				f32 uCoord;
 				if (wallSegment->orient == WORIENT_DZ_DX)
 				{
@@ -1272,8 +1337,8 @@ namespace RClassic_Float
 					f32 dz = z - z0;
 					uCoord = u0 + (dz*wallSegment->uScale) + cachedWall->botOffset.x;
 				}
-				s_rcfltState.depth1d[x] = z;
-				if (s_yPixelCount > 0)
+				state->depth1d[x] = z;
+				if (state->yPixelCount > 0)
 				{
 					s32 widthMask = tex->width - 1;
 					s32 texelU = floorFloat(uCoord) & widthMask;
@@ -1284,19 +1349,19 @@ namespace RClassic_Float
 
 					f32 vCoordStep = cachedWall->botTexelHeight / (yBot - yTop + 1.0f);
 					f32 v0 = (yBot - f32(yBot_pixel) + 0.5f) * vCoordStep;
-					s_vCoordFixed = floatToFixed20(v0 + cachedWall->botOffset.z);
-					s_vCoordStep  = floatToFixed20(vCoordStep);
+					state->vCoordFixed = floatToFixed20(v0 + cachedWall->botOffset.z);
+					state->vCoordStep  = floatToFixed20(vCoordStep);
 
-					s_texImage = &tex->image[texelU << tex->logSizeY];
-					s_columnOut = &s_display[yTop_pixel * s_width + x];
-					s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
-					if (s_columnLight)
+					state->texImage = &tex->image[texelU << tex->logSizeY];
+					state->columnOut = &s_display[yTop_pixel * s_width + x];
+					state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
+					if (state->columnLight)
 					{
-						drawColumn_Lit();
+						drawColumn_Lit(state);
 					}
 					else
 					{
-						drawColumn_Fullbright();
+						drawColumn_Fullbright(state);
 					}
 
 					// Handle the "sign texture" - a wall overlay.
@@ -1305,26 +1370,26 @@ namespace RClassic_Float
 						f32 signYBase = yBot + (cachedWall->signOffset.z/vCoordStep);
 						s32 y0 = max(floorFloat(signYBase - (f32(signTex->height)/vCoordStep) + 1.5f), yTop_pixel);
 						s32 y1 = min(floorFloat(signYBase + 0.5f), yBot_pixel);
-						s_yPixelCount = y1 - y0 + 1;
+						state->yPixelCount = y1 - y0 + 1;
 
-						if (s_yPixelCount > 0)
+						if (state->yPixelCount > 0)
 						{
-							s_vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f)*vCoordStep);
-							s_columnOut = &s_display[y0*s_width + x];
+							state->vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f)*vCoordStep);
+							state->columnOut = &s_display[y0*s_width + x];
 							texelU = floorFloat(uCoord - signU0);
-							s_texImage = &signTex->image[texelU << signTex->logSizeY];
+							state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-							s32 heightMask = s_texHeightMask;
-							s_texHeightMask = signTex->height - 1;
-							if (s_columnLight)
+							s32 heightMask = state->texHeightMask;
+							state->texHeightMask = signTex->height - 1;
+							if (state->columnLight)
 							{
-								signLit();
+								signLit(state);
 							}
 							else
 							{
-								signFullbright();
+								signFullbright(state);
 							}
-							s_texHeightMask = heightMask;
+							state->texHeightMask = heightMask;
 						}
 					}
 				}
@@ -1336,7 +1401,7 @@ namespace RClassic_Float
 		srcWall->seen = JTRUE;
 	}
 
-	void wall_drawTop(RWallSegmentFloat* wallSegment)
+	void wall_drawTop(RClassicFloatState* state, RWallSegmentFloat* wallSegment)
 	{
 		WallCached* cachedWall = wallSegment->srcWall;
 		SectorCached* cachedSector = cachedWall->sector;
@@ -1354,23 +1419,23 @@ namespace RClassic_Float
 		s32 x0 = wallSegment->wallX0;
 		s32 lengthInPixels = wallSegment->wallX1 - wallSegment->wallX0 + 1;
 
-		f32 ceilRel = cachedSector->ceilingHeight - s_rcfltState.eyeHeight;
-		f32 yC0 =((ceilRel*s_rcfltState.focalLenAspect)/z0) + s_rcfltState.projOffsetY;
-		f32 yC1 =((ceilRel*s_rcfltState.focalLenAspect)/z1) + s_rcfltState.projOffsetY;
+		f32 ceilRel = cachedSector->ceilingHeight - state->eyeHeight;
+		f32 yC0 =((ceilRel*state->focalLenAspect)/z0) + state->projOffsetY;
+		f32 yC1 =((ceilRel*state->focalLenAspect)/z1) + state->projOffsetY;
 
 		s32 yC0_pixel = roundFloat(yC0);
 		s32 yC1_pixel = roundFloat(yC1);
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 
 		if (yC0_pixel > s_windowMaxY_Pixels && yC1_pixel > s_windowMaxY_Pixels)
 		{
 			srcWall->visible = 0;
 			for (s32 i = 0; i < lengthInPixels; i++) { s_columnTop[x0 + i] = s_windowMaxY_Pixels; }
-			flat_addEdges(lengthInPixels, x0, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, lengthInPixels, x0, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
 			for (s32 i = 0, x = x0; i < lengthInPixels; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 			srcWall->seen = JTRUE;
@@ -1384,9 +1449,9 @@ namespace RClassic_Float
 		}
 		else
 		{
-			f32 floorRel = cachedSector->floorHeight - s_rcfltState.eyeHeight;
-			yF0 = (floorRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-			yF1 = (floorRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+			f32 floorRel = cachedSector->floorHeight - state->eyeHeight;
+			yF0 = (floorRel*state->focalLenAspect)/z0 + state->projOffsetY;
+			yF1 = (floorRel*state->focalLenAspect)/z1 + state->projOffsetY;
 		}
 
 		s32 yF0_pixel = roundFloat(yF0);
@@ -1395,19 +1460,19 @@ namespace RClassic_Float
 		{
 			srcWall->visible = 0;
 			for (s32 i = 0; i < lengthInPixels; i++) { s_columnBot[x0 + i] = s_windowMinY_Pixels; }
-			flat_addEdges(lengthInPixels, x0, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, lengthInPixels, x0, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
 			for (s32 i = 0, x = x0; i < lengthInPixels; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			srcWall->seen = JTRUE;
 			return;
 		}
 
-		f32 next_ceilRel = fixed16ToFloat(next->ceilingHeight) - s_rcfltState.eyeHeight;
-		f32 next_yC0 = (next_ceilRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-		f32 next_yC1 = (next_ceilRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+		f32 next_ceilRel = fixed16ToFloat(next->ceilingHeight) - state->eyeHeight;
+		f32 next_yC0 = (next_ceilRel*state->focalLenAspect)/z0 + state->projOffsetY;
+		f32 next_yC1 = (next_ceilRel*state->focalLenAspect)/z1 + state->projOffsetY;
 
 		f32 xOffset = f32(wallSegment->wallX0 - wallSegment->wallX0_raw);
 		f32 length  = f32(wallSegment->wallX1_raw - wallSegment->wallX0_raw);
@@ -1427,12 +1492,12 @@ namespace RClassic_Float
 			yF0 += (floor_dYdX * xOffset);
 		}
 
-		flat_addEdges(lengthInPixels, x0, floor_dYdX, yF0, ceil_dYdX, yC0);
+		flat_addEdges(state, lengthInPixels, x0, floor_dYdX, yF0, ceil_dYdX, yC0);
 		s32 next_yC0_pixel = roundFloat(next_yC0);
 		s32 next_yC1_pixel = roundFloat(next_yC1);
 		if ((next_yC0_pixel < s_windowMaxY_Pixels || next_yC1_pixel < s_windowMaxY_Pixels) && (sector->floorHeight > next->ceilingHeight))
 		{
-			wall_addAdjoinSegment(lengthInPixels, x0, floor_dYdX, yF0, next_ceil_dYdX, next_yC0, wallSegment);
+			wall_addAdjoinSegment(state, lengthInPixels, x0, floor_dYdX, yF0, next_ceil_dYdX, next_yC0, wallSegment);
 		}
 
 		if (next_yC0_pixel < s_windowMinY_Pixels && next_yC1_pixel < s_windowMinY_Pixels)
@@ -1447,7 +1512,7 @@ namespace RClassic_Float
 				}
 
 				s_columnBot[x] = yF0_pixel + 1;
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				yF0 += floor_dYdX;
 			}
 			srcWall->seen = JTRUE;
@@ -1481,17 +1546,17 @@ namespace RClassic_Float
 				next_yC0_pixel = bot;
 			}
 
-			s_yPixelCount = next_yC0_pixel - yC0_pixel + 1;
+			state->yPixelCount = next_yC0_pixel - yC0_pixel + 1;
 
 			f32 dxView;
-			f32 z = solveForZ(wallSegment, x, num, &dxView);
+			f32 z = solveForZ(state, wallSegment, x, num, &dxView);
 
 			f32 uScale = wallSegment->uScale;
 			f32 uCoord0 = wallSegment->uCoord0 + cachedWall->topOffset.x;
 			f32 uCoord = uCoord0 + ((wallSegment->orient == WORIENT_DZ_DX) ? dxView*uScale : (z - z0)*uScale);
 
-			s_rcfltState.depth1d[x] = z;
-			if (s_yPixelCount > 0)
+			state->depth1d[x] = z;
+			if (state->yPixelCount > 0)
 			{
 				s32 widthMask = texture->width - 1;
 				s32 texelU = floorFloat(uCoord) & widthMask;
@@ -1502,19 +1567,19 @@ namespace RClassic_Float
 				assert(texelU >= 0 && texelU <= widthMask);
 
 				f32 vCoordStep = (cachedWall->topTexelHeight) / (next_yC0 - yC0 + 1.0f);
-				s_vCoordFixed  = floatToFixed20(cachedWall->topOffset.z + (next_yC0 - f32(next_yC0_pixel) + 0.5f)*vCoordStep);
-				s_vCoordStep   = floatToFixed20(vCoordStep);
-				s_texImage = &texture->image[texelU << texture->logSizeY];
+				state->vCoordFixed  = floatToFixed20(cachedWall->topOffset.z + (next_yC0 - f32(next_yC0_pixel) + 0.5f)*vCoordStep);
+				state->vCoordStep   = floatToFixed20(vCoordStep);
+				state->texImage = &texture->image[texelU << texture->logSizeY];
 
-				s_columnOut = &s_display[yC0_pixel * s_width + x];
-				s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
-				if (s_columnLight)
+				state->columnOut = &s_display[yC0_pixel * s_width + x];
+				state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
+				if (state->columnLight)
 				{
-					drawColumn_Lit();
+					drawColumn_Lit(state);
 				}
 				else
 				{
-					drawColumn_Fullbright();
+					drawColumn_Fullbright(state);
 				}
 
 				// Handle the "sign texture" - a wall overlay.
@@ -1523,26 +1588,26 @@ namespace RClassic_Float
 					f32 signYBase = next_yC0 + (cachedWall->signOffset.z/vCoordStep);
 					s32 y0 = max(floorFloat(signYBase - (f32(signTex->height)/vCoordStep) + 1.5f), yC0_pixel);
 					s32 y1 = min(floorFloat(signYBase + 0.5f), next_yC0_pixel);
-					s_yPixelCount = y1 - y0 + 1;
+					state->yPixelCount = y1 - y0 + 1;
 
-					if (s_yPixelCount > 0)
+					if (state->yPixelCount > 0)
 					{
-						s_vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f)*vCoordStep);
-						s_columnOut = &s_display[y0*s_width + x];
+						state->vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f)*vCoordStep);
+						state->columnOut = &s_display[y0*s_width + x];
 						texelU = floorFloat(uCoord - signU0);
-						s_texImage = &signTex->image[texelU << signTex->logSizeY];
+						state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-						s32 heightMask = s_texHeightMask;
-						s_texHeightMask = signTex->height - 1;
-						if (s_columnLight)
+						s32 heightMask = state->texHeightMask;
+						state->texHeightMask = signTex->height - 1;
+						if (state->columnLight)
 						{
-							signLit();
+							signLit(state);
 						}
 						else
 						{
-							signFullbright();
+							signFullbright(state);
 						}
-						s_texHeightMask = heightMask;
+						state->texHeightMask = heightMask;
 					}
 				}
 			}
@@ -1555,7 +1620,7 @@ namespace RClassic_Float
 		srcWall->seen = JTRUE;
 	}
 
-	void wall_drawTopAndBottom(RWallSegmentFloat* wallSegment)
+	void wall_drawTopAndBottom(RClassicFloatState* state, RWallSegmentFloat* wallSegment)
 	{
 		WallCached* cachedWall = wallSegment->srcWall;
 		SectorCached* cachedSector = cachedWall->sector;
@@ -1571,9 +1636,9 @@ namespace RClassic_Float
 		s32 length  = wallSegment->wallX1 - wallSegment->wallX0 + 1;
 		f32 lengthRaw = f32(wallSegment->wallX1_raw - wallSegment->wallX0_raw);
 
-		f32 ceilRel = cachedSector->ceilingHeight - s_rcfltState.eyeHeight;
-		f32 cProj0 = (ceilRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-		f32 cProj1 = (ceilRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+		f32 ceilRel = cachedSector->ceilingHeight - state->eyeHeight;
+		f32 cProj0 = (ceilRel*state->focalLenAspect)/z0 + state->projOffsetY;
+		f32 cProj1 = (ceilRel*state->focalLenAspect)/z1 + state->projOffsetY;
 
 		s32 c0_pixel = roundFloat(cProj0);
 		s32 c1_pixel = roundFloat(cProj1);
@@ -1583,20 +1648,20 @@ namespace RClassic_Float
 			srcWall->visible = 0;
 			for (s32 i = 0; i < length; i++) { s_columnTop[x0 + i] = s_windowMaxY_Pixels; }
 
-			flat_addEdges(length, x0, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
+			flat_addEdges(state, length, x0, 0, f32(s_windowMaxY_Pixels + 1), 0, f32(s_windowMaxY_Pixels + 1));
 			f32 num = solveForZ_Numerator(wallSegment);
 			for (s32 i = 0, x = x0; i < length; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnTop[x] = s_windowMaxY_Pixels;
 			}
 			srcWall->seen = JTRUE;
 			return;
 		}
 
-		f32 floorRel = cachedSector->floorHeight - s_rcfltState.eyeHeight;
-		f32 fProj0 = (floorRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-		f32 fProj1 = (floorRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+		f32 floorRel = cachedSector->floorHeight - state->eyeHeight;
+		f32 fProj0 = (floorRel*state->focalLenAspect)/z0 + state->projOffsetY;
+		f32 fProj1 = (floorRel*state->focalLenAspect)/z1 + state->projOffsetY;
 
 		s32 f0_pixel = roundFloat(fProj0);
 		s32 f1_pixel = roundFloat(fProj1);
@@ -1605,12 +1670,12 @@ namespace RClassic_Float
 			srcWall->visible = 0;
 			for (s32 i = 0; i < length; i++) { s_columnBot[x0 + i] = s_windowMinY_Pixels; }
 
-			flat_addEdges(length, x0, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
+			flat_addEdges(state, length, x0, 0, f32(s_windowMinY_Pixels - 1), 0, f32(s_windowMinY_Pixels - 1));
 			f32 num = solveForZ_Numerator(wallSegment);
 
 			for (s32 i = 0, x = x0; i < length; i++, x++)
 			{
-				s_rcfltState.depth1d[x] = solveForZ(wallSegment, x, num);
+				state->depth1d[x] = solveForZ(state, wallSegment, x, num);
 				s_columnBot[x] = s_windowMinY_Pixels;
 			}
 			srcWall->seen = JTRUE;
@@ -1618,9 +1683,9 @@ namespace RClassic_Float
 		}
 
 		RSector* nextSector = srcWall->nextSector;
-		f32 next_ceilRel = fixed16ToFloat(nextSector->ceilingHeight) - s_rcfltState.eyeHeight;
-		f32 next_cProj0 = (next_ceilRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-		f32 next_cProj1 = (next_ceilRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+		f32 next_ceilRel = fixed16ToFloat(nextSector->ceilingHeight) - state->eyeHeight;
+		f32 next_cProj0 = (next_ceilRel*state->focalLenAspect)/z0 + state->projOffsetY;
+		f32 next_cProj1 = (next_ceilRel*state->focalLenAspect)/z1 + state->projOffsetY;
 
 		f32 ceil_dYdX = 0;
 		f32 next_ceil_dYdX = 0;
@@ -1644,7 +1709,7 @@ namespace RClassic_Float
 		{
 			f32 u0 = wallSegment->uCoord0;
 			f32 num = solveForZ_Numerator(wallSegment);
-			s_texHeightMask = topTex->height - 1;
+			state->texHeightMask = topTex->height - 1;
 			JBool flipHorz = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 
 			for (s32 i = 0, x = x0; i < length; i++, x++)
@@ -1662,11 +1727,11 @@ namespace RClassic_Float
 				{
 					yC1_pixel = bot;
 				}
-				s_yPixelCount = yC1_pixel - yC0_pixel + 1;
+				state->yPixelCount = yC1_pixel - yC0_pixel + 1;
 
 				// Calculate perspective correct Z and U (texture coordinate).
 				f32 dxView;
-				f32 z = solveForZ(wallSegment, x, num, &dxView);
+				f32 z = solveForZ(state, wallSegment, x, num, &dxView);
 				f32 u;
 				if (wallSegment->orient == WORIENT_DZ_DX)
 				{
@@ -1677,8 +1742,8 @@ namespace RClassic_Float
 					f32 dz = z - z0;
 					u = u0 + (dz*wallSegment->uScale) + cachedWall->topOffset.x;
 				}
-				s_rcfltState.depth1d[x] = z;
-				if (s_yPixelCount > 0)
+				state->depth1d[x] = z;
+				if (state->yPixelCount > 0)
 				{
 					s32 widthMask = topTex->width - 1;
 					s32 texelU = floorFloat(u) & widthMask;
@@ -1688,20 +1753,20 @@ namespace RClassic_Float
 					}
 					f32 vCoordStep = cachedWall->topTexelHeight / (yC1 - yC0 + 1.0f);
 					f32 yOffset = yC1 - f32(yC1_pixel) + 0.5f;
-					s_vCoordFixed = floatToFixed20(yOffset*vCoordStep + cachedWall->topOffset.z);
-					s_vCoordStep  = floatToFixed20(vCoordStep);
+					state->vCoordFixed = floatToFixed20(yOffset*vCoordStep + cachedWall->topOffset.z);
+					state->vCoordStep  = floatToFixed20(vCoordStep);
 
-					s_texImage = &topTex->image[texelU << topTex->logSizeY];
-					s_columnOut = &s_display[yC0_pixel * s_width + x];
-					s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+					state->texImage = &topTex->image[texelU << topTex->logSizeY];
+					state->columnOut = &s_display[yC0_pixel * s_width + x];
+					state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 
-					if (s_columnLight)
+					if (state->columnLight)
 					{
-						drawColumn_Lit();
+						drawColumn_Lit(state);
 					}
 					else
 					{
-						drawColumn_Fullbright();
+						drawColumn_Fullbright(state);
 					}
 				}
 				yC0 += ceil_dYdX;
@@ -1713,9 +1778,9 @@ namespace RClassic_Float
 			for (s32 i = 0; i < length; i++) { s_columnTop[x0 + i] = s_windowMinY_Pixels - 1; }
 		}
 
-		f32 next_floorRel = fixed16ToFloat(nextSector->floorHeight) - s_rcfltState.eyeHeight;
-		f32 next_fProj0 = (next_floorRel*s_rcfltState.focalLenAspect)/z0 + s_rcfltState.projOffsetY;
-		f32 next_fProj1 = (next_floorRel*s_rcfltState.focalLenAspect)/z1 + s_rcfltState.projOffsetY;
+		f32 next_floorRel = fixed16ToFloat(nextSector->floorHeight) - state->eyeHeight;
+		f32 next_fProj0 = (next_floorRel*state->focalLenAspect)/z0 + state->projOffsetY;
+		f32 next_fProj1 = (next_floorRel*state->focalLenAspect)/z1 + state->projOffsetY;
 
 		f32 next_floor_dYdX = 0;
 		f32 floor_dYdX = 0;
@@ -1741,7 +1806,7 @@ namespace RClassic_Float
 			f32 u0 = wallSegment->uCoord0;
 			f32 num = solveForZ_Numerator(wallSegment);
 
-			s_texHeightMask = botTex->height - 1;
+			state->texHeightMask = botTex->height - 1;
 			JBool flipHorz  = ((srcWall->flags1 & WF1_FLIP_HORIZ)!=0) ? JTRUE : JFALSE;
 			JBool illumSign = ((srcWall->flags1 & WF1_ILLUM_SIGN)!=0) ? JTRUE : JFALSE;
 
@@ -1766,11 +1831,11 @@ namespace RClassic_Float
 					{
 						yF1_pixel = bot;
 					}
-					s_yPixelCount = yF1_pixel - yF0_pixel + 1;
+					state->yPixelCount = yF1_pixel - yF0_pixel + 1;
 
 					// Calculate perspective correct Z and U (texture coordinate).
 					f32 dxView;
-					f32 z = solveForZ(wallSegment, x, num, &dxView);
+					f32 z = solveForZ(state, wallSegment, x, num, &dxView);
 					f32 uCoord;
 					if (wallSegment->orient == WORIENT_DZ_DX)
 					{
@@ -1781,8 +1846,8 @@ namespace RClassic_Float
 						f32 dz = z - z0;
 						uCoord = u0 + (dz*wallSegment->uScale) + cachedWall->botOffset.x;
 					}
-					s_rcfltState.depth1d[x] = z;
-					if (s_yPixelCount > 0)
+					state->depth1d[x] = z;
+					if (state->yPixelCount > 0)
 					{
 						s32 widthMask = botTex->width - 1;
 						s32 texelU = floorFloat(uCoord) & widthMask;
@@ -1791,20 +1856,20 @@ namespace RClassic_Float
 							texelU = widthMask - texelU;
 						}
 						f32 vCoordStep = (cachedWall->botTexelHeight) / (yF1 - yF0 + 1.0f);
-						s_vCoordFixed  = floatToFixed20(cachedWall->botOffset.z + (yF1 - f32(yF1_pixel) + 0.5f)*vCoordStep);
-						s_vCoordStep   = floatToFixed20(vCoordStep);
+						state->vCoordFixed  = floatToFixed20(cachedWall->botOffset.z + (yF1 - f32(yF1_pixel) + 0.5f)*vCoordStep);
+						state->vCoordStep   = floatToFixed20(vCoordStep);
 
-						s_texImage = &botTex->image[texelU << botTex->logSizeY];
-						s_columnOut = &s_display[yF0_pixel * s_width + x];
-						s_columnLight = computeLighting(z, floor16(srcWall->wallLight));
+						state->texImage = &botTex->image[texelU << botTex->logSizeY];
+						state->columnOut = &s_display[yF0_pixel * s_width + x];
+						state->columnLight = computeLighting(z, floor16(srcWall->wallLight));
 
-						if (s_columnLight)
+						if (state->columnLight)
 						{
-							drawColumn_Lit();
+							drawColumn_Lit(state);
 						}
 						else
 						{
-							drawColumn_Fullbright();
+							drawColumn_Fullbright(state);
 						}
 
 						// Handle the "sign texture" - a wall overlay.
@@ -1813,26 +1878,26 @@ namespace RClassic_Float
 							f32 signYBase = yF1 + (cachedWall->signOffset.z/vCoordStep);
 							s32 y0 = max(floorFloat(signYBase - (f32(signTex->height)/vCoordStep) + 1.5f), yF0_pixel);
 							s32 y1 = min(floorFloat(signYBase + 0.5f), yF1_pixel);
-							s_yPixelCount = y1 - y0 + 1;
+							state->yPixelCount = y1 - y0 + 1;
 
-							if (s_yPixelCount > 0)
+							if (state->yPixelCount > 0)
 							{
-								s_vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f)*vCoordStep);
-								s_columnOut = &s_display[y0*s_width + x];
+								state->vCoordFixed = floatToFixed20((signYBase - f32(y1) + 0.5f)*vCoordStep);
+								state->columnOut = &s_display[y0*s_width + x];
 								texelU = floorFloat(uCoord - signU0);
-								s_texImage = &signTex->image[texelU << signTex->logSizeY];
+								state->texImage = &signTex->image[texelU << signTex->logSizeY];
 
-								s32 heightMask = s_texHeightMask;
-								s_texHeightMask = signTex->height - 1;
-								if (s_columnLight)
+								s32 heightMask = state->texHeightMask;
+								state->texHeightMask = signTex->height - 1;
+								if (state->columnLight)
 								{
-									signLit();
+									signLit(state);
 								}
 								else
 								{
-									signFullbright();
+									signFullbright(state);
 								}
-								s_texHeightMask = heightMask;
+								state->texHeightMask = heightMask;
 							}
 						}
 					}
@@ -1845,7 +1910,7 @@ namespace RClassic_Float
 		{
 			for (s32 i = 0; i < length; i++) { s_columnBot[x0 + i] = s_windowMaxY_Pixels + 1; }
 		}
-		flat_addEdges(length, x0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
+		flat_addEdges(state, length, x0, floor_dYdX, fProj0, ceil_dYdX, cProj0);
 
 		s32 next_f0_pixel = roundFloat(next_fProj0);
 		s32 next_f1_pixel = roundFloat(next_fProj1);
@@ -1857,13 +1922,13 @@ namespace RClassic_Float
 			return;
 		}
 
-		wall_addAdjoinSegment(length, x0, next_floor_dYdX, next_fProj0 - 1.0f, next_ceil_dYdX, next_cProj0 + 1.0f, wallSegment);
+		wall_addAdjoinSegment(state, length, x0, next_floor_dYdX, next_fProj0 - 1.0f, next_ceil_dYdX, next_cProj0 + 1.0f, wallSegment);
 		srcWall->seen = JTRUE;
 	}
 
 	// Parts of the code inside 's_height == SKY_BASE_HEIGHT' are based on the original DOS exe.
 	// Other parts of those same conditionals are modified to handle higher resolutions.
-	void wall_drawSkyTop(RSector* sector)
+	void wall_drawSkyTop(RClassicFloatState* state, RSector* sector)
 	{
 		if (s_wallMaxCeilY < s_windowMinY_Pixels) { return; }
 		TFE_ZONE("Draw Sky");
@@ -1885,9 +1950,9 @@ namespace RClassic_Float
 			vCoordStep = f32(SKY_BASE_HEIGHT) / f32(s_height);
 			heightScale = vCoordStep;
 		}
-		s_vCoordStep = floatToFixed20(vCoordStep);
+		state->vCoordStep = floatToFixed20(vCoordStep);
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		const s32 texWidthMask = texture->width - 1;
 
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
@@ -1895,27 +1960,27 @@ namespace RClassic_Float
 			const s32 y0 = s_windowTop[x];
 			const s32 y1 = min(s_columnTop[x], s_windowBot[x]);
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask - y1) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask - y1) - state->skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
 				}
 				else
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask) - (f32(y1)*heightScale) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask) - (f32(y1)*heightScale) - state->skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
 				}
 
-				s32 texelU = (floorFloat(fixed16ToFloat(sector->ceilOffset.x) - s_rcfltState.skyYawOffset + s_rcfltState.skyTable[x]) ) & texWidthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
-				drawColumn_Fullbright();
+				s32 texelU = (floorFloat(fixed16ToFloat(sector->ceilOffset.x) - state->skyYawOffset + state->skyTable[x]) ) & texWidthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 
-	void wall_drawSkyTopNoWall(RSector* sector)
+	void wall_drawSkyTopNoWall(RClassicFloatState* state, RSector* sector)
 	{
 		TFE_ZONE("Draw Sky");
 		const TextureData* texture = sector->ceilTex ? *sector->ceilTex : nullptr;
@@ -1935,39 +2000,39 @@ namespace RClassic_Float
 			vCoordStep  = f32(SKY_BASE_HEIGHT) / f32(s_height);
 			heightScale = vCoordStep;
 		}
-		s_vCoordStep = floatToFixed20(vCoordStep);
+		state->vCoordStep = floatToFixed20(vCoordStep);
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
 		{
 			const s32 y0 = s_windowTop[x];
 			const s32 y1 = min(s_screenYMidFlt - 1, s_windowBot[x]);
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask - y1) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask - y1) - state->skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
 				}
 				else
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask) - (f32(y1)*heightScale) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask) - (f32(y1)*heightScale) - state->skyPitchOffset - fixed16ToFloat(sector->ceilOffset.z));
 				}
 
 				s32 widthMask = texture->width - 1;
-				s32 texelU = floorFloat(fixed16ToFloat(sector->ceilOffset.x) - s_rcfltState.skyYawOffset + s_rcfltState.skyTable[x]) & widthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
+				s32 texelU = floorFloat(fixed16ToFloat(sector->ceilOffset.x) - state->skyYawOffset + state->skyTable[x]) & widthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
 
-				drawColumn_Fullbright();
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 
 	// Parts of the code inside 's_height == SKY_BASE_HEIGHT' are based on the original DOS exe.
 	// Other parts of those same conditionals are modified to handle higher resolutions.
-	void wall_drawSkyBottom(RSector* sector)
+	void wall_drawSkyBottom(RClassicFloatState* state, RSector* sector)
 	{
 		if (s_wallMinFloorY > s_windowMaxY_Pixels) { return; }
 		TFE_ZONE("Draw Sky");
@@ -1989,9 +2054,9 @@ namespace RClassic_Float
 			vCoordStep  = f32(SKY_BASE_HEIGHT) / f32(s_height);
 			heightScale = vCoordStep;
 		}
-		s_vCoordStep = floatToFixed20(vCoordStep);
+		state->vCoordStep = floatToFixed20(vCoordStep);
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		const s32 texWidthMask = texture->width - 1;
 
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
@@ -1999,27 +2064,27 @@ namespace RClassic_Float
 			const s32 y0 = max(s_columnBot[x], s_windowTop[x]);
 			const s32 y1 = s_windowBot[x];
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask - y1) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask - y1) - state->skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
 				}
 				else
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask) - (f32(y1)*heightScale) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask) - (f32(y1)*heightScale) - state->skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
 				}
 
-				s32 texelU = floorFloat(fixed16ToFloat(sector->floorOffset.x) - s_rcfltState.skyYawOffset + s_rcfltState.skyTable[x]) & texWidthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
-				drawColumn_Fullbright();
+				s32 texelU = floorFloat(fixed16ToFloat(sector->floorOffset.x) - state->skyYawOffset + state->skyTable[x]) & texWidthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 
-	void wall_drawSkyBottomNoWall(RSector* sector)
+	void wall_drawSkyBottomNoWall(RClassicFloatState* state, RSector* sector)
 	{
 		TFE_ZONE("Draw Sky");
 		const TextureData* texture = sector->floorTex ? *sector->floorTex : nullptr;
@@ -2039,46 +2104,46 @@ namespace RClassic_Float
 			vCoordStep  = f32(SKY_BASE_HEIGHT) / f32(s_height);
 			heightScale = vCoordStep;
 		}
-		s_vCoordStep = floatToFixed20(vCoordStep);
+		state->vCoordStep = floatToFixed20(vCoordStep);
 
-		s_texHeightMask = texture->height - 1;
+		state->texHeightMask = texture->height - 1;
 		for (s32 x = s_windowMinX_Pixels; x <= s_windowMaxX_Pixels; x++)
 		{
 			const s32 y0 = max(s_screenYMidFlt, s_windowTop[x]);
 			const s32 y1 = s_windowBot[x];
 
-			s_yPixelCount = y1 - y0 + 1;
-			if (s_yPixelCount > 0)
+			state->yPixelCount = y1 - y0 + 1;
+			if (state->yPixelCount > 0)
 			{
 				if (s_height == SKY_BASE_HEIGHT)
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask - y1) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask - y1) - state->skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
 				}
 				else
 				{
-					s_vCoordFixed = floatToFixed20(f32(s_texHeightMask) - (f32(y1)*heightScale) - s_rcfltState.skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
+					state->vCoordFixed = floatToFixed20(f32(state->texHeightMask) - (f32(y1)*heightScale) - state->skyPitchOffset - fixed16ToFloat(sector->floorOffset.z));
 				}
 
 				s32 widthMask = texture->width - 1;
-				s32 texelU = floorFloat(fixed16ToFloat(sector->floorOffset.x) - s_rcfltState.skyYawOffset + s_rcfltState.skyTable[x]) & widthMask;
-				s_texImage = &texture->image[texelU << texture->logSizeY];
-				s_columnOut = &s_display[y0*s_width + x];
+				s32 texelU = floorFloat(fixed16ToFloat(sector->floorOffset.x) - state->skyYawOffset + state->skyTable[x]) & widthMask;
+				state->texImage = &texture->image[texelU << texture->logSizeY];
+				state->columnOut = &s_display[y0*s_width + x];
 
-				drawColumn_Fullbright();
+				drawColumn_Fullbright(state);
 			}
 		}
 	}
 	
 	// Determines if segment A is disjoint from the line formed by B - i.e. they do not intersect.
 	// Returns 1 if segment A does NOT cross line B or 0 if it does.
-	s32 segmentCrossesLine(f32 ax0, f32 ay0, f32 ax1, f32 ay1, f32 bx0, f32 by0, f32 bx1, f32 by1)
+	s32 segmentCrossesLine(RClassicFloatState* state, f32 ax0, f32 ay0, f32 ax1, f32 ay1, f32 bx0, f32 by0, f32 bx1, f32 by1)
 	{
 		// [ (a1-b0)x(b1-b0) ].[ (a0-b0)x(b1 - b0) ]
 		// In 2D x = "perp product"
-		s_segmentCross = ((ax1 - bx0)*(by1 - by0) - (ay1 - by0)*(bx1 - bx0)) *
+		state->segmentCross = ((ax1 - bx0)*(by1 - by0) - (ay1 - by0)*(bx1 - bx0)) *
                          ((ax0 - bx0)*(by1 - by0) - (ay0 - by0)*(bx1 - bx0));
 
-		return s_segmentCross > 0.0f ? 1 : 0;
+		return state->segmentCross > 0.0f ? 1 : 0;
 	}
 		
 	// When solving for Z, part of the computation can be done once per wall.
@@ -2100,7 +2165,7 @@ namespace RClassic_Float
 	}
 	
 	// Solve for perspective correct Z at the current x pixel coordinate.
-	f32 solveForZ(RWallSegmentFloat* wallSegment, s32 x, f32 numerator, f32* outViewDx/*=nullptr*/)
+	f32 solveForZ(RClassicFloatState* state, RWallSegmentFloat* wallSegment, s32 x, f32 numerator, f32* outViewDx/*=nullptr*/)
 	{
 		f32 z;	// perspective correct z coordinate at the current x pixel coordinate.
 		if (wallSegment->orient == WORIENT_DZ_DX)
@@ -2109,7 +2174,7 @@ namespace RClassic_Float
 			const f32 fx = f32(x);
 			// Scale halfWidthOverX by focal length to account for widescreen.
 			// Note in the original code s_focalLength == s_halfWidth, so in that case the code is functionally equivalent.
-			const f32 halfWidthOverX = ((fx != s_rcfltState.halfWidth) ? s_rcfltState.focalLength / (fx - s_rcfltState.halfWidth) : s_rcfltState.focalLength);
+			const f32 halfWidthOverX = ((fx != state->halfWidth) ? state->focalLength / (fx - state->halfWidth) : state->focalLength);
 			f32 den = halfWidthOverX - wallSegment->slope;
 			// Avoid divide by zero.
 			if (den == 0.0f) { den = 1.0f; }
@@ -2129,7 +2194,7 @@ namespace RClassic_Float
 			// Directly solve for Z at the current pixel x coordinate.
 			// Scale xOverHalfWidth by focal length to account for widescreen.
 			// Note in the original code s_focalLength == s_halfWidth, so in that case the code is functionally equivalent.
-			const f32 xOverHalfWidth = (f32(x) - s_rcfltState.halfWidth) / s_rcfltState.focalLength;
+			const f32 xOverHalfWidth = (f32(x) - state->halfWidth) / state->focalLength;
 			f32 den = xOverHalfWidth - wallSegment->slope;
 			// Avoid divide by 0.
 			if (den == 0.0f) { den = 1.0f; }
@@ -2140,67 +2205,141 @@ namespace RClassic_Float
 		return z;
 	}
 
-	void drawColumn_Fullbright()
+	// Draw using the SIMD column kernel if there is one for this CPU, otherwise the scalar code below is used.
+	bool drawColumnStrip_Simd(const StripDraw* draw, ColumnKernelId id)
+	{
+		const ColumnKernel kernel = column_getKernel(id);
+		if (!kernel || !column_supportsMask(draw->texMask, FRAC_BITS_20)) { return false; }
+
+		kernel(draw->out, s_width, draw->count, draw->tex, draw->colorMap, u32(draw->v), u32(draw->dV), FRAC_BITS_20, draw->texMask);
+		return true;
+	}
+
+	// Column kernels, these only use the StripDraw so they can run on any render thread.
+	void drawColumnStrip_Fullbright(const StripDraw* draw)
 	{
-		fixed44_20 vCoordFixed = s_vCoordFixed;
-		const u8* tex = s_texImage;
-		const s32 end = s_yPixelCount - 1;
+		if (drawColumnStrip_Simd(draw, COLKERNEL_FULLBRIGHT)) { return; }
+
+		fixed44_20 vCoordFixed = draw->v;
+		const fixed44_20 vCoordStep = draw->dV;
+		const u8* tex = draw->tex;
+		const s32 texHeightMask = draw->texMask;
+		u8* columnOut = draw->out;
+		const s32 end = draw->count - 1;
 
 		s32 offset = end * s_width;
-		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += s_vCoordStep)
+		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += vCoordStep)
 		{
-			const s32 v = floor20(vCoordFixed) & s_texHeightMask;
-			s_columnOut[offset] = tex[v];
+			const s32 v = floor20(vCoordFixed) & texHeightMask;
+			columnOut[offset] = tex[v];
 		}
 	}
 
-	void drawColumn_Lit()
+	void drawColumnStrip_Lit(const StripDraw* draw)
 	{
-		fixed44_20 vCoordFixed = s_vCoordFixed;
-		const u8* tex = s_texImage;
-		const s32 end = s_yPixelCount - 1;
+		if (drawColumnStrip_Simd(draw, COLKERNEL_LIT)) { return; }
+
+		fixed44_20 vCoordFixed = draw->v;
+		const fixed44_20 vCoordStep = draw->dV;
+		const u8* tex = draw->tex;
+		const u8* columnLight = draw->colorMap;
+		const s32 texHeightMask = draw->texMask;
+		u8* columnOut = draw->out;
+		const s32 end = draw->count - 1;
 
 		s32 offset = end * s_width;
-		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += s_vCoordStep)
+		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += vCoordStep)
 		{
-			const s32 v = floor20(vCoordFixed) & s_texHeightMask;
-			s_columnOut[offset] = s_columnLight[tex[v]];
+			const s32 v = floor20(vCoordFixed) & texHeightMask;
+			columnOut[offset] = columnLight[tex[v]];
 		}
 	}
 
-	void drawColumn_Fullbright_Trans()
+	void drawColumnStrip_Fullbright_Trans(const StripDraw* draw)
 	{
-		fixed44_20 vCoordFixed = s_vCoordFixed;
-		const u8* tex = s_texImage;
-		const s32 end = s_yPixelCount - 1;
+		if (drawColumnStrip_Simd(draw, COLKERNEL_FULLBRIGHT_TRANS)) { return; }
+
+		fixed44_20 vCoordFixed = draw->v;
+		const fixed44_20 vCoordStep = draw->dV;
+		const u8* tex = draw->tex;
+		const s32 texHeightMask = draw->texMask;
+		u8* columnOut = draw->out;
+		const s32 end = draw->count - 1;
 
 		s32 offset = end * s_width;
-		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += s_vCoordStep)
+		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += vCoordStep)
 		{
-			const s32 v = floor20(vCoordFixed) & s_texHeightMask;
+			const s32 v = floor20(vCoordFixed) & texHeightMask;
 			const u8 c = tex[v];
-			if (c) { s_columnOut[offset] = c; }
+			if (c) { columnOut[offset] = c; }
 		}
 	}
 
-	void drawColumn_Lit_Trans()
+	void drawColumnStrip_Lit_Trans(const StripDraw* draw)
 	{
-		fixed44_20 vCoordFixed = s_vCoordFixed;
-		const u8* tex = s_texImage;
-		const s32 end = s_yPixelCount - 1;
+		if (drawColumnStrip_Simd(draw, COLKERNEL_LIT_TRANS)) { return; }
+
+		fixed44_20 vCoordFixed = draw->v;
+		const fixed44_20 vCoordStep = draw->dV;
+		const u8* tex = draw->tex;
+		const u8* columnLight = draw->colorMap;
+		const s32 texHeightMask = draw->texMask;
+		u8* columnOut = draw->out;
+		const s32 end = draw->count - 1;
 
 		s32 offset = end * s_width;
-		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += s_vCoordStep)
+		for (s32 i = end; i >= 0; i--, offset -= s_width, vCoordFixed += vCoordStep)
 		{
-			const s32 v = floor20(vCoordFixed) & s_texHeightMask;
+			const s32 v = floor20(vCoordFixed) & texHeightMask;
 			const u8 c = tex[v];
-			if (c) { s_columnOut[offset] = s_columnLight[c]; }
+			if (c) { columnOut[offset] = columnLight[c]; }
 		}
 	}
 
-	void wall_addAdjoinSegment(s32 length, s32 x0, f32 top_dydx, f32 y1, f32 bot_dydx, f32 y0, RWallSegmentFloat* wallSegment)
+	// Capture the current column state and draw it or record it for the render threads.
+	void drawColumn(RClassicFloatState* state, StripDrawFunc func)
+	{
+		StripDraw draw = {};
+		draw.func = func;
+		draw.type = STRIP_COLUMN;
+		draw.out = state->columnOut;
+		draw.x = s32((state->columnOut - s_display) % s_width);
+		draw.count = state->yPixelCount;
+		draw.tex = state->texImage;
+		draw.texMask = state->texHeightMask;
+		draw.colorMap = state->columnLight;
+		draw.v = state->vCoordFixed;
+		draw.dV = state->vCoordStep;
+		strip_draw(&draw);
+	}
+
+	void drawColumn_Fullbright(RClassicFloatState* state)
+	{
+		drawColumn(state, drawColumnStrip_Fullbright);
+	}
+
+	void drawColumn_Lit(RClassicFloatState* state)
 	{
-		if (s_adjoinSegCount < s_maxAdjoinSegCount)
+		drawColumn(state, drawColumnStrip_Lit);
+	}
+
+	void drawColumn_Fullbright_Trans(RClassicFloatState* state)
+	{
+		drawColumn(state, drawColumnStrip_Fullbright_Trans);
+	}
+
+	void drawColumn_Lit_Trans(RClassicFloatState* state)
+	{
+		drawColumn(state, drawColumnStrip_Lit_Trans);
+	}
+
+	void wall_addAdjoinSegment(RClassicFloatState* state, s32 length, s32 x0, f32 top_dydx, f32 y1, f32 bot_dydx, f32 y0, RWallSegmentFloat* wallSegment)
+	{
+		if (s_adjoinSegCount >= state->adjoinSegLimit)
+		{
+			state->adjoinSegLimitHit = JTRUE;
+		}
+		else
 		{
 			f32 lengthFlt = f32(length - 1);
 			f32 y0End = y0;
@@ -2213,18 +2352,18 @@ namespace RClassic_Float
 			{
 				y1End += (top_dydx * lengthFlt);
 			}
-			edgePair_setup(length, x0, top_dydx, y1End, y1, bot_dydx, y0, y0End, s_rcfltState.adjoinEdge);
+			edgePair_setup(length, x0, top_dydx, y1End, y1, bot_dydx, y0, y0End, state->adjoinEdge);
 
-			s_rcfltState.adjoinEdge++;
+			state->adjoinEdge++;
 			s_adjoinSegCount++;
 
-			*s_rcfltState.adjoinSegment = wallSegment;
-			s_rcfltState.adjoinSegment++;
+			*state->adjoinSegment = wallSegment;
+			state->adjoinSegment++;
 		}
 	}
 
 	// Refactor this into a sprite specific file.
-	void sprite_drawFrame(u8* basePtr, WaxFrame* frame, SecObject* obj, vec3_float* cachedPosVS)
+	void sprite_drawFrame(RClassicFloatState* state, u8* basePtr, WaxFrame* frame, SecObject* obj, vec3_float* cachedPosVS)
 	{
 		if (!frame) { return; }
 
@@ -2245,8 +2384,8 @@ namespace RClassic_Float
 		const f32 y0 = cachedPosVS->y - yOffset;
 
 		const f32 rcpZ = 1.0f/z;
-		const f32 projX0 = x0*s_rcfltState.focalLength   *rcpZ + s_rcfltState.projOffsetX;
-		const f32 projY0 = y0*s_rcfltState.focalLenAspect*rcpZ + s_rcfltState.projOffsetY;
+		const f32 projX0 = x0*state->focalLength   *rcpZ + state->projOffsetX;
+		const f32 projY0 = y0*state->focalLenAspect*rcpZ + state->projOffsetY;
 
 		s32 x0_pixel = roundFloat(projX0);
 		s32 y0_pixel = roundFloat(projY0);
@@ -2257,8 +2396,8 @@ namespace RClassic_Float
 
 		const f32 x1 = x0 + widthWS;
 		const f32 y1 = y0 + heightWS;
-		const f32 projX1 = x1*s_rcfltState.focalLength   *rcpZ + s_rcfltState.projOffsetX;
-		const f32 projY1 = y1*s_rcfltState.focalLenAspect*rcpZ + s_rcfltState.projOffsetY;
+		const f32 projX1 = x1*state->focalLength   *rcpZ + state->projOffsetX;
+		const f32 projY1 = y1*state->focalLenAspect*rcpZ + state->projOffsetY;
 
 		s32 x1_pixel = roundFloat(projX1);
 		s32 y1_pixel = roundFloat(projY1);
@@ -2277,7 +2416,7 @@ namespace RClassic_Float
 		const f32 width  = projX1 - projX0 + 1.0f;
 		const f32 uCoordStep = f32(cell->sizeX) / width;
 		const f32 vCoordStep = f32(cell->sizeY) / height;
-		s_vCoordStep = floatToFixed20(vCoordStep);
+		state->vCoordStep = floatToFixed20(vCoordStep);
 
 		f32 uCoord = 0.0f;
 		if (x0_pixel < s_windowX0)
@@ -2291,11 +2430,11 @@ namespace RClassic_Float
 		}
 
 		// Compute the lighting for the whole sprite.
-		s_columnLight = computeLighting(z, 0);
+		state->columnLight = computeLighting(z, 0);
 
 		// Figure out the correct column function.
 		ColumnFunction spriteColumnFunc;
-		if (s_columnLight && !(obj->flags & OBJ_FLAG_FULLBRIGHT) && !s_flatLighting)
+		if (state->columnLight && !(obj->flags & OBJ_FLAG_FULLBRIGHT) && !s_flatLighting)
 		{
 			spriteColumnFunc = s_columnFunc[COLFUNC_LIT_TRANS];
 		}
@@ -2327,12 +2466,15 @@ namespace RClassic_Float
 		}
 
 		// This should be set to handle all sizes, repeating is not required.
-		s_texHeightMask = 0xffff;
+		state->texHeightMask = 0xffff;
+
+		// Compressed cells that are drawn often are decompressed once and then drawn from the sprite cache.
+		const u8* cellImage = compressed ? spriteCache_getCell(cell, basePtr) : nullptr;
 
 		const u32* columnOffset = (u32*)(basePtr + cell->columnOffset);
 		for (s32 x = x0_pixel; x <= x1_pixel; x++, uCoord += uCoordStep)
 		{
-			if (z < s_rcfltState.depth1d[x])
+			if (z < state->depth1d[x])
 			{
 				s32 y0 = y0_pixel;
 				s32 y1 = y1_pixel;
@@ -2348,11 +2490,11 @@ namespace RClassic_Float
 					y1 = bot;
 				}
 
-				s_yPixelCount = y1 - y0 + 1;
-				if (s_yPixelCount > 0)
+				state->yPixelCount = y1 - y0 + 1;
+				if (state->yPixelCount > 0)
 				{
 					const f32 vOffset = f32(y1_pixel - y1);
-					s_vCoordFixed = floatToFixed20(vOffset*vCoordStep);
+					state->vCoordFixed = floatToFixed20(vOffset*vCoordStep);
 
 					s32 texelU = min(cell->sizeX-1, floorFloat(uCoord));
 					if (flip)
@@ -2360,24 +2502,31 @@ namespace RClassic_Float
 						texelU = cell->sizeX - texelU - 1;
 					}
 
-					if (compressed)
+					if (cellImage)
+					{
+						state->texImage = (u8*)cellImage + texelU * cell->sizeY;
+					}
+					else if (compressed)
 					{
 						const u8* colPtr = (u8*)cell + columnOffset[texelU];
 
 						// Decompress the column into "work buffer."
+						// When recording for the render threads, the column has to stay valid until the end of the frame.
 						assert(cell->sizeY <= 1024 && texelU >= 0 && texelU < cell->sizeX);
-						sprite_decompressColumn(colPtr, s_workBuffer, cell->sizeY);
-						s_texImage = (u8*)s_workBuffer;
+						u8* columnBuffer = strip_isRecording() ? strip_allocFrameMemory(cell->sizeY) : nullptr;
+						if (!columnBuffer) { columnBuffer = state->workBuffer; }
+						sprite_decompressColumn(colPtr, columnBuffer, cell->sizeY);
+						state->texImage = columnBuffer;
 					}
 					else
 					{
-						s_texImage = (u8*)image + columnOffset[texelU];
+						state->texImage = (u8*)image + columnOffset[texelU];
 					}
 					// Output.
-					s_columnOut = &s_display[y0 * s_width + x];
+					state->columnOut = &s_display[y0 * s_width + x];
 					// Draw the column.
-					spriteColumnFunc();
-					if (s_yPixelCount > 1) { drawn = JTRUE; }
+					spriteColumnFunc(state);
+					if (state->yPixelCount > 1) { drawn = JTRUE; }
 				}
 			}
 		}
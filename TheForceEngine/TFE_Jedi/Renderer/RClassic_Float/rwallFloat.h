@@ -17,6 +17,7 @@ struct RSector;
 namespace TFE_Jedi
 {
 	struct EdgePairFloat;
+	struct RClassicFloatState;
 	struct SectorCached;
 
 	struct WallCached
@@ -47,24 +48,24 @@ namespace TFE_Jedi
 
 	namespace RClassic_Float
 	{
-		void wall_process(WallCached* wallCached);
-		s32  wall_mergeSort(RWallSegmentFloat* segOutList, s32 availSpace, s32 start, s32 count);
+		void wall_process(RClassicFloatState* state, WallCached* wallCached);
+		s32  wall_mergeSort(RClassicFloatState* state, RWallSegmentFloat* segOutList, s32 availSpace, s32 start, s32 count);
 
-		void wall_drawSolid(RWallSegmentFloat* wallSegment);
-		void wall_drawTransparent(RWallSegmentFloat* wallSegment, EdgePairFloat* edge);
-		void wall_drawMask(RWallSegmentFloat* wallSegment);
-		void wall_drawBottom(RWallSegmentFloat* wallSegment);
-		void wall_drawTop(RWallSegmentFloat* wallSegment);
-		void wall_drawTopAndBottom(RWallSegmentFloat* wallSegment);
+		void wall_drawSolid(RClassicFloatState* state, RWallSegmentFloat* wallSegment);
+		void wall_drawTransparent(RClassicFloatState* state, RWallSegmentFloat* wallSegment, EdgePairFloat* edge);
+		void wall_drawMask(RClassicFloatState* state, RWallSegmentFloat* wallSegment);
+		void wall_drawBottom(RClassicFloatState* state, RWallSegmentFloat* wallSegment);
+		void wall_drawTop(RClassicFloatState* state, RWallSegmentFloat* wallSegment);
+		void wall_drawTopAndBottom(RClassicFloatState* state, RWallSegmentFloat* wallSegment);
 
-		void wall_drawSkyTop(RSector* sector);
-		void wall_drawSkyTopNoWall(RSector* sector);
-		void wall_drawSkyBottom(RSector* sector);
-		void wall_drawSkyBottomNoWall(RSector* sector);
+		void wall_drawSkyTop(RClassicFloatState* state, RSector* sector);
+		void wall_drawSkyTopNoWall(RClassicFloatState* state, RSector* sector);
+		void wall_drawSkyBottom(RClassicFloatState* state, RSector* sector);
+		void wall_drawSkyBottomNoWall(RClassicFloatState* state, RSector* sector);
 
-		void wall_addAdjoinSegment(s32 length, s32 x0, f32 top_dydx, f32 y1, f32 bot_dydx, f32 y0, RWallSegmentFloat* wallSegment);
+		void wall_addAdjoinSegment(RClassicFloatState* state, s32 length, s32 x0, f32 top_dydx, f32 y1, f32 bot_dydx, f32 y0, RWallSegmentFloat* wallSegment);
 
 		// Sprite code for now because so much is shared.
-		void sprite_drawFrame(u8* basePtr, WaxFrame* frame, SecObject* obj, vec3_float* cachedPosVS);
+		void sprite_drawFrame(RClassicFloatState* state, u8* basePtr, WaxFrame* frame, SecObject* obj, vec3_float* cachedPosVS);
 	}
 }
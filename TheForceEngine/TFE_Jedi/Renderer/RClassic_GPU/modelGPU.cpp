@@ -19,6 +19,7 @@
 #include <TFE_RenderBackend/indexBuffer.h>
 #include <TFE_RenderBackend/shader.h>
 #include <TFE_RenderBackend/shaderBuffer.h>
+#include <TFE_RenderShared/texturePacker.h>
 
 #include <TFE_Settings/settings.h>
 
@@ -769,6 +770,10 @@ namespace TFE_Jedi
 
 		ModelGPU* modelGPU = (ModelGPU *)model->drawId;
 		ModelDraw* drawItem = getDrawItem(modelGPU->shader);
+		for (s32 i = 0; i < model->textureCount; i++)
+		{
+			texturepacker_markHdVisible(model->textures[i]);
+		}
 		
 		drawItem->modelId = model->drawId;
 		drawItem->posWS = posWS;
@@ -13,6 +13,7 @@
 #include <TFE_Jedi/Math/fixedPoint.h>
 #include <TFE_Jedi/Math/core_math.h>
 #include <TFE_Jedi/Renderer/jediRenderer.h>
+#include <TFE_Jedi/Serialization/serialization.h>
 #include <TFE_Settings/settings.h>
 
 #include <TFE_RenderBackend/renderBackend.h>
@@ -131,6 +132,7 @@ namespace TFE_Jedi
 	static bool s_trueColor = false;
 	static bool s_mipmapping = false;
 	static bool s_forceTextureUpdate = false;
+	static bool s_streamHdTextures = false;
 
 	struct ShaderSettings
 	{
@@ -266,6 +268,14 @@ namespace TFE_Jedi
 		s_flushCache = JFALSE;
 	}
 
+	void TFE_Sectors_GPU::serializeInPlace(Stream* stream)
+	{
+		// The GPU buffers are refreshed from the source data as the restored sectors are marked dirty.
+		SERIALIZE_INPLACE(m_levelInit);
+		SERIALIZE_INPLACE(s_cachedSectors);
+		SERIALIZE_INPLACE(s_gpuSourceData);
+	}
+
 	void TFE_Sectors_GPU::flushCache()
 	{
 		s_flushCache = JTRUE;
@@ -1671,6 +1681,27 @@ namespace TFE_Jedi
 		}
 	}
 		
+	void markHdTextureVisible(TextureData** tex)
+	{
+		if (tex) { texturepacker_markHdVisible(*tex); }
+	}
+
+	// Let the HD texture streamer know which textures the sector may show this frame.
+	void markSectorHdTextures(RSector* sector)
+	{
+		markHdTextureVisible(sector->floorTex);
+		markHdTextureVisible(sector->ceilTex);
+
+		RWall* wall = sector->walls;
+		for (s32 w = 0; w < sector->wallCount; w++, wall++)
+		{
+			markHdTextureVisible(wall->topTex);
+			markHdTextureVisible(wall->midTex);
+			markHdTextureVisible(wall->botTex);
+			markHdTextureVisible(wall->signTex);
+		}
+	}
+
 	void traverseSector(RSector* curSector, RSector* prevSector, RWall* portalWall, s32 prevPortalId, s32& level, u32& uploadFlags, Vec2f p0, Vec2f p1)
 	{
 		if (level > MAX_ADJOIN_DEPTH_EXT)
@@ -1687,6 +1718,10 @@ namespace TFE_Jedi
 		{
 			return;
 		}
+		if (s_streamHdTextures)
+		{
+			markSectorHdTextures(curSector);
+		}
 
 		// There is a portal but the sector beyond is degenerate but has a sky.
 		// In this case the software renderer will still fill in the sky even though no walls are visible, so the GPU
@@ -2070,10 +2105,15 @@ namespace TFE_Jedi
 		updateShaderSettings(false);
 
 		// Build the draw list.
+		s_streamHdTextures = TFE_Settings::getEnhancementsSettings()->streamHdTextures;
 		if (!traverseScene(sector))
 		{
 			return;
 		}
+		if (s_streamHdTextures)
+		{
+			texturepacker_streamHdTextures();
+		}
 
 		// State
 		TFE_RenderState::setStateEnable(false, STATE_BLEND);
@@ -24,6 +24,7 @@ namespace TFE_Jedi
 		void prepare() override;
 		void draw(RSector* sector) override;
 		void subrendererChanged() override;
+		void serializeInPlace(Stream* stream) override;
 
 		void flushCache();
 		void flushTextureCache();
@@ -2,8 +2,15 @@
 #include <TFE_Jedi/Math/fixedPoint.h>
 #include <TFE_Jedi/Level/robject.h>
 #include <TFE_Jedi/Level/level.h>
+#include <TFE_Jedi/Level/rtexture.h>
+#include <TFE_Jedi/Serialization/serialization.h>
 #include "rcommon.h"
 #include "rsectorRender.h"
+#include "rcolumn.h"
+#include "rscanlineKernel.h"
+#include "rspriteCache.h"
+#include "rdynamicResolution.h"
+#include "rlightTable.h"
 #include "screenDraw.h"
 #include "RClassic_Fixed/rclassicFixedSharedState.h"
 #include "RClassic_Fixed/rclassicFixed.h"
@@ -12,17 +19,23 @@
 #include "RClassic_Float/rclassicFloat.h"
 #include "RClassic_Float/rsectorFloat.h"
 #include "RClassic_Float/rclassicFloatSharedState.h"
+#include "RClassic_Float/rstripFloat.h"
+#include "RClassic_Float/robj3d_float/robj3dFloat_TransformAndLighting.h"
 
 #include "RClassic_GPU/rclassicGPU.h"
 #include "RClassic_GPU/rsectorGPU.h"
 #include "RClassic_GPU/screenDrawGPU.h"
 
 #include <TFE_System/profiler.h>
+#include <TFE_System/system.h>
 #include <TFE_RenderBackend/renderBackend.h>
 #include <TFE_Settings/settings.h>
 #include <TFE_Asset/spriteAsset_Jedi.h>
 #include <TFE_Asset/modelAsset_jedi.h>
 #include <TFE_FrontEndUI/console.h>
+#include <TFE_Archive/archive.h>
+#include <TFE_FileSystem/paths.h>
+#include <SDL_cpuinfo.h>
 
 namespace TFE_Jedi
 {
@@ -35,6 +48,7 @@ namespace TFE_Jedi
 	static Vec3f s_lumMask = { 0 };
 	static Vec3f s_palFx = { 0 };
 	static u32 s_sourcePalette[256];
+	static std::vector<u8> s_sceneBuffer;
 	bool s_showWireframe = false;
 	TFE_Sectors* s_sectorRenderer = nullptr;
 	RendererType s_rendererType = RENDERER_SOFTWARE;
@@ -43,8 +57,14 @@ namespace TFE_Jedi
 	// Forward Declarations
 	/////////////////////////////////////////////
 	void clear1dDepth();
+	void renderer_drawScene(u8* display, RSector* sector, const u8* colormap, const u8* lightSourceRamp);
+	void renderer_upscaleScene(u8* display, u32 dispWidth, u32 dispHeight);
+	void renderer_updateSceneScale(u64 sceneTicks, u32 dispWidth, u32 dispHeight);
 	void console_setSubRenderer(const std::vector<std::string>& args);
 	void console_getSubRenderer(const std::vector<std::string>& args);
+	void console_testColumns(const std::vector<std::string>& args);
+	void console_testBitmapDecode(const std::vector<std::string>& args);
+	void console_testThreads(const std::vector<std::string>& args);
 
 	/////////////////////////////////////////////
 	// Implementation
@@ -54,6 +74,7 @@ namespace TFE_Jedi
 		RClassic_Fixed::resetState();
 		RClassic_Float::resetState();
 		RClassic_GPU::resetState();
+		spriteCache_clear();
 		s_hudTextureCallbacks.clear();
 		screen_clear();
 
@@ -109,6 +130,9 @@ namespace TFE_Jedi
 	{
 		if (s_init) { return; }
 		s_init = true;
+		column_init();
+		scanline_init();
+
 		// Setup Debug CVars.
 		s_maxWallCount = 0xffff;
 		s_maxDepthCount = 0xffff;
@@ -116,10 +140,17 @@ namespace TFE_Jedi
 		CVAR_INT(s_maxDepthCount, "d_maxDepthCount", CVFLAG_DO_NOT_SERIALIZE, "Maximum adjoin depth count.");
 		CVAR_INT(s_sectorAmbient, "d_sectorAmbient", CVFLAG_DO_NOT_SERIALIZE, "Current Sector Ambient.");
 		CVAR_BOOL(s_showWireframe, "d_enableWireframe", CVFLAG_DO_NOT_SERIALIZE, "Enable wireframe rendering.");
+		CVAR_BOOL(s_simdColumns, "d_simdColumns", CVFLAG_DO_NOT_SERIALIZE, "Use SIMD column kernels when supported by the CPU.");
+		CVAR_BOOL(s_simdScanlines, "d_simdScanlines", CVFLAG_DO_NOT_SERIALIZE, "Use SIMD scanline kernels when supported by the CPU.");
+		CVAR_BOOL(s_spriteCache, "d_spriteCache", CVFLAG_DO_NOT_SERIALIZE, "Draw frequently used compressed sprites from a cache of decompressed cells.");
+		CVAR_BOOL(RClassic_Float::s_simdVertices, "d_simdVertices", CVFLAG_DO_NOT_SERIALIZE, "Use SIMD 3D object transform and lighting when supported by the CPU.");
 
 		// Remove temporarily until they do something useful again.
 		CCMD("rsetSubRenderer", console_setSubRenderer, 1, "Set the sub-renderer - valid values are: Classic_Fixed, Classic_Float, Classic_GPU.");
 		CCMD("rgetSubRenderer", console_getSubRenderer, 0, "Get the current sub-renderer.");
+		CCMD("rtestColumns", console_testColumns, 0, "Compare the SIMD column kernels supported by the CPU against the scalar reference.");
+		CCMD("rtestThreads", console_testThreads, 0, "Draw the next frame with one render thread and with worker threads (Classic_Float) and compare the results - rtestThreads [threads].");
+		CCMD("rtestBitmapDecode", console_testBitmapDecode, 0, "Decode every compressed BM in the stock GOBs with the reference and current decoders and compare them.");
 
 		// Setup performance counters.
 		TFE_COUNTER(s_maxAdjoinDepth, "Maximum Adjoin Depth");
@@ -150,13 +181,33 @@ namespace TFE_Jedi
 		}
 	}
 
+	void renderer_serializeInPlace(Stream* stream)
+	{
+		for (s32 i = 0; i < TSR_COUNT; i++)
+		{
+			u8 present = s_sectorRendererCache[i] ? 1 : 0;
+			SERIALIZE(SaveVersionInit, present, 0);
+			if (!s_sectorRendererCache[i]) { continue; }
+
+			if (present)
+			{
+				s_sectorRendererCache[i]->serializeInPlace(stream);
+			}
+			else
+			{
+				// Created after the state was captured, its cached data is no longer in the level region.
+				s_sectorRendererCache[i]->reset();
+			}
+		}
+	}
+
 	void renderer_setLimits()
 	{
 		if (TFE_Settings::extendAdjoinLimits())
 		{
-			s_maxSegCount = MAX_SEG_EXT;
-			s_maxAdjoinSegCount = MAX_ADJOIN_SEG_EXT;
-			s_maxAdjoinDepthRecursion = MAX_ADJOIN_DEPTH_EXT;
+			s_maxSegCount = MAX_SEG_DYN;
+			s_maxAdjoinSegCount = MAX_ADJOIN_SEG_DYN;
+			s_maxAdjoinDepthRecursion = MAX_ADJOIN_DEPTH_DYN;
 		}
 		else
 		{
@@ -166,6 +217,11 @@ namespace TFE_Jedi
 		}
 	}
 
+	void renderer_resetLimits()
+	{
+		RClassic_Float::resetLimits();
+	}
+
 	void renderer_setType(RendererType type)
 	{
 		s_rendererType = type;
@@ -234,6 +290,86 @@ namespace TFE_Jedi
 		TFE_Console::addToHistory(c_subRenderers[s_subRenderer]);
 	}
 
+	void console_testColumns(const std::vector<std::string>& args)
+	{
+		const s32 columnCount = 100000;
+		s32 kernelSets = 0;
+		const s32 failCount = column_test(columnCount, &kernelSets);
+
+		char msg[256];
+		if (!kernelSets)
+		{
+			strcpy(msg, "No SIMD column kernels are supported by this CPU.");
+		}
+		else
+		{
+			sprintf(msg, "%d kernel set(s) tested on %d columns each, %d column(s) differ from the scalar reference (see the log).", kernelSets, columnCount, failCount);
+		}
+		TFE_Console::addToHistory(msg);
+	}
+
+	void console_testBitmapDecode(const std::vector<std::string>& args)
+	{
+		const char* c_stockGobs[] = { "DARK.GOB", "TEXTURES.GOB", "SPRITES.GOB" };
+		char msg[256];
+		for (s32 i = 0; i < TFE_ARRAYSIZE(c_stockGobs); i++)
+		{
+			FilePath archivePath;
+			Archive* archive = TFE_Paths::getFilePath(c_stockGobs[i], &archivePath) ? Archive::getArchive(ARCHIVE_GOB, c_stockGobs[i], archivePath.path) : nullptr;
+			if (!archive)
+			{
+				sprintf(msg, "Cannot open '%s'.", c_stockGobs[i]);
+				TFE_Console::addToHistory(msg);
+				continue;
+			}
+
+			s32 bmCount;
+			const s32 diffCount = bitmap_testDecompress(archive, &bmCount);
+			sprintf(msg, "%s: %d compressed BM(s) tested, %d image(s) differ from the reference decoder (see the log).", c_stockGobs[i], bmCount, diffCount);
+			TFE_Console::addToHistory(msg);
+		}
+	}
+
+	// Thread count for the next frame comparison, or 0 if none is requested.
+	static s32 s_testThreadCount = 0;
+
+	void console_testThreads(const std::vector<std::string>& args)
+	{
+		if (s_subRenderer != TSR_CLASSIC_FLOAT)
+		{
+			TFE_Console::addToHistory("Render threads are only used by the Classic_Float sub-renderer.");
+			return;
+		}
+		const s32 threadCount = args.size() > 1 ? atoi(args[1].c_str()) : SDL_GetCPUCount();
+		s_testThreadCount = max(threadCount, 2);
+	}
+
+	// Draw the frame with a single thread and then with worker threads, the threaded frame is the one shown.
+	void renderer_testThreads(u8* display, RSector* sector, const u8* colormap, const u8* lightSourceRamp)
+	{
+		const s32 threadCount = s_testThreadCount;
+		s_testThreadCount = 0;
+
+		const size_t size = size_t(s_width) * size_t(s_height);
+		RClassic_Float::strip_setThreadCountOverride(1);
+		renderer_drawScene(display, sector, colormap, lightSourceRamp);
+		std::vector<u8> single(display, display + size);
+
+		RClassic_Float::strip_setThreadCountOverride(threadCount);
+		renderer_drawScene(display, sector, colormap, lightSourceRamp);
+		RClassic_Float::strip_setThreadCountOverride(0);
+
+		s32 diffCount = 0;
+		for (size_t i = 0; i < size; i++)
+		{
+			if (display[i] != single[i]) { diffCount++; }
+		}
+
+		char msg[256];
+		sprintf(msg, "%dx%d frame drawn with 1 and %d threads, %d pixel(s) differ.", s_width, s_height, threadCount, diffCount);
+		TFE_Console::addToHistory(msg);
+	}
+
 	static s32 s_fov = -1;
 	static bool s_clearCachedTextures = false;
 
@@ -285,6 +421,11 @@ namespace TFE_Jedi
 			updateTexturePacking = true;
 		}
 
+		if (!graphics->dynamicResolution || subRenderer != TSR_CLASSIC_FLOAT)
+		{
+			dynamicRes_reset();
+		}
+
 		if (!vfb_setResolution(width, height) && !fovChanged && !updateTexturePacking)
 		{
 			return JFALSE;
@@ -316,7 +457,11 @@ namespace TFE_Jedi
 				s_sectorRenderer = renderer_getSectorRenderer(TSR_CLASSIC_FLOAT);
 			}
 			screen_enableGPU(false);
-			RClassic_Float::changeResolution(width, height);
+
+			// The scene may be drawn below the game resolution, see drawWorld().
+			s32 sceneWidth, sceneHeight;
+			dynamicRes_getSceneSize(width, height, &sceneWidth, &sceneHeight);
+			RClassic_Float::changeResolution(sceneWidth, sceneHeight);
 		}
 		else
 		{
@@ -493,6 +638,49 @@ namespace TFE_Jedi
 	}
 
 	void drawWorld(u8* display, RSector* sector, const u8* colormap, const u8* lightSourceRamp)
+	{
+		// With dynamic resolution the float sub-renderer draws into the scene buffer, which is then scaled up to the display.
+		const u64 sceneStart = TFE_System::getCurrentTimeInTicks();
+		u8* output = display;
+		u32 dispWidth, dispHeight;
+		vfb_getResolution(&dispWidth, &dispHeight);
+		const bool scaleScene = s_subRenderer == TSR_CLASSIC_FLOAT && (s_width != s32(dispWidth) || s_height != s32(dispHeight));
+		if (scaleScene)
+		{
+			s_sceneBuffer.resize(s_width * s_height);
+			display = s_sceneBuffer.data();
+		}
+
+		// TFE: The float sub-renderer grows its buffers when a frame runs out of room, the frame is then drawn again.
+		// Only one redraw is allowed per frame to bound the cost, if the grown buffers are still too small the frame
+		// is shown clipped (as in vanilla) and the buffers grow again on the next frame.
+		renderer_drawScene(display, sector, colormap, lightSourceRamp);
+		if (s_subRenderer == TSR_CLASSIC_FLOAT && RClassic_Float::limitsNeedToGrow())
+		{
+			renderer_drawScene(display, sector, colormap, lightSourceRamp);
+		}
+		// Both frames are drawn with the limits found above.
+		if (s_subRenderer == TSR_CLASSIC_FLOAT && s_testThreadCount)
+		{
+			renderer_testThreads(display, sector, colormap, lightSourceRamp);
+		}
+
+		if (s_subRenderer == TSR_CLASSIC_FLOAT)
+		{
+			if (scaleScene)
+			{
+				renderer_upscaleScene(output, dispWidth, dispHeight);
+				s_display = output;
+			}
+			renderer_updateSceneScale(TFE_System::getCurrentTimeInTicks() - sceneStart, dispWidth, dispHeight);
+		}
+	}
+
+	/////////////////////////////////////////////
+	// Internal
+	/////////////////////////////////////////////
+	// Draw the sectors and their contents (sprites, 3D objects) from the view of 'sector'.
+	void renderer_drawScene(u8* display, RSector* sector, const u8* colormap, const u8* lightSourceRamp)
 	{
 		// Clear the top pixel row.
 		if (s_subRenderer != TSR_CLASSIC_GPU)
@@ -508,6 +696,7 @@ namespace TFE_Jedi
 		}
 		else if (s_subRenderer == TSR_CLASSIC_FLOAT)
 		{
+			RClassic_Float::beginFrame();
 			RClassic_Float::computeSkyOffsets();
 		}
 		else if (s_subRenderer == TSR_CLASSIC_GPU)
@@ -521,6 +710,7 @@ namespace TFE_Jedi
 		if (s_subRenderer != TSR_CLASSIC_GPU)
 		{
 			clear1dDepth();
+			lightTable_beginFrame();
 		}
 
 		s_windowMinX_Pixels = s_minScreenX_Pixels;
@@ -559,12 +749,43 @@ namespace TFE_Jedi
 			TFE_ZONE("Sector Draw");
 			s_sectorRenderer->prepare();
 			s_sectorRenderer->draw(sector);
+			s_sectorRenderer->finish();
+		}
+	}
+
+	// Scale the scene buffer up to the display with the screen blit, leaving the weapon and HUD at full resolution.
+	void renderer_upscaleScene(u8* display, u32 dispWidth, u32 dispHeight)
+	{
+		ScreenImage image = { s_width, s_height, s_sceneBuffer.data(), JFALSE, JFALSE };
+		DrawRect rect = { 0, 0, s32(dispWidth) - 1, s32(dispHeight) - 1 };
+		// Round the scale up so the last row and column land on the display edge.
+		const fixed16_16 xScale = div16(intToFixed16(s32(dispWidth) - 1),  intToFixed16(max(s_width - 1, 1)))  + 1;
+		const fixed16_16 yScale = div16(intToFixed16(s32(dispHeight) - 1), intToFixed16(max(s_height - 1, 1))) + 1;
+		blitTextureToScreenScaled(&image, &rect, 0, 0, xScale, yScale, display);
+	}
+
+	// Feed the scene time to the dynamic resolution controller and apply the new scene size for the next frame.
+	// The size is not changed mid-frame since the camera has already been set up with the current projection.
+	void renderer_updateSceneScale(u64 sceneTicks, u32 dispWidth, u32 dispHeight)
+	{
+		TFE_Settings_Graphics* graphics = TFE_Settings::getGraphicsSettings();
+		if (graphics->dynamicResolution)
+		{
+			dynamicRes_update(TFE_System::convertFromTicksToSeconds(sceneTicks), graphics->dynamicResTargetFps, graphics->dynamicResMinScale);
+		}
+		else
+		{
+			dynamicRes_reset();
+		}
+
+		s32 sceneWidth, sceneHeight;
+		dynamicRes_getSceneSize(dispWidth, dispHeight, &sceneWidth, &sceneHeight);
+		if (sceneWidth != s_width || sceneHeight != s_height)
+		{
+			RClassic_Float::changeResolution(sceneWidth, sceneHeight);
 		}
 	}
 
-	/////////////////////////////////////////////
-	// Internal
-	/////////////////////////////////////////////
 	void clear1dDepth()
 	{
 		if (s_subRenderer == TSR_CLASSIC_FIXED)
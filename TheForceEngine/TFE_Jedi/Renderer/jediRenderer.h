@@ -25,6 +25,8 @@
 #include <TFE_Jedi/Renderer/virtualFramebuffer.h>
 #include <TFE_Jedi/Renderer/textureInfo.h>
 
+class Stream;
+
 enum TFE_SubRenderer
 {
 	TSR_CLASSIC_FIXED = 0,	// The Reverse-Engineered DOS Jedi Renderer, using 16.16 fixed point.
@@ -49,6 +51,10 @@ namespace TFE_Jedi
 	void renderer_destroy();
 	void renderer_reset();
 	void renderer_setLimits();
+	// Return buffers grown for the previous level to the vanilla limits.
+	void renderer_resetLimits();
+	// Copy the sub-renderer pointers into the level region for in-place save states.
+	void renderer_serializeInPlace(Stream* stream);
 	void renderer_setType(RendererType type = RENDERER_SOFTWARE);
 	void setupInitCameraAndLights();
 	void renderer_computeCameraTransform(RSector* sector, angle14_32 pitch, angle14_32 yaw, fixed16_16 camX, fixed16_16 camY, fixed16_16 camZ);
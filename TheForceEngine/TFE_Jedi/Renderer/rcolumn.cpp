@@ -0,0 +1,307 @@
+#include "rcolumn.h"
+#include <TFE_System/system.h>
+#include <SDL_cpuinfo.h>
+
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLUMN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 is not enabled for the whole build, so the kernel is compiled for it separately and only called when supported.
+#if defined(COLUMN_SSE2) && (defined(_MSC_VER) || defined(__GNUC__))
+#define COLUMN_AVX2 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define COLUMN_AVX2_TARGET
+#else
+#define COLUMN_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define COLUMN_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace TFE_Jedi
+{
+	enum ColumnKernelSet
+	{
+		COLSET_SSE2 = 0,
+		COLSET_AVX2,
+		COLSET_NEON,
+
+		COLSET_COUNT
+	};
+
+	static const char* c_columnKernelSetName[COLSET_COUNT] =
+	{
+		"SSE2",	// COLSET_SSE2
+		"AVX2",	// COLSET_AVX2
+		"NEON",	// COLSET_NEON
+	};
+
+	bool s_simdColumns = false;
+	static ColumnKernel s_columnKernels[COLKERNEL_COUNT] = { 0 };
+	// Every kernel set supported by the CPU, so they can all be tested even though only one is used.
+	static ColumnKernel s_columnKernelSets[COLSET_COUNT][COLKERNEL_COUNT] = { 0 };
+
+	template<bool lit, bool trans>
+	inline void column_writeTexel(u8* dst, const u8* tex, const u8* colorMap, u32 texel)
+	{
+		const u8 c = tex[texel];
+		if (trans && !c) { return; }
+		*dst = lit ? colorMap[c] : c;
+	}
+
+	// Pixels left over after the vector loop.
+	template<bool lit, bool trans>
+	inline void column_drawRemainder(u8* dst, s32 stride, s32 count, const u8* tex, const u8* colorMap, u32 v, u32 dV, u32 fracBits, u32 texMask)
+	{
+		for (s32 i = 0; i < count; i++, v += dV, dst -= stride)
+		{
+			column_writeTexel<lit, trans>(dst, tex, colorMap, (v >> fracBits) & texMask);
+		}
+	}
+
+#ifdef COLUMN_SSE2
+	template<bool lit, bool trans>
+	void column_kernelSSE2(u8* out, s32 stride, s32 count, const u8* tex, const u8* colorMap, u32 v, u32 dV, u32 fracBits, u32 texMask)
+	{
+		u8* dst = out + (count - 1) * stride;
+		const __m128i step  = _mm_set1_epi32(s32(dV * 8));
+		const __m128i mask  = _mm_set1_epi32(s32(texMask));
+		const __m128i shift = _mm_cvtsi32_si128(s32(fracBits));
+		__m128i v0 = _mm_setr_epi32(s32(v), s32(v + dV), s32(v + dV * 2), s32(v + dV * 3));
+		__m128i v1 = _mm_add_epi32(v0, _mm_set1_epi32(s32(dV * 4)));
+
+		s32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i t0 = _mm_and_si128(_mm_srl_epi32(v0, shift), mask);
+			__m128i t1 = _mm_and_si128(_mm_srl_epi32(v1, shift), mask);
+			v0 = _mm_add_epi32(v0, step);
+			v1 = _mm_add_epi32(v1, step);
+
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(t0)));                    dst -= stride;
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(_mm_srli_si128(t0, 4)))); dst -= stride;
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(_mm_srli_si128(t0, 8)))); dst -= stride;
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(_mm_srli_si128(t0, 12)))); dst -= stride;
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(t1)));                    dst -= stride;
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(_mm_srli_si128(t1, 4)))); dst -= stride;
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(_mm_srli_si128(t1, 8)))); dst -= stride;
+			column_writeTexel<lit, trans>(dst, tex, colorMap, u32(_mm_cvtsi128_si32(_mm_srli_si128(t1, 12)))); dst -= stride;
+		}
+		column_drawRemainder<lit, trans>(dst, stride, count - i, tex, colorMap, v + u32(i) * dV, dV, fracBits, texMask);
+	}
+#endif
+
+#ifdef COLUMN_AVX2
+	template<bool lit, bool trans>
+	COLUMN_AVX2_TARGET void column_kernelAVX2(u8* out, s32 stride, s32 count, const u8* tex, const u8* colorMap, u32 v, u32 dV, u32 fracBits, u32 texMask)
+	{
+		u8* dst = out + (count - 1) * stride;
+		const __m256i step  = _mm256_set1_epi32(s32(dV * 16));
+		const __m256i mask  = _mm256_set1_epi32(s32(texMask));
+		const __m128i shift = _mm_cvtsi32_si128(s32(fracBits));
+		const __m256i lane  = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		__m256i v0 = _mm256_add_epi32(_mm256_set1_epi32(s32(v)), _mm256_mullo_epi32(lane, _mm256_set1_epi32(s32(dV))));
+		__m256i v1 = _mm256_add_epi32(v0, _mm256_set1_epi32(s32(dV * 8)));
+
+		// There is no byte scatter, so the texel indices are stored and the texels fetched one at a time.
+		alignas(32) u32 texel[16];
+		s32 i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			_mm256_store_si256((__m256i*)&texel[0], _mm256_and_si256(_mm256_srl_epi32(v0, shift), mask));
+			_mm256_store_si256((__m256i*)&texel[8], _mm256_and_si256(_mm256_srl_epi32(v1, shift), mask));
+			v0 = _mm256_add_epi32(v0, step);
+			v1 = _mm256_add_epi32(v1, step);
+
+			for (s32 t = 0; t < 16; t++, dst -= stride)
+			{
+				column_writeTexel<lit, trans>(dst, tex, colorMap, texel[t]);
+			}
+		}
+		column_drawRemainder<lit, trans>(dst, stride, count - i, tex, colorMap, v + u32(i) * dV, dV, fracBits, texMask);
+	}
+#endif
+
+#ifdef COLUMN_NEON
+	template<bool lit, bool trans>
+	void column_kernelNEON(u8* out, s32 stride, s32 count, const u8* tex, const u8* colorMap, u32 v, u32 dV, u32 fracBits, u32 texMask)
+	{
+		u8* dst = out + (count - 1) * stride;
+		const uint32x4_t step  = vdupq_n_u32(dV * 8);
+		const uint32x4_t mask  = vdupq_n_u32(texMask);
+		const int32x4_t  shift = vdupq_n_s32(-s32(fracBits));
+		const u32 start[4] = { v, v + dV, v + dV * 2, v + dV * 3 };
+		uint32x4_t v0 = vld1q_u32(start);
+		uint32x4_t v1 = vaddq_u32(v0, vdupq_n_u32(dV * 4));
+
+		alignas(16) u32 texel[8];
+		s32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			vst1q_u32(&texel[0], vandq_u32(vshlq_u32(v0, shift), mask));
+			vst1q_u32(&texel[4], vandq_u32(vshlq_u32(v1, shift), mask));
+			v0 = vaddq_u32(v0, step);
+			v1 = vaddq_u32(v1, step);
+
+			for (s32 t = 0; t < 8; t++, dst -= stride)
+			{
+				column_writeTexel<lit, trans>(dst, tex, colorMap, texel[t]);
+			}
+		}
+		column_drawRemainder<lit, trans>(dst, stride, count - i, tex, colorMap, v + u32(i) * dV, dV, fracBits, texMask);
+	}
+#endif
+
+	void column_init()
+	{
+		for (s32 i = 0; i < COLKERNEL_COUNT; i++)
+		{
+			s_columnKernels[i] = nullptr;
+			for (s32 s = 0; s < COLSET_COUNT; s++)
+			{
+				s_columnKernelSets[s][i] = nullptr;
+			}
+		}
+
+#ifdef COLUMN_SSE2
+		if (SDL_HasSSE2())
+		{
+			ColumnKernel* kernels = s_columnKernelSets[COLSET_SSE2];
+			kernels[COLKERNEL_FULLBRIGHT]       = column_kernelSSE2<false, false>;
+			kernels[COLKERNEL_LIT]              = column_kernelSSE2<true,  false>;
+			kernels[COLKERNEL_FULLBRIGHT_TRANS] = column_kernelSSE2<false, true>;
+			kernels[COLKERNEL_LIT_TRANS]        = column_kernelSSE2<true,  true>;
+		}
+#endif
+#ifdef COLUMN_AVX2
+		if (SDL_HasAVX2())
+		{
+			ColumnKernel* kernels = s_columnKernelSets[COLSET_AVX2];
+			kernels[COLKERNEL_FULLBRIGHT]       = column_kernelAVX2<false, false>;
+			kernels[COLKERNEL_LIT]              = column_kernelAVX2<true,  false>;
+			kernels[COLKERNEL_FULLBRIGHT_TRANS] = column_kernelAVX2<false, true>;
+			kernels[COLKERNEL_LIT_TRANS]        = column_kernelAVX2<true,  true>;
+		}
+#endif
+#ifdef COLUMN_NEON
+		if (SDL_HasNEON())
+		{
+			ColumnKernel* kernels = s_columnKernelSets[COLSET_NEON];
+			kernels[COLKERNEL_FULLBRIGHT]       = column_kernelNEON<false, false>;
+			kernels[COLKERNEL_LIT]              = column_kernelNEON<true,  false>;
+			kernels[COLKERNEL_FULLBRIGHT_TRANS] = column_kernelNEON<false, true>;
+			kernels[COLKERNEL_LIT_TRANS]        = column_kernelNEON<true,  true>;
+		}
+#endif
+
+		// Use the widest supported set.
+		const ColumnKernelSet preferred[] = { COLSET_AVX2, COLSET_NEON, COLSET_SSE2 };
+		for (s32 p = 0; p < s32(TFE_ARRAYSIZE(preferred)); p++)
+		{
+			const ColumnKernelSet set = preferred[p];
+			if (!s_columnKernelSets[set][0]) { continue; }
+
+			for (s32 i = 0; i < COLKERNEL_COUNT; i++)
+			{
+				s_columnKernels[i] = s_columnKernelSets[set][i];
+			}
+			TFE_System::logWrite(LOG_MSG, "Renderer", "%s column kernels available.", c_columnKernelSetName[set]);
+			break;
+		}
+	}
+
+	ColumnKernel column_getKernel(ColumnKernelId id)
+	{
+		return s_simdColumns ? s_columnKernels[id] : nullptr;
+	}
+
+	// Matches the scalar loops in the sub-renderers: the coordinate is stepped in 64 bits and the pixels are written
+	// from the bottom of the column up.
+	static void column_drawReference(ColumnKernelId id, u8* out, s32 stride, s32 count, const u8* tex, const u8* colorMap, s64 v, s64 dV, u32 fracBits, u32 texMask)
+	{
+		const bool lit   = id == COLKERNEL_LIT || id == COLKERNEL_LIT_TRANS;
+		const bool trans = id == COLKERNEL_FULLBRIGHT_TRANS || id == COLKERNEL_LIT_TRANS;
+		for (s32 i = count - 1; i >= 0; i--, v += dV)
+		{
+			const u8 c = tex[(v >> fracBits) & texMask];
+			if (trans && !c) { continue; }
+			out[i * stride] = lit ? colorMap[c] : c;
+		}
+	}
+
+	s32 column_test(s32 columnCount, s32* kernelSets)
+	{
+		// Fixed seed so a failure can be reproduced.
+		u32 seed = 0x2545f491u;
+		auto random = [&seed]() -> u32
+		{
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			return seed;
+		};
+
+		const s32 maxCount = 512;
+		const s32 maxStride = 8;
+		const u32 fracBits[] = { 16, 20 };	// Fixed point and float sub-renderers.
+		u8 colorMap[256];
+		std::vector<u8> tex(4096);
+		std::vector<u8> refOut(maxCount * maxStride);
+		std::vector<u8> simdOut(maxCount * maxStride);
+
+		s32 failCount = 0;
+		*kernelSets = 0;
+		for (s32 set = 0; set < COLSET_COUNT; set++)
+		{
+			if (!s_columnKernelSets[set][0]) { continue; }
+			(*kernelSets)++;
+
+			s32 setFailCount = 0;
+			for (s32 c = 0; c < columnCount; c++)
+			{
+				const ColumnKernelId id = ColumnKernelId(c % COLKERNEL_COUNT);
+				const u32 frac = fracBits[(c / COLKERNEL_COUNT) & 1];
+				const u32 texMask = (1u << (random() % 13)) - 1;	// Textures from 1 to 4096 texels tall.
+				const s32 count = 1 + s32(random() % maxCount);
+				const s32 stride = 1 + s32(random() % maxStride);
+				// Coordinates and steps of either sign, large enough to wrap the 32-bit lanes.
+				const s64 v  = s64(s32(random())) << 8;
+				const s64 dV = s64(s32(random())) >> (random() % 24);
+				if (!column_supportsMask(texMask, frac)) { continue; }
+
+				for (u32 t = 0; t <= texMask; t++)
+				{
+					const u32 r = random();
+					tex[t] = (r & 3) ? u8(r >> 8) : 0;	// Leave holes for the transparent kernels.
+				}
+				for (s32 i = 0; i < 256; i++)
+				{
+					colorMap[i] = u8(random());
+				}
+				const u8 background = u8(random());
+				memset(refOut.data(), background, refOut.size());
+				memset(simdOut.data(), background, simdOut.size());
+
+				column_drawReference(id, refOut.data(), stride, count, tex.data(), colorMap, v, dV, frac, texMask);
+				s_columnKernelSets[set][id](simdOut.data(), stride, count, tex.data(), colorMap, u32(v), u32(dV), frac, texMask);
+				if (memcmp(refOut.data(), simdOut.data(), refOut.size()) != 0)
+				{
+					setFailCount++;
+				}
+			}
+
+			TFE_System::logWrite(setFailCount ? LOG_ERROR : LOG_MSG, "Renderer", "%s column kernels: %d of %d columns differ from the scalar reference.",
+				c_columnKernelSetName[set], setFailCount, columnCount);
+			failCount += setFailCount;
+		}
+		return failCount;
+	}
+}
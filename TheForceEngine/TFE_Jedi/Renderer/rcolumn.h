@@ -0,0 +1,53 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Column Kernels
+// Dark Forces Derived Renderer - SIMD texture column drawing
+//
+// Vectorized versions of the wall and sprite column loops shared by
+// the fixed and float sub-renderers. The texture coordinates of
+// several pixels are stepped at once (8 with SSE2 and NEON, 16 with
+// AVX2) and then used to fetch and light the texels. The kernels are
+// selected at runtime based on the CPU, and the scalar loops in the
+// sub-renderers remain the reference and are used when no kernel is
+// available. The rtestColumns console command checks every kernel the
+// CPU supports against the reference.
+//
+// The column loops are bound by the strided framebuffer writes rather
+// than the texture coordinate math, so the kernels measure about the
+// same as the scalar code. They are disabled by default and can be
+// enabled with the d_simdColumns cvar for comparison.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+
+namespace TFE_Jedi
+{
+	enum ColumnKernelId
+	{
+		COLKERNEL_FULLBRIGHT = 0,
+		COLKERNEL_LIT,
+		COLKERNEL_FULLBRIGHT_TRANS,
+		COLKERNEL_LIT_TRANS,
+
+		COLKERNEL_COUNT
+	};
+
+	// Draws 'count' pixels from the bottom of the column up, the bottom pixel is at out[(count - 1) * stride].
+	// Pixel 'i' from the bottom uses texel tex[((v + i*dV) >> fracBits) & texMask], computed with 32-bit wrapping math.
+	typedef void(*ColumnKernel)(u8* out, s32 stride, s32 count, const u8* tex, const u8* colorMap, u32 v, u32 dV, u32 fracBits, u32 texMask);
+
+	extern bool s_simdColumns;
+
+	// Select the kernels supported by the CPU.
+	void column_init();
+	// Returns nullptr if SIMD kernels are disabled or there is no kernel for this CPU.
+	ColumnKernel column_getKernel(ColumnKernelId id);
+	// Draw random columns with every kernel supported by the CPU and with the scalar reference, returns the number
+	// of columns that differ. 'kernelSets' is set to the number of kernel sets tested.
+	s32 column_test(s32 columnCount, s32* kernelSets);
+
+	// The kernels step coordinates in 32 bits, so the texel bits must fit in 32 bits to match the scalar code.
+	inline bool column_supportsMask(u32 texMask, u32 fracBits)
+	{
+		return texMask <= (0xffffffffu >> fracBits);
+	}
+}
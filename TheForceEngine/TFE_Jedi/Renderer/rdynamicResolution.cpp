@@ -0,0 +1,100 @@
+#include "rdynamicResolution.h"
+#include <TFE_Jedi/Math/core_math.h>
+#include <cmath>
+
+namespace TFE_Jedi
+{
+	enum
+	{
+		DYNRES_DOWN_FRAMES = 8,		// Frames over budget before the scale is lowered.
+		DYNRES_UP_FRAMES   = 60,	// Frames with room to spare before the scale is raised.
+		DYNRES_COOLDOWN    = 30,	// Frames to wait after a change, so the average reflects the new scale.
+	};
+	// Fraction of the frame the scene may take, the rest is left for the game logic, weapon, HUD and presentation.
+	static const f32 c_sceneBudget = 0.75f;
+	// Fraction of the scene budget the scene must be expected to fit in after a change.
+	static const f32 c_fitMargin = 0.85f;
+	static const f32 c_scaleStep = 0.05f;
+	static const f32 c_averageWeight = 0.2f;
+
+	static f32 s_scale = 1.0f;
+	static f32 s_avgTime = 0.0f;
+	static s32 s_overFrames = 0;
+	static s32 s_underFrames = 0;
+	static s32 s_cooldown = 0;
+
+	void dynamicRes_reset()
+	{
+		s_scale = 1.0f;
+		s_avgTime = 0.0f;
+		s_overFrames = 0;
+		s_underFrames = 0;
+		s_cooldown = 0;
+	}
+
+	static void dynamicRes_setScale(f32 scale)
+	{
+		// Drawing time is roughly proportional to the pixel count, so carry the average over to the new scale.
+		const f32 ratio = scale / s_scale;
+		s_avgTime *= ratio * ratio;
+		s_scale = scale;
+		s_overFrames = 0;
+		s_underFrames = 0;
+		s_cooldown = DYNRES_COOLDOWN;
+	}
+
+	bool dynamicRes_update(f64 sceneTime, s32 targetFps, f32 minScale)
+	{
+		minScale = clamp(minScale, c_scaleStep, 1.0f);
+		const f32 budget = c_sceneBudget / f32(max(targetFps, 1));
+		s_avgTime = (s_avgTime > 0.0f) ? s_avgTime + (f32(sceneTime) - s_avgTime) * c_averageWeight : f32(sceneTime);
+
+		// The minimum scale may have been raised in the settings.
+		if (s_scale < minScale)
+		{
+			dynamicRes_setScale(minScale);
+			return true;
+		}
+		if (s_cooldown > 0)
+		{
+			s_cooldown--;
+			return false;
+		}
+
+		const f32 upScale = min(s_scale + c_scaleStep, 1.0f);
+		const f32 upRatio = upScale / s_scale;
+		s_overFrames  = (s_avgTime > budget) ? s_overFrames + 1 : 0;
+		s_underFrames = (s_scale < 1.0f && s_avgTime * upRatio * upRatio < budget * c_fitMargin) ? s_underFrames + 1 : 0;
+
+		f32 scale = s_scale;
+		if (s_overFrames >= DYNRES_DOWN_FRAMES)
+		{
+			// Go straight to the scale expected to fit, rounded down to a whole step.
+			const f32 fitScale = s_scale * sqrtf(budget * c_fitMargin / s_avgTime);
+			scale = min(floorf(fitScale / c_scaleStep) * c_scaleStep, s_scale - c_scaleStep);
+		}
+		else if (s_underFrames >= DYNRES_UP_FRAMES)
+		{
+			scale = upScale;
+		}
+		scale = clamp(scale, minScale, 1.0f);
+
+		if (scale == s_scale)
+		{
+			return false;
+		}
+		dynamicRes_setScale(scale);
+		return true;
+	}
+
+	f32 dynamicRes_getScale()
+	{
+		return s_scale;
+	}
+
+	void dynamicRes_getSceneSize(s32 width, s32 height, s32* sceneWidth, s32* sceneHeight)
+	{
+		*sceneWidth  = clamp(s32(f32(width)  * s_scale) & ~3, 4, width);
+		*sceneHeight = clamp(s32(f32(height) * s_scale), 2, height);
+	}
+}
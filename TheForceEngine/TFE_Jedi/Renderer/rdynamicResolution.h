@@ -0,0 +1,25 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Dynamic Resolution
+// Dark Forces Derived Renderer - Scene resolution controller
+//
+// Watches the time spent drawing the 3D view and picks the fraction
+// of the game resolution the float sub-renderer draws the scene at.
+// The scene is lowered quickly when it misses the frame budget and
+// raised slowly, only once the next step up is expected to fit, so
+// the resolution does not oscillate. The scene is then scaled up to
+// the game resolution before the weapon and HUD are drawn.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+
+namespace TFE_Jedi
+{
+	// Go back to full resolution and forget the frame time history.
+	void dynamicRes_reset();
+	// Record the time spent drawing the scene this frame, in seconds.
+	// Returns true if the scene scale changed.
+	bool dynamicRes_update(f64 sceneTime, s32 targetFps, f32 minScale);
+	f32  dynamicRes_getScale();
+	// Returns the scene size for the game resolution at the current scale, the width is kept a multiple of 4.
+	void dynamicRes_getSceneSize(s32 width, s32 height, s32* sceneWidth, s32* sceneHeight);
+}
@@ -0,0 +1,51 @@
+#include "rlightTable.h"
+#include <TFE_Jedi/Math/core_math.h>
+
+namespace TFE_Jedi
+{
+	LightTable s_lightTables[MAX_LIGHT_LEVEL];
+	// Starts above the zero initialized tables so they are built on first use.
+	u32 s_lightTableGen = 1;
+
+	void lightTable_beginFrame()
+	{
+		s_lightTableGen++;
+	}
+
+	// Matches computeLighting() in the fixed and float sub-renderers: floor(depth / 16) + floor(depth / 32) == (q >> 6) + (q >> 7).
+	static s32 lightTable_computeLevel(s32 q)
+	{
+		s32 light = 0;
+		if (s_worldAmbient < MAX_LIGHT_LEVEL || s_cameraLightSource)
+		{
+			s32 lightSource = MAX_LIGHT_LEVEL - (s_lightSourceRamp[min(q, LIGHT_SOURCE_LEVELS - 1)] + s_worldAmbient);
+			if (lightSource > 0)
+			{
+				light += lightSource;
+			}
+		}
+		if (light < s_sectorAmbient) { light = s_sectorAmbient; }
+
+		s32 depthAtten = (q >> 6) + (q >> 7);
+		return max(light - depthAtten, s_scaledAmbient);
+	}
+
+	void lightTable_build(LightTable* table)
+	{
+		table->gen = s_lightTableGen;
+		table->count = LIGHT_TABLE_SIZE;
+		table->saturated = JFALSE;
+		for (s32 q = 0; q < LIGHT_TABLE_SIZE; q++)
+		{
+			const s32 level = lightTable_computeLevel(q);
+			table->level[q] = s16(level);
+			// Past the light source ramp the level only decreases with depth, so once it is clamped to the scaled ambient it stays there.
+			if (q >= LIGHT_SOURCE_LEVELS - 1 && level == s_scaledAmbient)
+			{
+				table->count = q + 1;
+				table->saturated = JTRUE;
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Light Table
+// Dark Forces Derived Renderer - Depth based light levels
+//
+// Wall columns and flat scanlines look up their colormap from the
+// depth, the sector ambient and the camera light source. Both the
+// headlamp ramp and the depth attenuation only change every quarter
+// unit of depth, so the light level is tabulated per frame for each
+// sector ambient in use, indexed by floor(depth * 4). Past the depth
+// where the level reaches the scaled ambient it no longer changes and
+// the table stops.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+#include "rcommon.h"
+#include "rlimits.h"
+
+namespace TFE_Jedi
+{
+	enum
+	{
+		LIGHT_TABLE_SIZE = 2048,	// Quantized depths covered by a table, depth < 512.
+	};
+
+	struct LightTable
+	{
+		u32 gen;			// Table generation the levels were built for.
+		s32 count;			// Number of quantized depths stored.
+		JBool saturated;	// The level stays at the scaled ambient past 'count'.
+		s16 level[LIGHT_TABLE_SIZE];
+	};
+	extern LightTable s_lightTables[MAX_LIGHT_LEVEL];
+	extern u32 s_lightTableGen;
+
+	// Invalidate the tables, called at the start of each frame once the light source ramp is set.
+	void lightTable_beginFrame();
+	// Fill in the table for the current sector ambient.
+	void lightTable_build(LightTable* table);
+
+	// Looks up the light level before the light offset, for the current sector ambient and the quantized
+	// depth q = floor(depth * 4). Returns false if the table does not cover the depth, the level must then
+	// be computed directly.
+	inline bool lightTable_getLevel(u32 q, s32* level)
+	{
+		if (u32(s_sectorAmbient) >= MAX_LIGHT_LEVEL) { return false; }
+
+		LightTable* table = &s_lightTables[s_sectorAmbient];
+		if (table->gen != s_lightTableGen)
+		{
+			lightTable_build(table);
+		}
+
+		if (q < u32(table->count))
+		{
+			*level = table->level[q];
+			return true;
+		}
+		else if (table->saturated)
+		{
+			*level = s_scaledAmbient;
+			return true;
+		}
+		return false;
+	}
+}
@@ -17,4 +17,12 @@ namespace TFE_Jedi
 	#define MAX_SEG_EXT	         2048 // Maximum number of wall segments with extended limits, this allows for ~1 wall/pixel column @1080p like vanilla @ 320x200
 	#define MAX_ADJOIN_SEG_EXT   1024 // Maximum number of adjoin segments with extended limits.
 	#define MAX_ADJOIN_DEPTH_EXT 255  // Maximum adjoin recursion depth with extended limits.
+
+	// Dynamic Max Limits
+	// The float sub-renderer starts each level with buffers sized for the vanilla limits and grows them from
+	// its frame arena when a frame runs out of room, up to these limits when extended limits are enabled.
+	// Grown buffers are kept until the next level is loaded.
+	#define MAX_SEG_DYN          32768 // Maximum number of wall segments and flat edges in a frame.
+	#define MAX_ADJOIN_SEG_DYN   32768 // Maximum number of adjoin segments in a frame.
+	#define MAX_ADJOIN_DEPTH_DYN 512   // Maximum adjoin recursion depth, bounded by the stack used by each level of recursion.
 }
\ No newline at end of file
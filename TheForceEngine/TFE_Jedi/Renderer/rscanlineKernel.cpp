@@ -0,0 +1,240 @@
+#include "rscanlineKernel.h"
+#include <TFE_System/system.h>
+#include <SDL_cpuinfo.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCANLINE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define SCANLINE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace TFE_Jedi
+{
+	enum ScanlineConst
+	{
+		SCANLINE_BLOCK = 16,	// Pixels per vector step.
+	};
+
+	bool s_simdScanlines = true;
+	static ScanlineKernel s_scanlineKernels[SCANKERNEL_COUNT] = { 0 };
+
+	// Pixels left over after the vector loop, 'out' points at the first pixel of the scanline.
+	template<bool lit, bool trans>
+	inline void scanline_drawRemainder(u8* out, s32 count, const u8* tex, const u8* colorMap, u32 u, u32 v, u32 dU, u32 dV, u32 fracBits, u32 texDataEnd)
+	{
+		for (s32 i = count - 1; i >= 0; i--, u += dU, v += dV)
+		{
+			const u32 texel = ((((u >> fracBits) & 63) << 6) | ((v >> fracBits) & 63)) & texDataEnd;
+			const u8 c = tex[texel];
+			if (trans && !c) { continue; }
+			out[i] = lit ? colorMap[c] : c;
+		}
+	}
+
+	// Fetch and light the texels of a block, pixel 'j' of the block is written to color[SCANLINE_BLOCK - 1 - j]
+	// since the scanline is drawn from right to left.
+	template<bool lit>
+	inline void scanline_fetchBlock(const u16* texel, const u8* tex, const u8* colorMap, u8* base, u8* color)
+	{
+		for (s32 j = 0; j < SCANLINE_BLOCK; j++)
+		{
+			base[SCANLINE_BLOCK - 1 - j] = tex[texel[j]];
+		}
+		if (lit)
+		{
+			for (s32 j = 0; j < SCANLINE_BLOCK; j++)
+			{
+				color[j] = colorMap[base[j]];
+			}
+		}
+	}
+
+#ifdef SCANLINE_SSE2
+	inline __m128i scanline_texelSSE2(__m128i u, __m128i v, __m128i shift, __m128i mask63, __m128i texDataEnd)
+	{
+		const __m128i row = _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(u, shift), mask63), 6);
+		const __m128i col = _mm_and_si128(_mm_srl_epi32(v, shift), mask63);
+		return _mm_and_si128(_mm_or_si128(row, col), texDataEnd);
+	}
+
+	// Texel indices are at most 4095 so they pack into 16 bit lanes without saturating.
+	template<bool lit>
+	inline void scanline_fetchSSE2(__m128i t01, __m128i t23, const u8* tex, const u8* colorMap, u8* base, u8* color)
+	{
+		base[15] = tex[_mm_extract_epi16(t01, 0)];
+		base[14] = tex[_mm_extract_epi16(t01, 1)];
+		base[13] = tex[_mm_extract_epi16(t01, 2)];
+		base[12] = tex[_mm_extract_epi16(t01, 3)];
+		base[11] = tex[_mm_extract_epi16(t01, 4)];
+		base[10] = tex[_mm_extract_epi16(t01, 5)];
+		base[9]  = tex[_mm_extract_epi16(t01, 6)];
+		base[8]  = tex[_mm_extract_epi16(t01, 7)];
+		base[7]  = tex[_mm_extract_epi16(t23, 0)];
+		base[6]  = tex[_mm_extract_epi16(t23, 1)];
+		base[5]  = tex[_mm_extract_epi16(t23, 2)];
+		base[4]  = tex[_mm_extract_epi16(t23, 3)];
+		base[3]  = tex[_mm_extract_epi16(t23, 4)];
+		base[2]  = tex[_mm_extract_epi16(t23, 5)];
+		base[1]  = tex[_mm_extract_epi16(t23, 6)];
+		base[0]  = tex[_mm_extract_epi16(t23, 7)];
+		if (lit)
+		{
+			for (s32 j = 0; j < SCANLINE_BLOCK; j++)
+			{
+				color[j] = colorMap[base[j]];
+			}
+		}
+	}
+
+	template<bool lit, bool trans>
+	void scanline_kernelSSE2(u8* out, s32 count, const u8* tex, const u8* colorMap, u32 u, u32 v, u32 dU, u32 dV, u32 fracBits, u32 texDataEnd)
+	{
+		const __m128i shift  = _mm_cvtsi32_si128(s32(fracBits));
+		const __m128i mask63 = _mm_set1_epi32(63);
+		const __m128i endMask = _mm_set1_epi32(s32(texDataEnd));
+		const __m128i stepU  = _mm_set1_epi32(s32(dU * SCANLINE_BLOCK));
+		const __m128i stepV  = _mm_set1_epi32(s32(dV * SCANLINE_BLOCK));
+
+		__m128i uLane[4], vLane[4];
+		uLane[0] = _mm_setr_epi32(s32(u), s32(u + dU), s32(u + dU * 2), s32(u + dU * 3));
+		vLane[0] = _mm_setr_epi32(s32(v), s32(v + dV), s32(v + dV * 2), s32(v + dV * 3));
+		for (s32 k = 1; k < 4; k++)
+		{
+			uLane[k] = _mm_add_epi32(uLane[k - 1], _mm_set1_epi32(s32(dU * 4)));
+			vLane[k] = _mm_add_epi32(vLane[k - 1], _mm_set1_epi32(s32(dV * 4)));
+		}
+
+		alignas(16) u8 base[SCANLINE_BLOCK];
+		alignas(16) u8 color[SCANLINE_BLOCK];
+		s32 i = count;
+		for (; i >= SCANLINE_BLOCK; i -= SCANLINE_BLOCK)
+		{
+			const __m128i t0 = scanline_texelSSE2(uLane[0], vLane[0], shift, mask63, endMask);
+			const __m128i t1 = scanline_texelSSE2(uLane[1], vLane[1], shift, mask63, endMask);
+			const __m128i t2 = scanline_texelSSE2(uLane[2], vLane[2], shift, mask63, endMask);
+			const __m128i t3 = scanline_texelSSE2(uLane[3], vLane[3], shift, mask63, endMask);
+			for (s32 k = 0; k < 4; k++)
+			{
+				uLane[k] = _mm_add_epi32(uLane[k], stepU);
+				vLane[k] = _mm_add_epi32(vLane[k], stepV);
+			}
+
+			scanline_fetchSSE2<lit>(_mm_packs_epi32(t0, t1), _mm_packs_epi32(t2, t3), tex, colorMap, base, color);
+			__m128i result = _mm_load_si128((const __m128i*)(lit ? color : base));
+
+			u8* dst = out + i - SCANLINE_BLOCK;
+			if (trans)
+			{
+				// Keep the existing pixels where the texel is transparent.
+				const __m128i transparent = _mm_cmpeq_epi8(_mm_load_si128((const __m128i*)base), _mm_setzero_si128());
+				const __m128i prev = _mm_loadu_si128((const __m128i*)dst);
+				result = _mm_or_si128(_mm_and_si128(transparent, prev), _mm_andnot_si128(transparent, result));
+			}
+			_mm_storeu_si128((__m128i*)dst, result);
+		}
+
+		const s32 stepped = count - i;
+		scanline_drawRemainder<lit, trans>(out, i, tex, colorMap, u + u32(stepped) * dU, v + u32(stepped) * dV, dU, dV, fracBits, texDataEnd);
+	}
+#endif
+
+#ifdef SCANLINE_NEON
+	inline uint16x4_t scanline_texelNEON(uint32x4_t u, uint32x4_t v, int32x4_t shift, uint32x4_t mask63, uint32x4_t texDataEnd)
+	{
+		const uint32x4_t row = vshlq_n_u32(vandq_u32(vshlq_u32(u, shift), mask63), 6);
+		const uint32x4_t col = vandq_u32(vshlq_u32(v, shift), mask63);
+		return vmovn_u32(vandq_u32(vorrq_u32(row, col), texDataEnd));
+	}
+
+	template<bool lit, bool trans>
+	void scanline_kernelNEON(u8* out, s32 count, const u8* tex, const u8* colorMap, u32 u, u32 v, u32 dU, u32 dV, u32 fracBits, u32 texDataEnd)
+	{
+		const int32x4_t  shift  = vdupq_n_s32(-s32(fracBits));
+		const uint32x4_t mask63 = vdupq_n_u32(63);
+		const uint32x4_t endMask = vdupq_n_u32(texDataEnd);
+		const uint32x4_t stepU  = vdupq_n_u32(dU * SCANLINE_BLOCK);
+		const uint32x4_t stepV  = vdupq_n_u32(dV * SCANLINE_BLOCK);
+
+		const u32 startU[4] = { u, u + dU, u + dU * 2, u + dU * 3 };
+		const u32 startV[4] = { v, v + dV, v + dV * 2, v + dV * 3 };
+		uint32x4_t uLane[4], vLane[4];
+		uLane[0] = vld1q_u32(startU);
+		vLane[0] = vld1q_u32(startV);
+		for (s32 k = 1; k < 4; k++)
+		{
+			uLane[k] = vaddq_u32(uLane[k - 1], vdupq_n_u32(dU * 4));
+			vLane[k] = vaddq_u32(vLane[k - 1], vdupq_n_u32(dV * 4));
+		}
+
+		alignas(16) u16 texel[SCANLINE_BLOCK];
+		alignas(16) u8 base[SCANLINE_BLOCK];
+		alignas(16) u8 color[SCANLINE_BLOCK];
+		s32 i = count;
+		for (; i >= SCANLINE_BLOCK; i -= SCANLINE_BLOCK)
+		{
+			vst1q_u16(&texel[0], vcombine_u16(scanline_texelNEON(uLane[0], vLane[0], shift, mask63, endMask),
+			                                  scanline_texelNEON(uLane[1], vLane[1], shift, mask63, endMask)));
+			vst1q_u16(&texel[8], vcombine_u16(scanline_texelNEON(uLane[2], vLane[2], shift, mask63, endMask),
+			                                  scanline_texelNEON(uLane[3], vLane[3], shift, mask63, endMask)));
+			for (s32 k = 0; k < 4; k++)
+			{
+				uLane[k] = vaddq_u32(uLane[k], stepU);
+				vLane[k] = vaddq_u32(vLane[k], stepV);
+			}
+
+			scanline_fetchBlock<lit>(texel, tex, colorMap, base, color);
+			uint8x16_t result = vld1q_u8(lit ? color : base);
+
+			u8* dst = out + i - SCANLINE_BLOCK;
+			if (trans)
+			{
+				// Keep the existing pixels where the texel is transparent.
+				const uint8x16_t transparent = vceqq_u8(vld1q_u8(base), vdupq_n_u8(0));
+				result = vbslq_u8(transparent, vld1q_u8(dst), result);
+			}
+			vst1q_u8(dst, result);
+		}
+
+		const s32 stepped = count - i;
+		scanline_drawRemainder<lit, trans>(out, i, tex, colorMap, u + u32(stepped) * dU, v + u32(stepped) * dV, dU, dV, fracBits, texDataEnd);
+	}
+#endif
+
+	void scanline_init()
+	{
+		for (s32 i = 0; i < SCANKERNEL_COUNT; i++)
+		{
+			s_scanlineKernels[i] = nullptr;
+		}
+
+#ifdef SCANLINE_SSE2
+		if (SDL_HasSSE2())
+		{
+			s_scanlineKernels[SCANKERNEL_LIT]              = scanline_kernelSSE2<true,  false>;
+			s_scanlineKernels[SCANKERNEL_FULLBRIGHT]       = scanline_kernelSSE2<false, false>;
+			s_scanlineKernels[SCANKERNEL_LIT_TRANS]        = scanline_kernelSSE2<true,  true>;
+			s_scanlineKernels[SCANKERNEL_FULLBRIGHT_TRANS] = scanline_kernelSSE2<false, true>;
+			TFE_System::logWrite(LOG_MSG, "Renderer", "Using SSE2 scanline kernels.");
+		}
+#endif
+#ifdef SCANLINE_NEON
+		if (SDL_HasNEON())
+		{
+			s_scanlineKernels[SCANKERNEL_LIT]              = scanline_kernelNEON<true,  false>;
+			s_scanlineKernels[SCANKERNEL_FULLBRIGHT]       = scanline_kernelNEON<false, false>;
+			s_scanlineKernels[SCANKERNEL_LIT_TRANS]        = scanline_kernelNEON<true,  true>;
+			s_scanlineKernels[SCANKERNEL_FULLBRIGHT_TRANS] = scanline_kernelNEON<false, true>;
+			TFE_System::logWrite(LOG_MSG, "Renderer", "Using NEON scanline kernels.");
+		}
+#endif
+	}
+
+	ScanlineKernel scanline_getKernel(ScanlineKernelId id)
+	{
+		return s_simdScanlines ? s_scanlineKernels[id] : nullptr;
+	}
+}
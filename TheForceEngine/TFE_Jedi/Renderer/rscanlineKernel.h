@@ -0,0 +1,38 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Scanline Kernels
+// Dark Forces Derived Renderer - SIMD flat scanline drawing
+//
+// Vectorized versions of the floor and ceiling scanline loops shared
+// by the fixed and float sub-renderers. The texture coordinates of 16
+// pixels are stepped at once, the texels are fetched and lit and then
+// written with a single store. The kernels are selected at runtime
+// based on the CPU and the scalar loops in the sub-renderers remain
+// the reference, used when no kernel is available.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+
+namespace TFE_Jedi
+{
+	enum ScanlineKernelId
+	{
+		SCANKERNEL_LIT = 0,
+		SCANKERNEL_FULLBRIGHT,
+		SCANKERNEL_LIT_TRANS,
+		SCANKERNEL_FULLBRIGHT_TRANS,
+
+		SCANKERNEL_COUNT
+	};
+
+	// Draws 'count' pixels from right to left, the first pixel is at out[count - 1].
+	// Pixel 'i' uses texel tex[((((u + i*dU) >> fracBits) & 63) * 64 + (((v + i*dV) >> fracBits) & 63)) & texDataEnd],
+	// computed with 32-bit wrapping math. Like the original this assumes a 64x64 texture.
+	typedef void(*ScanlineKernel)(u8* out, s32 count, const u8* tex, const u8* colorMap, u32 u, u32 v, u32 dU, u32 dV, u32 fracBits, u32 texDataEnd);
+
+	extern bool s_simdScanlines;
+
+	// Select the kernels supported by the CPU.
+	void scanline_init();
+	// Returns nullptr if SIMD kernels are disabled or there is no kernel for this CPU.
+	ScanlineKernel scanline_getKernel(ScanlineKernelId id);
+}
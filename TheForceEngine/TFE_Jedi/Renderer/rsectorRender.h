@@ -11,6 +11,7 @@
 struct TextureFrame;
 struct RWall;
 struct SecObject;
+class Stream;
 
 namespace TFE_Jedi
 {
@@ -60,7 +61,11 @@ namespace TFE_Jedi
 		virtual void reset() = 0;
 		virtual void prepare() = 0;
 		virtual void draw(RSector* sector) = 0;
+		// Called after the top level draw() returns.
+		virtual void finish() {}
 		virtual void subrendererChanged() = 0;
+		// Copy the pointers to data cached in the level region for in-place save states.
+		virtual void serializeInPlace(Stream* stream) {}
 
 		// Tests if a point (p2) is to the left, on or right of an infinite line (p0 -> p1).
 		// Return: >0 p2 is on the left of the line.
@@ -0,0 +1,151 @@
+#include "rspriteCache.h"
+#include "rcommon.h"
+#include <TFE_System/system.h>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace TFE_Jedi
+{
+	enum
+	{
+		SPRITE_CACHE_BUDGET = 16 * 1024 * 1024,
+		SPRITE_CACHE_ENTRY_SIZE = 64,	// Approximate overhead of an entry, so cells that are only seen once still count.
+	};
+
+	struct SpriteCacheEntry
+	{
+		const WaxCell* cell;
+		u8*    data;		// Decompressed columns, null until the cell is used in a second frame.
+		size_t size;		// Memory used by the entry in bytes.
+		s32    lastFrame;	// Frame the cell was last used.
+
+		// Least-recently-used list, the most recently used entry is at the head.
+		SpriteCacheEntry* prev;
+		SpriteCacheEntry* next;
+	};
+	typedef std::unordered_map<const WaxCell*, SpriteCacheEntry> SpriteCacheMap;
+
+	bool s_spriteCache = true;
+
+	static SpriteCacheMap s_cacheMap;
+	static SpriteCacheEntry* s_cacheHead = nullptr;
+	static SpriteCacheEntry* s_cacheTail = nullptr;
+	static size_t s_cacheSize = 0;
+	static u32 s_cacheAssetGen = 0;
+
+	void spriteCache_unlink(SpriteCacheEntry* entry)
+	{
+		if (entry->prev) { entry->prev->next = entry->next; }
+		else { s_cacheHead = entry->next; }
+		if (entry->next) { entry->next->prev = entry->prev; }
+		else { s_cacheTail = entry->prev; }
+		entry->prev = nullptr;
+		entry->next = nullptr;
+	}
+
+	void spriteCache_pushFront(SpriteCacheEntry* entry)
+	{
+		entry->prev = nullptr;
+		entry->next = s_cacheHead;
+		if (s_cacheHead) { s_cacheHead->prev = entry; }
+		else { s_cacheTail = entry; }
+		s_cacheHead = entry;
+	}
+
+	void spriteCache_clear()
+	{
+		for (SpriteCacheMap::iterator iEntry = s_cacheMap.begin(); iEntry != s_cacheMap.end(); ++iEntry)
+		{
+			free(iEntry->second.data);
+		}
+		s_cacheMap.clear();
+		s_cacheHead = nullptr;
+		s_cacheTail = nullptr;
+		s_cacheSize = 0;
+	}
+
+	// Evict least-recently-used entries until 'size' more bytes fit in the budget.
+	// Returns false if that would require evicting a cell used in the current frame.
+	bool spriteCache_makeRoom(size_t size)
+	{
+		while (s_cacheSize + size > SPRITE_CACHE_BUDGET)
+		{
+			SpriteCacheEntry* entry = s_cacheTail;
+			if (!entry || entry->lastFrame == s_drawFrame)
+			{
+				return false;
+			}
+
+			spriteCache_unlink(entry);
+			s_cacheSize -= entry->size;
+			free(entry->data);
+			s_cacheMap.erase(entry->cell);
+		}
+		return true;
+	}
+
+	void spriteCache_decompressCell(const WaxCell* cell, const u8* basePtr, u8* data)
+	{
+		const u32* columnOffset = (u32*)(basePtr + cell->columnOffset);
+		for (s32 x = 0; x < cell->sizeX; x++, data += cell->sizeY)
+		{
+			sprite_decompressColumn((u8*)cell + columnOffset[x], data, cell->sizeY);
+		}
+	}
+
+	const u8* spriteCache_getCell(const WaxCell* cell, const u8* basePtr)
+	{
+		if (!s_spriteCache) { return nullptr; }
+
+		// Cells are looked up by address, so start over if sprite memory has been freed since they were cached.
+		const u32 assetGen = TFE_Sprite_Jedi::getFreeGeneration();
+		if (assetGen != s_cacheAssetGen)
+		{
+			spriteCache_clear();
+			s_cacheAssetGen = assetGen;
+		}
+
+		SpriteCacheMap::iterator iEntry = s_cacheMap.find(cell);
+		if (iEntry == s_cacheMap.end())
+		{
+			// Only remember the cell the first time it is seen, a sprite that is drawn once is not worth decompressing in full.
+			if (!spriteCache_makeRoom(SPRITE_CACHE_ENTRY_SIZE)) { return nullptr; }
+
+			SpriteCacheEntry* entry = &s_cacheMap[cell];
+			entry->cell = cell;
+			entry->data = nullptr;
+			entry->size = SPRITE_CACHE_ENTRY_SIZE;
+			entry->lastFrame = s_drawFrame;
+			spriteCache_pushFront(entry);
+			s_cacheSize += entry->size;
+			return nullptr;
+		}
+
+		SpriteCacheEntry* entry = &iEntry->second;
+		if (entry != s_cacheHead)
+		{
+			spriteCache_unlink(entry);
+			spriteCache_pushFront(entry);
+		}
+
+		if (!entry->data && entry->lastFrame != s_drawFrame)
+		{
+			// Make room with the entry pinned to the current frame so it is not evicted itself.
+			const size_t dataSize = size_t(cell->sizeX) * size_t(cell->sizeY);
+			entry->lastFrame = s_drawFrame;
+			if (!spriteCache_makeRoom(dataSize)) { return nullptr; }
+
+			entry->data = (u8*)malloc(dataSize);
+			if (!entry->data)
+			{
+				TFE_System::logWrite(LOG_ERROR, "Sprite Cache", "Failed to allocate %u bytes for a decompressed sprite cell.", u32(dataSize));
+				return nullptr;
+			}
+			spriteCache_decompressCell(cell, basePtr, entry->data);
+			entry->size += dataSize;
+			s_cacheSize += dataSize;
+		}
+		entry->lastFrame = s_drawFrame;
+		return entry->data;
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+//////////////////////////////////////////////////////////////////////
+// Sprite Cache
+// Dark Forces Derived Renderer - Decompressed sprite cells
+//
+// Compressed WAX and FME cells are normally decompressed one column
+// at a time, every time the sprite is drawn. Cells that are drawn in
+// more than one frame are instead decompressed once and kept in a
+// least-recently-used cache so the columns can be drawn directly.
+// Cells used in the current frame are never evicted, since recorded
+// strip draws may still reference them.
+//////////////////////////////////////////////////////////////////////
+#include <TFE_System/types.h>
+#include <TFE_Asset/spriteAsset_Jedi.h>
+
+namespace TFE_Jedi
+{
+	extern bool s_spriteCache;
+
+	// Returns the decompressed cell, stored column by column with 'sizeY' bytes per column,
+	// or nullptr if the cell should be decompressed per column this frame.
+	const u8* spriteCache_getCell(const WaxCell* cell, const u8* basePtr);
+	// Free all cached cells.
+	void spriteCache_clear();
+}
@@ -7,6 +7,9 @@
 //////////////////////////////////////////////////////////////////////
 #include <TFE_System/types.h>
 #include <TFE_FileSystem/stream.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 #include <TFE_DarkForces/sound.h>
 #include <TFE_Jedi/Level/level.h>
 #include <TFE_Jedi/Level/rtexture.h>
@@ -58,6 +61,25 @@ namespace TFE_Jedi
 			else { memset(x, 0, s); } \
 		}
 
+	// Serialize a run of plain-old-data fields, 'first' through 'last' of the struct pointed to by 'obj', with a single stream call.
+	// The fields must be adjacent in memory without padding, so that the stream layout is the same as serializing them one at a time;
+	// 'size' is the expected size of the run in bytes and is checked at compile time.
+	// 'v' is the newest version of any field in the run. The macro evaluates to false if the stream is older, in which case
+	// the caller falls back to serializing the fields individually, with their own versions and defaults:
+	//   if (!SERIALIZE_RUN(v, RSector, sector, floorHeight, ambient, 4 * sizeof(fixed16_16))) { SERIALIZE(v, sector->floorHeight, 0); ... }
+	#define SERIALIZE_RUN(v, type, obj, first, last, size) \
+		(serialization_checkRun<offsetof(type, first), offsetof(type, last) + sizeof(type::last), (size)>() && \
+		 serialization_serializeRun(stream, v, &(obj)->first, (size)))
+
+	// Serialize an array of simple structs with a single stream call.
+	#define SERIALIZE_ARRAY(v, arr, count) \
+		static_assert(std::is_trivially_copyable<std::remove_pointer<decltype(arr)>::type>::value, "SERIALIZE_ARRAY requires trivially copyable elements."); \
+		SERIALIZE_BUF(v, arr, u32((count) * sizeof(*(arr))))
+
+	// Copy a variable as is, including any pointers it holds. Only used by in-place save states, which restore the memory
+	// regions at the same addresses within the same level, so pointers into the regions stay valid.
+	#define SERIALIZE_INPLACE(x) serialization_serializeInPlace(stream, &(x))
+
 	// Discard values that were previously added. This might mean skipping over data in the stream and ignoring it.
 	// This is done by advancing the stream by the size of the type or buffer.
 	// v0 = version added, v1 = version removed.
@@ -67,6 +89,30 @@ namespace TFE_Jedi
 	inline void serialization_setVersion(u32 version) { s_sVersion = version; }
 	inline void serialization_setMode(SerializationMode mode) { s_sMode = mode; }
 	inline SerializationMode serialization_getMode() { return s_sMode; }
+
+	template<size_t begin, size_t end, size_t size>
+	inline bool serialization_checkRun()
+	{
+		static_assert(end - begin == size, "SERIALIZE_RUN fields are not contiguous - check for padding or fields that are not serialized.");
+		return true;
+	}
+
+	// The type is copied as raw bytes, so it must not own resources or have a user-defined copy.
+	template<typename T>
+	inline void serialization_serializeInPlace(Stream* stream, T* x)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "SERIALIZE_INPLACE requires a trivially copyable type.");
+		if (s_sMode == SMODE_WRITE) { stream->writeBuffer(x, u32(sizeof(T))); }
+		else if (s_sMode == SMODE_READ) { stream->readBuffer(x, u32(sizeof(T))); }
+	}
+
+	inline bool serialization_serializeRun(Stream* stream, u32 version, void* data, u32 size)
+	{
+		if (s_sVersion < version) { return false; }
+		if (s_sMode == SMODE_WRITE) { stream->writeBuffer(data, size); }
+		else if (s_sMode == SMODE_READ) { stream->readBuffer(data, size); }
+		return true;
+	}
 		
 	void serialization_serializeDfSound(Stream* stream, u32 version, SoundSourceId* id);
 	void serialization_serializeSectorPtr(Stream* stream, u32 version, RSector*& sector);
@@ -214,6 +214,22 @@ namespace TFE_Jedi
 		}
 	}
 
+	void task_serializeInPlace(Stream* stream)
+	{
+		// Tasks and their stacks live in the game region, only the task list state needs to be copied.
+		SERIALIZE_INPLACE(s_tasks);
+		SERIALIZE_INPLACE(s_stackBlocks);
+		SERIALIZE_INPLACE(s_taskCount);
+		SERIALIZE_INPLACE(s_rootTask);
+		SERIALIZE_INPLACE(s_taskIter);
+		SERIALIZE_INPLACE(s_curTask);
+		SERIALIZE_INPLACE(s_currentMsg);
+		SERIALIZE_INPLACE(s_curContext);
+		SERIALIZE_INPLACE(s_frameActiveTaskCount);
+		SERIALIZE_INPLACE(s_taskSystemPaused);
+		SERIALIZE_INPLACE(s_taskPauseTask);
+	}
+
 	Task* task_getCurrent()
 	{
 		return s_curTask;
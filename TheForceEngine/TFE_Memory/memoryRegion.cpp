@@ -10,6 +10,16 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <algorithm>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 // #define _VERIFY_MEMORY
 
@@ -33,6 +43,9 @@ enum
 	MAX_BLOCK_SIZE  = 16 * 1024 * 1024,
 	RELATIVE_NON_NULL_BIT = 1u,
 	SHARED_HEADER_SIZE = 8,	// 8 bytes are shared between RegionAllocHeader{} and AllocHeaderFree{}
+	PAGE_SIZE = 4096,		// Granularity of page tracking, matches the OS page size where writes are tracked.
+	PAGE_LIST_END = 0xffffffff,
+	PAGE_MIN_ZERO_RUN = 8,	// Shortest run of unchanged bytes that ends a literal run when encoding a page.
 };
 
 struct RegionAllocHeader
@@ -85,6 +98,13 @@ struct MemoryRegion
 	size_t blockCount;
 	size_t blockSize;
 	size_t maxBlocks;
+	// Incremented each time the region is cleared, so state captured from it can be matched to the same contents.
+	u32 generation;
+	// Page tracking: a copy of each block as of the last capture, see region_capturePageChanges().
+	u8** shadowBlocks;
+	size_t shadowBlockCount;
+	// One byte per page of each shadowed block, set when the page may differ from its copy.
+	u8* dirtyPages;
 };
 
 static_assert(sizeof(RegionAllocHeader) == 16, "RegionAllocHeader is the wrong size.");
@@ -97,6 +117,8 @@ namespace TFE_Memory
 	static const u32 c_relativeBlockShift = 24u;
 	static const u32 c_relativeOffsetMask = (1u << c_relativeBlockShift) - 1u;
 
+	MemoryBlock* allocBlockMemory(size_t blockSize);
+	void freeBlockMemory(MemoryBlock* block, size_t blockSize);
 	void freeSlot(RegionAllocHeader* alloc, RegionAllocHeader* next, MemoryBlock* block);
 	size_t alloc_align(size_t baseSize);
 	s32  getBinFromSize(u32 size);
@@ -104,6 +126,12 @@ namespace TFE_Memory
 	void removeHeaderFromFreelist(MemoryBlock* block, RegionAllocHeader* header);
 	void insertBlockIntoFreelist(MemoryBlock* block, RegionAllocHeader* header);
 
+	// Blocks are allocated separately and are not in address order, so the whole range has to be checked.
+	static bool isInBlock(const MemoryRegion* region, const MemoryBlock* block, const void* ptr)
+	{
+		return ptr >= block && ptr < (const u8*)block + sizeof(MemoryBlock) + region->blockSize;
+	}
+
 	void verifyMemory(MemoryRegion* region)
 	{
 		for (s32 i = 0; i < region->blockCount; i++)
@@ -160,6 +188,10 @@ namespace TFE_Memory
 		region->blockCount = 0;
 		region->blockSize = blockSize;
 		region->maxBlocks = maxSize ? (maxSize + blockSize - 1) / blockSize : 0;
+		region->generation = 0;
+		region->shadowBlocks = nullptr;
+		region->shadowBlockCount = 0;
+		region->dirtyPages = nullptr;
 		if (!allocateNewBlock(region))
 		{
 			free(region);
@@ -171,30 +203,42 @@ namespace TFE_Memory
 		return region;
 	}
 
+	static void clearBlock(MemoryRegion* region, MemoryBlock* block)
+	{
+		block->sizeFree = u32(region->blockSize);
+		block->count = 1;
+
+		RegionAllocHeader* header = (RegionAllocHeader*)((u8*)block + sizeof(MemoryBlock));
+		header->size = block->sizeFree;
+		header->free = 0;
+		memset(block->freeListBins, 0, sizeof(AllocHeaderFree*)*ALLOC_BIN_COUNT);
+		insertBlockIntoFreelist(block, header);
+	}
+
 	void region_clear(MemoryRegion* region)
 	{
 		assert(region);
 		for (s32 i = 0; i < region->blockCount; i++)
 		{
-			MemoryBlock* block = region->memBlocks[i];
-			block->sizeFree = u32(region->blockSize);
-			block->count = 1;
-
-			RegionAllocHeader* header = (RegionAllocHeader*)((u8*)block + sizeof(MemoryBlock));
-			header->size = block->sizeFree;
-			header->free = 0;
-			memset(block->freeListBins, 0, sizeof(AllocHeaderFree*)*ALLOC_BIN_COUNT);
-			insertBlockIntoFreelist(block, header);
+			clearBlock(region, region->memBlocks[i]);
 			VERIFY_MEMORY();
 		}
+		region->generation++;
+	}
+
+	u32 region_getGeneration(MemoryRegion* region)
+	{
+		assert(region);
+		return region->generation;
 	}
 
 	void region_destroy(MemoryRegion* region)
 	{
 		assert(region);
+		region_clearPageTracking(region);
 		for (s32 i = 0; i < region->blockCount; i++)
 		{
-			free(region->memBlocks[i]);
+			freeBlockMemory(region->memBlocks[i], region->blockSize);
 		}
 		free(region->memBlocks);
 		free(region);
@@ -304,7 +348,7 @@ namespace TFE_Memory
 		for (s32 i = (s32)region->blockCount - 1; i >= 0; i--)
 		{
 			MemoryBlock* block = region->memBlocks[i];
-			if (ptr >= block)
+			if (isInBlock(region, block, ptr))
 			{
 				RegionAllocHeader* header = (RegionAllocHeader*)((u8*)ptr - sizeof(RegionAllocHeader));
 				RegionAllocHeader* nextHeader = (RegionAllocHeader*)((u8*)header + header->size);
@@ -384,7 +428,7 @@ namespace TFE_Memory
 		for (s32 i = (s32)region->blockCount - 1; i >= 0; i--)
 		{
 			MemoryBlock* block = region->memBlocks[i];
-			if (ptr >= block)
+			if (isInBlock(region, block, ptr))
 			{
 				RegionAllocHeader* header = (RegionAllocHeader*)((u8*)ptr - sizeof(RegionAllocHeader));
 				RegionAllocHeader* nextHeader = (RegionAllocHeader*)((u8*)header + header->size);
@@ -437,7 +481,7 @@ namespace TFE_Memory
 		for (s32 i = (s32)region->blockCount - 1; i >= 0; i--)
 		{
 			MemoryBlock* block = region->memBlocks[i];
-			if (ptr >= block)
+			if (isInBlock(region, block, ptr))
 			{
 				rp = RelativePointer((u8*)ptr - (u8*)block - sizeof(MemoryBlock));
 				rp |= (i << c_relativeBlockShift);
@@ -472,28 +516,28 @@ namespace TFE_Memory
 		return (u8*)block + (ptr & c_relativeOffsetMask) + sizeof(MemoryBlock);
 	}
 
-	bool region_serializeToDisk(MemoryRegion* region, FileStream* file)
+	bool region_serializeToDisk(MemoryRegion* region, Stream* stream)
 	{
-		if (!region || !file || !file->isOpen())
+		if (!region || !stream)
 		{
 			return false;
 		}
 
-		file->writeBuffer(region->name, 32);
-		file->write(&region->blockArrCapacity);
-		file->write(&region->blockCount);
-		file->write(&region->blockSize);
-		file->write(&region->maxBlocks);
+		stream->writeBuffer(region->name, 32);
+		stream->write(&region->blockArrCapacity);
+		stream->write(&region->blockCount);
+		stream->write(&region->blockSize);
+		stream->write(&region->maxBlocks);
 
 		for (s32 b = 0; b < region->blockCount; b++)
 		{
 			MemoryBlock* block = region->memBlocks[b];
-			file->write(&block->count);
-			file->write(&block->sizeFree);
+			stream->write(&block->count);
+			stream->write(&block->sizeFree);
 			for (s32 bin = 0; bin < ALLOC_BIN_COUNT; bin++)
 			{
 				RelativePointer ptr = region_getRelativePointer(region, block->freeListBins[bin]);
-				file->write(&ptr);
+				stream->write(&ptr);
 			}
 
 			u8* memPtr = (u8*)block + sizeof(MemoryBlock);
@@ -503,16 +547,16 @@ namespace TFE_Memory
 				if (header->free)
 				{
 					AllocHeaderFree* freeHeader = (AllocHeaderFree*)memPtr;
-					file->writeBuffer(freeHeader, SHARED_HEADER_SIZE);
+					stream->writeBuffer(freeHeader, SHARED_HEADER_SIZE);
 
 					RelativePointer binNext = region_getRelativePointer(region, freeHeader->binNext);
 					RelativePointer binPrev = region_getRelativePointer(region, freeHeader->binPrev);
-					file->write(&binNext);
-					file->write(&binPrev);
+					stream->write(&binNext);
+					stream->write(&binPrev);
 				}
 				else
 				{
-					file->writeBuffer(header, header->size);
+					stream->writeBuffer(header, header->size);
 				}
 
 				memPtr += header->size;
@@ -522,16 +566,23 @@ namespace TFE_Memory
 		return true;
 	}
 
-	MemoryRegion* region_restoreFromDisk(MemoryRegion* region, FileStream* file)
+	MemoryRegion* region_restoreFromDisk(MemoryRegion* region, Stream* stream)
 	{
-		if (!file || !file->isOpen())
+		if (!stream)
 		{
 			return nullptr;
 		}
 		if (!region)
 		{
 			region = (MemoryRegion*)malloc(sizeof(MemoryRegion));
-			region->blockArrCapacity = 0;
+			if (region)
+			{
+				region->blockArrCapacity = 0;
+				region->generation = 0;
+				region->shadowBlocks = nullptr;
+				region->shadowBlockCount = 0;
+				region->dirtyPages = nullptr;
+			}
 		}
 		if (!region)
 		{
@@ -540,30 +591,32 @@ namespace TFE_Memory
 		}
 
 		size_t blockAllocStart = 0;
-		file->readBuffer(region->name, 32);
+		size_t blockKeepCount = 0;
+		stream->readBuffer(region->name, 32);
 		if (region->blockArrCapacity == 0)
 		{
-			file->read(&region->blockArrCapacity);
-			file->read(&region->blockCount);
-			file->read(&region->blockSize);
-			file->read(&region->maxBlocks);
+			stream->read(&region->blockArrCapacity);
+			stream->read(&region->blockCount);
+			stream->read(&region->blockSize);
+			stream->read(&region->maxBlocks);
 			region->memBlocks = (MemoryBlock**)malloc(sizeof(MemoryBlock*)*region->blockArrCapacity);
 		}
 		else
 		{
 			size_t blockArrCapacity, blockCount, blockSize, maxBlocks;
-			file->read(&blockArrCapacity);
-			file->read(&blockCount);
-			file->read(&blockSize);
-			file->read(&maxBlocks);
+			stream->read(&blockArrCapacity);
+			stream->read(&blockCount);
+			stream->read(&blockSize);
+			stream->read(&maxBlocks);
 
 			// The region is just too different, we have to start again.
 			if (blockSize != region->blockSize)
 			{
 				// Free memory since we have to reallocate from scratch.
+				region_clearPageTracking(region);
 				for (s32 i = 0; i < region->blockCount; i++)
 				{
-					free(region->memBlocks[i]);
+					freeBlockMemory(region->memBlocks[i], region->blockSize);
 				}
 				free(region->memBlocks);
 
@@ -577,7 +630,10 @@ namespace TFE_Memory
 			else  // We don't need to allocate from scratch.
 			{
 				// Don't reallocate existing blocks, just reset them.
+				// Blocks past the stored count are kept as empty blocks, so the existing memory is neither
+				// leaked nor moved, and pointers into the restored blocks stay valid.
 				blockAllocStart = region->blockCount;
+				blockKeepCount = region->blockCount > blockCount ? region->blockCount : 0;
 				// Only reallocate if the capacity is lower.
 				if (region->blockArrCapacity < blockArrCapacity)
 				{
@@ -602,23 +658,22 @@ namespace TFE_Memory
 			// Only allocate the block if it was not part of the original region passed in.
 			if (b >= blockAllocStart)
 			{
-				region->memBlocks[b] = (MemoryBlock*)malloc(sizeof(MemoryBlock) + region->blockSize);
+				region->memBlocks[b] = allocBlockMemory(region->blockSize);
 			}
 
 			MemoryBlock* block = region->memBlocks[b];
 			if (!block)
 			{
 				TFE_System::logWrite(LOG_ERROR, "MemoryRegion", "Invalid memory block.");
-				file->close();
 				return nullptr;
 			}
 
-			file->read(&block->count);
-			file->read(&block->sizeFree);
+			stream->read(&block->count);
+			stream->read(&block->sizeFree);
 			for (s32 bin = 0; bin < ALLOC_BIN_COUNT; bin++)
 			{
 				RelativePointer ptr;
-				file->read(&ptr);
+				stream->read(&ptr);
 				block->freeListBins[bin] = (AllocHeaderFree*)region_getRealPointer(region, ptr);
 			}
 
@@ -626,27 +681,32 @@ namespace TFE_Memory
 			for (u32 al = 0; al < block->count; al++)
 			{
 				RegionAllocHeader* header = (RegionAllocHeader*)memPtr;
-				file->readBuffer(header, SHARED_HEADER_SIZE);
+				stream->readBuffer(header, SHARED_HEADER_SIZE);
 
 				if (header->free)
 				{
 					AllocHeaderFree* freeHeader = (AllocHeaderFree*)memPtr;
 					RelativePointer binNext, binPrev;
-					file->read(&binNext);
-					file->read(&binPrev);
+					stream->read(&binNext);
+					stream->read(&binPrev);
 
 					freeHeader->binNext = (AllocHeaderFree*)region_getRealPointer(region, binNext);
 					freeHeader->binPrev = (AllocHeaderFree*)region_getRealPointer(region, binPrev);
 				}
 				else
 				{
-					file->readBuffer((u8*)header + SHARED_HEADER_SIZE, header->size - SHARED_HEADER_SIZE);
+					stream->readBuffer((u8*)header + SHARED_HEADER_SIZE, header->size - SHARED_HEADER_SIZE);
 				}
 
 				memPtr += header->size;
 			}
 		}
 
+		for (size_t b = region->blockCount; b < blockKeepCount; b++)
+		{
+			clearBlock(region, region->memBlocks[b]);
+		}
+		region->blockCount = std::max(region->blockCount, blockKeepCount);
 		return region;
 	}
 
@@ -773,7 +833,7 @@ namespace TFE_Memory
 
 		size_t blockIndex = region->blockCount;
 		assert(blockIndex < region->blockArrCapacity);
-		region->memBlocks[blockIndex] = (MemoryBlock*)malloc(sizeof(MemoryBlock) + region->blockSize);
+		region->memBlocks[blockIndex] = allocBlockMemory(region->blockSize);
 		if (!region->memBlocks[blockIndex])
 		{
 			TFE_System::logWrite(LOG_ERROR, "MemoryRegion", "Failed to allocate block of size %u in region '%s'.", region->blockSize, region->name);
@@ -801,6 +861,456 @@ namespace TFE_Memory
 	#define ALLOC_COUNT 20000
 	const size_t _testAllocSize[] = { 16, 32, 24, 100, 200, 500, 327, 537, 200, 17, 57, 387, 874, 204, 100, 22 };
 
+	////////////////////////////////////////////
+	// Page tracking
+	////////////////////////////////////////////
+	// Writes are tracked by the OS where possible, so a capture only has to look at the pages written since the last one:
+	// - Windows: blocks are allocated with MEM_WRITE_WATCH and read back with GetWriteWatch().
+	// - Linux: the soft-dirty bits in /proc/self/pagemap, which are cleared for the whole process through /proc/self/clear_refs.
+	// Otherwise every page in use is treated as written and compared against its copy.
+	enum WriteTracking
+	{
+		WRITE_TRACK_UNKNOWN = 0,
+		WRITE_TRACK_OS,
+		WRITE_TRACK_NONE,
+	};
+	static WriteTracking s_writeTracking = WRITE_TRACK_UNKNOWN;
+	// Regions with page tracking, on Linux the dirty bits of all of them are read before they are cleared.
+	static std::vector<MemoryRegion*> s_trackedRegions;
+#ifdef _WIN32
+	static std::vector<void*> s_writeWatchAddr;
+#elif defined(__linux__)
+	static s32 s_pagemapFile = -1;
+	static s32 s_clearRefsFile = -1;
+	static std::vector<u64> s_pagemapEntries;
+	static const u64 c_softDirtyBit = 1ull << 55ull;
+#endif
+
+	static size_t getBlockMemSize(const MemoryRegion* region)
+	{
+		return sizeof(MemoryBlock) + region->blockSize;
+	}
+
+	static size_t getBlockPageCount(const MemoryRegion* region)
+	{
+		return (getBlockMemSize(region) + PAGE_SIZE - 1) / PAGE_SIZE;
+	}
+
+#ifdef _WIN32
+	MemoryBlock* allocBlockMemory(size_t blockSize)
+	{
+		return (MemoryBlock*)VirtualAlloc(nullptr, sizeof(MemoryBlock) + blockSize, MEM_RESERVE | MEM_COMMIT | MEM_WRITE_WATCH, PAGE_READWRITE);
+	}
+
+	void freeBlockMemory(MemoryBlock* block, size_t blockSize)
+	{
+		if (block) { VirtualFree(block, 0, MEM_RELEASE); }
+	}
+
+	static bool initWriteTracking()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return info.dwPageSize == PAGE_SIZE;
+	}
+#elif defined(__linux__)
+	// Blocks are mapped directly so they start on a page boundary.
+	MemoryBlock* allocBlockMemory(size_t blockSize)
+	{
+		void* mem = mmap(nullptr, sizeof(MemoryBlock) + blockSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return mem == MAP_FAILED ? nullptr : (MemoryBlock*)mem;
+	}
+
+	void freeBlockMemory(MemoryBlock* block, size_t blockSize)
+	{
+		if (block) { munmap(block, sizeof(MemoryBlock) + blockSize); }
+	}
+
+	static bool clearSoftDirty()
+	{
+		return write(s_clearRefsFile, "4", 1) == 1;
+	}
+
+	static bool isSoftDirty(const void* page)
+	{
+		u64 entry = 0;
+		const off_t offset = off_t(size_t(page) / PAGE_SIZE * sizeof(u64));
+		return pread(s_pagemapFile, &entry, sizeof(u64), offset) == sizeof(u64) && (entry & c_softDirtyBit);
+	}
+
+	// Soft-dirty bits need a kernel built with CONFIG_MEM_SOFT_DIRTY, so check that a write to a test page is seen.
+	static bool initWriteTracking()
+	{
+		if (sysconf(_SC_PAGESIZE) != PAGE_SIZE) { return false; }
+		s_pagemapFile = open("/proc/self/pagemap", O_RDONLY);
+		s_clearRefsFile = open("/proc/self/clear_refs", O_WRONLY);
+
+		bool supported = false;
+		volatile u8* page = (volatile u8*)mmap(nullptr, PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (s_pagemapFile >= 0 && s_clearRefsFile >= 0 && page != MAP_FAILED)
+		{
+			page[0] = 1;
+			if (clearSoftDirty() && !isSoftDirty((const void*)page))
+			{
+				page[0] = 2;
+				supported = isSoftDirty((const void*)page);
+			}
+		}
+		if (page != MAP_FAILED) { munmap((void*)page, PAGE_SIZE); }
+
+		if (!supported)
+		{
+			if (s_pagemapFile >= 0)   { close(s_pagemapFile); }
+			if (s_clearRefsFile >= 0) { close(s_clearRefsFile); }
+			s_pagemapFile = -1;
+			s_clearRefsFile = -1;
+		}
+		return supported;
+	}
+#else
+	MemoryBlock* allocBlockMemory(size_t blockSize)
+	{
+		return (MemoryBlock*)malloc(sizeof(MemoryBlock) + blockSize);
+	}
+
+	void freeBlockMemory(MemoryBlock* block, size_t blockSize)
+	{
+		free(block);
+	}
+
+	static bool initWriteTracking()
+	{
+		return false;
+	}
+#endif
+
+	static WriteTracking getWriteTracking()
+	{
+		if (s_writeTracking == WRITE_TRACK_UNKNOWN)
+		{
+			s_writeTracking = initWriteTracking() ? WRITE_TRACK_OS : WRITE_TRACK_NONE;
+			if (s_writeTracking == WRITE_TRACK_NONE)
+			{
+				TFE_System::logWrite(LOG_WARNING, "MemoryRegion", "Page writes cannot be tracked on this system, changed pages are found by comparing all pages in use.");
+			}
+		}
+		return s_writeTracking;
+	}
+
+	// Returns the size of the block memory in use, past that point there is only free memory whose contents don't matter.
+	static size_t getBlockExtent(const u8* blockMem, size_t blockSize)
+	{
+		const size_t blockMemSize = sizeof(MemoryBlock) + blockSize;
+		const MemoryBlock* block = (const MemoryBlock*)blockMem;
+		size_t offset = sizeof(MemoryBlock);
+		size_t end = offset;
+		for (u32 a = 0; a < block->count && offset < blockMemSize; a++)
+		{
+			const RegionAllocHeader* header = (const RegionAllocHeader*)(blockMem + offset);
+			// Only the header of a free slot is in use.
+			end = offset + (header->free ? sizeof(AllocHeaderFree) : header->size);
+			if (!header->size) { break; }
+			offset += header->size;
+		}
+		return std::min(end, blockMemSize);
+	}
+
+	// Mark the pages of a region written since the last update as dirty.
+	static void updateDirtyPages(MemoryRegion* region)
+	{
+		const size_t pageCount = getBlockPageCount(region);
+		if (getWriteTracking() == WRITE_TRACK_NONE)
+		{
+			for (size_t b = 0; b < region->shadowBlockCount; b++)
+			{
+				const size_t extent = std::max(getBlockExtent((const u8*)region->memBlocks[b], region->blockSize), getBlockExtent(region->shadowBlocks[b], region->blockSize));
+				memset(region->dirtyPages + b * pageCount, 1, (extent + PAGE_SIZE - 1) / PAGE_SIZE);
+			}
+			return;
+		}
+
+#ifdef _WIN32
+		s_writeWatchAddr.resize(pageCount);
+		for (size_t b = 0; b < region->shadowBlockCount; b++)
+		{
+			const u8* blockMem = (const u8*)region->memBlocks[b];
+			ULONG_PTR count = pageCount;
+			DWORD granularity;
+			if (GetWriteWatch(WRITE_WATCH_FLAG_RESET, (void*)blockMem, getBlockMemSize(region), s_writeWatchAddr.data(), &count, &granularity) != 0)
+			{
+				// The pages cannot be read back, so treat them all as written.
+				memset(region->dirtyPages + b * pageCount, 1, pageCount);
+				continue;
+			}
+			for (ULONG_PTR i = 0; i < count; i++)
+			{
+				region->dirtyPages[b * pageCount + ((const u8*)s_writeWatchAddr[i] - blockMem) / PAGE_SIZE] = 1;
+			}
+		}
+#elif defined(__linux__)
+		// Clearing the bits affects every page in the process, so the bits of all tracked regions are read first.
+		for (size_t r = 0; r < s_trackedRegions.size(); r++)
+		{
+			MemoryRegion* tracked = s_trackedRegions[r];
+			const size_t trackedPageCount = getBlockPageCount(tracked);
+			s_pagemapEntries.resize(trackedPageCount);
+			for (size_t b = 0; b < tracked->shadowBlockCount; b++)
+			{
+				u8* dirty = tracked->dirtyPages + b * trackedPageCount;
+				const off_t offset = off_t(size_t(tracked->memBlocks[b]) / PAGE_SIZE * sizeof(u64));
+				const ssize_t readSize = ssize_t(trackedPageCount * sizeof(u64));
+				if (pread(s_pagemapFile, s_pagemapEntries.data(), readSize, offset) != readSize)
+				{
+					memset(dirty, 1, trackedPageCount);
+					continue;
+				}
+				for (size_t p = 0; p < trackedPageCount; p++)
+				{
+					if (s_pagemapEntries[p] & c_softDirtyBit) { dirty[p] = 1; }
+				}
+			}
+		}
+		if (!clearSoftDirty())
+		{
+			TFE_System::logWrite(LOG_WARNING, "MemoryRegion", "Failed to clear the soft-dirty bits, changed pages are found by comparing all pages in use.");
+			s_writeTracking = WRITE_TRACK_NONE;
+		}
+#endif
+	}
+
+	void region_clearPageTracking(MemoryRegion* region)
+	{
+		assert(region);
+		for (size_t b = 0; b < region->shadowBlockCount; b++)
+		{
+			free(region->shadowBlocks[b]);
+		}
+		free(region->shadowBlocks);
+		free(region->dirtyPages);
+		region->shadowBlocks = nullptr;
+		region->shadowBlockCount = 0;
+		region->dirtyPages = nullptr;
+		s_trackedRegions.erase(std::remove(s_trackedRegions.begin(), s_trackedRegions.end(), region), s_trackedRegions.end());
+	}
+
+	size_t region_getPageTrackingSize(MemoryRegion* region)
+	{
+		assert(region);
+		return region->shadowBlockCount * (getBlockMemSize(region) + getBlockPageCount(region));
+	}
+
+	// Write the difference between the old and new contents of a page as runs of unchanged bytes and changed bytes,
+	// each run pair is stored as { u16 unchanged, u16 changed, changed bytes XOR old bytes }.
+	// Returns 0 if the page did not change.
+	static u32 encodePage(const u8* oldPage, const u8* newPage, u32 size, u8* out)
+	{
+		u8* outStart = out;
+		u32 i = 0;
+		bool changed = false;
+		while (i < size)
+		{
+			const u32 zeroStart = i;
+			while (i < size && oldPage[i] == newPage[i]) { i++; }
+			const u32 litStart = i;
+			// Extend the literal run until a long enough run of unchanged bytes is found.
+			u32 zeroRun = 0;
+			while (i < size && zeroRun < PAGE_MIN_ZERO_RUN)
+			{
+				zeroRun = (oldPage[i] == newPage[i]) ? zeroRun + 1 : 0;
+				i++;
+			}
+			if (zeroRun >= PAGE_MIN_ZERO_RUN) { i -= zeroRun; }
+			const u32 litEnd = i;
+			if (litEnd == litStart) { break; }
+
+			changed = true;
+			const u16 runs[] = { u16(litStart - zeroStart), u16(litEnd - litStart) };
+			memcpy(out, runs, sizeof(runs));
+			out += sizeof(runs);
+			for (u32 j = litStart; j < litEnd; j++)
+			{
+				*out++ = oldPage[j] ^ newPage[j];
+			}
+		}
+		return changed ? u32(out - outStart) : 0;
+	}
+
+	// Apply a page difference written by encodePage(), the page ends with the last run.
+	static bool decodePage(Stream* stream, u8* page, u32 size, u32 encodedSize)
+	{
+		u8 literal[PAGE_SIZE];
+		u32 offset = 0;
+		u32 read = 0;
+		while (read < encodedSize)
+		{
+			u16 runs[2];
+			stream->readBuffer(runs, sizeof(runs));
+			offset += runs[0];
+			if (offset + runs[1] > size) { return false; }
+			stream->readBuffer(literal, runs[1]);
+			for (u32 j = 0; j < runs[1]; j++)
+			{
+				page[offset + j] ^= literal[j];
+			}
+			offset += runs[1];
+			read += u32(sizeof(runs)) + runs[1];
+		}
+		return read == encodedSize;
+	}
+
+	bool region_capturePageChanges(MemoryRegion* region, Stream* stream)
+	{
+		assert(region && stream);
+		const size_t blockMemSize = getBlockMemSize(region);
+		const size_t pageCount = getBlockPageCount(region);
+
+		// Find the pages written since the last capture before any new copies are taken.
+		updateDirtyPages(region);
+
+		// Blocks allocated since the last capture were not in use then, they only need a copy to compare against.
+		if (region->blockCount > region->shadowBlockCount)
+		{
+			u8** shadowBlocks = (u8**)realloc(region->shadowBlocks, sizeof(u8*) * region->blockCount);
+			u8* dirtyPages = shadowBlocks ? (u8*)realloc(region->dirtyPages, pageCount * region->blockCount) : nullptr;
+			if (shadowBlocks) { region->shadowBlocks = shadowBlocks; }
+			if (dirtyPages)   { region->dirtyPages = dirtyPages; }
+			if (!shadowBlocks || !dirtyPages)
+			{
+				region_clearPageTracking(region);
+				TFE_System::logWrite(LOG_ERROR, "MemoryRegion", "Failed to allocate page tracking for region '%s'.", region->name);
+				return false;
+			}
+			for (size_t b = region->shadowBlockCount; b < region->blockCount; b++)
+			{
+				region->shadowBlocks[b] = nullptr;
+			}
+			memset(region->dirtyPages + region->shadowBlockCount * pageCount, 0, (region->blockCount - region->shadowBlockCount) * pageCount);
+			if (std::find(s_trackedRegions.begin(), s_trackedRegions.end(), region) == s_trackedRegions.end())
+			{
+				s_trackedRegions.push_back(region);
+			}
+		}
+
+		u8 encoded[PAGE_SIZE + 4 * (PAGE_SIZE / (PAGE_MIN_ZERO_RUN + 1) + 1)];
+		const u32 blockCount = u32(region->shadowBlockCount);
+		stream->write(&blockCount);
+		for (size_t b = 0; b < region->blockCount; b++)
+		{
+			const u8* blockMem = (const u8*)region->memBlocks[b];
+			if (b >= region->shadowBlockCount)
+			{
+				region->shadowBlocks[b] = (u8*)malloc(blockMemSize);
+				if (!region->shadowBlocks[b])
+				{
+					region->shadowBlockCount = b;
+					region_clearPageTracking(region);
+					TFE_System::logWrite(LOG_ERROR, "MemoryRegion", "Failed to allocate page tracking for region '%s'.", region->name);
+					return false;
+				}
+				memcpy(region->shadowBlocks[b], blockMem, blockMemSize);
+				continue;
+			}
+
+			// The old contents of each written page are stored as the difference from the new contents.
+			u8* shadow = region->shadowBlocks[b];
+			u8* dirty = region->dirtyPages + b * pageCount;
+			for (size_t p = 0; p < pageCount; p++)
+			{
+				if (!dirty[p]) { continue; }
+				dirty[p] = 0;
+
+				const size_t offset = p * PAGE_SIZE;
+				const u32 size = u32(std::min(size_t(PAGE_SIZE), blockMemSize - offset));
+				const u32 encodedSize = encodePage(shadow + offset, blockMem + offset, size, encoded);
+				if (!encodedSize) { continue; }
+
+				const u32 page[] = { u32(b), u32(p), encodedSize };
+				stream->writeBuffer(page, sizeof(page));
+				stream->writeBuffer(encoded, encodedSize);
+				memcpy(shadow + offset, blockMem + offset, size);
+			}
+		}
+		region->shadowBlockCount = region->blockCount;
+
+		const u32 end = PAGE_LIST_END;
+		stream->write(&end);
+		return true;
+	}
+
+	void region_revertToCapture(MemoryRegion* region)
+	{
+		assert(region);
+		const size_t blockMemSize = getBlockMemSize(region);
+		const size_t pageCount = getBlockPageCount(region);
+
+		// Only the pages written since the capture can differ from the copy.
+		updateDirtyPages(region);
+		for (size_t b = 0; b < region->blockCount; b++)
+		{
+			if (b >= region->shadowBlockCount)
+			{
+				clearBlock(region, region->memBlocks[b]);
+				continue;
+			}
+			u8* dirty = region->dirtyPages + b * pageCount;
+			for (size_t p = 0; p < pageCount; p++)
+			{
+				if (!dirty[p]) { continue; }
+				dirty[p] = 0;
+
+				const size_t offset = p * PAGE_SIZE;
+				memcpy((u8*)region->memBlocks[b] + offset, region->shadowBlocks[b] + offset, std::min(size_t(PAGE_SIZE), blockMemSize - offset));
+			}
+		}
+	}
+
+	bool region_undoPageChanges(MemoryRegion* region, Stream* stream)
+	{
+		assert(region && stream);
+		const size_t blockMemSize = getBlockMemSize(region);
+		const size_t pageCount = getBlockPageCount(region);
+
+		u32 blockCount;
+		stream->read(&blockCount);
+		if (blockCount > region->shadowBlockCount)
+		{
+			TFE_System::logWrite(LOG_ERROR, "MemoryRegion", "Page changes for region '%s' have too many blocks: %u.", region->name, blockCount);
+			return false;
+		}
+		// Blocks allocated after the changes were not in use, only the start of the block holds allocator state.
+		for (size_t b = blockCount; b < region->shadowBlockCount; b++)
+		{
+			clearBlock(region, region->memBlocks[b]);
+			memcpy(region->shadowBlocks[b], region->memBlocks[b], std::min(size_t(PAGE_SIZE), blockMemSize));
+		}
+
+		for (;;)
+		{
+			u32 block, page, encodedSize;
+			stream->read(&block);
+			if (block == PAGE_LIST_END) { break; }
+			stream->read(&page);
+			stream->read(&encodedSize);
+			if (block >= blockCount || page >= pageCount)
+			{
+				TFE_System::logWrite(LOG_ERROR, "MemoryRegion", "Invalid page %u in block %u for region '%s'.", page, block, region->name);
+				return false;
+			}
+
+			// The copy holds the newer contents of the page, which the difference turns back into the older contents.
+			const size_t offset = size_t(page) * PAGE_SIZE;
+			const u32 size = u32(std::min(size_t(PAGE_SIZE), blockMemSize - offset));
+			u8* shadow = region->shadowBlocks[block] + offset;
+			if (!decodePage(stream, shadow, size, encodedSize))
+			{
+				TFE_System::logWrite(LOG_ERROR, "MemoryRegion", "Invalid changes to page %u in block %u for region '%s'.", page, block, region->name);
+				return false;
+			}
+			memcpy((u8*)region->memBlocks[block] + offset, shadow, size);
+		}
+		return true;
+	}
+
 	void region_test()
 	{
 		u64 start = TFE_System::getCurrentTimeInTicks();
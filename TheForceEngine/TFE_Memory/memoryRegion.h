@@ -17,6 +17,8 @@ namespace TFE_Memory
 {
 	MemoryRegion* region_create(const char* name, size_t blockSize, size_t maxSize = 0u);
 	void region_clear(MemoryRegion* region);
+	// The generation changes every time the region is cleared.
+	u32  region_getGeneration(MemoryRegion* region);
 	void region_destroy(MemoryRegion* region);
 
 	void* region_alloc(MemoryRegion* region, size_t size);
@@ -30,11 +32,24 @@ namespace TFE_Memory
 	RelativePointer region_getRelativePointer(MemoryRegion* region, void* ptr);
 	void* region_getRealPointer(MemoryRegion* region, RelativePointer ptr);
 
-	// TODO: Support writing to and restoring from streams in memory.
-	bool region_serializeToDisk(MemoryRegion* region, FileStream* file);
-	// Restore a region from disk. If 'region' is NULL then a new region is allocated,
+	// Write the region to a stream, which can either be a file or a stream in memory.
+	bool region_serializeToDisk(MemoryRegion* region, Stream* stream);
+	// Restore a region from a stream. If 'region' is NULL then a new region is allocated,
 	// otherwise it will attempt to reuse the existing region.
-	MemoryRegion* region_restoreFromDisk(MemoryRegion* region, FileStream* file);
+	MemoryRegion* region_restoreFromDisk(MemoryRegion* region, Stream* stream);
+
+	// Page tracking for incremental snapshots. The region keeps a copy of its memory as of the last capture,
+	// pages written since then are found through the OS where supported and compared against the copy.
+	// Write the difference between the old and new contents of the pages that changed since the last capture and
+	// update the copy. The first capture only takes the copy.
+	bool region_capturePageChanges(MemoryRegion* region, Stream* stream);
+	// Bring the region back to its contents at the last capture.
+	void region_revertToCapture(MemoryRegion* region);
+	// Undo changes written by region_capturePageChanges(), newest first, after region_revertToCapture().
+	bool region_undoPageChanges(MemoryRegion* region, Stream* stream);
+	void region_clearPageTracking(MemoryRegion* region);
+	// Memory used by the page copies and dirty page flags.
+	size_t region_getPageTrackingSize(MemoryRegion* region);
 
 	void region_test();
 }
\ No newline at end of file
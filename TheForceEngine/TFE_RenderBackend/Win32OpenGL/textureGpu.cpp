@@ -184,6 +184,30 @@ bool TextureGpu::update(const void* buffer, size_t size, s32 layer, s32 mipLevel
 	return true;
 }
 
+bool TextureGpu::updateRegion(const void* buffer, u32 x, u32 y, u32 width, u32 height, u32 rowLength, s32 layer, s32 mipLevel)
+{
+	if (width == 0 || height == 0) { return false; }
+
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+	if (m_layers == 1)
+	{
+		glBindTexture(GL_TEXTURE_2D, m_gpuHandle);
+		glTexSubImage2D(GL_TEXTURE_2D, mipLevel, x, y, width, height, m_channels == 4 ? GL_RGBA : GL_RED, GL_UNSIGNED_BYTE, buffer);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	else
+	{
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_gpuHandle);
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, mipLevel, x, y, layer, width, height, 1,
+			m_channels == 4 ? GL_RGBA : GL_RED, GL_UNSIGNED_BYTE, buffer);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+	TFE_ASSERT_GL;
+	return true;
+}
+
 void TextureGpu::setFilter(MagFilter magFilter, MinFilter minFilter, bool isArray) const
 {
 	glTexParameteri(isArray ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter == MAG_FILTER_LINEAR ? GL_LINEAR : GL_NEAREST);
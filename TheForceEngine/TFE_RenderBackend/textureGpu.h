@@ -38,6 +38,8 @@ public:
 	bool createArray(u32 width, u32 height, u32 layers, u32 channels = 4, u32 mipCount = 1);
 	bool createWithData(u32 width, u32 height, const void* buffer, MagFilter magFilter = MAG_FILTER_NONE);
 	bool update(const void* buffer, size_t size, s32 layer = -1, s32 mipLevel = 0);	// layer = -1 means update all layers, otherwise it is the layer index.
+	// Update a sub-rectangle of a single layer, 'rowLength' is the source stride in texels.
+	bool updateRegion(const void* buffer, u32 x, u32 y, u32 width, u32 height, u32 rowLength, s32 layer = 0, s32 mipLevel = 0);
 	void setFilter(MagFilter magFilter, MinFilter minFilter, bool isArray = false) const;
 	void bind(u32 slot = 0) const;
 	static void clear(u32 slot = 0);
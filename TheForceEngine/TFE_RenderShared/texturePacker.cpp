@@ -83,6 +83,18 @@ namespace TFE_Jedi
 	static TexturePacker* s_globalTexturePacker = nullptr;
 
 	static s32 s_colorIndexStart = -1;
+
+	// Where a streamed HD texture was packed, so the HD data can be copied in once it is resident.
+	struct HdStreamSlot
+	{
+		TexturePacker* packer;
+		s32 page;
+		u32 x, y;
+		s32 paddingX, paddingY;
+		s32 mipCount;
+		s32 tableIndex;
+	};
+	static std::map<const TextureData*, HdStreamSlot> s_hdStreamSlots;
 		
 	TextureNode* allocateNode();
 	u8* getWritePointer(s32 page, s32 x, s32 y, u32 mipLevel = 0);
@@ -259,6 +271,7 @@ namespace TFE_Jedi
 		TFE_Memory::chunkedArrayClear(s_nodePool);
 		s_textureDataMap.clear();
 		s_waxDataMap.clear();
+		s_hdStreamSlots.clear();
 		s_texInfoPool.clear();
 
 		// Insert the parent that covers all of the available space.
@@ -633,10 +646,11 @@ namespace TFE_Jedi
 		}
 	}
 
-	void copy8BitToTrueColorTexture(const TextureData* texData, const u8* srcImage, s32 paddingX, s32 paddingY, s32 offsetX, s32 offsetY, u32* output, Vec3f& halfTint)
+	// 'scaleFactor' > 1 upscales the base texture, this is used as a placeholder while HD data is streamed in.
+	void copy8BitToTrueColorTexture(const TextureData* texData, const u8* srcImage, s32 scaleFactor, s32 paddingX, s32 paddingY, s32 offsetX, s32 offsetY, u32* output, Vec3f& halfTint)
 	{
-		const s32 w = texData->width;
-		const s32 h = texData->height;
+		const s32 w = texData->width  * scaleFactor;
+		const s32 h = texData->height * scaleFactor;
 		const s32 dstStrideInTexels = s_texturePacker->width;
 		const u32* pal = getPalette(texData->palIndex);
 		// TODO: For some levels this should be 30.
@@ -651,12 +665,12 @@ namespace TFE_Jedi
 
 		if (srcImage && w > 0 && h > 0)
 		{
-			for (s32 y = 0; y < texData->height + paddingY; y++, output += dstStrideInTexels)
+			for (s32 y = 0; y < h + paddingY; y++, output += dstStrideInTexels)
 			{
-				const s32 ySrc = (y - offsetY + h) % h;
-				for (s32 x = 0; x < texData->width + paddingX; x++)
+				const s32 ySrc = ((y - offsetY + h) % h) / scaleFactor;
+				for (s32 x = 0; x < w + paddingX; x++)
 				{
-					const s32 xSrc = (x - offsetX + w) % w;
+					const s32 xSrc = ((x - offsetX + w) % w) / scaleFactor;
 
 					u8 palIndex = srcImage ? srcImage[xSrc*texData->height + ySrc] : 0;
 					if (texData->flags & INDEXED)
@@ -769,8 +783,10 @@ namespace TFE_Jedi
 		const s32 offsetX = paddingX / 2;
 		const s32 offsetY = paddingY / 2;
 		const bool isHdTex = hdSrc && hdSrc->hdAssetData;
+		// Streamed HD textures reserve the full HD size but show the upscaled base texture until the data is resident.
+		const bool isHdPending = !isHdTex && hdSrc && hdSrc->scaleFactor > 1 && bitmap_isHdPending(hdSrc);
 		const u8* srcImage = isHdTex ? hdSrc->hdAssetData : texData->image;
-		const s32 scaleFactor = isHdTex ? hdSrc->scaleFactor : 1;
+		const s32 scaleFactor = (isHdTex || isHdPending) ? hdSrc->scaleFactor : 1;
 
 		Vec3f halfTint = { 1.0f, 1.0f, 1.0f };
 		if (s_texturePacker->trueColor)
@@ -783,9 +799,14 @@ namespace TFE_Jedi
 			}
 			else
 			{
-				copy8BitToTrueColorTexture(texData, srcImage, paddingX, paddingY, offsetX, offsetY, output, halfTint);
+				copy8BitToTrueColorTexture(texData, srcImage, scaleFactor, paddingX, paddingY, offsetX, offsetY, output, halfTint);
 			}
 			generateTrueColorMips(node, texData, scaleFactor, paddingX, paddingY, mipCount, output);
+
+			if (isHdPending)
+			{
+				s_hdStreamSlots[hdSrc] = { s_texturePacker, s_currentPage, node->rect.x, node->rect.y, paddingX, paddingY, mipCount, s32(tableEntry - s_texturePacker->textureTable) };
+			}
 		}
 		else
 		{
@@ -1209,6 +1230,7 @@ namespace TFE_Jedi
 		TFE_Memory::chunkedArrayClear(s_nodePool);
 		s_textureDataMap.clear();
 		s_waxDataMap.clear();
+		s_hdStreamSlots.clear();
 		s_texInfoPool.clear();
 
 		// Insert the parent that covers all of the available space.
@@ -1292,7 +1314,7 @@ namespace TFE_Jedi
 						else
 						{
 							list[i].sortKey = list[i].texData->width * list[i].texData->height;
-							if (list[i].type == TEXINFO_DF_TEXTURE_DATA && packHdTextures && list[i].texData->hdAssetData)
+							if (list[i].type == TEXINFO_DF_TEXTURE_DATA && packHdTextures && (list[i].texData->hdAssetData || bitmap_isHdPending(list[i].texData)))
 							{
 								list[i].sortKey *= (list[i].texData->scaleFactor * list[i].texData->scaleFactor);
 							}
@@ -1439,6 +1461,70 @@ namespace TFE_Jedi
 		return s_texturePacker->texturesPacked;
 	}
 
+	// Copy newly resident HD data into its reserved slot and upload only that region.
+	// Returns true if the data was copied, the atlas pages then hold the only copy that is needed.
+	bool texturepacker_onHdResident(TextureData* texture)
+	{
+		std::map<const TextureData*, HdStreamSlot>::iterator iSlot = s_hdStreamSlots.find(texture);
+		if (iSlot == s_hdStreamSlots.end()) { return false; }
+
+		const HdStreamSlot& slot = iSlot->second;
+		TexturePacker* packer = slot.packer;
+		if (!packer->texture || slot.page >= (s32)packer->texture->getLayers()) { return false; }
+
+		TexturePacker* prevPacker = s_texturePacker;
+		const s32 prevPage = s_currentPage;
+		s_texturePacker = packer;
+		s_currentPage = slot.page;
+
+		TextureNode node = {};
+		node.rect = { slot.x, slot.y, 0u, 0u };
+		const s32 scaleFactor = texture->scaleFactor;
+		u32* output = (u32*)getWritePointer(slot.page, slot.x, slot.y, 0);
+		copyHdTrueColorTexture(texture, scaleFactor, (u32*)texture->hdAssetData, 0, slot.paddingX, slot.paddingY, slot.paddingX / 2, slot.paddingY / 2, output);
+		generateTrueColorMips(&node, texture, scaleFactor, slot.paddingX, slot.paddingY, slot.mipCount, output);
+
+		u32 x = slot.x, y = slot.y;
+		u32 w = texture->width  * scaleFactor + slot.paddingX;
+		u32 h = texture->height * scaleFactor + slot.paddingY;
+		u32 stride = packer->width;
+		for (s32 m = 0; m < slot.mipCount; m++)
+		{
+			packer->texture->updateRegion(getWritePointer(slot.page, slot.x, slot.y, m), x, y, w, h, stride, slot.page, m);
+			x >>= 1; y >>= 1;
+			w >>= 1; h >>= 1;
+			stride >>= 1;
+		}
+
+		// HD textures are not tinted.
+		Vec4i* tableEntry = &packer->textureTable[slot.tableIndex];
+		tableEntry->z = (tableEntry->z & 0x7fff) | (255 << 15) | (255 << 23);
+		tableEntry->w = (tableEntry->w & 0x7fff) | (255 << 15);
+		packer->textureTableGPU.update(packer->textureTable, sizeof(Vec4i) * packer->texturesPacked);
+
+		// The texture is now packed the same way as a non-streamed HD texture, so the slot is no longer needed.
+		s_hdStreamSlots.erase(iSlot);
+		s_texturePacker = prevPacker;
+		s_currentPage = prevPage;
+		return true;
+	}
+
+	void texturepacker_markHdVisible(const TextureData* texture)
+	{
+		// Only textures still showing their placeholder need the HD data. This includes resident data that could not be
+		// copied yet, so it stays marked as recently seen while it is visible.
+		if (!texture || s_hdStreamSlots.empty()) { return; }
+		if (s_hdStreamSlots.find(texture) != s_hdStreamSlots.end())
+		{
+			bitmap_markHdVisible(texture);
+		}
+	}
+
+	void texturepacker_streamHdTextures()
+	{
+		bitmap_updateHdStreaming(texturepacker_onHdResident);
+	}
+
 	void texturepacker_setIndexStart(s32 colorIndexStart)
 	{
 		s_colorIndexStart = colorIndexStart;
@@ -1469,6 +1555,7 @@ namespace TFE_Jedi
 		TFE_Memory::chunkedArrayClear(s_nodePool);
 		s_textureDataMap.clear();
 		s_waxDataMap.clear();
+		s_hdStreamSlots.clear();
 		s_texInfoPool.clear();
 
 		texturepacker_begin(s_globalTexturePacker);
@@ -83,6 +83,11 @@ namespace TFE_Jedi
 	// Note this may be called multiple times on the same texture packer, new pages are created as needed.
 	s32 texturepacker_pack(TextureListCallback getList, AssetPool pool);
 
+	// HD texture streaming: mark textures seen by the renderer, then once per frame load the HD data
+	// and copy it into the atlas space reserved for it.
+	void texturepacker_markHdVisible(const TextureData* texture);
+	void texturepacker_streamHdTextures();
+
 	void texturepacker_setIndexStart(s32 colorIndexStart = -1);
 	void texturepacker_setConversionPalette(s32 index, s32 bpp, const u8* input);
 }  // TFE_Jedi
\ No newline at end of file
@@ -392,6 +392,10 @@ namespace TFE_Settings
 		writeKeyValue_Float(settings, "anisotropyQuality", s_graphicsSettings.anisotropyQuality);
 
 		writeKeyValue_Int(settings, "frameRateLimit", s_graphicsSettings.frameRateLimit);
+		writeKeyValue_Int(settings, "rendererThreads", s_graphicsSettings.rendererThreads);
+		writeKeyValue_Bool(settings, "dynamicResolution", s_graphicsSettings.dynamicResolution);
+		writeKeyValue_Int(settings, "dynamicResTargetFps", s_graphicsSettings.dynamicResTargetFps);
+		writeKeyValue_Float(settings, "dynamicResMinScale", s_graphicsSettings.dynamicResMinScale);
 		writeKeyValue_Float(settings, "brightness", s_graphicsSettings.brightness);
 		writeKeyValue_Float(settings, "contrast", s_graphicsSettings.contrast);
 		writeKeyValue_Float(settings, "saturation", s_graphicsSettings.saturation);
@@ -420,6 +424,8 @@ namespace TFE_Settings
 		writeKeyValue_Int(settings, "hdTextures", s_enhancementsSettings.enableHdTextures);
 		writeKeyValue_Int(settings, "hdSprites", s_enhancementsSettings.enableHdSprites);
 		writeKeyValue_Int(settings, "hdHud", s_enhancementsSettings.enableHdHud);
+		writeKeyValue_Int(settings, "hdTextureCacheCompress", s_enhancementsSettings.compressHdTextureCache);
+		writeKeyValue_Bool(settings, "hdTextureStreaming", s_enhancementsSettings.streamHdTextures);
 	}
 
 	void writeHudSettings(FileStream& settings)
@@ -578,59 +584,63 @@ namespace TFE_Settings
 		size_t bufferPos = 0;
 		SectionID curSection = SECTION_INVALID;
 
+		TokenViewList tokenViews;
+		char tokens[2][1024];
 		while (bufferPos < len)
 		{
 			const char* line = parser.readLine(bufferPos);
 			if (!line) { break; }
 
-			TokenList tokens;
-			parser.tokenizeLine(line, tokens);
-			if (tokens.size() < 1) { continue; }
+			parser.tokenizeLine(line, tokenViews);
+			if (tokenViews.size() < 1) { continue; }
 
-			if (tokens.size() == 1)
+			if (tokenViews.size() == 1)
 			{
-				curSection = parseSectionName(tokens[0].c_str());
+				TFE_Parser::tokenCopy(tokenViews[0], tokens[0], sizeof(tokens[0]));
+				curSection = parseSectionName(tokens[0]);
 				if (curSection == SECTION_INVALID)
 				{
 					continue;
 				}
 			}
-			else if (tokens.size() == 2)
+			else if (tokenViews.size() == 2)
 			{
+				TFE_Parser::tokenCopy(tokenViews[0], tokens[0], sizeof(tokens[0]));
+				TFE_Parser::tokenCopy(tokenViews[1], tokens[1], sizeof(tokens[1]));
 				switch (curSection)
 				{
 				case SECTION_WINDOW:
-					parseWindowSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseWindowSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_GRAPHICS:
-					parseGraphicsSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseGraphicsSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_ENHANCEMENTS:
-					parseEnhancementsSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseEnhancementsSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_HUD:
-					parseHudSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseHudSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_SOUND:
-					parseSoundSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseSoundSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_SYSTEM:
-					parseSystemSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseSystemSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_A11Y:
-					parseA11ySettings(tokens[0].c_str(), tokens[1].c_str());
+					parseA11ySettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_GAME:
-					parseGame(tokens[0].c_str(), tokens[1].c_str());
+					parseGame(tokens[0], tokens[1]);
 					break;
 				case SECTION_DARK_FORCES:
-					parseDark_ForcesSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseDark_ForcesSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_OUTLAWS:
-					parseOutlawsSettings(tokens[0].c_str(), tokens[1].c_str());
+					parseOutlawsSettings(tokens[0], tokens[1]);
 					break;
 				case SECTION_CVAR:
-					parseCVars(tokens[0].c_str(), tokens[1].c_str());
+					parseCVars(tokens[0], tokens[1]);
 					break;
 				default:
 					assert(0);
@@ -749,6 +759,22 @@ namespace TFE_Settings
 		{
 			s_graphicsSettings.frameRateLimit = parseInt(value);
 		}
+		else if (strcasecmp("rendererThreads", key) == 0)
+		{
+			s_graphicsSettings.rendererThreads = max(0, parseInt(value));
+		}
+		else if (strcasecmp("dynamicResolution", key) == 0)
+		{
+			s_graphicsSettings.dynamicResolution = parseBool(value);
+		}
+		else if (strcasecmp("dynamicResTargetFps", key) == 0)
+		{
+			s_graphicsSettings.dynamicResTargetFps = min(max(parseInt(value), 15), 240);
+		}
+		else if (strcasecmp("dynamicResMinScale", key) == 0)
+		{
+			s_graphicsSettings.dynamicResMinScale = min(max(parseFloat(value), 0.25f), 1.0f);
+		}
 		else if (strcasecmp("brightness", key) == 0)
 		{
 			s_graphicsSettings.brightness = parseFloat(value);
@@ -833,6 +859,14 @@ namespace TFE_Settings
 		{
 			s_enhancementsSettings.enableHdHud = parseBool(value);
 		}
+		else if (strcasecmp("hdTextureCacheCompress", key) == 0)
+		{
+			s_enhancementsSettings.compressHdTextureCache = parseBool(value);
+		}
+		else if (strcasecmp("hdTextureStreaming", key) == 0)
+		{
+			s_enhancementsSettings.streamHdTextures = parseBool(value);
+		}
 	}
 
 	void parseHudSettings(const char* key, const char* value)
@@ -75,6 +75,10 @@ struct TFE_Settings_Graphics
 	f32   gamma = 1.0f;
 	s32   fov = 90;
 	s32   rendererIndex = 0;
+	s32   rendererThreads = 1;	// Software renderer threads, 1 = draw on the main thread only (default), 0 = one per CPU core.
+	bool  dynamicResolution = false;	// Lower the software renderer resolution when the scene misses the frame budget.
+	s32   dynamicResTargetFps = 60;
+	f32   dynamicResMinScale = 0.5f;	// Lowest scene resolution as a fraction of the game resolution.
 	s32   colorMode = COLORMODE_8BIT;
 
 	// 8-bit options.
@@ -109,6 +113,8 @@ struct TFE_Settings_Enhancements
 	bool enableHdTextures = false;
 	bool enableHdSprites = false;
 	bool enableHdHud = false;
+	bool compressHdTextureCache = false;	// Compress the on-disk HD texture cache instead of mapping it directly.
+	bool streamHdTextures = false;			// Read HD level textures as they become visible rather than at level start.
 };
 
 enum TFE_HudScale
@@ -3,6 +3,8 @@
 #include "parser.h"
 #include <assert.h>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
 
 namespace
 {
@@ -230,3 +232,129 @@ void TFE_Parser::tokenizeLine(const char* line, TokenList& tokens)
 		tokens.push_back(curToken);
 	}
 }
+
+void TFE_Parser::tokenizeLine(const char* line, TokenViewList& tokens)
+{
+	tokens.clear();
+
+	for (const char* c = line; *c; )
+	{
+		// Skip separators between tokens.
+		if (isWhitespace(*c) || isSeparator(*c) || (m_enableColonSeperator && *c == ':'))
+		{
+			c++;
+			continue;
+		}
+
+		if (*c == '"')
+		{
+			// Quoted token, which may contain separators.
+			const char* start = ++c;
+			while (*c && *c != '"') { c++; }
+			tokens.push_back({ start, u32(c - start) });
+			if (*c) { c++; }
+			continue;
+		}
+
+		const char* start = c;
+		while (*c && !isWhitespace(*c) && !isSeparator(*c) && !(m_enableColonSeperator && *c == ':')) { c++; }
+		tokens.push_back({ start, u32(c - start) });
+	}
+}
+
+bool TFE_Parser::tokenEquals(const TokenView& token, const char* str)
+{
+	for (u32 i = 0; i < token.len; i++)
+	{
+		if (!str[i] || tolower(token.str[i]) != tolower(str[i])) { return false; }
+	}
+	return str[token.len] == 0;
+}
+
+void TFE_Parser::tokenCopy(const TokenView& token, char* dst, size_t dstSize)
+{
+	if (!dstSize) { return; }
+	const size_t len = std::min(size_t(token.len), dstSize - 1);
+	memcpy(dst, token.str, len);
+	dst[len] = 0;
+}
+
+bool TFE_Parser::parseS32(const TokenView& token, s32* value)
+{
+	const char* c = token.str;
+	const char* end = token.str + token.len;
+	bool negative = false;
+	if (c < end && (*c == '-' || *c == '+'))
+	{
+		negative = *c == '-';
+		c++;
+	}
+	if (c >= end) { return false; }
+
+	s64 result = 0;
+	for (; c < end; c++)
+	{
+		if (*c < '0' || *c > '9') { return false; }
+		result = result * 10 + (*c - '0');
+		if (result > 0x80000000ll) { return false; }
+	}
+	if (negative) { result = -result; }
+	if (result > 0x7fffffffll) { return false; }
+
+	*value = s32(result);
+	return true;
+}
+
+bool TFE_Parser::parseF32(const TokenView& token, f32* value)
+{
+	const char* c = token.str;
+	const char* end = token.str + token.len;
+	bool negative = false;
+	if (c < end && (*c == '-' || *c == '+'))
+	{
+		negative = *c == '-';
+		c++;
+	}
+
+	// Integer and fractional digits are accumulated together and scaled once at the end.
+	f64 result = 0.0;
+	s32 digits = 0;
+	s32 exponent = 0;
+	for (; c < end && *c >= '0' && *c <= '9'; c++, digits++)
+	{
+		result = result * 10.0 + f64(*c - '0');
+	}
+	if (c < end && *c == '.')
+	{
+		for (c++; c < end && *c >= '0' && *c <= '9'; c++, digits++, exponent--)
+		{
+			result = result * 10.0 + f64(*c - '0');
+		}
+	}
+	if (!digits) { return false; }
+
+	// Exponent.
+	if (c < end && (*c == 'e' || *c == 'E'))
+	{
+		c++;
+		bool negativeExp = false;
+		if (c < end && (*c == '-' || *c == '+'))
+		{
+			negativeExp = *c == '-';
+			c++;
+		}
+		if (c >= end) { return false; }
+
+		s32 tokenExp = 0;
+		for (; c < end && *c >= '0' && *c <= '9'; c++)
+		{
+			tokenExp = std::min(tokenExp * 10 + (*c - '0'), 400);
+		}
+		exponent += negativeExp ? -tokenExp : tokenExp;
+	}
+	if (c != end) { return false; }
+	if (exponent) { result *= pow(10.0, exponent); }
+
+	*value = f32(negative ? -result : result);
+	return true;
+}
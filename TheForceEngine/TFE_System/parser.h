@@ -10,6 +10,15 @@
 
 typedef std::vector<std::string> TokenList;
 
+// A token that references the line it was read from, rather than owning a copy of the string.
+// The token is not null-terminated and is only valid until the line changes.
+struct TokenView
+{
+	const char* str;
+	u32 len;
+};
+typedef std::vector<TokenView> TokenViewList;
+
 class TFE_Parser
 {
 public:
@@ -35,6 +44,18 @@ public:
 	// Split a line into tokens using space, comma or equals as separators.
 	// Note strings with spaces still work, they need to be closed in quotes, which are removed upon tokenizing.
 	void tokenizeLine(const char* line, TokenList& tokens);
+	// Split a line into token views, this is the same as above but does not allocate if 'tokens' is reused across lines.
+	// Quotes are only handled at the start of a token, so a token such as ab"cd"ef keeps its quotes.
+	void tokenizeLine(const char* line, TokenViewList& tokens);
+
+	// Token helpers, these avoid sscanf() and do not allocate.
+	// Returns true if the token matches 'str', ignoring case.
+	static bool tokenEquals(const TokenView& token, const char* str);
+	// Copy the token into a null-terminated string, truncating if needed.
+	static void tokenCopy(const TokenView& token, char* dst, size_t dstSize);
+	// Parse a number, returns false if the whole token is not a valid number.
+	static bool parseS32(const TokenView& token, s32* value);
+	static bool parseF32(const TokenView& token, f32* value);
 
 private:
 	const char* m_buffer;
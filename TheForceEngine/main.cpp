@@ -7,6 +7,7 @@
 #include <TFE_Archive/gobArchive.h>
 #include <TFE_Game/igame.h>
 #include <TFE_Game/saveSystem.h>
+#include <TFE_Game/rewind.h>
 #include <TFE_Game/reticle.h>
 #include <TFE_Jedi/InfSystem/infSystem.h>
 #include <TFE_FileSystem/fileutil.h>
@@ -650,6 +651,7 @@ int main(int argc, char* argv[])
 	game_init();
 	inputMapping_startup();
 	TFE_SaveSystem::init();
+	TFE_Rewind::init();
 	TFE_A11Y::init();
 
 	// Uncomment to test memory region allocator.
@@ -859,6 +861,7 @@ int main(int argc, char* argv[])
 			else
 			{
 				TFE_SaveSystem::update();
+				TFE_Rewind::update();
 				s_curGame->loopGame();
 				endInputFrame = TFE_Jedi::task_run() != 0;
 			}
@@ -929,6 +932,7 @@ int main(int argc, char* argv[])
 	TFE_Settings::shutdown();
 	TFE_Jedi::texturepacker_freeGlobal();
 	TFE_RenderBackend::destroy();
+	TFE_Rewind::destroy();
 	TFE_SaveSystem::destroy();
 	SDL_Quit();
 